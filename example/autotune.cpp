@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <string>
+
+#include <boost/program_options.hpp>
+
+#include <boost/compute/core.hpp>
+#include <boost/compute/utility/autotuner.hpp>
+
+namespace compute = boost::compute;
+namespace po = boost::program_options;
+
+// tunes the algorithm parameters for the default device and stores them in
+// the offline parameter cache
+int main(int argc, char *argv[])
+{
+    // setup command line arguments
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("size", po::value<size_t>()->default_value(1 << 22), "input size")
+        ("trials", po::value<size_t>()->default_value(3), "number of trials to run")
+        ("algorithm", po::value<std::string>()->default_value("all"),
+            "algorithm to tune (sort, reduce, copy, map_copy, host_dispatch or all)")
+    ;
+
+    // parse command line
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    const size_t size = vm["size"].as<size_t>();
+    const size_t trials = vm["trials"].as<size_t>();
+    const std::string algorithm = vm["algorithm"].as<std::string>();
+
+    // get the default device
+    compute::device device = compute::system::default_device();
+    compute::command_queue queue = compute::system::default_queue();
+    std::cout << "device: " << device.name() << std::endl;
+    std::cout << "size: " << size << std::endl;
+
+    compute::autotuner tuner(queue, trials);
+
+    if(algorithm == "sort" || algorithm == "all"){
+        std::cout << "tuning sort..." << std::endl;
+        tuner.tune_sort<compute::int_>(size);
+        tuner.tune_sort<compute::uint_>(size);
+        tuner.tune_sort<compute::float_>(size);
+    }
+    if(algorithm == "reduce" || algorithm == "all"){
+        std::cout << "tuning reduce..." << std::endl;
+        tuner.tune_reduce<compute::int_>(size);
+        tuner.tune_reduce<compute::uint_>(size);
+        tuner.tune_reduce<compute::float_>(size);
+    }
+    if(algorithm == "copy" || algorithm == "all"){
+        std::cout << "tuning copy..." << std::endl;
+        tuner.tune_copy<compute::uchar_>(size);
+        tuner.tune_copy<compute::int_>(size);
+        tuner.tune_copy<compute::double_>(size);
+    }
+    if(algorithm == "map_copy" || algorithm == "all"){
+        std::cout << "tuning map copy threshold..." << std::endl;
+        tuner.tune_map_copy<compute::int_, compute::float_>(size);
+        tuner.tune_map_copy<compute::float_, compute::int_>(size);
+    }
+    if(algorithm == "host_dispatch" || algorithm == "all"){
+        std::cout << "tuning host dispatch thresholds..." << std::endl;
+        tuner.tune_host_dispatch<compute::int_>(size);
+        tuner.tune_host_dispatch<compute::float_>(size);
+    }
+
+    // store the parameters in the offline cache
+    tuner.save();
+
+#ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+    std::cout << "stored parameters in the offline cache" << std::endl;
+#else
+    std::cout << "warning: BOOST_COMPUTE_USE_OFFLINE_CACHE is not defined, "
+              << "the parameters were not stored" << std::endl;
+#endif
+
+    return 0;
+}
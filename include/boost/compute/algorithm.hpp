@@ -20,6 +20,14 @@
 #include <boost/compute/algorithm/adjacent_find.hpp>
 #include <boost/compute/algorithm/all_of.hpp>
 #include <boost/compute/algorithm/any_of.hpp>
+#include <boost/compute/algorithm/axpby.hpp>
+#include <boost/compute/algorithm/batched_exclusive_scan.hpp>
+#include <boost/compute/algorithm/batched_gemm.hpp>
+#include <boost/compute/algorithm/batched_inclusive_scan.hpp>
+#include <boost/compute/algorithm/batched_max_element.hpp>
+#include <boost/compute/algorithm/batched_min_element.hpp>
+#include <boost/compute/algorithm/batched_reduce.hpp>
+#include <boost/compute/algorithm/batched_transpose.hpp>
 #include <boost/compute/algorithm/binary_search.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
@@ -38,8 +46,12 @@
 #include <boost/compute/algorithm/for_each.hpp>
 #include <boost/compute/algorithm/for_each_n.hpp>
 #include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/gemm.hpp>
+#include <boost/compute/algorithm/gemv.hpp>
 #include <boost/compute/algorithm/generate.hpp>
 #include <boost/compute/algorithm/generate_n.hpp>
+#include <boost/compute/algorithm/group_by.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
 #include <boost/compute/algorithm/includes.hpp>
 #include <boost/compute/algorithm/inner_product.hpp>
@@ -47,6 +59,7 @@
 #include <boost/compute/algorithm/is_partitioned.hpp>
 #include <boost/compute/algorithm/is_permutation.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/k_way_merge.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/lexicographical_compare.hpp> 
 #include <boost/compute/algorithm/max_element.hpp>
@@ -60,6 +73,7 @@
 #include <boost/compute/algorithm/partition.hpp>
 #include <boost/compute/algorithm/partition_copy.hpp>
 #include <boost/compute/algorithm/partition_point.hpp>
+#include <boost/compute/algorithm/permute_axes.hpp>
 #include <boost/compute/algorithm/prev_permutation.hpp>
 #include <boost/compute/algorithm/random_shuffle.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
@@ -81,12 +95,15 @@
 #include <boost/compute/algorithm/set_union.hpp>
 #include <boost/compute/algorithm/sort.hpp>
 #include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/spmm.hpp>
+#include <boost/compute/algorithm/spmv.hpp>
 #include <boost/compute/algorithm/stable_partition.hpp>
 #include <boost/compute/algorithm/stable_sort.hpp>
 #include <boost/compute/algorithm/stable_sort_by_key.hpp>
 #include <boost/compute/algorithm/swap_ranges.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/algorithm/transform_reduce.hpp>
+#include <boost/compute/algorithm/transpose.hpp>
 #include <boost/compute/algorithm/unique.hpp>
 #include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
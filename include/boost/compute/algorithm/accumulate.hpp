@@ -17,12 +17,14 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/algorithm/detail/serial_accumulate.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 
 namespace boost {
 namespace compute {
@@ -187,6 +189,52 @@ inline T accumulate(InputIterator first,
     return detail::dispatch_accumulate(first, last, init, plus<IT>(), queue);
 }
 
+/// Asynchronous version of accumulate(). Enqueues the accumulation and a
+/// non-blocking read of its result and returns a future for the result
+/// without waiting for the device.
+///
+/// Space complexity: \Omega(1)<br>
+/// Space complexity when optimized to \c reduce(): \Omega(n)
+///
+/// \see accumulate(), reduce_async()
+template<class InputIterator, class T, class BinaryFunction>
+inline future<T> accumulate_async(InputIterator first,
+                                  InputIterator last,
+                                  T init,
+                                  BinaryFunction function,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+
+    if(first == last){
+        return future<T>(init, queue.enqueue_marker());
+    }
+
+    // accumulate to a temporary buffer on the device
+    array<T, 1> value(queue.get_context());
+    if(detail::can_accumulate_with_reduce(init, function)){
+        detail::dispatch_reduce(first, last, value.begin(), function, queue);
+    }
+    else {
+        detail::serial_accumulate(first, last, value.begin(), init, function, queue);
+    }
+
+    return detail::read_single_value_async<T>(value.get_buffer(), 0, queue);
+}
+
+/// \overload
+template<class InputIterator, class T>
+inline future<T> accumulate_async(InputIterator first,
+                                  InputIterator last,
+                                  T init,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type IT;
+
+    return ::boost::compute::accumulate_async(first, last, init, plus<IT>(), queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
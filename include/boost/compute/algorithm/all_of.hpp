@@ -14,6 +14,8 @@
 #include <boost/static_assert.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/functional.hpp>
 #include <boost/compute/algorithm/find_if_not.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
@@ -36,6 +38,23 @@ inline bool all_of(InputIterator first,
     return ::boost::compute::find_if_not(first, last, predicate, queue) == last;
 }
 
+/// Asynchronous version of all_of(). Returns a future which is \c true if
+/// \p predicate returns \c true for all of the elements in the range
+/// [\p first, \p last).
+///
+/// Space complexity: \Omega(1)
+///
+/// \see all_of()
+template<class InputIterator, class UnaryPredicate>
+inline future<bool> all_of_async(InputIterator first,
+                                 InputIterator last,
+                                 UnaryPredicate predicate,
+                                 command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    return detail::find_if_test_async(first, last, not1(predicate), false, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
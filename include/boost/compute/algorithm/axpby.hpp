@@ -0,0 +1,84 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_AXPBY_HPP
+#define BOOST_COMPUTE_ALGORITHM_AXPBY_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Computes <tt>y = alpha * x + beta * y</tt> for the vector \c x in the
+/// range [\p first, \p last) and the vector \c y beginning at \p y.
+///
+/// Unlike transform() with a lambda expression, \p alpha and \p beta are
+/// passed as kernel arguments, so changing them does not build a new
+/// program. If \p beta is zero \c y is not read.
+///
+/// \param alpha scale factor for \c x
+/// \param first first element of \c x
+/// \param last last element of \c x
+/// \param beta scale factor for \c y
+/// \param y first element of \c y
+/// \param queue command queue to perform the operation
+///
+/// \snippet test/test_blas.cpp axpby
+///
+/// Space complexity: \Omega(1)
+///
+/// \see gemv(), transform()
+template<class InputIterator, class OutputIterator>
+inline void axpby(typename std::iterator_traits<OutputIterator>::value_type alpha,
+                  InputIterator first,
+                  InputIterator last,
+                  typename std::iterator_traits<OutputIterator>::value_type beta,
+                  OutputIterator y,
+                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename std::iterator_traits<OutputIterator>::value_type T;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return;
+    }
+
+    detail::meta_kernel k("axpby");
+    k.add_set_arg<const T>("alpha", alpha);
+    k.add_set_arg<const T>("beta", beta);
+
+    k << "const uint i = get_global_id(0);\n"
+      << "if(beta == 0){\n"
+      << "    " << y[k.var<uint_>("i")] << " = alpha * "
+      <<          first[k.var<uint_>("i")] << ";\n"
+      << "}\n"
+      << "else {\n"
+      << "    " << y[k.var<uint_>("i")] << " = alpha * "
+      <<          first[k.var<uint_>("i")] << " + beta * "
+      <<          y[k.var<uint_>("i")] << ";\n"
+      << "}\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_AXPBY_HPP
@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_BATCHED_EXCLUSIVE_SCAN_HPP
+#define BOOST_COMPUTE_ALGORITHM_BATCHED_EXCLUSIVE_SCAN_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/batched_scan.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Performs an exclusive scan of each of the \p segments of the range
+/// beginning at \p first and stores the results at the same positions in
+/// the range beginning at \p result.
+///
+/// Each output value is the sum of \p init and of every previous value in
+/// its segment.
+///
+/// All of the segments are scanned with a single kernel launch, with one
+/// work-group per segment. The scan may be performed in-place.
+///
+/// \param first first element in the input range
+/// \param segments the segments to scan
+/// \param result first element in the result range
+/// \param init value used to initialize the scan of each segment
+/// \param binary_op associative binary operator
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(1)
+///
+/// \see exclusive_scan(), batched_inclusive_scan(), segments
+template<class InputIterator, class OutputIterator, class T, class BinaryOperator>
+inline void batched_exclusive_scan(InputIterator first,
+                                   const segments &segments,
+                                   OutputIterator result,
+                                   T init,
+                                   BinaryOperator binary_op,
+                                   command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::batched_scan(
+        first, segments, result, true, init, binary_op, queue
+    );
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator, class T>
+inline void batched_exclusive_scan(InputIterator first,
+                                   const segments &segments,
+                                   OutputIterator result,
+                                   T init,
+                                   command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename
+        std::iterator_traits<OutputIterator>::value_type output_type;
+
+    detail::batched_scan(
+        first, segments, result, true, init, plus<output_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_BATCHED_EXCLUSIVE_SCAN_HPP
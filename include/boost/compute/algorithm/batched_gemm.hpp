@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_BATCHED_GEMM_HPP
+#define BOOST_COMPUTE_ALGORITHM_BATCHED_GEMM_HPP
+
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/gemm.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Computes the \p batch matrix products
+/// <tt>C[i] = alpha * A[i] * B[i] + beta * C[i]</tt>. The matrices are laid
+/// out as for gemm() and the matrices of each batch begin \p stride_a,
+/// \p stride_b and \p stride_c values after those of the previous one.
+///
+/// All of the products are computed with a single kernel launch, which is
+/// much faster than calling gemm() for each product when there are many
+/// small matrices. A stride of zero uses the same matrix for all products
+/// (e.g. to apply the same weights to a batch of inputs).
+///
+/// \param batch number of products
+/// \param m number of rows in each \c A and \c C
+/// \param n number of columns in each \c B and \c C
+/// \param k number of columns in each \c A and rows in each \c B
+/// \param alpha scale factor for the products
+/// \param a first element of the first \c A
+/// \param lda leading dimension of each \c A
+/// \param stride_a number of values between the starts of each \c A
+/// \param b first element of the first \c B
+/// \param ldb leading dimension of each \c B
+/// \param stride_b number of values between the starts of each \c B
+/// \param beta scale factor for each \c C
+/// \param c first element of the first \c C
+/// \param ldc leading dimension of each \c C
+/// \param stride_c number of values between the starts of each \c C
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(1)
+///
+/// \see gemm()
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline void batched_gemm(size_t batch,
+                         size_t m,
+                         size_t n,
+                         size_t k,
+                         typename std::iterator_traits<OutputIterator>::value_type alpha,
+                         InputIterator1 a,
+                         size_t lda,
+                         size_t stride_a,
+                         InputIterator2 b,
+                         size_t ldb,
+                         size_t stride_b,
+                         typename std::iterator_traits<OutputIterator>::value_type beta,
+                         OutputIterator c,
+                         size_t ldc,
+                         size_t stride_c,
+                         command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator1>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator2>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    BOOST_ASSERT(lda >= k);
+    BOOST_ASSERT(ldb >= n);
+    BOOST_ASSERT(ldc >= n);
+
+    detail::gemm(
+        batch, m, n, k, alpha, a, lda, stride_a, b, ldb, stride_b,
+        beta, c, ldc, stride_c, queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_BATCHED_GEMM_HPP
@@ -0,0 +1,84 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_BATCHED_INCLUSIVE_SCAN_HPP
+#define BOOST_COMPUTE_ALGORITHM_BATCHED_INCLUSIVE_SCAN_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/batched_scan.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Performs an inclusive scan of each of the \p segments of the range
+/// beginning at \p first and stores the results at the same positions in
+/// the range beginning at \p result.
+///
+/// Each output value is the sum of the corresponding input value and of
+/// every previous value in its segment.
+///
+/// All of the segments are scanned with a single kernel launch, with one
+/// work-group per segment. The scan may be performed in-place.
+///
+/// \param first first element in the input range
+/// \param segments the segments to scan
+/// \param result first element in the result range
+/// \param binary_op associative binary operator
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(1)
+///
+/// \see inclusive_scan(), batched_exclusive_scan(), segments
+template<class InputIterator, class OutputIterator, class BinaryOperator>
+inline void batched_inclusive_scan(InputIterator first,
+                                   const segments &segments,
+                                   OutputIterator result,
+                                   BinaryOperator binary_op,
+                                   command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename
+        std::iterator_traits<OutputIterator>::value_type output_type;
+
+    detail::batched_scan(
+        first, segments, result, false, output_type(0), binary_op, queue
+    );
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void batched_inclusive_scan(InputIterator first,
+                                   const segments &segments,
+                                   OutputIterator result,
+                                   command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename
+        std::iterator_traits<OutputIterator>::value_type output_type;
+
+    detail::batched_scan(
+        first, segments, result, false, output_type(0), plus<output_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_BATCHED_INCLUSIVE_SCAN_HPP
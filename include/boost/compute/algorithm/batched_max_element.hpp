@@ -0,0 +1,78 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_BATCHED_MAX_ELEMENT_HPP
+#define BOOST_COMPUTE_ALGORITHM_BATCHED_MAX_ELEMENT_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/batched_find_extrema.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Finds the first element with the maximum value in each of the
+/// \p segments of the range beginning at \p first and stores its position,
+/// relative to the start of segment \c i, in \c result[i]. The position
+/// stored for empty segments is zero.
+///
+/// All of the segments are searched with a single kernel launch, with one
+/// work-group per segment.
+///
+/// \param first first element in the input range
+/// \param segments the segments to search
+/// \param result first element in the result range
+/// \param compare comparison function object which returns true if the first
+///        argument is less than (i.e. is ordered before) the second.
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(1)
+///
+/// \see max_element(), batched_min_element(), segments
+template<class InputIterator, class OutputIterator, class Compare>
+inline void batched_max_element(InputIterator first,
+                                const segments &segments,
+                                OutputIterator result,
+                                Compare compare,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::batched_find_extrema(first, segments, result, compare, false, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void batched_max_element(InputIterator first,
+                                const segments &segments,
+                                OutputIterator result,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    detail::batched_find_extrema(
+        first, segments, result, less<value_type>(), false, queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_BATCHED_MAX_ELEMENT_HPP
@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_BATCHED_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_BATCHED_REDUCE_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/batched_reduce.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Reduces each of the \p segments of the range beginning at \p first with
+/// \p function and stores the result for segment \c i in \c result[i].
+///
+/// All of the segments are reduced with a single kernel launch, with one
+/// work-group per segment. This is much faster than calling reduce() for
+/// each segment when there are many short segments (e.g. thousands of
+/// segments of up to a few thousand values).
+///
+/// The result of empty segments is not written.
+///
+/// \param first first element in the input range
+/// \param segments the segments to reduce
+/// \param result first element in the result range
+/// \param function associative binary reduction function
+/// \param queue command queue to perform the operation
+///
+/// For example, to sum each row of a 1000x64 matrix stored in row-major
+/// order:
+///
+/// \snippet test/test_batched.cpp batched_reduce_rows
+///
+/// The minimum or maximum of each segment is found with \c min<T>() or
+/// \c max<T>() as \p function.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see reduce(), segments
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void batched_reduce(InputIterator first,
+                           const segments &segments,
+                           OutputIterator result,
+                           BinaryFunction function,
+                           command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::batched_reduce(first, segments, result, function, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void batched_reduce(InputIterator first,
+                           const segments &segments,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    detail::batched_reduce(first, segments, result, plus<T>(), queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_BATCHED_REDUCE_HPP
@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_BATCHED_TRANSPOSE_HPP
+#define BOOST_COMPUTE_ALGORITHM_BATCHED_TRANSPOSE_HPP
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/transpose.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Transposes each of the \p batch consecutive \p rows x \p cols matrices
+/// stored in row-major order in the range beginning at \p first and stores
+/// the \p cols x \p rows results consecutively in the range beginning at
+/// \p result.
+///
+/// All of the matrices are transposed with a single kernel launch, which is
+/// much faster than calling transpose() for each matrix when there are many
+/// small matrices.
+///
+/// The input and result ranges must not overlap.
+///
+/// \param first first element in the input range
+/// \param result first element in the result range
+/// \param batch number of matrices
+/// \param rows number of rows in each input matrix
+/// \param cols number of columns in each input matrix
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(1)
+///
+/// \see transpose(), permute_axes()
+template<class InputIterator, class OutputIterator>
+inline void batched_transpose(InputIterator first,
+                              OutputIterator result,
+                              size_t batch,
+                              size_t rows,
+                              size_t cols,
+                              command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::tiled_transpose(first, result, batch, rows, cols, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_BATCHED_TRANSPOSE_HPP
@@ -260,13 +260,17 @@ dispatch_copy(InputIterator first,
     size_t count = iterator_range_size(first, last);
     size_t input_size_bytes = count * sizeof(input_type);
 
+    // a recording queue can only store buffer writes, so the input is
+    // always converted on host and then written
+    const bool recording = queue.is_recording();
+
     // [0; map_copy_threshold) -> copy_to_device_map()
-    if(input_size_bytes < map_copy_threshold) {
+    if(input_size_bytes < map_copy_threshold && !recording) {
         return copy_to_device_map(first, last, result, queue, events);
     }
     // [map_copy_threshold; direct_copy_threshold) -> convert [first; last)
     //     on host and then perform copy_to_device()
-    else if(input_size_bytes < direct_copy_threshold) {
+    else if(input_size_bytes < direct_copy_threshold || recording) {
         std::vector<output_type> vector(first, last);
         return copy_to_device(
             vector.begin(), vector.end(), result, queue, events
@@ -349,9 +353,11 @@ dispatch_copy(InputIterator first,
     // [0; map_copy_threshold) -> copy_to_device_map()
     //
     // if direct_copy_threshold is less than map_copy_threshold
-    // copy_to_device_map() is used for every input
-    if(input_size_bytes < map_copy_threshold
-        || direct_copy_threshold <= map_copy_threshold) {
+    // copy_to_device_map() is used for every input, unless the queue is
+    // recording as only buffer writes can be stored
+    if(!queue.is_recording() &&
+       (input_size_bytes < map_copy_threshold
+        || direct_copy_threshold <= map_copy_threshold)) {
         return copy_to_device_map(first, last, result, queue, events);
     }
     // [map_copy_threshold; inf) -> convert [first; last)
@@ -16,7 +16,9 @@
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/detail/host_dispatch.hpp>
 #include <boost/compute/type_traits/vector_size.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
@@ -26,6 +28,9 @@ namespace compute {
 /// Returns the number of occurrences of \p value in the range
 /// [\p first, \p last).
 ///
+/// Inputs smaller than an opt-in per-device threshold are counted on the
+/// host instead (see host_dispatch).
+///
 /// Space complexity on CPUs: \Omega(1)<br>
 /// Space complexity on GPUs: \Omega(n)
 ///
@@ -43,6 +48,10 @@ inline size_t count(InputIterator first,
     using ::boost::compute::lambda::all;
 
     if(vector_size<value_type>::value == 1){
+        if(detail::use_host_path("count", first, last, equal_to<value_type>(), queue)){
+            return detail::host_count(first, last, value, _1 == value, queue);
+        }
+
         return ::boost::compute::count_if(first,
                                           last,
                                           _1 == value,
@@ -56,6 +65,38 @@ inline size_t count(InputIterator first,
     }
 }
 
+/// Asynchronous version of count(). Returns a future for the number of
+/// occurrences of \p value in the range [\p first, \p last).
+///
+/// Space complexity: \Omega(n)
+///
+/// \see count(), count_if_async()
+template<class InputIterator, class T>
+inline future<size_t> count_async(InputIterator first,
+                                  InputIterator last,
+                                  const T &value,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    using ::boost::compute::_1;
+    using ::boost::compute::lambda::all;
+
+    if(vector_size<value_type>::value == 1){
+        return ::boost::compute::count_if_async(first,
+                                                last,
+                                                _1 == value,
+                                                queue);
+    }
+    else {
+        return ::boost::compute::count_if_async(first,
+                                                last,
+                                                all(_1 == value),
+                                                queue);
+    }
+}
+
 } // end compute namespace
 } // end boost namespace
 
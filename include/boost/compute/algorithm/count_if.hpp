@@ -16,6 +16,7 @@
 #include <boost/compute/device.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_ballot.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_reduce.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_threads.hpp>
@@ -63,6 +64,31 @@ inline size_t count_if(InputIterator first,
     }
 }
 
+/// Asynchronous version of count_if(). Enqueues the count and a
+/// non-blocking read of it and returns a future for the count without
+/// waiting for the device.
+///
+/// Unlike count_if() the count is always computed with a reduction on the
+/// device.
+///
+/// Space complexity: \Omega(n)
+///
+/// \see count_if(), count_async()
+template<class InputIterator, class Predicate>
+inline future<size_t> count_if_async(InputIterator first,
+                                     InputIterator last,
+                                     Predicate predicate,
+                                     command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+
+    if(first == last){
+        return future<size_t>(size_t(0), queue.enqueue_marker());
+    }
+
+    return detail::count_if_with_reduce_async(first, last, predicate, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
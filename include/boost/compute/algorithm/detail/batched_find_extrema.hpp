@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_FIND_EXTREMA_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_FIND_EXTREMA_HPP
+
+#include <iterator>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/utility/segments.hpp>
+#include <boost/compute/algorithm/detail/batched_segments.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// finds the position of the first minimum (or maximum) of each segment
+// with one work-group and stores it, relative to the start of the segment,
+// in result. the position stored for empty segments is zero.
+template<class InputIterator, class OutputIterator, class Compare>
+inline void batched_find_extrema(InputIterator first,
+                                 const segments &segments,
+                                 OutputIterator result,
+                                 Compare compare,
+                                 const bool find_minimum,
+                                 command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type value_type;
+
+    if(segments.count() == 0){
+        return;
+    }
+
+    meta_kernel k("batched_find_extrema");
+    size_t scratch_arg =
+        k.add_arg<value_type *>(memory_object::local_memory, "scratch");
+    size_t scratch_index_arg =
+        k.add_arg<uint_ *>(memory_object::local_memory, "scratch_index");
+
+    batched_segment_kernel segment_kernel(k, segments);
+
+    // a value replaces the current extremum only if it is strictly better
+    // so that the first extremum is found
+    k <<
+        "#ifdef BOOST_COMPUTE_FIND_MAXIMUM\n" <<
+        "#define BOOST_COMPUTE_BETTER(x, y) (" <<
+            compare(k.var<value_type>("y"), k.var<value_type>("x")) << ")\n" <<
+        "#else\n" <<
+        "#define BOOST_COMPUTE_BETTER(x, y) (" <<
+            compare(k.var<value_type>("x"), k.var<value_type>("y")) << ")\n" <<
+        "#endif\n" <<
+
+        "if(lid < active){\n" <<
+        "    uint i = block_start;\n" <<
+        "    " << k.decl<value_type>("best") << " = " <<
+                first[k.var<uint_>("i")] << ";\n" <<
+        "    uint best_index = i;\n" <<
+        "    for(i++; i < block_end; i++){\n" <<
+        "        " << k.decl<const value_type>("next") << " = " <<
+                    first[k.var<uint_>("i")] << ";\n" <<
+        "        if(BOOST_COMPUTE_BETTER(next, best)){\n" <<
+        "            best = next;\n" <<
+        "            best_index = i;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    scratch[lid] = best;\n" <<
+        "    scratch_index[lid] = best_index;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        "for(uint offset = 1; offset < active; offset <<= 1){\n" <<
+        "    if((lid & ((offset << 1) - 1)) == 0 && lid + offset < active){\n" <<
+        "        if(BOOST_COMPUTE_BETTER(scratch[lid + offset], scratch[lid])){\n" <<
+        "            scratch[lid] = scratch[lid + offset];\n" <<
+        "            scratch_index[lid] = scratch_index[lid + offset];\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+
+        "if(lid == 0){\n" <<
+        "    " << result[k.var<uint_>("seg")] <<
+                " = active > 0 ? scratch_index[0] - start : 0;\n" <<
+        "}\n";
+
+    std::string options;
+    if(!find_minimum){
+        options = "-DBOOST_COMPUTE_FIND_MAXIMUM";
+    }
+    kernel kernel = k.compile(queue.get_context(), options);
+
+    size_t work_group_size = segment_kernel.work_group_size(
+        std::string("__boost_batched_find_extrema_") + type_name<value_type>(),
+        kernel,
+        queue
+    );
+
+    kernel.set_arg(scratch_arg, local_buffer<value_type>(work_group_size));
+    kernel.set_arg(scratch_index_arg, local_buffer<uint_>(work_group_size));
+    segment_kernel.exec(kernel, work_group_size, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_FIND_EXTREMA_HPP
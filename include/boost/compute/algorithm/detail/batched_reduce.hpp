@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_REDUCE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_REDUCE_HPP
+
+#include <iterator>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/utility/segments.hpp>
+#include <boost/compute/algorithm/detail/batched_segments.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// reduces each segment with one work-group. each work-item serially
+// reduces its block of the segment and the blocks are then reduced in
+// local memory with a tree reduction.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void batched_reduce(InputIterator first,
+                           const segments &segments,
+                           OutputIterator result,
+                           BinaryFunction function,
+                           command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type input_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(input_type, input_type)>::type
+        result_type;
+
+    if(segments.count() == 0){
+        return;
+    }
+
+    meta_kernel k("batched_reduce");
+    size_t scratch_arg =
+        k.add_arg<result_type *>(memory_object::local_memory, "scratch");
+
+    batched_segment_kernel segment_kernel(k, segments);
+
+    k <<
+        "if(lid < active){\n" <<
+        "    uint i = block_start;\n" <<
+        "    " << k.decl<result_type>("acc") << " = " <<
+                first[k.var<uint_>("i")] << ";\n" <<
+        "    for(i++; i < block_end; i++){\n" <<
+        "        acc = " << function(k.var<result_type>("acc"),
+                                     first[k.var<uint_>("i")]) << ";\n" <<
+        "    }\n" <<
+        "    scratch[lid] = acc;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        "for(uint offset = 1; offset < active; offset <<= 1){\n" <<
+        "    if((lid & ((offset << 1) - 1)) == 0 && lid + offset < active){\n" <<
+        "        scratch[lid] = " <<
+                     function(k.var<result_type>("scratch[lid]"),
+                              k.var<result_type>("scratch[lid + offset]")) << ";\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+
+        "if(lid == 0 && active > 0){\n" <<
+        "    " << result[k.var<uint_>("seg")] << " = scratch[0];\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    size_t work_group_size = segment_kernel.work_group_size(
+        std::string("__boost_batched_reduce_") + type_name<result_type>(), kernel, queue
+    );
+
+    kernel.set_arg(scratch_arg, local_buffer<result_type>(work_group_size));
+    segment_kernel.exec(kernel, work_group_size, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_REDUCE_HPP
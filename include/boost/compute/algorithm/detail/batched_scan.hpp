@@ -0,0 +1,143 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_SCAN_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_SCAN_HPP
+
+#include <iterator>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/utility/segments.hpp>
+#include <boost/compute/algorithm/detail/batched_segments.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// scans each segment with one work-group. each work-item reduces its block
+// of the segment, the block sums are scanned in local memory and each
+// work-item then scans its block starting from the sum of the previous
+// blocks. the input is read before any output is written so the scan may
+// be performed in-place.
+template<class InputIterator, class OutputIterator, class T, class BinaryOperator>
+inline void batched_scan(InputIterator first,
+                         const segments &segments,
+                         OutputIterator result,
+                         bool exclusive,
+                         T init,
+                         BinaryOperator op,
+                         command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type input_type;
+    typedef typename
+        std::iterator_traits<OutputIterator>::value_type output_type;
+
+    if(segments.count() == 0){
+        return;
+    }
+
+    meta_kernel k("batched_scan");
+    size_t scratch_arg =
+        k.add_arg<output_type *>(memory_object::local_memory, "scratch");
+    size_t init_arg = 0;
+    if(exclusive){
+        init_arg = k.add_arg<output_type>("init");
+    }
+
+    batched_segment_kernel segment_kernel(k, segments);
+
+    // reduce the block of each work-item
+    k <<
+        "if(lid < active){\n" <<
+        "    uint i = block_start;\n" <<
+        "    " << k.decl<output_type>("sum") << " = " <<
+                first[k.var<uint_>("i")] << ";\n" <<
+        "    for(i++; i < block_end; i++){\n" <<
+        "        sum = " << op(k.var<output_type>("sum"),
+                               first[k.var<uint_>("i")]) << ";\n" <<
+        "    }\n" <<
+        "    scratch[lid] = sum;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+    // inclusive scan of the block sums
+        "for(uint offset = 1; offset < active; offset <<= 1){\n" <<
+        "    const bool update = lid >= offset && lid < active;\n" <<
+        "    " << k.decl<output_type>("x") << ";\n" <<
+        "    if(update){\n" <<
+        "        x = " << op(k.var<output_type>("scratch[lid - offset]"),
+                             k.var<output_type>("scratch[lid]")) << ";\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(update){\n" <<
+        "        scratch[lid] = x;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+
+    // scan the block of each work-item
+        "if(lid < active){\n" <<
+        "    uint i = block_start;\n";
+
+    if(exclusive){
+        k <<
+            "    " << k.decl<output_type>("sum") << " = lid == 0 ? init : " <<
+                    op(k.var<output_type>("init"),
+                       k.var<output_type>("scratch[lid - 1]")) << ";\n" <<
+            "    for(; i < block_end; i++){\n" <<
+            "        " << k.decl<const input_type>("x") << " = " <<
+                        first[k.var<uint_>("i")] << ";\n" <<
+            "        " << result[k.var<uint_>("i")] << " = sum;\n" <<
+            "        sum = " << op(k.var<output_type>("sum"),
+                                   k.var<output_type>("x")) << ";\n" <<
+            "    }\n";
+    }
+    else {
+        k <<
+            "    " << k.decl<output_type>("sum") << ";\n" <<
+            "    if(lid == 0){\n" <<
+            "        sum = " << first[k.var<uint_>("i")] << ";\n" <<
+            "        " << result[k.var<uint_>("i")] << " = sum;\n" <<
+            "        i++;\n" <<
+            "    }\n" <<
+            "    else {\n" <<
+            "        sum = scratch[lid - 1];\n" <<
+            "    }\n" <<
+            "    for(; i < block_end; i++){\n" <<
+            "        sum = " << op(k.var<output_type>("sum"),
+                                   first[k.var<uint_>("i")]) << ";\n" <<
+            "        " << result[k.var<uint_>("i")] << " = sum;\n" <<
+            "    }\n";
+    }
+
+    k << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    size_t work_group_size = segment_kernel.work_group_size(
+        std::string("__boost_batched_scan_") + type_name<output_type>(), kernel, queue
+    );
+
+    kernel.set_arg(scratch_arg, local_buffer<output_type>(work_group_size));
+    if(exclusive){
+        kernel.set_arg(init_arg, static_cast<output_type>(init));
+    }
+    segment_kernel.exec(kernel, work_group_size, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_SCAN_HPP
@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_SEGMENTS_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_SEGMENTS_HPP
+
+#include <string>
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// emits the declarations common to the batched algorithms. each work-group
+// processes one segment. the segment [start, end) is split into "active"
+// contiguous blocks of "block" values, one per work-item, so that the
+// order of the values is preserved for associative functions.
+class batched_segment_kernel
+{
+public:
+    batched_segment_kernel(meta_kernel &k, const segments &segments)
+        : m_segments(segments),
+          m_size_arg(0),
+          m_stride_arg(0)
+    {
+        k <<
+            k.decl<const uint_>("seg") << " = get_group_id(0);\n" <<
+            k.decl<const uint_>("lid") << " = get_local_id(0);\n" <<
+            k.decl<const uint_>("wgs") << " = get_local_size(0);\n";
+
+        if(segments.has_offsets()){
+            k <<
+                k.decl<const uint_>("start") << " = " <<
+                    segments.offsets()[k.var<uint_>("seg")] << ";\n" <<
+                k.decl<const uint_>("end") << " = " <<
+                    segments.offsets()[k.expr<uint_>("seg+1")] << ";\n";
+        }
+        else {
+            m_size_arg = k.add_arg<uint_>("segment_size");
+            m_stride_arg = k.add_arg<uint_>("segment_stride");
+
+            k <<
+                k.decl<const uint_>("start") << " = seg * segment_stride;\n" <<
+                k.decl<const uint_>("end") << " = start + segment_size;\n";
+        }
+
+        k <<
+            k.decl<const uint_>("n") << " = end - start;\n" <<
+            k.decl<const uint_>("block") << " = (n + wgs - 1) / wgs;\n" <<
+            k.decl<const uint_>("active") << " = block == 0 ? 0 : (n + block - 1) / block;\n" <<
+            k.decl<const uint_>("block_start") << " = start + lid * block;\n" <<
+            k.decl<const uint_>("block_end") << " = min(end, block_start + block);\n";
+    }
+
+    void set_args(kernel &kernel) const
+    {
+        if(!m_segments.has_offsets()){
+            kernel.set_arg(m_size_arg, static_cast<uint_>(m_segments.size()));
+            kernel.set_arg(m_stride_arg, static_cast<uint_>(m_segments.stride()));
+        }
+    }
+
+    // returns the work-group size, read from the parameter cache as "wgs"
+    // for cache_key and reduced to fit the segments and the kernel
+    size_t work_group_size(const std::string &cache_key,
+                           const kernel &kernel,
+                           command_queue &queue) const
+    {
+        const device &device = queue.get_device();
+
+        boost::shared_ptr<parameter_cache> parameters =
+            detail::parameter_cache::get_global_cache(device);
+
+        size_t wgs = parameters->get(cache_key, "wgs", 128);
+
+        if(!m_segments.has_offsets()){
+            size_t size = 1;
+            while(size < m_segments.size()){
+                size *= 2;
+            }
+            wgs = (std::min)(wgs, size);
+        }
+
+        wgs = (std::min)(
+            wgs, kernel.get_work_group_info<size_t>(device, CL_KERNEL_WORK_GROUP_SIZE)
+        );
+
+        return (std::max)(wgs, size_t(1));
+    }
+
+    // launches one work-group of work_group_size work-items per segment
+    void exec(kernel &kernel, size_t work_group_size, command_queue &queue) const
+    {
+        set_args(kernel);
+
+        queue.enqueue_1d_range_kernel(
+            kernel, 0, m_segments.count() * work_group_size, work_group_size
+        );
+    }
+
+private:
+    segments m_segments;
+    size_t m_size_arg;
+    size_t m_stride_arg;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_BATCHED_SEGMENTS_HPP
@@ -17,6 +17,7 @@
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/buffer_host_memory.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
 
@@ -45,6 +46,20 @@ inline DeviceIterator copy_to_device(HostIterator first,
 
     size_t offset = result.get_index();
 
+    // the values are already stored in the host memory of the buffer
+    if(is_buffer_host_memory(result.get_buffer(),
+                             offset * sizeof(value_type),
+                             ::boost::addressof(*first))){
+        synchronize_buffer_host_memory(result.get_buffer(),
+                                       offset * sizeof(value_type),
+                                       count * sizeof(value_type),
+                                       CL_MAP_WRITE,
+                                       queue,
+                                       events);
+
+        return result + static_cast<difference_type>(count);
+    }
+
     queue.enqueue_write_buffer(result.get_buffer(),
                                offset * sizeof(value_type),
                                count * sizeof(value_type),
@@ -17,6 +17,7 @@
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/buffer_host_memory.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
 #include <boost/compute/detail/iterator_plus_distance.hpp>
@@ -44,6 +45,20 @@ inline HostIterator copy_to_host(DeviceIterator first,
     const buffer &buffer = first.get_buffer();
     size_t offset = first.get_index();
 
+    // the result is the host memory of the buffer
+    if(is_buffer_host_memory(buffer,
+                             offset * sizeof(value_type),
+                             ::boost::addressof(*result))){
+        synchronize_buffer_host_memory(buffer,
+                                       offset * sizeof(value_type),
+                                       count * sizeof(value_type),
+                                       CL_MAP_READ,
+                                       queue,
+                                       events);
+
+        return iterator_plus_distance(result, count);
+    }
+
     queue.enqueue_read_buffer(buffer,
                               offset * sizeof(value_type),
                               count * sizeof(value_type),
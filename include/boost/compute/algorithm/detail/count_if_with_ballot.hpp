@@ -13,6 +13,7 @@
 
 #include <boost/compute/context.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/functional/detail/nvidia_ballot.hpp>
@@ -38,7 +39,8 @@ inline size_t count_if_with_ballot(InputIterator first,
 
     const ::boost::compute::context &context = queue.get_context();
 
-    ::boost::compute::vector<uint_> counts(block_count, context);
+    ::boost::compute::vector<uint_, scratch_allocator<uint_> >
+        counts(block_count, context);
 
     ::boost::compute::detail::nvidia_popcount<uint_> popc;
     ::boost::compute::detail::nvidia_ballot<uint_> ballot;
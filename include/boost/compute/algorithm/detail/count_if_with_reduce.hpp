@@ -11,7 +11,13 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_COUNT_IF_WITH_REDUCE_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_COUNT_IF_WITH_REDUCE_HPP
 
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
 #include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/array.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/types/fundamental.hpp>
 
@@ -80,6 +86,52 @@ inline size_t count_if_with_reduce(InputIterator first,
     return static_cast<size_t>(count);
 }
 
+// converts the count read by count_if_with_reduce_async() to size_t
+struct count_reader
+{
+    typedef size_t result_type;
+
+    count_reader(const boost::shared_ptr<ulong_> &count)
+        : m_count(count)
+    {
+    }
+
+    size_t operator()() const
+    {
+        return static_cast<size_t>(*m_count);
+    }
+
+    boost::shared_ptr<ulong_> m_count;
+};
+
+// counts the number of elements matching predicate using reduce() without
+// blocking, the count is read with a non-blocking read
+template<class InputIterator, class Predicate>
+inline future<size_t> count_if_with_reduce_async(InputIterator first,
+                                                 InputIterator last,
+                                                 Predicate predicate,
+                                                 command_queue &queue)
+{
+    countable_predicate<Predicate> reduce_predicate(predicate);
+
+    array<ulong_, 1> device_count(queue.get_context());
+    ::boost::compute::reduce(
+        ::boost::compute::make_transform_iterator(first, reduce_predicate),
+        ::boost::compute::make_transform_iterator(last, reduce_predicate),
+        device_count.begin(),
+        ::boost::compute::plus<ulong_>(),
+        queue
+    );
+
+    boost::shared_ptr<ulong_> count = boost::make_shared<ulong_>(0);
+    event event_ = queue.enqueue_read_buffer_async(
+        device_count.get_buffer(), 0, sizeof(ulong_), count.get()
+    );
+    hold_until_complete(event_, count);
+
+    return future<size_t>(event_, count_reader(count));
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -13,6 +13,7 @@
 
 #include <numeric>
 
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/container/vector.hpp>
 
@@ -88,7 +89,8 @@ public:
         }
 
         // storage for counts
-        ::boost::compute::vector<ulong_> counts(threads, context);
+        ::boost::compute::vector<ulong_, scratch_allocator<ulong_> >
+            counts(threads, context);
 
         // exec kernel
         set_arg(m_size_arg, static_cast<ulong_>(m_size));
@@ -11,10 +11,23 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_HPP
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_FIND_EXTREMA_HPP
 
+#include <iterator>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/array.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/algorithm/detail/find_extrema_on_cpu.hpp>
 #include <boost/compute/algorithm/detail/find_extrema_with_reduce.hpp>
 #include <boost/compute/algorithm/detail/find_extrema_with_atomics.hpp>
+#include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
+#include <boost/compute/algorithm/detail/host_dispatch.hpp>
 #include <boost/compute/algorithm/detail/serial_find_extrema.hpp>
 
 namespace boost {
@@ -35,6 +48,10 @@ inline InputIterator find_extrema(InputIterator first,
         return first;
     }
 
+    if(use_host_path("find_extrema", first, last, compare, queue)){
+        return host_find_extrema(first, last, compare, find_minimum, queue);
+    }
+
     const device &device = queue.get_device();
 
     // CPU
@@ -63,6 +80,143 @@ inline InputIterator find_extrema(InputIterator first,
     return find_extrema_with_atomics(first, last, compare, find_minimum, queue);
 }
 
+template<class Compare, class Arg1, class Arg2>
+struct invoked_extremum_function
+{
+    invoked_extremum_function(Compare compare,
+                              const Arg1 &arg1,
+                              const Arg2 &arg2,
+                              bool find_minimum)
+        : m_compare(compare),
+          m_arg1(arg1),
+          m_arg2(arg2),
+          m_find_minimum(find_minimum)
+    {
+    }
+
+    Compare m_compare;
+    Arg1 m_arg1;
+    Arg2 m_arg2;
+    bool m_find_minimum;
+};
+
+template<class Compare, class Arg1, class Arg2>
+inline meta_kernel& operator<<(meta_kernel &k,
+                               const invoked_extremum_function<Compare, Arg1, Arg2> &expr)
+{
+    if(expr.m_find_minimum){
+        return k << "(" << expr.m_compare(expr.m_arg2, expr.m_arg1) << " ? "
+                 << expr.m_arg2 << " : " << expr.m_arg1 << ")";
+    }
+    else {
+        return k << "(" << expr.m_compare(expr.m_arg1, expr.m_arg2) << " ? "
+                 << expr.m_arg2 << " : " << expr.m_arg1 << ")";
+    }
+}
+
+// binary function returning the lesser (or greater) of two values according
+// to compare, used to reduce a range to its extremum value
+template<class T, class Compare>
+struct extremum_function
+{
+    typedef T result_type;
+
+    extremum_function(Compare compare, bool find_minimum)
+        : m_compare(compare),
+          m_find_minimum(find_minimum)
+    {
+    }
+
+    template<class Arg1, class Arg2>
+    invoked_extremum_function<Compare, Arg1, Arg2>
+    operator()(const Arg1 &arg1, const Arg2 &arg2) const
+    {
+        return invoked_extremum_function<Compare, Arg1, Arg2>(
+            m_compare, arg1, arg2, m_find_minimum
+        );
+    }
+
+    Compare m_compare;
+    bool m_find_minimum;
+};
+
+// condition for find_index_with_atomics_async() which is true if the i'th
+// value is equivalent to the extremum value stored on the device
+template<class InputIterator, class Compare>
+struct extremum_index_condition
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    extremum_index_condition(InputIterator first,
+                             buffer_iterator<value_type> extremum,
+                             Compare compare,
+                             bool find_minimum)
+        : m_first(first),
+          m_extremum(extremum),
+          m_compare(compare),
+          m_find_minimum(find_minimum)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        if(m_find_minimum){
+            k << "!(" << m_compare(m_extremum[k.expr<uint_>("0")],
+                                   m_first[k.expr<uint_>("i")]) << ")";
+        }
+        else {
+            k << "!(" << m_compare(m_first[k.expr<uint_>("i")],
+                                   m_extremum[k.expr<uint_>("0")]) << ")";
+        }
+    }
+
+    InputIterator m_first;
+    buffer_iterator<value_type> m_extremum;
+    Compare m_compare;
+    bool m_find_minimum;
+};
+
+// enqueues the search for the first extremum in the range without blocking.
+// the extremum value is found with reduce() and its position with a second
+// kernel searching for the first equivalent value.
+template<class InputIterator, class Compare>
+inline future<InputIterator> find_extrema_async(InputIterator first,
+                                                InputIterator last,
+                                                Compare compare,
+                                                const bool find_minimum,
+                                                command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    size_t count = iterator_range_size(first, last);
+
+    // handle trivial cases
+    if(count == 0 || count == 1){
+        return future<InputIterator>(first, queue.enqueue_marker());
+    }
+
+    array<value_type, 1> extremum(queue.get_context());
+    ::boost::compute::reduce(
+        first,
+        last,
+        extremum.begin(),
+        extremum_function<value_type, Compare>(compare, find_minimum),
+        queue
+    );
+
+    boost::shared_ptr<uint_> index = boost::make_shared<uint_>(0);
+    event event_ = find_index_with_atomics_async(
+        extremum_index_condition<InputIterator, Compare>(
+            first, extremum.begin(), compare, find_minimum
+        ),
+        count, index, queue
+    );
+
+    return future<InputIterator>(
+        event_, found_index_iterator<InputIterator>(first, index)
+    );
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -17,6 +17,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/allocator/pinned_allocator.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
@@ -290,8 +291,9 @@ InputIterator find_extrema_with_reduce(InputIterator first,
 
     // device buffors for extremum candidates and their indices
     // each work-group computes its candidate
-    vector<input_type> candidates(work_groups_no, context);
-    vector<uint_> candidates_idx(work_groups_no, context);
+    vector<input_type, scratch_allocator<input_type> >
+        candidates(work_groups_no, context);
+    vector<uint_, scratch_allocator<uint_> > candidates_idx(work_groups_no, context);
 
     // finding candidates for first extremum and their indices
     find_extrema_with_reduce(
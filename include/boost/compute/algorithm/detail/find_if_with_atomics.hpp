@@ -13,15 +13,20 @@
 
 #include <iterator>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
 #include <boost/compute/types.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 
 namespace boost {
 namespace compute {
@@ -206,6 +211,175 @@ inline InputIterator find_if_with_atomics(InputIterator first,
     );
 }
 
+// condition for find_index_with_atomics_async() which is true if predicate
+// returns true for the i'th value
+template<class InputIterator, class UnaryPredicate>
+struct find_if_index_condition
+{
+    find_if_index_condition(InputIterator first, UnaryPredicate predicate)
+        : m_first(first),
+          m_predicate(predicate)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << m_predicate(m_first[k.var<const uint_>("i")]);
+    }
+
+    InputIterator m_first;
+    UnaryPredicate m_predicate;
+};
+
+// converts the index read by find_index_with_atomics_async() to an iterator
+template<class Iterator>
+struct found_index_iterator
+{
+    typedef Iterator result_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    found_index_iterator(Iterator first, const boost::shared_ptr<uint_> &index)
+        : m_first(first),
+          m_index(index)
+    {
+    }
+
+    Iterator operator()() const
+    {
+        return m_first + static_cast<difference_type>(*m_index);
+    }
+
+    Iterator m_first;
+    boost::shared_ptr<uint_> m_index;
+};
+
+// returns true if the index read by find_index_with_atomics_async() is
+// equal to (or with found set, is not equal to) not_found
+struct found_index_test
+{
+    typedef bool result_type;
+
+    found_index_test(const boost::shared_ptr<uint_> &index,
+                     uint_ not_found,
+                     bool found)
+        : m_index(index),
+          m_not_found(not_found),
+          m_found(found)
+    {
+    }
+
+    bool operator()() const
+    {
+        return (*m_index != m_not_found) == m_found;
+    }
+
+    boost::shared_ptr<uint_> m_index;
+    uint_ m_not_found;
+    bool m_found;
+};
+
+// enqueues the search for the lowest index i in [0, count) for which the
+// condition emitted by condition(k) is true, followed by a non-blocking read
+// of it (or of count if there is no such index) to *index. returns the
+// event for the read. nothing blocks, index is kept alive until the event
+// is complete.
+//
+// Space complexity: O(1)
+template<class Condition>
+inline event find_index_with_atomics_async(const Condition &condition,
+                                           size_t count,
+                                           const boost::shared_ptr<uint_> &index,
+                                           command_queue &queue)
+{
+    const context &context = queue.get_context();
+
+    detail::meta_kernel k("find_index");
+    size_t index_arg = k.add_arg<uint_ *>(memory_object::global_memory, "index");
+    atomic_min<uint_> atomic_min_uint;
+
+    k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+      << "if(";
+    condition(k);
+    k << "){\n"
+      << "    " << atomic_min_uint(k.var<uint_ *>("index"), k.var<uint_>("i")) << ";\n"
+      << "}\n";
+
+    buffer index_buffer(context, sizeof(uint_));
+
+    // initialize index to count, it is then overwritten by the read. the
+    // commands are chained with their events so that the read into the same
+    // host memory cannot overlap the write on an out-of-order queue
+    *index = static_cast<uint_>(count);
+    event last = queue.enqueue_write_buffer_async(
+        index_buffer, 0, sizeof(uint_), index.get()
+    );
+
+    if(count > 0){
+        kernel kernel = k.compile(context);
+        kernel.set_arg(index_arg, index_buffer);
+        last = queue.enqueue_1d_range_kernel(kernel, 0, count, 0, last);
+    }
+
+    event event_ = queue.enqueue_read_buffer_async(
+        index_buffer, 0, sizeof(uint_), index.get(), last
+    );
+    hold_until_complete(event_, index);
+
+    return event_;
+}
+
+// condition for find_index_with_atomics_async() which is true if predicate
+// returns true for the i'th and (i+1)'th values
+template<class InputIterator, class BinaryPredicate>
+struct adjacent_index_condition
+{
+    adjacent_index_condition(InputIterator first, BinaryPredicate predicate)
+        : m_first(first),
+          m_predicate(predicate)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << m_predicate(m_first[k.expr<uint_>("i")],
+                         m_first[k.expr<uint_>("i+1")]);
+    }
+
+    InputIterator m_first;
+    BinaryPredicate m_predicate;
+};
+
+template<class InputIterator, class BinaryPredicate>
+inline adjacent_index_condition<InputIterator, BinaryPredicate>
+make_adjacent_index_condition(InputIterator first, BinaryPredicate predicate)
+{
+    return adjacent_index_condition<InputIterator, BinaryPredicate>(
+        first, predicate
+    );
+}
+
+// returns a future which is true if predicate returns true for any value in
+// the range (or with found set to false, for none of them)
+template<class InputIterator, class UnaryPredicate>
+inline future<bool> find_if_test_async(InputIterator first,
+                                       InputIterator last,
+                                       UnaryPredicate predicate,
+                                       bool found,
+                                       command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(first, last);
+    boost::shared_ptr<uint_> index = boost::make_shared<uint_>(0);
+
+    event event_ = find_index_with_atomics_async(
+        find_if_index_condition<InputIterator, UnaryPredicate>(first, predicate),
+        count, index, queue
+    );
+
+    return future<bool>(
+        event_, found_index_test(index, static_cast<uint_>(count), found)
+    );
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -0,0 +1,276 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_GEMM_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_GEMM_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// adds the arguments shared by the gemm kernels
+template<class T>
+inline void gemm_add_args(meta_kernel &k,
+                          size_t m,
+                          size_t n,
+                          size_t depth,
+                          const T &alpha,
+                          size_t lda,
+                          size_t stride_a,
+                          size_t ldb,
+                          size_t stride_b,
+                          const T &beta,
+                          size_t ldc,
+                          size_t stride_c)
+{
+    k.add_set_arg<const uint_>("m", static_cast<uint_>(m));
+    k.add_set_arg<const uint_>("n", static_cast<uint_>(n));
+    k.add_set_arg<const uint_>("depth", static_cast<uint_>(depth));
+    k.add_set_arg<const T>("alpha", alpha);
+    k.add_set_arg<const uint_>("lda", static_cast<uint_>(lda));
+    k.add_set_arg<const uint_>("stride_a", static_cast<uint_>(stride_a));
+    k.add_set_arg<const uint_>("ldb", static_cast<uint_>(ldb));
+    k.add_set_arg<const uint_>("stride_b", static_cast<uint_>(stride_b));
+    k.add_set_arg<const T>("beta", beta);
+    k.add_set_arg<const uint_>("ldc", static_cast<uint_>(ldc));
+    k.add_set_arg<const uint_>("stride_c", static_cast<uint_>(stride_c));
+}
+
+// stores alpha * acc + beta * c to c[index]. c is not read if beta is zero
+// so that it may be uninitialized.
+template<class T, class OutputIterator>
+inline void gemm_store(meta_kernel &k,
+                       OutputIterator c,
+                       const std::string &index,
+                       const std::string &acc)
+{
+    k << "if(beta == 0){\n"
+      << "    " << c[k.expr<uint_>(index)] << " = alpha * " << acc << ";\n"
+      << "}\n"
+      << "else {\n"
+      << "    " << c[k.expr<uint_>(index)] << " = alpha * " << acc << " + beta * "
+      <<          c[k.expr<uint_>(index)] << ";\n"
+      << "}\n";
+}
+
+// computes each value of c with one work-item. used on cpu devices, where
+// the work-items of a work-group run serially and the local memory tiles
+// would only add barriers.
+template<class InputIterator1, class InputIterator2, class OutputIterator, class T>
+inline void gemm_with_work_items(size_t batch,
+                                 size_t m,
+                                 size_t n,
+                                 size_t depth,
+                                 const T &alpha,
+                                 InputIterator1 a,
+                                 size_t lda,
+                                 size_t stride_a,
+                                 InputIterator2 b,
+                                 size_t ldb,
+                                 size_t stride_b,
+                                 const T &beta,
+                                 OutputIterator c,
+                                 size_t ldc,
+                                 size_t stride_c,
+                                 command_queue &queue)
+{
+    meta_kernel k("gemm");
+    gemm_add_args(
+        k, m, n, depth, alpha, lda, stride_a, ldb, stride_b, beta, ldc, stride_c
+    );
+
+    k << "const uint col = get_global_id(0);\n"
+      << "const uint row = get_global_id(1);\n"
+      << "const uint batch = get_global_id(2);\n"
+      << k.decl<T>("acc") << " = 0;\n"
+      << "for(uint p = 0; p < depth; p++){\n"
+      << "    acc += "
+      <<      a[k.expr<uint_>("batch * stride_a + row * lda + p")] << " * "
+      <<      b[k.expr<uint_>("batch * stride_b + p * ldb + col")] << ";\n"
+      << "}\n";
+    gemm_store<T>(k, c, "batch * stride_c + row * ldc + col", "acc");
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_work_size[] = { n, m, batch };
+    queue.enqueue_nd_range_kernel(kernel, 3, 0, global_work_size, 0);
+}
+
+// computes c with tiles of tile x tile values for each work-group. the
+// tiles of a and b are staged in local memory and each work-item keeps
+// wpt values of a column of the c tile in registers, so that each value
+// read from the b tile is used wpt times.
+template<class InputIterator1, class InputIterator2, class OutputIterator, class T>
+inline void gemm_with_tiles(size_t batch,
+                            size_t m,
+                            size_t n,
+                            size_t depth,
+                            const T &alpha,
+                            InputIterator1 a,
+                            size_t lda,
+                            size_t stride_a,
+                            InputIterator2 b,
+                            size_t ldb,
+                            size_t stride_b,
+                            const T &beta,
+                            OutputIterator c,
+                            size_t ldc,
+                            size_t stride_c,
+                            command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    std::string cache_key = std::string("__boost_gemm_") + type_name<T>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    size_t tile = (std::max)(size_t(parameters->get(cache_key, "tile", 16)), size_t(1));
+    size_t wpt = (std::max)(size_t(parameters->get(cache_key, "wpt", 4)), size_t(1));
+
+    // the two tiles must fit in local memory and the work-group of
+    // tile x (tile / wpt) work-items must fit on the device
+    const size_t max_work_group_size =
+        device.get_info<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE);
+    while(tile > 1 && 2 * tile * tile * sizeof(T) > device.local_memory_size()){
+        tile /= 2;
+    }
+    wpt = (std::min)(wpt, tile);
+    while(tile % wpt != 0){
+        wpt--;
+    }
+    while(tile * (tile / wpt) > max_work_group_size && wpt < tile){
+        wpt++;
+        while(tile % wpt != 0){
+            wpt++;
+        }
+    }
+
+    const size_t rows_per_group = tile / wpt;
+
+    meta_kernel k("gemm_with_tiles");
+    gemm_add_args(
+        k, m, n, depth, alpha, lda, stride_a, ldb, stride_b, beta, ldc, stride_c
+    );
+    size_t a_tile_arg = k.add_arg<T *>(memory_object::local_memory, "a_tile");
+    size_t b_tile_arg = k.add_arg<T *>(memory_object::local_memory, "b_tile");
+
+    k << "const uint lx = get_local_id(0);\n"
+      << "const uint ly = get_local_id(1);\n"
+      << "const uint col = get_group_id(0) * " << uint_(tile) << " + lx;\n"
+      << "const uint row0 = get_group_id(1) * " << uint_(tile) << ";\n"
+      << "const uint batch = get_global_id(2);\n"
+      << k.decl<T>("acc") << "[" << uint_(wpt) << "];\n"
+      << "for(uint w = 0; w < " << uint_(wpt) << "; w++){\n"
+      << "    acc[w] = 0;\n"
+      << "}\n"
+
+      << "for(uint t = 0; t < depth; t += " << uint_(tile) << "){\n"
+      // load the tiles, padding the parts outside of the matrices with zeros
+      << "    for(uint w = 0; w < " << uint_(wpt) << "; w++){\n"
+      << "        const uint r = ly + w * " << uint_(rows_per_group) << ";\n"
+      << "        a_tile[r * " << uint_(tile) << " + lx] =\n"
+      << "            (row0 + r < m && t + lx < depth) ? "
+      <<              a[k.expr<uint_>("batch * stride_a + (row0 + r) * lda + t + lx")]
+      <<              " : 0;\n"
+      << "        b_tile[r * " << uint_(tile) << " + lx] =\n"
+      << "            (t + r < depth && col < n) ? "
+      <<              b[k.expr<uint_>("batch * stride_b + (t + r) * ldb + col")]
+      <<              " : 0;\n"
+      << "    }\n"
+      << "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+
+      << "    for(uint p = 0; p < " << uint_(tile) << "; p++){\n"
+      << "        " << k.decl<T>("b_value") << " = b_tile[p * "
+      <<              uint_(tile) << " + lx];\n"
+      << "        for(uint w = 0; w < " << uint_(wpt) << "; w++){\n"
+      << "            acc[w] += a_tile[(ly + w * " << uint_(rows_per_group) << ") * "
+      <<                  uint_(tile) << " + p] * b_value;\n"
+      << "        }\n"
+      << "    }\n"
+      << "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "}\n"
+
+      << "for(uint w = 0; w < " << uint_(wpt) << "; w++){\n"
+      << "    const uint row = row0 + ly + w * " << uint_(rows_per_group) << ";\n"
+      << "    if(row < m && col < n){\n";
+    gemm_store<T>(k, c, "batch * stride_c + row * ldc + col", "acc[w]");
+    k << "    }\n"
+      << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(a_tile_arg, local_buffer<T>(tile * tile));
+    kernel.set_arg(b_tile_arg, local_buffer<T>(tile * tile));
+
+    const size_t global_work_size[] = {
+        ((n + tile - 1) / tile) * tile,
+        ((m + tile - 1) / tile) * rows_per_group,
+        batch
+    };
+    const size_t local_work_size[] = { tile, rows_per_group, 1 };
+
+    queue.enqueue_nd_range_kernel(
+        kernel, 3, 0, global_work_size, local_work_size
+    );
+}
+
+// computes c = alpha * a * b + beta * c for batch row-major matrices
+template<class InputIterator1, class InputIterator2, class OutputIterator, class T>
+inline void gemm(size_t batch,
+                 size_t m,
+                 size_t n,
+                 size_t depth,
+                 const T &alpha,
+                 InputIterator1 a,
+                 size_t lda,
+                 size_t stride_a,
+                 InputIterator2 b,
+                 size_t ldb,
+                 size_t stride_b,
+                 const T &beta,
+                 OutputIterator c,
+                 size_t ldc,
+                 size_t stride_c,
+                 command_queue &queue)
+{
+    if(batch == 0 || m == 0 || n == 0){
+        return;
+    }
+
+    if(queue.get_device().type() & device::cpu){
+        gemm_with_work_items(
+            batch, m, n, depth, alpha, a, lda, stride_a, b, ldb, stride_b,
+            beta, c, ldc, stride_c, queue
+        );
+    }
+    else {
+        gemm_with_tiles(
+            batch, m, n, depth, alpha, a, lda, stride_a, b, ldb, stride_b,
+            beta, c, ldc, stride_c, queue
+        );
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_GEMM_HPP
@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_GEMV_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_GEMV_HPP
+
+#include <algorithm>
+#include <string>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/gemm.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes y = alpha * a * x + beta * y for a row-major matrix a. on cpu
+// devices each work-item computes the dot product of one row serially.
+// otherwise each row is reduced by a work-group, whose work-items read
+// consecutive values of the row and combine their partial sums in local
+// memory.
+template<class MatrixIterator, class VectorIterator, class OutputIterator, class T>
+inline void gemv(size_t rows,
+                 size_t cols,
+                 const T &alpha,
+                 MatrixIterator a,
+                 size_t lda,
+                 VectorIterator x,
+                 const T &beta,
+                 OutputIterator y,
+                 command_queue &queue)
+{
+    if(rows == 0){
+        return;
+    }
+
+    const device &device = queue.get_device();
+    const bool cpu = (device.type() & device::cpu) != 0;
+
+    meta_kernel k("gemv");
+    k.add_set_arg<const uint_>("cols", static_cast<uint_>(cols));
+    k.add_set_arg<const uint_>("lda", static_cast<uint_>(lda));
+    k.add_set_arg<const T>("alpha", alpha);
+    k.add_set_arg<const T>("beta", beta);
+
+    if(cpu){
+        k << "const uint row = get_global_id(0);\n"
+          << k.decl<T>("acc") << " = 0;\n"
+          << "for(uint j = 0; j < cols; j++){\n"
+          << "    acc += " << a[k.expr<uint_>("row * lda + j")] << " * "
+          <<                  x[k.var<uint_>("j")] << ";\n"
+          << "}\n";
+        gemm_store<T>(k, y, "row", "acc");
+
+        k.exec_1d(queue, 0, rows);
+        return;
+    }
+
+    size_t scratch_arg = k.add_arg<T *>(memory_object::local_memory, "scratch");
+
+    k << "const uint row = get_group_id(0);\n"
+      << "const uint lid = get_local_id(0);\n"
+      << "const uint local_size = get_local_size(0);\n"
+      << k.decl<T>("acc") << " = 0;\n"
+      << "for(uint j = lid; j < cols; j += local_size){\n"
+      << "    acc += " << a[k.expr<uint_>("row * lda + j")] << " * "
+      <<                  x[k.var<uint_>("j")] << ";\n"
+      << "}\n"
+      << "scratch[lid] = acc;\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "for(uint offset = local_size / 2; offset > 0; offset >>= 1){\n"
+      << "    if(lid < offset){\n"
+      << "        scratch[lid] += scratch[lid + offset];\n"
+      << "    }\n"
+      << "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "}\n"
+      << "if(lid == 0){\n";
+    gemm_store<T>(k, y, "row", "scratch[0]");
+    k << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    std::string cache_key = std::string("__boost_gemv_") + type_name<T>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    // the reduction needs a power of two work-group size, which is not
+    // larger than needed for short rows
+    const size_t max_work_group_size = (std::min)(
+        size_t(parameters->get(cache_key, "wgsize", 128)),
+        kernel.get_work_group_info<size_t>(device, CL_KERNEL_WORK_GROUP_SIZE)
+    );
+    size_t work_group_size = 1;
+    while(work_group_size * 2 <= max_work_group_size &&
+          work_group_size < cols){
+        work_group_size *= 2;
+    }
+
+    kernel.set_arg(scratch_arg, local_buffer<T>(work_group_size));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, rows * work_group_size, work_group_size
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_GEMV_HPP
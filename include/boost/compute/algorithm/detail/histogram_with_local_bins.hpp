@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_WITH_LOCAL_BINS_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_WITH_LOCAL_BINS_HPP
+
+#include <algorithm>
+#include <string>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Returns true if a private copy of the bins fits in the local memory of
+// the device.
+inline bool histogram_with_local_bins_requirements_met(size_t num_bins,
+                                                       command_queue &queue)
+{
+    const device &device = queue.get_device();
+    const size_t local_mem_size = device.local_memory_size();
+
+    return num_bins * sizeof(uint_) <= local_mem_size;
+}
+
+// Computes a histogram where each work-group counts into its own copy of the
+// bins in local memory and then adds them to the global bins, so the global
+// atomics are proportional to the number of bins rather than the number of
+// values and hot bins only contend within a work-group.
+//
+// The bin_index functor emits the bin of the value at index "i", values
+// which fall outside of [0, num_bins) are not counted.
+template<class BinIndex, class OutputIterator>
+inline void histogram_with_local_bins(const BinIndex &bin_index,
+                                      size_t count,
+                                      OutputIterator bins_result,
+                                      size_t num_bins,
+                                      command_queue &queue)
+{
+    const device &device = queue.get_device();
+
+    std::string cache_key = "__boost_histogram_with_local_bins";
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    const size_t work_group_size = (std::min)(
+        static_cast<size_t>(parameters->get(cache_key, "wgsize", 256)),
+        device.get_info<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE)
+    );
+    const size_t groups_per_compute_unit =
+        static_cast<size_t>(parameters->get(cache_key, "wg_per_cu", 8));
+
+    // each work-group strides over many values so that merging its bins
+    // into the global bins is amortized
+    size_t work_groups = (std::min)(
+        device.compute_units() * groups_per_compute_unit,
+        (count + work_group_size - 1) / work_group_size
+    );
+    work_groups = (std::max)(work_groups, size_t(1));
+
+    ::boost::compute::fill_n(bins_result, num_bins, uint_(0), queue);
+
+    meta_kernel k("histogram_with_local_bins");
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k.add_set_arg<const uint_>("num_bins", static_cast<uint_>(num_bins));
+    size_t local_bins_arg =
+        k.add_arg<uint_ *>(memory_object::local_memory, "local_bins");
+
+    k << "const uint lid = get_local_id(0);\n"
+      << "const uint local_size = get_local_size(0);\n"
+      << "for(uint b = lid; b < num_bins; b += local_size){\n"
+      << "    local_bins[b] = 0;\n"
+      << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n"
+      << "    const uint bin = (uint)(";
+    bin_index(k);
+    k << ");\n"
+      << "    if(bin < num_bins){\n"
+      << "        " BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "inc(&local_bins[bin]);\n"
+      << "    }\n"
+      << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "for(uint b = lid; b < num_bins; b += local_size){\n"
+      << "    const uint local_count = local_bins[b];\n"
+      << "    if(local_count > 0){\n"
+      << "        " BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "add(&"
+      <<              bins_result[k.var<const uint_>("b")] << ", local_count);\n"
+      << "    }\n"
+      << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(local_bins_arg, local_buffer<uint_>(num_bins));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_groups * work_group_size, work_group_size
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_WITH_LOCAL_BINS_HPP
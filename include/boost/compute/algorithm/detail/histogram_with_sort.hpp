@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_WITH_SORT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_WITH_SORT_HPP
+
+#include <iterator>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Computes a histogram by sorting the bin of each value and counting the
+// runs of equal bins with reduce_by_key(). Used when the bins do not fit in
+// local memory, the cost is independent of the number of bins.
+template<class BinIndex, class OutputIterator>
+inline void histogram_with_sort(const BinIndex &bin_index,
+                                size_t count,
+                                OutputIterator bins_result,
+                                size_t num_bins,
+                                command_queue &queue)
+{
+    const context &context = queue.get_context();
+
+    // compute the bin for each value
+    vector<uint_> bins(count, context);
+
+    meta_kernel bin_kernel("histogram_with_sort_bins");
+    bin_kernel << "const uint i = get_global_id(0);\n"
+               << bins.begin()[bin_kernel.var<const uint_>("i")]
+               << " = (uint)(";
+    bin_index(bin_kernel);
+    bin_kernel << ");\n";
+    bin_kernel.exec_1d(queue, 0, count);
+
+    ::boost::compute::sort(bins.begin(), bins.end(), queue);
+
+    // count the values in each bin
+    vector<uint_> unique_bins(count, context);
+    vector<uint_> bin_counts(count, context);
+    size_t unique_count = std::distance(
+        unique_bins.begin(),
+        ::boost::compute::reduce_by_key(
+            bins.begin(), bins.end(),
+            make_constant_iterator<uint_>(1),
+            unique_bins.begin(),
+            bin_counts.begin(),
+            queue
+        ).first
+    );
+
+    // write the counts, bins outside of [0, num_bins) are dropped
+    ::boost::compute::fill_n(bins_result, num_bins, uint_(0), queue);
+
+    meta_kernel k("histogram_with_sort_scatter");
+    k.add_set_arg<const uint_>("num_bins", static_cast<uint_>(num_bins));
+    k << "const uint j = get_global_id(0);\n"
+      << "const uint bin = " << unique_bins.begin()[k.var<const uint_>("j")] << ";\n"
+      << "if(bin < num_bins){\n"
+      << "    " << bins_result[k.var<const uint_>("bin")] << " = "
+      <<          bin_counts.begin()[k.var<const uint_>("j")] << ";\n"
+      << "}\n";
+    k.exec_1d(queue, 0, unique_count);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HISTOGRAM_WITH_SORT_HPP
@@ -0,0 +1,435 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_DISPATCH_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_DISPATCH_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/serial_count_if.hpp>
+#include <boost/compute/algorithm/detail/serial_find_extrema.hpp>
+#include <boost/compute/algorithm/detail/serial_reduce.hpp>
+#include <boost/compute/algorithm/detail/serial_scan.hpp>
+#include <boost/compute/container/array.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
+#include <boost/compute/detail/is_buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/functional/integer.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/type_traits/is_fundamental.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/vector_size.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+template<class T>
+struct host_min
+{
+    T operator()(const T &x, const T &y) const
+    {
+        return y < x ? y : x;
+    }
+};
+
+template<class T>
+struct host_max
+{
+    T operator()(const T &x, const T &y) const
+    {
+        return x < y ? y : x;
+    }
+};
+
+// maps the functions which have an equivalent on the host to it
+template<class Function>
+struct host_function
+{
+    typedef void type;
+};
+
+#define BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(name, host_name) \
+    template<class T> \
+    struct host_function<name<T> > \
+    { \
+        typedef host_name<T> type; \
+    };
+
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(plus, std::plus)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(multiplies, std::multiplies)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(bit_and, std::bit_and)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(bit_or, std::bit_or)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(bit_xor, std::bit_xor)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(equal_to, std::equal_to)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(less, std::less)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(greater, std::greater)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(min, host_min)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(max, host_max)
+
+#undef BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION
+
+// true if the values pointed to by Iterator can be mapped to the host
+template<class Iterator>
+struct is_host_mappable_iterator
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    BOOST_STATIC_CONSTANT(bool, value = (
+        is_buffer_iterator<Iterator>::value &&
+        is_fundamental<value_type>::value &&
+        vector_size<value_type>::value == 1
+    ));
+};
+
+// true if function can be applied on the host to the values pointed to by
+// Iterator
+template<class Iterator, class Function>
+struct can_run_on_host
+{
+    BOOST_STATIC_CONSTANT(bool, value = (
+        is_host_mappable_iterator<Iterator>::value &&
+        !boost::is_same<typename host_function<Function>::type, void>::value
+    ));
+};
+
+// maps the range [first, first + count) of a buffer iterator for reading
+// and unmaps it when destroyed
+template<class Iterator>
+class host_mapped_range : boost::noncopyable
+{
+public:
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    host_mapped_range(Iterator first, size_t count, command_queue &queue)
+        : m_buffer(first.get_buffer()),
+          m_queue(queue)
+    {
+        m_ptr = static_cast<value_type *>(
+            queue.enqueue_map_buffer(
+                m_buffer,
+                command_queue::map_read,
+                first.get_index() * sizeof(value_type),
+                count * sizeof(value_type)
+            )
+        );
+        m_end = m_ptr + count;
+    }
+
+    ~host_mapped_range()
+    {
+        m_queue.enqueue_unmap_buffer(m_buffer, m_ptr);
+    }
+
+    const value_type* begin() const
+    {
+        return m_ptr;
+    }
+
+    const value_type* end() const
+    {
+        return m_end;
+    }
+
+private:
+    buffer m_buffer;
+    command_queue &m_queue;
+    value_type *m_ptr;
+    value_type *m_end;
+};
+
+// returns true if algorithm should run on the host (or with a serial kernel
+// for inputs which cannot be processed on the host) for [first, last)
+template<class Iterator, class Function>
+inline bool use_host_path(const char *algorithm,
+                          Iterator first,
+                          Iterator last,
+                          Function function,
+                          command_queue &queue)
+{
+    (void) function;
+
+    // the results of the host path are not recorded
+    if(command_recorder::active(queue.get())){
+        return false;
+    }
+
+    switch(host_dispatch::mode()){
+    case host_dispatch::force_host:
+        return true;
+    case host_dispatch::force_device:
+        return false;
+    default:
+        break;
+    }
+
+    if(!can_run_on_host<Iterator, Function>::value){
+        return false;
+    }
+
+    return iterator_range_size(first, last) <
+               host_dispatch::threshold(algorithm, queue.get_device());
+}
+
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void host_reduce(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        BinaryFunction function,
+                        command_queue &queue,
+                        boost::true_type)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    typename host_function<BinaryFunction>::type host_op;
+
+    T value;
+    {
+        host_mapped_range<InputIterator>
+            input(first, iterator_range_size(first, last), queue);
+
+        const T *iter = input.begin();
+        value = *iter++;
+        for(; iter != input.end(); ++iter){
+            value = host_op(value, *iter);
+        }
+    }
+
+    ::boost::compute::copy_n(&value, 1, result, queue);
+}
+
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void host_reduce(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        BinaryFunction function,
+                        command_queue &queue,
+                        boost::false_type)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+    typedef typename
+        ::boost::compute::result_of<BinaryFunction(T, T)>::type result_type;
+
+    array<result_type, 1> value(queue.get_context());
+    serial_reduce(first, last, value.begin(), function, queue);
+    ::boost::compute::copy_n(value.begin(), 1, result, queue);
+}
+
+// reduces [first, last) on the host, or with a single work-item if function
+// cannot be applied on the host
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void host_reduce(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        BinaryFunction function,
+                        command_queue &queue)
+{
+    host_reduce(
+        first, last, result, function, queue,
+        boost::integral_constant<
+            bool, can_run_on_host<InputIterator, BinaryFunction>::value
+        >()
+    );
+}
+
+template<class InputIterator, class OutputIterator, class T, class BinaryOperator>
+inline OutputIterator host_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                bool exclusive,
+                                T init,
+                                BinaryOperator op,
+                                command_queue &queue,
+                                boost::true_type)
+{
+    typedef typename
+        std::iterator_traits<OutputIterator>::value_type output_type;
+
+    typename host_function<BinaryOperator>::type host_op;
+
+    const size_t count = iterator_range_size(first, last);
+    std::vector<output_type> values(count);
+    {
+        host_mapped_range<InputIterator> input(first, count, queue);
+
+        output_type sum = static_cast<output_type>(init);
+        for(size_t i = 0; i < count; i++){
+            const output_type x = static_cast<output_type>(input.begin()[i]);
+            if(exclusive){
+                values[i] = sum;
+                sum = host_op(sum, x);
+            }
+            else {
+                sum = i == 0 ? x : host_op(sum, x);
+                values[i] = sum;
+            }
+        }
+    }
+
+    queue.enqueue_write_buffer(
+        result.get_buffer(),
+        result.get_index() * sizeof(output_type),
+        count * sizeof(output_type),
+        &values[0]
+    );
+
+    return result + static_cast<std::ptrdiff_t>(count);
+}
+
+template<class InputIterator, class OutputIterator, class T, class BinaryOperator>
+inline OutputIterator host_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                bool exclusive,
+                                T init,
+                                BinaryOperator op,
+                                command_queue &queue,
+                                boost::false_type)
+{
+    return serial_scan(first, last, result, exclusive, init, op, queue);
+}
+
+// scans [first, last) on the host, or with a single work-item if op cannot
+// be applied on the host
+template<class InputIterator, class OutputIterator, class T, class BinaryOperator>
+inline OutputIterator host_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                bool exclusive,
+                                T init,
+                                BinaryOperator op,
+                                command_queue &queue)
+{
+    if(first == last){
+        return result;
+    }
+
+    return host_scan(
+        first, last, result, exclusive, init, op, queue,
+        boost::integral_constant<
+            bool,
+            can_run_on_host<InputIterator, BinaryOperator>::value &&
+            is_host_mappable_iterator<OutputIterator>::value
+        >()
+    );
+}
+
+template<class InputIterator, class T, class Predicate>
+inline size_t host_count(InputIterator first,
+                         InputIterator last,
+                         const T &value,
+                         Predicate predicate,
+                         command_queue &queue,
+                         boost::true_type)
+{
+    host_mapped_range<InputIterator>
+        input(first, iterator_range_size(first, last), queue);
+
+    return static_cast<size_t>(std::count(input.begin(), input.end(), value));
+}
+
+template<class InputIterator, class T, class Predicate>
+inline size_t host_count(InputIterator first,
+                         InputIterator last,
+                         const T &value,
+                         Predicate predicate,
+                         command_queue &queue,
+                         boost::false_type)
+{
+    return serial_count_if(first, last, predicate, queue);
+}
+
+// counts the occurrences of value in [first, last) on the host, or with a
+// single work-item evaluating predicate if the values cannot be mapped
+template<class InputIterator, class T, class Predicate>
+inline size_t host_count(InputIterator first,
+                         InputIterator last,
+                         const T &value,
+                         Predicate predicate,
+                         command_queue &queue)
+{
+    if(first == last){
+        return 0;
+    }
+
+    return host_count(
+        first, last, value, predicate, queue,
+        boost::integral_constant<
+            bool, is_host_mappable_iterator<InputIterator>::value
+        >()
+    );
+}
+
+template<class InputIterator, class Compare>
+inline InputIterator host_find_extrema(InputIterator first,
+                                       InputIterator last,
+                                       Compare compare,
+                                       const bool find_minimum,
+                                       command_queue &queue,
+                                       boost::true_type)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    typename host_function<Compare>::type host_compare;
+
+    host_mapped_range<InputIterator>
+        input(first, iterator_range_size(first, last), queue);
+
+    const T *extremum = find_minimum ?
+        std::min_element(input.begin(), input.end(), host_compare) :
+        std::max_element(input.begin(), input.end(), host_compare);
+
+    return first + static_cast<std::ptrdiff_t>(extremum - input.begin());
+}
+
+template<class InputIterator, class Compare>
+inline InputIterator host_find_extrema(InputIterator first,
+                                       InputIterator last,
+                                       Compare compare,
+                                       const bool find_minimum,
+                                       command_queue &queue,
+                                       boost::false_type)
+{
+    return serial_find_extrema(first, last, compare, find_minimum, queue);
+}
+
+// finds the first minimum or maximum in [first, last) on the host, or with a
+// single work-item if compare cannot be applied on the host
+template<class InputIterator, class Compare>
+inline InputIterator host_find_extrema(InputIterator first,
+                                       InputIterator last,
+                                       Compare compare,
+                                       const bool find_minimum,
+                                       command_queue &queue)
+{
+    return host_find_extrema(
+        first, last, compare, find_minimum, queue,
+        boost::integral_constant<
+            bool, can_run_on_host<InputIterator, Compare>::value
+        >()
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_DISPATCH_HPP
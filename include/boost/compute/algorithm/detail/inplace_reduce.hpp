@@ -16,6 +16,7 @@
 #include <boost/utility/result_of.hpp>
 
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
@@ -47,7 +48,7 @@ inline void inplace_reduce(Iterator first,
     if(block_count * block_size * values_per_thread != input_size)
         block_count++;
 
-    vector<value_type> output(block_count, context);
+    vector<value_type, scratch_allocator<value_type> > output(block_count, context);
 
     meta_kernel k("inplace_reduce");
     size_t input_arg = k.add_arg<value_type *>(memory_object::global_memory, "input");
@@ -0,0 +1,410 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_K_WAY_MERGE_WITH_PARTITION_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_K_WAY_MERGE_WITH_PARTITION_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+///
+/// \brief Multi-sequence partition kernel class
+///
+/// For the output rank of each tile boundary finds the position in every
+/// run which splits the runs into the values before and after the boundary.
+/// One work-group handles one boundary: it keeps an undecided window for
+/// each run in local memory and repeatedly takes the middle value of the
+/// largest window as pivot, ranks it against all runs with binary searches
+/// and shrinks the windows on the side of the pivot which does not contain
+/// the boundary. Values which compare equal are ordered by run and then by
+/// position, which makes the merge stable.
+///
+class k_way_merge_partition_kernel : public meta_kernel
+{
+public:
+    size_t lo_arg;
+    size_t hi_arg;
+    size_t bounds_arg;
+    size_t scratch_size_arg;
+    size_t scratch_index_arg;
+
+    k_way_merge_partition_kernel() : meta_kernel("k_way_merge_partition")
+    {
+    }
+
+    template<class OffsetIterator, class InputIterator, class Compare>
+    void set_range(OffsetIterator offsets_first,
+                   InputIterator input_first,
+                   vector<uint_>::iterator splits_first,
+                   uint_ runs,
+                   uint_ total,
+                   uint_ tile_size,
+                   Compare comp)
+    {
+        typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+        add_set_arg<const uint_>("runs", runs);
+        add_set_arg<const uint_>("total", total);
+        add_set_arg<const uint_>("tile_size", tile_size);
+        lo_arg = add_arg<uint_ *>(memory_object::local_memory, "lo");
+        hi_arg = add_arg<uint_ *>(memory_object::local_memory, "hi");
+        bounds_arg = add_arg<uint_ *>(memory_object::local_memory, "bounds");
+        scratch_size_arg =
+            add_arg<uint_ *>(memory_object::local_memory, "scratch_size");
+        scratch_index_arg =
+            add_arg<uint_ *>(memory_object::local_memory, "scratch_index");
+
+        *this <<
+        "const uint g = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint lsize = get_local_size(0);\n" <<
+        "const uint d = min(g * tile_size, total);\n" <<
+        "for(uint s = lid; s < runs; s += lsize){\n" <<
+        "    lo[s] = " << offsets_first[expr<uint_>("s")] << ";\n" <<
+        "    hi[s] = " << offsets_first[expr<uint_>("s + 1")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(;;){\n" <<
+        // find the run with the largest undecided window
+        "    uint best = 0;\n" <<
+        "    uint best_size = 0;\n" <<
+        "    for(uint s = lid; s < runs; s += lsize){\n" <<
+        "        const uint size = hi[s] - lo[s];\n" <<
+        "        if(size > best_size){\n" <<
+        "            best_size = size;\n" <<
+        "            best = s;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    scratch_size[lid] = best_size;\n" <<
+        "    scratch_index[lid] = best;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    for(uint offset = lsize / 2; offset > 0; offset /= 2){\n" <<
+        "        if(lid < offset){\n" <<
+        "            const uint other_size = scratch_size[lid + offset];\n" <<
+        "            const uint other_index = scratch_index[lid + offset];\n" <<
+        "            if(other_size > scratch_size[lid] ||\n" <<
+        "               (other_size == scratch_size[lid] &&\n" <<
+        "                other_index < scratch_index[lid])){\n" <<
+        "                scratch_size[lid] = other_size;\n" <<
+        "                scratch_index[lid] = other_index;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    }\n" <<
+        "    best_size = scratch_size[0];\n" <<
+        "    best = scratch_index[0];\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(best_size == 0){\n" <<
+        "        break;\n" <<
+        "    }\n" <<
+
+        // rank the pivot against the windows of all runs
+        "    const uint mid = lo[best] + best_size / 2;\n" <<
+        "    " << decl<const value_type>("pivot") << " = " <<
+                  input_first[expr<uint_>("mid")] << ";\n" <<
+        "    uint before = 0;\n" <<
+        "    for(uint s = lid; s < runs; s += lsize){\n" <<
+        "        uint first = lo[s];\n" <<
+        "        uint last = hi[s];\n" <<
+        "        if(s == best){\n" <<
+        "            first = mid;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            while(first < last){\n" <<
+        "                const uint m = first + (last - first) / 2;\n" <<
+        "                " << decl<const value_type>("value") << " = " <<
+                              input_first[expr<uint_>("m")] << ";\n" <<
+        "                if(s < best ? !(" <<
+                              comp(var<value_type>("pivot"), var<value_type>("value")) <<
+                              ") : (" <<
+                              comp(var<value_type>("value"), var<value_type>("pivot")) <<
+                              ")){\n" <<
+        "                    first = m + 1;\n" <<
+        "                }\n" <<
+        "                else {\n" <<
+        "                    last = m;\n" <<
+        "                }\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        bounds[s] = first;\n" <<
+        "        before += first - " << offsets_first[expr<uint_>("s")] << ";\n" <<
+        "    }\n" <<
+        "    scratch_size[lid] = before;\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    for(uint offset = lsize / 2; offset > 0; offset /= 2){\n" <<
+        "        if(lid < offset){\n" <<
+        "            scratch_size[lid] += scratch_size[lid + offset];\n" <<
+        "        }\n" <<
+        "        barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    }\n" <<
+        "    before = scratch_size[0];\n" <<
+
+        // keep the side of the pivot which contains the boundary
+        "    for(uint s = lid; s < runs; s += lsize){\n" <<
+        "        if(before < d){\n" <<
+        "            lo[s] = s == best ? mid + 1 : bounds[s];\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            hi[s] = bounds[s];\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "}\n" <<
+        "for(uint s = lid; s < runs; s += lsize){\n" <<
+        "    " << splits_first[expr<uint_>("g * runs + s")] << " = lo[s];\n" <<
+        "}\n";
+    }
+};
+
+///
+/// \brief Multi-sequence merge kernel class
+///
+/// One work-group merges the segments of all runs between two tile
+/// boundaries. The segments are loaded into local memory one after the
+/// other and merged pairwise in log2(k) rounds, each value finding its
+/// position in the neighbouring segment with a binary search in local
+/// memory. Segments of lower runs are always merged as the left side, which
+/// keeps the merge stable.
+///
+class k_way_merge_tile_kernel : public meta_kernel
+{
+public:
+    size_t seg_start_arg;
+    size_t prefix_arg;
+    size_t values_arg;
+    size_t merged_arg;
+
+    k_way_merge_tile_kernel() : meta_kernel("k_way_merge_tile")
+    {
+    }
+
+    template<class InputIterator, class OutputIterator, class Compare>
+    void set_range(InputIterator input_first,
+                   vector<uint_>::iterator splits_first,
+                   OutputIterator result,
+                   uint_ runs,
+                   uint_ total,
+                   uint_ tile_size,
+                   Compare comp)
+    {
+        typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+        add_set_arg<const uint_>("runs", runs);
+        add_set_arg<const uint_>("total", total);
+        add_set_arg<const uint_>("tile_size", tile_size);
+        seg_start_arg = add_arg<uint_ *>(memory_object::local_memory, "seg_start");
+        prefix_arg = add_arg<uint_ *>(memory_object::local_memory, "prefix");
+        values_arg = add_arg<value_type *>(memory_object::local_memory, "values");
+        merged_arg = add_arg<value_type *>(memory_object::local_memory, "merged");
+
+        *this <<
+        "const uint t = get_group_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint lsize = get_local_size(0);\n" <<
+        "const uint tile_begin = t * tile_size;\n" <<
+        "const uint tile_count = min(tile_begin + tile_size, total) - tile_begin;\n" <<
+        "for(uint s = lid; s < runs; s += lsize){\n" <<
+        "    seg_start[s] = " << splits_first[expr<uint_>("t * runs + s")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(lid == 0){\n" <<
+        "    uint sum = 0;\n" <<
+        "    for(uint s = 0; s < runs; s++){\n" <<
+        "        prefix[s] = sum;\n" <<
+        "        sum += " << splits_first[expr<uint_>("(t + 1) * runs + s")] <<
+                         " - seg_start[s];\n" <<
+        "    }\n" <<
+        "    prefix[runs] = sum;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // load the segments of the tile one after the other
+        "for(uint e = lid; e < tile_count; e += lsize){\n" <<
+        "    uint first = 0;\n" <<
+        "    uint last = runs;\n" <<
+        "    while(first < last){\n" <<
+        "        const uint m = first + (last - first) / 2;\n" <<
+        "        if(prefix[m + 1] <= e){\n" <<
+        "            first = m + 1;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            last = m;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "    values[e] = " <<
+                 input_first[expr<uint_>("seg_start[first] + (e - prefix[first])")] << ";\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // merge pairs of segments, each of which holds width runs
+        "__local " << type_name<value_type>() << " *src = values;\n" <<
+        "__local " << type_name<value_type>() << " *dst = merged;\n" <<
+        "for(uint width = 1; width < runs; width *= 2){\n" <<
+        "    for(uint e = lid; e < tile_count; e += lsize){\n" <<
+        "        uint first = 0;\n" <<
+        "        uint last = runs;\n" <<
+        "        while(first < last){\n" <<
+        "            const uint m = first + (last - first) / 2;\n" <<
+        "            if(prefix[m + 1] <= e){\n" <<
+        "                first = m + 1;\n" <<
+        "            }\n" <<
+        "            else {\n" <<
+        "                last = m;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        const uint pair = first / (2 * width) * (2 * width);\n" <<
+        "        const uint left_begin = prefix[pair];\n" <<
+        "        const uint right_begin = prefix[min(pair + width, runs)];\n" <<
+        "        const uint right_end = prefix[min(pair + 2 * width, runs)];\n" <<
+        "        const bool is_left = e < right_begin;\n" <<
+        "        " << decl<const value_type>("value") << " = src[e];\n" <<
+        "        uint lo = is_left ? right_begin : left_begin;\n" <<
+        "        uint hi = is_left ? right_end : right_begin;\n" <<
+        "        const uint other_begin = lo;\n" <<
+        "        while(lo < hi){\n" <<
+        "            const uint m = lo + (hi - lo) / 2;\n" <<
+        "            " << decl<const value_type>("other") << " = src[m];\n" <<
+        "            if(is_left ? (" <<
+                          comp(var<value_type>("other"), var<value_type>("value")) <<
+                          ") : !(" <<
+                          comp(var<value_type>("value"), var<value_type>("other")) <<
+                          ")){\n" <<
+        "                lo = m + 1;\n" <<
+        "            }\n" <<
+        "            else {\n" <<
+        "                hi = m;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        const uint own_offset = e - (is_left ? left_begin : right_begin);\n" <<
+        "        dst[left_begin + own_offset + (lo - other_begin)] = value;\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    __local " << type_name<value_type>() << " *swap = src;\n" <<
+        "    src = dst;\n" <<
+        "    dst = swap;\n" <<
+        "}\n" <<
+        "for(uint e = lid; e < tile_count; e += lsize){\n" <<
+        "    " << result[expr<uint_>("tile_begin + e")] << " = src[e];\n" <<
+        "}\n";
+    }
+};
+
+///
+/// \brief K-way merge with multi-sequence partitioning
+///
+/// Merges the \p runs sorted runs of \p input_first delimited by the
+/// \p runs + 1 offsets in \p offsets_first into \p result. The output is
+/// split into tiles, the position of every tile boundary in every run is
+/// found in a first pass and each tile is merged independently in a second
+/// pass, so all runs are merged without intermediate copies.
+///
+template<class OffsetIterator, class InputIterator,
+         class OutputIterator, class Compare>
+inline void k_way_merge_with_partition(OffsetIterator offsets_first,
+                                       size_t runs,
+                                       size_t total,
+                                       InputIterator input_first,
+                                       OutputIterator result,
+                                       Compare comp,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    std::string cache_key =
+        std::string("__boost_k_way_merge_") + type_name<value_type>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    // each tile and its merged copy must fit into local memory with the
+    // segment offsets
+    const size_t local_memory = static_cast<size_t>(device.local_memory_size());
+    const size_t offsets_size = (2 * runs + 1) * sizeof(uint_);
+    const size_t max_tile_size = local_memory > offsets_size ?
+        (local_memory - offsets_size) / (2 * sizeof(value_type)) : 1;
+    const uint_ tile_size = static_cast<uint_>((std::max)(
+        (std::min)(
+            static_cast<size_t>(parameters->get(cache_key, "tile_size", 2048)),
+            max_tile_size
+        ),
+        size_t(1)
+    ));
+
+    // the reductions in the partition kernel need a power of two
+    size_t work_group_size = (std::min)(
+        static_cast<size_t>(parameters->get(cache_key, "wgsize", 128)),
+        device.get_info<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE)
+    );
+    size_t power_of_two = 1;
+    while(power_of_two * 2 <= work_group_size){
+        power_of_two *= 2;
+    }
+    work_group_size = power_of_two;
+
+    const size_t tiles = (total + tile_size - 1) / tile_size;
+
+    // split positions in each run for each of the tiles + 1 boundaries
+    vector<uint_> splits((tiles + 1) * runs, context);
+
+    k_way_merge_partition_kernel partition_kernel;
+    partition_kernel.set_range(
+        offsets_first, input_first, splits.begin(),
+        static_cast<uint_>(runs), static_cast<uint_>(total), tile_size, comp
+    );
+    kernel partition = partition_kernel.compile(context);
+    partition.set_arg(partition_kernel.lo_arg, local_buffer<uint_>(runs));
+    partition.set_arg(partition_kernel.hi_arg, local_buffer<uint_>(runs));
+    partition.set_arg(partition_kernel.bounds_arg, local_buffer<uint_>(runs));
+    partition.set_arg(
+        partition_kernel.scratch_size_arg, local_buffer<uint_>(work_group_size)
+    );
+    partition.set_arg(
+        partition_kernel.scratch_index_arg, local_buffer<uint_>(work_group_size)
+    );
+    queue.enqueue_1d_range_kernel(
+        partition, 0, (tiles + 1) * work_group_size, work_group_size
+    );
+
+    k_way_merge_tile_kernel tile_kernel;
+    tile_kernel.set_range(
+        input_first, splits.begin(), result,
+        static_cast<uint_>(runs), static_cast<uint_>(total), tile_size, comp
+    );
+    kernel merge = tile_kernel.compile(context);
+    merge.set_arg(tile_kernel.seg_start_arg, local_buffer<uint_>(runs));
+    merge.set_arg(tile_kernel.prefix_arg, local_buffer<uint_>(runs + 1));
+    merge.set_arg(tile_kernel.values_arg, local_buffer<value_type>(tile_size));
+    merge.set_arg(tile_kernel.merged_arg, local_buffer<value_type>(tile_size));
+    queue.enqueue_1d_range_kernel(
+        merge, 0, tiles * work_group_size, work_group_size
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_K_WAY_MERGE_WITH_PARTITION_HPP
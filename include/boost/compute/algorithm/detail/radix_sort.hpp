@@ -23,6 +23,7 @@
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/algorithm/exclusive_scan.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
@@ -330,10 +331,10 @@ inline void radix_sort_impl(const buffer_iterator<T> first,
     }
 
     // setup temporary buffers
-    vector<value_type> output(count, context);
-    vector<T2> values_output(sort_by_key ? count : 0, context);
-    vector<uint_> offsets(k2, context);
-    vector<uint_> counts(block_count * k2, context);
+    vector<value_type, scratch_allocator<value_type> > output(count, context);
+    vector<T2, scratch_allocator<T2> > values_output(sort_by_key ? count : 0, context);
+    vector<uint_, scratch_allocator<uint_> > offsets(k2, context);
+    vector<uint_, scratch_allocator<uint_> > counts(block_count * k2, context);
 
     const buffer *input_buffer = &first.get_buffer();
     uint_ input_offset = static_cast<uint_>(first.get_index());
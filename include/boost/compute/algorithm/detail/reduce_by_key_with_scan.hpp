@@ -16,6 +16,7 @@
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/container/detail/scalar.hpp>
@@ -458,7 +459,7 @@ inline size_t reduce_by_key_with_scan(InputKeyIterator keys_first,
     // Replace original key with unsigned integer keys generated based on given
     // predicate. New key is also an index for keys_result and values_result vectors,
     // which points to place where reduced value should be saved.
-    vector<uint_> new_keys(count, context);
+    vector<uint_, scratch_allocator<uint_> > new_keys(count, context);
     vector<uint_>::iterator new_keys_first = new_keys.begin();
     generate_uint_keys(keys_first, count, predicate, new_keys_first,
                        work_group_size, queue);
@@ -467,12 +468,14 @@ inline size_t reduce_by_key_with_scan(InputKeyIterator keys_first,
     const size_t carry_out_size = static_cast<size_t>(
            std::ceil(float(count) / work_group_size)
     );
-    vector<uint_> carry_out_keys(carry_out_size, context);
-    vector<value_out_type> carry_out_values(carry_out_size, context);
+    vector<uint_, scratch_allocator<uint_> > carry_out_keys(carry_out_size, context);
+    vector<value_out_type, scratch_allocator<value_out_type> >
+        carry_out_values(carry_out_size, context);
     carry_outs(new_keys_first, values_first, count, carry_out_keys.begin(),
                carry_out_values.begin(), function, work_group_size, queue);
 
-    vector<value_out_type> carry_in_values(carry_out_size, context);
+    vector<value_out_type, scratch_allocator<value_out_type> >
+        carry_in_values(carry_out_size, context);
     carry_ins(carry_out_keys.begin(), carry_out_values.begin(),
               carry_in_values.begin(), carry_out_size, function, work_group_size,
               queue);
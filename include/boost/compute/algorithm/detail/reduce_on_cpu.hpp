@@ -15,6 +15,8 @@
 
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/parameter_cache.hpp>
@@ -64,7 +66,7 @@ inline void reduce_on_cpu(InputIterator first,
     }
 
     meta_kernel k("reduce_on_cpu");
-    buffer output(context, sizeof(result_type) * compute_units);
+    vector<result_type, scratch_allocator<result_type> > output(compute_units, context);
 
     size_t count_arg = k.add_arg<uint_>("count");
     size_t output_arg =
@@ -90,13 +92,13 @@ inline void reduce_on_cpu(InputIterator first,
 
     // reduction to global_work_size elements
     kernel.set_arg(count_arg, static_cast<uint_>(count));
-    kernel.set_arg(output_arg, output);
+    kernel.set_arg(output_arg, output.get_buffer());
     queue.enqueue_1d_range_kernel(kernel, 0, global_work_size, 0);
 
     // final reduction
     reduce_on_cpu(
-        make_buffer_iterator<result_type>(output),
-        make_buffer_iterator<result_type>(output, global_work_size),
+        output.begin(),
+        output.begin() + global_work_size,
         result,
         function,
         queue
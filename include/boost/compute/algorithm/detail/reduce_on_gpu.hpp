@@ -16,6 +16,8 @@
 #include <boost/compute/utility/source.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/vendor.hpp>
 #include <boost/compute/detail/parameter_cache.hpp>
 #include <boost/compute/detail/work_size.hpp>
@@ -240,16 +242,22 @@ inline void reduce_on_gpu(InputIterator first,
     size_t count = std::distance(first, last);
 
     // first pass, reduce from input to ping
-    buffer ping(context, std::ceil(float(count) / vpt / tpb) * sizeof(T));
-    initial_reduce(first, last, ping, function, reduce_kernel, vpt, tpb, queue);
+    vector<T, scratch_allocator<T> > ping(
+        static_cast<size_t>(std::ceil(float(count) / vpt / tpb)), context
+    );
+    initial_reduce(
+        first, last, ping.get_buffer(), function, reduce_kernel, vpt, tpb, queue
+    );
 
     // update count after initial reduce
     count = static_cast<size_t>(std::ceil(float(count) / vpt / tpb));
 
     // middle pass(es), reduce between ping and pong
-    const buffer *input_buffer = &ping;
-    buffer pong(context, static_cast<size_t>(count / vpt / tpb * sizeof(T)));
-    const buffer *output_buffer = &pong;
+    const buffer *input_buffer = &ping.get_buffer();
+    vector<T, scratch_allocator<T> > pong(
+        static_cast<size_t>(count / vpt / tpb), context
+    );
+    const buffer *output_buffer = &pong.get_buffer();
     if(count > vpt * tpb){
         while(count > vpt * tpb){
             reduce_kernel.set_arg(0, *input_buffer);
@@ -12,6 +12,7 @@
 #define BOOST_COMPUTE_ALGORITHM_DETAIL_SCAN_HPP
 
 #include <boost/compute/device.hpp>
+#include <boost/compute/algorithm/detail/host_dispatch.hpp>
 #include <boost/compute/algorithm/detail/scan_on_cpu.hpp>
 #include <boost/compute/algorithm/detail/scan_on_gpu.hpp>
 
@@ -28,6 +29,10 @@ inline OutputIterator scan(InputIterator first,
                            BinaryOperator op,
                            command_queue &queue)
 {
+    if(use_host_path("scan", first, last, op, queue)){
+        return host_scan(first, last, result, exclusive, init, op, queue);
+    }
+
     const device &device = queue.get_device();
 
     if(device.type() & device::cpu){
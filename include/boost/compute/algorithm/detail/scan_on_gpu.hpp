@@ -14,6 +14,7 @@
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
@@ -213,7 +214,8 @@ inline OutputIterator scan_impl(InputIterator first,
         block_count++;
     }
 
-    ::boost::compute::vector<input_type> block_sums(block_count, context);
+    ::boost::compute::vector<input_type, scratch_allocator<input_type> >
+        block_sums(block_count, context);
 
     // zero block sums
     input_type zero;
@@ -295,7 +297,7 @@ inline InputIterator dispatch_scan(InputIterator first,
 
         // make a temporary copy the input
         size_t count = iterator_range_size(first, last);
-        vector<value_type> tmp(count, context);
+        vector<value_type, scratch_allocator<value_type> > tmp(count, context);
         copy(first, last, tmp.begin(), queue);
 
         // scan from temporary values
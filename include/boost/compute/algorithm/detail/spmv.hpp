@@ -0,0 +1,274 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SPMV_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SPMV_HPP
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/detail/merge_path.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes y = a * x with one work-item per row. this is the fastest
+// kernel on cpu devices and for matrices with very few entries per row.
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv_scalar(const csr_matrix<T> &a,
+                        InputIterator x,
+                        OutputIterator y,
+                        command_queue &queue)
+{
+    if(a.rows() == 0){
+        return;
+    }
+
+    meta_kernel k("spmv_scalar");
+    k << "const uint row = get_global_id(0);\n"
+      << "const uint end = "
+      <<     a.row_offsets().begin()[k.expr<uint_>("row + 1")] << ";\n"
+      << k.decl<T>("acc") << " = 0;\n"
+      << "for(uint j = " << a.row_offsets().begin()[k.var<uint_>("row")]
+      <<     "; j < end; j++){\n"
+      << "    acc += " << a.values().begin()[k.var<uint_>("j")] << " * "
+      <<          x[a.column_indices().begin()[k.var<uint_>("j")]] << ";\n"
+      << "}\n"
+      << y[k.var<uint_>("row")] << " = acc;\n";
+
+    k.exec_1d(queue, 0, a.rows());
+}
+
+// computes y = a * x with vector_size consecutive work-items per row. the
+// work-items read consecutive entries of the row and combine their partial
+// sums in local memory. this is fast for rows with many entries but wastes
+// work-items on shorter rows.
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv_vector(const csr_matrix<T> &a,
+                        InputIterator x,
+                        OutputIterator y,
+                        command_queue &queue)
+{
+    const size_t rows = a.rows();
+    if(rows == 0){
+        return;
+    }
+
+    const device &device = queue.get_device();
+
+    std::string cache_key = std::string("__boost_spmv_vector_") + type_name<T>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    // by default the vector size is the average row length rounded up to a
+    // power of two, between 2 and 32
+    const size_t average = (a.nonzeros() + rows - 1) / rows;
+    size_t default_vector_size = 2;
+    while(default_vector_size < average && default_vector_size < 32){
+        default_vector_size *= 2;
+    }
+
+    size_t vector_size =
+        parameters->get(cache_key, "vector_size", uint_(default_vector_size));
+    size_t work_group_size = parameters->get(cache_key, "wgsize", 128);
+
+    meta_kernel k("spmv_vector");
+    k.add_set_arg<const uint_>("rows", static_cast<uint_>(rows));
+    size_t scratch_arg = k.add_arg<T *>(memory_object::local_memory, "scratch");
+
+    k << "const uint lid = get_local_id(0);\n"
+      << "const uint lane = lid % " << uint_(vector_size) << ";\n"
+      << "const uint row = get_global_id(0) / " << uint_(vector_size) << ";\n"
+      << k.decl<T>("acc") << " = 0;\n"
+      << "if(row < rows){\n"
+      << "    const uint end = "
+      <<         a.row_offsets().begin()[k.expr<uint_>("row + 1")] << ";\n"
+      << "    for(uint j = " << a.row_offsets().begin()[k.var<uint_>("row")]
+      <<         " + lane; j < end; j += " << uint_(vector_size) << "){\n"
+      << "        acc += " << a.values().begin()[k.var<uint_>("j")] << " * "
+      <<              x[a.column_indices().begin()[k.var<uint_>("j")]] << ";\n"
+      << "    }\n"
+      << "}\n"
+      << "scratch[lid] = acc;\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "for(uint offset = " << uint_(vector_size / 2) << "; offset > 0; offset >>= 1){\n"
+      << "    if(lane < offset){\n"
+      << "        scratch[lid] += scratch[lid + offset];\n"
+      << "    }\n"
+      << "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+      << "}\n"
+      << "if(lane == 0 && row < rows){\n"
+      << "    " << y[k.var<uint_>("row")] << " = scratch[lid];\n"
+      << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    // the work-group must hold a whole number of rows
+    work_group_size = (std::min)(
+        work_group_size,
+        kernel.get_work_group_info<size_t>(device, CL_KERNEL_WORK_GROUP_SIZE)
+    );
+    work_group_size = (std::max)(
+        work_group_size / vector_size * vector_size, vector_size
+    );
+
+    kernel.set_arg(scratch_arg, local_buffer<T>(work_group_size));
+
+    const size_t global_size = rows * vector_size;
+    queue.enqueue_1d_range_kernel(
+        kernel,
+        0,
+        ((global_size + work_group_size - 1) / work_group_size) * work_group_size,
+        work_group_size
+    );
+}
+
+// computes y = a * x with the same amount of work for each work-item,
+// regardless of the lengths of the rows. the work is the merge of the row
+// end offsets with the indices of the entries, which is split into tiles
+// of equal length with the merge path kernel. each work-item computes the
+// rows which end in its tile and carries the partial sum of the row which
+// continues in the next tile. the carries are then summed by row with
+// reduce_by_key() and added to y. the temporaries are taken from the
+// active scratch_pool, so repeated products within an execution_policy
+// scope do not allocate.
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv_merge_path(const csr_matrix<T> &a,
+                            InputIterator x,
+                            OutputIterator y,
+                            command_queue &queue)
+{
+    const size_t rows = a.rows();
+    const size_t nonzeros = a.nonzeros();
+    if(rows == 0){
+        return;
+    }
+
+    const context &context = queue.get_context();
+
+    std::string cache_key = std::string("__boost_spmv_merge_path_") + type_name<T>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(queue.get_device());
+
+    const size_t tile_size =
+        (std::max)(size_t(parameters->get(cache_key, "tile", 32)), size_t(1));
+    const size_t tiles = (rows + nonzeros + tile_size - 1) / tile_size;
+
+    // the start of each tile in the row end offsets and the entries
+    vector<uint_, scratch_allocator<uint_> > tile_rows(tiles + 1, context);
+    vector<uint_, scratch_allocator<uint_> > tile_entries(tiles + 1, context);
+
+    merge_path_kernel tiling_kernel;
+    tiling_kernel.tile_size = static_cast<unsigned int>(tile_size);
+    tiling_kernel.set_range(
+        a.row_offsets().begin() + 1,
+        a.row_offsets().end(),
+        ::boost::compute::make_counting_iterator<uint_>(0),
+        ::boost::compute::make_counting_iterator<uint_>(static_cast<uint_>(nonzeros)),
+        tile_rows.begin() + 1,
+        tile_entries.begin() + 1,
+        less<uint_>()
+    );
+    fill_n(tile_rows.begin(), 1, uint_(0), queue);
+    fill_n(tile_entries.begin(), 1, uint_(0), queue);
+    tiling_kernel.exec(queue);
+    fill_n(tile_rows.end() - 1, 1, static_cast<uint_>(rows), queue);
+    fill_n(tile_entries.end() - 1, 1, static_cast<uint_>(nonzeros), queue);
+
+    vector<uint_, scratch_allocator<uint_> > carry_rows(tiles, context);
+    vector<T, scratch_allocator<T> > carry_values(tiles, context);
+
+    meta_kernel k("spmv_merge_path");
+    k << "const uint i = get_global_id(0);\n"
+      << "uint row = " << tile_rows.begin()[k.var<uint_>("i")] << ";\n"
+      << "const uint row_end = " << tile_rows.begin()[k.expr<uint_>("i + 1")] << ";\n"
+      << "uint j = " << tile_entries.begin()[k.var<uint_>("i")] << ";\n"
+      << "const uint j_end = " << tile_entries.begin()[k.expr<uint_>("i + 1")] << ";\n"
+      << k.decl<T>("acc") << " = 0;\n"
+      << "for(; row < row_end; row++){\n"
+      << "    const uint end = "
+      <<         a.row_offsets().begin()[k.expr<uint_>("row + 1")] << ";\n"
+      << "    for(; j < end; j++){\n"
+      << "        acc += " << a.values().begin()[k.var<uint_>("j")] << " * "
+      <<              x[a.column_indices().begin()[k.var<uint_>("j")]] << ";\n"
+      << "    }\n"
+      << "    " << y[k.var<uint_>("row")] << " = acc;\n"
+      << "    acc = 0;\n"
+      << "}\n"
+      << "for(; j < j_end; j++){\n"
+      << "    acc += " << a.values().begin()[k.var<uint_>("j")] << " * "
+      <<          x[a.column_indices().begin()[k.var<uint_>("j")]] << ";\n"
+      << "}\n"
+      << carry_rows.begin()[k.var<uint_>("i")] << " = row;\n"
+      << carry_values.begin()[k.var<uint_>("i")] << " = acc;\n";
+    k.exec_1d(queue, 0, tiles);
+
+    // add the carried partial sums to their rows. the carries are ordered
+    // by row, so the carries for each row are adjacent
+    vector<uint_, scratch_allocator<uint_> > fixup_rows(tiles, context);
+    vector<T, scratch_allocator<T> > fixup_values(tiles, context);
+    std::pair<vector<uint_>::iterator, typename vector<T>::iterator> fixup_end =
+        ::boost::compute::reduce_by_key(
+            carry_rows.begin(), carry_rows.end(), carry_values.begin(),
+            fixup_rows.begin(), fixup_values.begin(), queue
+        );
+    const size_t fixups = fixup_end.first - fixup_rows.begin();
+
+    meta_kernel fixup_kernel("spmv_merge_path_fixup");
+    fixup_kernel.add_set_arg<const uint_>("rows", static_cast<uint_>(rows));
+    fixup_kernel
+        << "const uint row = "
+        <<     fixup_rows.begin()[fixup_kernel.get_global_id(0)] << ";\n"
+        << "if(row < rows){\n"
+        << "    " << y[fixup_kernel.var<uint_>("row")] << " += "
+        <<         fixup_values.begin()[fixup_kernel.get_global_id(0)] << ";\n"
+        << "}\n";
+    fixup_kernel.exec_1d(queue, 0, fixups);
+}
+
+// computes y = a * x with the kernel which suits the device and the matrix
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv(const csr_matrix<T> &a,
+                 InputIterator x,
+                 OutputIterator y,
+                 command_queue &queue)
+{
+    if(queue.get_device().type() & device::cpu){
+        spmv_scalar(a, x, y, queue);
+    }
+    else if(a.nonzeros() >= 32 * a.rows()){
+        spmv_vector(a, x, y, queue);
+    }
+    else {
+        spmv_merge_path(a, x, y, queue);
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SPMV_HPP
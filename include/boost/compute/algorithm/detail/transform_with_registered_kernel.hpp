@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSFORM_WITH_REGISTERED_KERNEL_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSFORM_WITH_REGISTERED_KERNEL_HPP
+
+#include <iterator>
+
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/kernel_registry.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// true if the transform of the iterators with function can use a kernel
+// registered by type (plain buffers and a built-in function)
+template<class Iterator>
+struct is_plain_buffer_iterator :
+    boost::is_same<
+        Iterator,
+        buffer_iterator<typename std::iterator_traits<Iterator>::value_type>
+    >
+{
+};
+
+template<class InputIterator, class OutputIterator, class UnaryFunction>
+struct can_transform_with_registered_kernel :
+    boost::mpl::and_<
+        is_plain_buffer_iterator<InputIterator>,
+        is_plain_buffer_iterator<OutputIterator>,
+        is_type_keyed_function<UnaryFunction>
+    >
+{
+};
+
+template<class InputIterator1, class InputIterator2,
+         class OutputIterator, class BinaryFunction>
+struct can_binary_transform_with_registered_kernel :
+    boost::mpl::and_<
+        is_plain_buffer_iterator<InputIterator1>,
+        is_plain_buffer_iterator<InputIterator2>,
+        is_plain_buffer_iterator<OutputIterator>,
+        is_type_keyed_function<BinaryFunction>
+    >
+{
+};
+
+template<class InputType, class OutputType, class UnaryFunction>
+struct transform_kernel_key
+{
+};
+
+template<class InputType1, class InputType2,
+         class OutputType, class BinaryFunction>
+struct binary_transform_kernel_key
+{
+};
+
+// generates the kernel for transform_with_registered_kernel(), the
+// buffers and offsets are kernel arguments so that it can be reused
+template<class InputType, class OutputType, class UnaryFunction>
+struct transform_kernel_generator
+{
+    transform_kernel_generator(UnaryFunction function)
+        : m_function(function)
+    {
+    }
+
+    kernel operator()(const context &context) const
+    {
+        meta_kernel k("transform");
+        k.add_arg<const InputType *>(memory_object::global_memory, "input");
+        k.add_arg<OutputType *>(memory_object::global_memory, "output");
+        k.add_arg<const uint_>("input_offset");
+        k.add_arg<const uint_>("output_offset");
+
+        k << "const uint i = get_global_id(0);\n"
+          << "output[output_offset + i] = "
+          << m_function(k.var<InputType>("input[input_offset + i]")) << ";\n";
+
+        return k.compile(context);
+    }
+
+    UnaryFunction m_function;
+};
+
+template<class InputType1, class InputType2,
+         class OutputType, class BinaryFunction>
+struct binary_transform_kernel_generator
+{
+    binary_transform_kernel_generator(BinaryFunction function)
+        : m_function(function)
+    {
+    }
+
+    kernel operator()(const context &context) const
+    {
+        meta_kernel k("binary_transform");
+        k.add_arg<const InputType1 *>(memory_object::global_memory, "input1");
+        k.add_arg<const InputType2 *>(memory_object::global_memory, "input2");
+        k.add_arg<OutputType *>(memory_object::global_memory, "output");
+        k.add_arg<const uint_>("input1_offset");
+        k.add_arg<const uint_>("input2_offset");
+        k.add_arg<const uint_>("output_offset");
+
+        k << "const uint i = get_global_id(0);\n"
+          << "output[output_offset + i] = "
+          << m_function(k.var<InputType1>("input1[input1_offset + i]"),
+                        k.var<InputType2>("input2[input2_offset + i]")) << ";\n";
+
+        return k.compile(context);
+    }
+
+    BinaryFunction m_function;
+};
+
+// transforms count values with a kernel which is only generated and compiled
+// on its first use, repeated calls just set the kernel arguments and enqueue
+// it. this avoids generating and hashing the source on every call which
+// otherwise dominates the time spent for small inputs.
+template<class InputType, class OutputType, class UnaryFunction>
+inline event transform_with_registered_kernel(buffer_iterator<InputType> first,
+                                              size_t count,
+                                              buffer_iterator<OutputType> result,
+                                              UnaryFunction function,
+                                              command_queue &queue)
+{
+    typedef transform_kernel_key<InputType, OutputType, UnaryFunction> key_type;
+    typedef transform_kernel_generator<InputType, OutputType, UnaryFunction> generator_type;
+
+    kernel &k = kernel_registry::get_global_registry().get_or_create<key_type>(
+        queue.get_context(), generator_type(function)
+    );
+
+    k.set_arg(0, first.get_buffer());
+    k.set_arg(1, result.get_buffer());
+    k.set_arg(2, static_cast<uint_>(first.get_index()));
+    k.set_arg(3, static_cast<uint_>(result.get_index()));
+
+    return queue.enqueue_1d_range_kernel(k, 0, count, 0);
+}
+
+template<class InputType1, class InputType2,
+         class OutputType, class BinaryFunction>
+inline event transform_with_registered_kernel(buffer_iterator<InputType1> first1,
+                                              size_t count,
+                                              buffer_iterator<InputType2> first2,
+                                              buffer_iterator<OutputType> result,
+                                              BinaryFunction function,
+                                              command_queue &queue)
+{
+    typedef binary_transform_kernel_key<
+        InputType1, InputType2, OutputType, BinaryFunction
+    > key_type;
+    typedef binary_transform_kernel_generator<
+        InputType1, InputType2, OutputType, BinaryFunction
+    > generator_type;
+
+    kernel &k = kernel_registry::get_global_registry().get_or_create<key_type>(
+        queue.get_context(), generator_type(function)
+    );
+
+    k.set_arg(0, first1.get_buffer());
+    k.set_arg(1, first2.get_buffer());
+    k.set_arg(2, result.get_buffer());
+    k.set_arg(3, static_cast<uint_>(first1.get_index()));
+    k.set_arg(4, static_cast<uint_>(first2.get_index()));
+    k.set_arg(5, static_cast<uint_>(result.get_index()));
+
+    return queue.enqueue_1d_range_kernel(k, 0, count, 0);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSFORM_WITH_REGISTERED_KERNEL_HPP
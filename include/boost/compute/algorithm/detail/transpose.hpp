@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSPOSE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSPOSE_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// transposes batch row-major matrices of rows x cols values. each
+// work-group reads a tile x tile block of a matrix with coalesced reads
+// into local memory and writes it back transposed with coalesced writes.
+// the tile rows are padded by one value so that reading a column of the
+// tile does not hit the same local memory bank. each work-item copies
+// tile / block_rows values of the block.
+template<class InputIterator, class OutputIterator>
+inline void tiled_transpose(InputIterator first,
+                            OutputIterator result,
+                            size_t batch,
+                            size_t rows,
+                            size_t cols,
+                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    if(batch == 0 || rows == 0 || cols == 0){
+        return;
+    }
+
+    const device &device = queue.get_device();
+
+    std::string cache_key = std::string("__boost_transpose_") + type_name<T>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    size_t tile = parameters->get(cache_key, "tile", 32);
+    size_t block_rows = parameters->get(cache_key, "block_rows", 8);
+
+    // the padded tile must fit in local memory and the work-group of
+    // tile x block_rows work-items must fit on the device
+    const size_t max_work_group_size =
+        device.get_info<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE);
+    while(tile > 1 &&
+          tile * (tile + 1) * sizeof(T) > device.local_memory_size()){
+        tile /= 2;
+    }
+    block_rows = (std::max)((std::min)(block_rows, tile), size_t(1));
+    while(block_rows > 1 &&
+          (tile * block_rows > max_work_group_size || tile % block_rows != 0)){
+        block_rows--;
+    }
+    while(tile * block_rows > max_work_group_size){
+        tile /= 2;
+    }
+
+    const size_t pitch = tile + 1;
+
+    meta_kernel k("tiled_transpose");
+    k.add_set_arg<const uint_>("rows", static_cast<uint_>(rows));
+    k.add_set_arg<const uint_>("cols", static_cast<uint_>(cols));
+    size_t tile_arg = k.add_arg<T *>(memory_object::local_memory, "tile");
+
+    k << "const uint lx = get_local_id(0);\n"
+      << "const uint ly = get_local_id(1);\n"
+      << "const uint offset = get_global_id(2) * rows * cols;\n"
+
+      // read the block with coalesced reads along the input rows
+      << "uint x = get_group_id(0) * " << uint_(tile) << " + lx;\n"
+      << "uint y = get_group_id(1) * " << uint_(tile) << " + ly;\n"
+      << "for(uint j = 0; j < " << uint_(tile) << "; j += " << uint_(block_rows) << "){\n"
+      << "    if(x < cols && y + j < rows){\n"
+      << "        tile[(ly + j) * " << uint_(pitch) << " + lx] = "
+      <<              first[k.expr<uint_>("offset + (y + j) * cols + x")] << ";\n"
+      << "    }\n"
+      << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+
+      // write the transposed block along the output rows
+      << "x = get_group_id(1) * " << uint_(tile) << " + lx;\n"
+      << "y = get_group_id(0) * " << uint_(tile) << " + ly;\n"
+      << "for(uint j = 0; j < " << uint_(tile) << "; j += " << uint_(block_rows) << "){\n"
+      << "    if(x < rows && y + j < cols){\n"
+      << "        " << result[k.expr<uint_>("offset + (y + j) * rows + x")]
+      <<              " = tile[lx * " << uint_(pitch) << " + ly + j];\n"
+      << "    }\n"
+      << "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(tile_arg, local_buffer<T>(tile * pitch));
+
+    const size_t global_work_size[] = {
+        ((cols + tile - 1) / tile) * tile,
+        ((rows + tile - 1) / tile) * block_rows,
+        batch
+    };
+    const size_t local_work_size[] = { tile, block_rows, 1 };
+
+    queue.enqueue_nd_range_kernel(
+        kernel, 3, 0, global_work_size, local_work_size
+    );
+}
+
+// copies the values of a row-major array with shape[i] values along axis i
+// to result with the axes reordered so that axis i of the result is axis
+// axes[i] of the input. each work-item writes one value of the result.
+template<class InputIterator, class OutputIterator>
+inline void permute_axes_with_gather(InputIterator first,
+                                     OutputIterator result,
+                                     const std::vector<size_t> &shape,
+                                     const std::vector<size_t> &axes,
+                                     command_queue &queue)
+{
+    const size_t dims = shape.size();
+
+    // strides of the input axes
+    std::vector<size_t> strides(dims, 1);
+    for(size_t i = dims - 1; i > 0; i--){
+        strides[i - 1] = strides[i] * shape[i];
+    }
+    const size_t count = strides[0] * shape[0];
+
+    meta_kernel k("permute_axes");
+    for(size_t i = 0; i < dims; i++){
+        const std::string index = boost::lexical_cast<std::string>(i);
+
+        k.add_set_arg<const uint_>(
+            "extent" + index, static_cast<uint_>(shape[axes[i]])
+        );
+        k.add_set_arg<const uint_>(
+            "stride" + index, static_cast<uint_>(strides[axes[i]])
+        );
+    }
+
+    k << "uint rest = get_global_id(0);\n"
+      << "uint src = 0;\n";
+    for(size_t i = dims; i > 0; i--){
+        const std::string index = boost::lexical_cast<std::string>(i - 1);
+
+        k << "src += (rest % extent" << index << ") * stride" << index << ";\n"
+          << "rest /= extent" << index << ";\n";
+    }
+    k << result[k.get_global_id(0)] << " = "
+      << first[k.var<uint_>("src")] << ";\n";
+
+    k.exec_1d(queue, 0, count);
+}
+
+// copies the row-major array with the given shape to result with its axes
+// permuted by axes. axes of extent one are dropped and axes which stay
+// adjacent and in order are merged, so that the permutation is reduced to
+// a copy, a transpose or a batch of transposes where possible. other
+// permutations are done with a gather.
+template<class InputIterator, class OutputIterator>
+inline void permute_axes(InputIterator first,
+                         OutputIterator result,
+                         const size_t *shape,
+                         const size_t *axes,
+                         size_t dims,
+                         command_queue &queue)
+{
+    size_t count = 1;
+    for(size_t i = 0; i < dims; i++){
+        count *= shape[i];
+    }
+    if(count == 0){
+        return;
+    }
+
+    // drop the axes of extent one
+    std::vector<size_t> kept(dims, 0);
+    std::vector<size_t> reduced_axes;
+    for(size_t i = 0, n = 0; i < dims; i++){
+        kept[i] = n;
+        if(shape[i] != 1){
+            n++;
+        }
+    }
+    for(size_t i = 0; i < dims; i++){
+        if(shape[axes[i]] != 1){
+            reduced_axes.push_back(kept[axes[i]]);
+        }
+    }
+
+    std::vector<size_t> reduced_shape;
+    for(size_t i = 0; i < dims; i++){
+        if(shape[i] != 1){
+            reduced_shape.push_back(shape[i]);
+        }
+    }
+
+    // merge runs of consecutive input axes in the output order. group[a]
+    // is the merged axis that input axis a belongs to.
+    const size_t n = reduced_axes.size();
+    std::vector<bool> starts_group(n, true);
+    for(size_t i = 1; i < n; i++){
+        if(reduced_axes[i] == reduced_axes[i - 1] + 1){
+            starts_group[reduced_axes[i]] = false;
+        }
+    }
+
+    std::vector<size_t> group(n, 0);
+    std::vector<size_t> merged_shape;
+    for(size_t a = 0; a < n; a++){
+        if(starts_group[a]){
+            merged_shape.push_back(reduced_shape[a]);
+        }
+        else {
+            merged_shape.back() *= reduced_shape[a];
+        }
+        group[a] = merged_shape.size() - 1;
+    }
+
+    std::vector<size_t> merged_axes;
+    for(size_t i = 0; i < n; i++){
+        if(starts_group[reduced_axes[i]]){
+            merged_axes.push_back(group[reduced_axes[i]]);
+        }
+    }
+
+    const size_t m = merged_shape.size();
+    if(m <= 1){
+        ::boost::compute::copy_n(first, count, result, queue);
+    }
+    else if(m == 2){
+        // merged_axes is (1, 0)
+        tiled_transpose(
+            first, result, 1, merged_shape[0], merged_shape[1], queue
+        );
+    }
+    else if(m == 3 && merged_axes[0] == 0){
+        // merged_axes is (0, 2, 1)
+        tiled_transpose(
+            first, result, merged_shape[0], merged_shape[1], merged_shape[2], queue
+        );
+    }
+    else {
+        permute_axes_with_gather(first, result, merged_shape, merged_axes, queue);
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_TRANSPOSE_HPP
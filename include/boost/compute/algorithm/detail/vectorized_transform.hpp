@@ -0,0 +1,431 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_TRANSFORM_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_TRANSFORM_HPP
+
+#include <string>
+#include <iterator>
+
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/algorithm/detail/transform_with_registered_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// true if values of type T can be accessed with vloadN() and vstoreN()
+template<class T>
+struct is_vectorizable_type :
+    boost::mpl::contains<
+        boost::mpl::vector<
+            char_, uchar_, short_, ushort_, int_, uint_,
+            long_, ulong_, float_, double_
+        >,
+        T
+    >::type
+{
+};
+
+// true if Iterator is a plain buffer iterator for a vectorizable type
+template<class Iterator>
+struct is_vectorizable_iterator :
+    boost::mpl::and_<
+        is_plain_buffer_iterator<Iterator>,
+        is_vectorizable_type<typename std::iterator_traits<Iterator>::value_type>
+    >
+{
+};
+
+// returns the preferred vector width reported by device for type T
+template<class T>
+inline uint_ preferred_vector_width_of(const device &device)
+{
+    if(boost::is_same<T, float_>::value){
+        return device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT);
+    }
+    else if(boost::is_same<T, double_>::value){
+        return device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_DOUBLE);
+    }
+
+    switch(sizeof(T)){
+    case 1:
+        return device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_CHAR);
+    case 2:
+        return device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_SHORT);
+    case 4:
+        return device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_INT);
+    case 8:
+        return device.get_info<uint_>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_LONG);
+    default:
+        return 1;
+    }
+}
+
+// returns the vector width for the vectorized kernels of object, read from
+// the parameter cache as "vw" and defaulting to the preferred vector width
+// of the device for T. the width is a power of two no larger than 16, a
+// width of one disables the vectorized kernels.
+template<class T>
+inline size_t vector_width(const std::string &object, const device &device)
+{
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    const uint_ requested =
+        parameters->get(object, "vw", preferred_vector_width_of<T>(device));
+
+    size_t width = 1;
+    while(width * 2 <= requested && width < 16){
+        width *= 2;
+    }
+    return width;
+}
+
+// returns the swizzle selecting component i of a vector
+inline std::string vector_component(size_t i)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    return std::string(".s") + digits[i];
+}
+
+// splits the range of a vectorized kernel into a scalar head which ends at
+// an output index aligned to the vector width, a body of whole vectors and
+// a scalar tail. the first vector_count work-items each process one vector
+// of the body and the remaining work-items process one value of the head
+// or the tail. the index of the first value is stored in "i".
+class vectorized_range
+{
+public:
+    vectorized_range(meta_kernel &k, size_t width)
+        : m_width(width)
+    {
+        m_head_arg = k.add_arg<const uint_>("head");
+        m_vector_count_arg = k.add_arg<const uint_>("vector_count");
+
+        k << k.decl<const uint_>("gid") << " = get_global_id(0);\n";
+    }
+
+    size_t width() const
+    {
+        return m_width;
+    }
+
+    // starts the code for the work-items processing a vector
+    void begin_vector(meta_kernel &k) const
+    {
+        k << "if(gid < vector_count){\n"
+          << k.decl<const uint_>("i") << " = head + gid * " << uint_(m_width) << ";\n";
+    }
+
+    // starts the code for the work-items processing a single value
+    void begin_scalar(meta_kernel &k) const
+    {
+        k << "}\n"
+          << "else {\n"
+          << k.decl<const uint_>("j") << " = gid - vector_count;\n"
+          << k.decl<const uint_>("i") << " = j < head ? j : j + vector_count * "
+          << uint_(m_width) << ";\n";
+    }
+
+    void end(meta_kernel &k) const
+    {
+        k << "}\n";
+    }
+
+    // processes count values, aligning the vectors to output_index
+    event exec(kernel &kernel,
+               size_t output_index,
+               size_t count,
+               command_queue &queue) const
+    {
+        size_t head = (m_width - output_index % m_width) % m_width;
+        if(head > count){
+            head = count;
+        }
+        const size_t vector_count = (count - head) / m_width;
+
+        kernel.set_arg(m_head_arg, static_cast<uint_>(head));
+        kernel.set_arg(m_vector_count_arg, static_cast<uint_>(vector_count));
+
+        return queue.enqueue_1d_range_kernel(
+            kernel, 0, vector_count + count - vector_count * m_width, 0
+        );
+    }
+
+private:
+    size_t m_width;
+    size_t m_head_arg;
+    size_t m_vector_count_arg;
+};
+
+// returns the cache key for the vectorized kernels writing values of type T
+template<class T>
+inline std::string vectorized_cache_key()
+{
+    return std::string("__boost_vectorized_transform_") + type_name<T>();
+}
+
+// returns true if a transform of count values which can use a registered
+// kernel should use the vectorized kernel instead. registered kernels are
+// cheaper to launch while vectorized kernels have a higher bandwidth, the
+// number of values from which the latter are used is read from the
+// parameter cache as "min_size".
+template<class OutputIterator>
+inline bool prefer_vectorized_transform(size_t count, command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    if(!is_vectorizable_iterator<OutputIterator>::value || count == 0){
+        return false;
+    }
+
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    return count >= parameters->get(
+        vectorized_cache_key<value_type>(), "min_size", 65536
+    );
+}
+
+// transforms count values with vloadN() and vstoreN(). the function is
+// applied to each component of the loaded vectors. returns false (and does
+// nothing) if the vector width for the device is one.
+template<class InputType, class OutputType, class UnaryFunction>
+inline bool vectorized_transform(buffer_iterator<InputType> first,
+                                 size_t count,
+                                 buffer_iterator<OutputType> result,
+                                 UnaryFunction function,
+                                 command_queue &queue)
+{
+    const size_t width =
+        vector_width<OutputType>(vectorized_cache_key<OutputType>(), queue.get_device());
+    if(width == 1){
+        return false;
+    }
+
+    meta_kernel k("vectorized_transform");
+    k.inject_type<InputType>();
+    k.inject_type<OutputType>();
+
+    vectorized_range range(k, width);
+
+    range.begin_vector(k);
+    k << type_name<InputType>() << uint_(width) << " x = vload" << uint_(width)
+      << "(0, &" << first[k.var<uint_>("i")] << ");\n"
+      << type_name<OutputType>() << uint_(width) << " y;\n";
+    for(size_t c = 0; c < width; c++){
+        k << "y" << vector_component(c) << " = "
+          << function(k.var<InputType>("x" + vector_component(c))) << ";\n";
+    }
+    k << "vstore" << uint_(width) << "(y, 0, &" << result[k.var<uint_>("i")] << ");\n";
+
+    range.begin_scalar(k);
+    k << result[k.var<uint_>("i")] << " = "
+      << function(first[k.var<uint_>("i")]) << ";\n";
+    range.end(k);
+
+    kernel kernel = k.compile(queue.get_context());
+    range.exec(kernel, result.get_index(), count, queue);
+
+    return true;
+}
+
+template<class InputType1, class InputType2,
+         class OutputType, class BinaryFunction>
+inline bool vectorized_transform(buffer_iterator<InputType1> first1,
+                                 size_t count,
+                                 buffer_iterator<InputType2> first2,
+                                 buffer_iterator<OutputType> result,
+                                 BinaryFunction function,
+                                 command_queue &queue)
+{
+    const size_t width =
+        vector_width<OutputType>(vectorized_cache_key<OutputType>(), queue.get_device());
+    if(width == 1){
+        return false;
+    }
+
+    meta_kernel k("vectorized_binary_transform");
+    k.inject_type<InputType1>();
+    k.inject_type<InputType2>();
+    k.inject_type<OutputType>();
+
+    vectorized_range range(k, width);
+
+    range.begin_vector(k);
+    k << type_name<InputType1>() << uint_(width) << " x1 = vload" << uint_(width)
+      << "(0, &" << first1[k.var<uint_>("i")] << ");\n"
+      << type_name<InputType2>() << uint_(width) << " x2 = vload" << uint_(width)
+      << "(0, &" << first2[k.var<uint_>("i")] << ");\n"
+      << type_name<OutputType>() << uint_(width) << " y;\n";
+    for(size_t c = 0; c < width; c++){
+        k << "y" << vector_component(c) << " = "
+          << function(k.var<InputType1>("x1" + vector_component(c)),
+                      k.var<InputType2>("x2" + vector_component(c))) << ";\n";
+    }
+    k << "vstore" << uint_(width) << "(y, 0, &" << result[k.var<uint_>("i")] << ");\n";
+
+    range.begin_scalar(k);
+    k << result[k.var<uint_>("i")] << " = "
+      << function(first1[k.var<uint_>("i")], first2[k.var<uint_>("i")]) << ";\n";
+    range.end(k);
+
+    kernel kernel = k.compile(queue.get_context());
+    range.exec(kernel, result.get_index(), count, queue);
+
+    return true;
+}
+
+// fills count values with vstoreN(). returns false (and does nothing) if
+// the vector width for the device is one.
+template<class T>
+inline bool vectorized_fill(buffer_iterator<T> first,
+                            size_t count,
+                            const T &value,
+                            command_queue &queue)
+{
+    const size_t width =
+        vector_width<T>(vectorized_cache_key<T>(), queue.get_device());
+    if(width == 1){
+        return false;
+    }
+
+    meta_kernel k("vectorized_fill");
+    k.inject_type<T>();
+    size_t value_arg = k.add_arg<const T>("value");
+
+    vectorized_range range(k, width);
+
+    range.begin_vector(k);
+    k << "vstore" << uint_(width) << "((" << type_name<T>() << uint_(width) << ")(value), 0, &"
+      << first[k.var<uint_>("i")] << ");\n";
+
+    range.begin_scalar(k);
+    k << first[k.var<uint_>("i")] << " = value;\n";
+    range.end(k);
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(value_arg, value);
+    range.exec(kernel, first.get_index(), count, queue);
+
+    return true;
+}
+
+// the try_vectorized_*() functions use the vectorized kernels if all of
+// the iterators are vectorizable and return false otherwise
+template<class InputIterator, class OutputIterator, class UnaryFunction>
+inline bool try_vectorized_transform(InputIterator first,
+                                     size_t count,
+                                     OutputIterator result,
+                                     UnaryFunction function,
+                                     command_queue &queue,
+                                     typename boost::enable_if_c<
+                                         is_vectorizable_iterator<InputIterator>::value &&
+                                         is_vectorizable_iterator<OutputIterator>::value
+                                     >::type* = 0)
+{
+    return vectorized_transform(first, count, result, function, queue);
+}
+
+template<class InputIterator, class OutputIterator, class UnaryFunction>
+inline bool try_vectorized_transform(InputIterator,
+                                     size_t,
+                                     OutputIterator,
+                                     UnaryFunction,
+                                     command_queue &,
+                                     typename boost::disable_if_c<
+                                         is_vectorizable_iterator<InputIterator>::value &&
+                                         is_vectorizable_iterator<OutputIterator>::value
+                                     >::type* = 0)
+{
+    return false;
+}
+
+template<class InputIterator1, class InputIterator2,
+         class OutputIterator, class BinaryFunction>
+inline bool try_vectorized_transform(InputIterator1 first1,
+                                     size_t count,
+                                     InputIterator2 first2,
+                                     OutputIterator result,
+                                     BinaryFunction function,
+                                     command_queue &queue,
+                                     typename boost::enable_if_c<
+                                         is_vectorizable_iterator<InputIterator1>::value &&
+                                         is_vectorizable_iterator<InputIterator2>::value &&
+                                         is_vectorizable_iterator<OutputIterator>::value
+                                     >::type* = 0)
+{
+    return vectorized_transform(first1, count, first2, result, function, queue);
+}
+
+template<class InputIterator1, class InputIterator2,
+         class OutputIterator, class BinaryFunction>
+inline bool try_vectorized_transform(InputIterator1,
+                                     size_t,
+                                     InputIterator2,
+                                     OutputIterator,
+                                     BinaryFunction,
+                                     command_queue &,
+                                     typename boost::disable_if_c<
+                                         is_vectorizable_iterator<InputIterator1>::value &&
+                                         is_vectorizable_iterator<InputIterator2>::value &&
+                                         is_vectorizable_iterator<OutputIterator>::value
+                                     >::type* = 0)
+{
+    return false;
+}
+
+template<class Iterator, class T>
+inline bool try_vectorized_fill(Iterator first,
+                                size_t count,
+                                const T &value,
+                                command_queue &queue,
+                                typename boost::enable_if<
+                                    is_vectorizable_iterator<Iterator>
+                                >::type* = 0)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    return vectorized_fill(first, count, static_cast<value_type>(value), queue);
+}
+
+template<class Iterator, class T>
+inline bool try_vectorized_fill(Iterator,
+                                size_t,
+                                const T &,
+                                command_queue &,
+                                typename boost::disable_if<
+                                    is_vectorizable_iterator<Iterator>
+                                >::type* = 0)
+{
+    return false;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_TRANSFORM_HPP
@@ -15,7 +15,9 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/mismatch.hpp>
+#include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
@@ -56,6 +58,49 @@ inline bool equal(InputIterator1 first1,
     return ::boost::compute::equal(first1, last1, first2, queue);
 }
 
+/// Asynchronous version of equal(). Returns a future which is \c true if the
+/// range [\p first1, \p last1) and the range beginning at \p first2 are
+/// equal.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see equal()
+template<class InputIterator1, class InputIterator2>
+inline future<bool> equal_async(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator1>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator2>::value);
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
+    using ::boost::compute::_1;
+
+    ::boost::compute::equal_to<value_type> op;
+
+    InputIterator2 last2 = first2 + std::distance(first1, last1);
+
+    // the ranges are equal if no mismatching pair is found
+    return detail::find_if_test_async(
+        ::boost::compute::make_transform_iterator(
+            ::boost::compute::make_zip_iterator(
+                boost::make_tuple(first1, first2)
+            ),
+            detail::unpack(op)
+        ),
+        ::boost::compute::make_transform_iterator(
+            ::boost::compute::make_zip_iterator(
+                boost::make_tuple(last1, last2)
+            ),
+            detail::unpack(op)
+        ),
+        _1 == false,
+        false,
+        queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
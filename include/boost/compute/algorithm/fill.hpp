@@ -23,6 +23,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/vectorized_transform.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/constant_iterator.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
@@ -37,13 +38,18 @@ namespace detail {
 
 namespace mpl = boost::mpl;
 
-// fills the range [first, first + count) with value using copy()
+// fills the range [first, first + count) with value using copy() or, for
+// buffers of built-in scalar types, a kernel with vector stores
 template<class BufferIterator, class T>
 inline void fill_with_copy(BufferIterator first,
                            size_t count,
                            const T &value,
                            command_queue &queue)
 {
+    if(try_vectorized_fill(first, count, value, queue)){
+        return;
+    }
+
     ::boost::compute::copy(
         ::boost::compute::make_constant_iterator(value, 0),
         ::boost::compute::make_constant_iterator(value, count),
@@ -16,6 +16,7 @@
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/type_traits/vector_size.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
@@ -57,6 +58,44 @@ inline InputIterator find(InputIterator first,
     }
 }
 
+/// Asynchronous version of find(). Returns a future for an iterator pointing
+/// to the first element in the range [\p first, \p last) that equals
+/// \p value.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see find(), find_if_async()
+template<class InputIterator, class T>
+inline future<InputIterator>
+find_async(InputIterator first,
+           InputIterator last,
+           const T &value,
+           command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    using ::boost::compute::_1;
+    using ::boost::compute::lambda::all;
+
+    if(vector_size<value_type>::value == 1){
+        return ::boost::compute::find_if_async(
+                   first,
+                   last,
+                   _1 == value,
+                   queue
+               );
+    }
+    else {
+        return ::boost::compute::find_if_async(
+                   first,
+                   last,
+                   all(_1 == value),
+                   queue
+               );
+    }
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -12,10 +12,14 @@
 #define BOOST_COMPUTE_ALGORITHM_FIND_IF_HPP
 
 #include <boost/static_assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
@@ -35,6 +39,37 @@ inline InputIterator find_if(InputIterator first,
     return detail::find_if_with_atomics(first, last, predicate, queue);
 }
 
+/// Asynchronous version of find_if(). Enqueues the search and a non-blocking
+/// read of its result and returns a future for the iterator without waiting
+/// for the device.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see find_if()
+template<class InputIterator, class UnaryPredicate>
+inline future<InputIterator>
+find_if_async(InputIterator first,
+              InputIterator last,
+              UnaryPredicate predicate,
+              command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+
+    size_t count = detail::iterator_range_size(first, last);
+    boost::shared_ptr<uint_> index = boost::make_shared<uint_>(0);
+
+    event event_ = detail::find_index_with_atomics_async(
+        detail::find_if_index_condition<InputIterator, UnaryPredicate>(
+            first, predicate
+        ),
+        count, index, queue
+    );
+
+    return future<InputIterator>(
+        event_, detail::found_index_iterator<InputIterator>(first, index)
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -16,6 +16,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
@@ -43,6 +44,29 @@ inline InputIterator find_if_not(InputIterator first,
            );
 }
 
+/// Asynchronous version of find_if_not(). Returns a future for an iterator
+/// pointing to the first element in the range [\p first, \p last) for which
+/// \p predicate returns \c false.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see find_if_not(), find_if_async()
+template<class InputIterator, class UnaryPredicate>
+inline future<InputIterator>
+find_if_not_async(InputIterator first,
+                  InputIterator last,
+                  UnaryPredicate predicate,
+                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    return ::boost::compute::find_if_async(
+               first,
+               last,
+               not1(predicate),
+               queue
+           );
+}
+
 } // end compute namespace
 } // end boost namespace
 
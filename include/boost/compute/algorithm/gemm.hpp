@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_GEMM_HPP
+#define BOOST_COMPUTE_ALGORITHM_GEMM_HPP
+
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/gemm.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Computes the matrix product <tt>C = alpha * A * B + beta * C</tt>, where
+/// \c A is the \p m x \p k matrix beginning at \p a, \c B is the \p k x
+/// \p n matrix beginning at \p b and \c C is the \p m x \p n matrix
+/// beginning at \p c. The matrices are stored in row-major order with
+/// \p lda, \p ldb and \p ldc values between the starts of their rows.
+///
+/// If \p beta is zero \c C is not read, so it does not need to be
+/// initialized. A transposed operand can be prepared with transpose().
+///
+/// On GPUs the product is computed in tiles of \c C. The tiles of \c A and
+/// \c B are staged in local memory and each work-item accumulates several
+/// values of its column of the tile in registers. On CPUs each value of
+/// \c C is computed by one work-item.
+///
+/// \param m number of rows in \c A and \c C
+/// \param n number of columns in \c B and \c C
+/// \param k number of columns in \c A and rows in \c B
+/// \param alpha scale factor for the product
+/// \param a first element of \c A
+/// \param lda leading dimension of \c A (at least \p k)
+/// \param b first element of \c B
+/// \param ldb leading dimension of \c B (at least \p n)
+/// \param beta scale factor for \c C
+/// \param c first element of \c C
+/// \param ldc leading dimension of \c C (at least \p n)
+/// \param queue command queue to perform the operation
+///
+/// For example, to multiply a 2x3 matrix with a 3x2 matrix:
+///
+/// \snippet test/test_blas.cpp gemm_float
+///
+/// The size of the tiles and the number of values accumulated by each
+/// work-item can be tuned with the \c "tile" and \c "wpt" parameters of
+/// \c "__boost_gemm_<type>" in the parameter cache.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see batched_gemm(), gemv()
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+inline void gemm(size_t m,
+                 size_t n,
+                 size_t k,
+                 typename std::iterator_traits<OutputIterator>::value_type alpha,
+                 InputIterator1 a,
+                 size_t lda,
+                 InputIterator2 b,
+                 size_t ldb,
+                 typename std::iterator_traits<OutputIterator>::value_type beta,
+                 OutputIterator c,
+                 size_t ldc,
+                 command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator1>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator2>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    BOOST_ASSERT(lda >= k);
+    BOOST_ASSERT(ldb >= n);
+    BOOST_ASSERT(ldc >= n);
+
+    detail::gemm(
+        1, m, n, k, alpha, a, lda, 0, b, ldb, 0, beta, c, ldc, 0, queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_GEMM_HPP
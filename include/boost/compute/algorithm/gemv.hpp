@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_GEMV_HPP
+#define BOOST_COMPUTE_ALGORITHM_GEMV_HPP
+
+#include <iterator>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/gemv.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Computes the matrix-vector product
+/// <tt>y = alpha * A * x + beta * y</tt>, where \c A is the \p rows x
+/// \p cols matrix stored in row-major order with \p lda values between the
+/// starts of its rows in the range beginning at \p a, \c x is the vector of
+/// \p cols values beginning at \p x and \c y is the vector of \p rows
+/// values beginning at \p y.
+///
+/// If \p beta is zero \c y is not read, so it does not need to be
+/// initialized. Vectors with a stride between their values can be passed
+/// with a strided_iterator.
+///
+/// All of the rows are computed with a single kernel launch. On GPUs each
+/// row is reduced by a work-group, on CPUs each row is computed by a single
+/// work-item.
+///
+/// \param rows number of rows in the matrix
+/// \param cols number of columns in the matrix
+/// \param alpha scale factor for the product
+/// \param a first element of the matrix
+/// \param lda leading dimension of the matrix (at least \p cols)
+/// \param x first element of the input vector
+/// \param beta scale factor for the result vector
+/// \param y first element of the result vector
+/// \param queue command queue to perform the operation
+///
+/// For example, to evaluate a dense layer with four inputs and three
+/// outputs:
+///
+/// \snippet test/test_blas.cpp gemv_dense_layer
+///
+/// The work-group size can be tuned with the \c "wgsize" parameter of
+/// \c "__boost_gemv_<type>" in the parameter cache.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see gemm(), axpby()
+template<class MatrixIterator, class VectorIterator, class OutputIterator>
+inline void gemv(size_t rows,
+                 size_t cols,
+                 typename std::iterator_traits<OutputIterator>::value_type alpha,
+                 MatrixIterator a,
+                 size_t lda,
+                 VectorIterator x,
+                 typename std::iterator_traits<OutputIterator>::value_type beta,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<MatrixIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<VectorIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    BOOST_ASSERT(lda >= cols);
+
+    detail::gemv(rows, cols, alpha, a, lda, x, beta, y, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_GEMV_HPP
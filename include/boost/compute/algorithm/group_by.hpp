@@ -0,0 +1,914 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_GROUP_BY_HPP
+#define BOOST_COMPUTE_ALGORITHM_GROUP_BY_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/any_of.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/detail/reduce_by_key_with_scan.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class group_by_aggregate
+/// \brief Describes one aggregate computed by group_by().
+///
+/// Each aggregate reads its values from \c input() and writes one result per
+/// group to \c output(). The value range must have the same length as the
+/// key range passed to group_by().
+///
+/// Aggregates are usually created with the aggregate_sum(), aggregate_min(),
+/// aggregate_max(), aggregate_count() and aggregate_mean() functions.
+///
+/// \see group_by()
+template<class T>
+class group_by_aggregate
+{
+public:
+    typedef T value_type;
+
+    enum operation {
+        sum,
+        minimum,
+        maximum,
+        count,
+        mean
+    };
+
+    group_by_aggregate(operation op,
+                       const buffer_iterator<T> &input,
+                       const buffer_iterator<T> &output)
+        : m_op(op),
+          m_input(input),
+          m_output(output)
+    {
+    }
+
+    operation op() const
+    {
+        return m_op;
+    }
+
+    const buffer_iterator<T>& input() const
+    {
+        return m_input;
+    }
+
+    const buffer_iterator<T>& output() const
+    {
+        return m_output;
+    }
+
+private:
+    operation m_op;
+    buffer_iterator<T> m_input;
+    buffer_iterator<T> m_output;
+};
+
+/// Returns an aggregate which sums the values in each group.
+template<class T>
+inline group_by_aggregate<T>
+aggregate_sum(const buffer_iterator<T> &input, const buffer_iterator<T> &output)
+{
+    return group_by_aggregate<T>(group_by_aggregate<T>::sum, input, output);
+}
+
+/// Returns an aggregate which finds the smallest value in each group.
+template<class T>
+inline group_by_aggregate<T>
+aggregate_min(const buffer_iterator<T> &input, const buffer_iterator<T> &output)
+{
+    return group_by_aggregate<T>(group_by_aggregate<T>::minimum, input, output);
+}
+
+/// Returns an aggregate which finds the largest value in each group.
+template<class T>
+inline group_by_aggregate<T>
+aggregate_max(const buffer_iterator<T> &input, const buffer_iterator<T> &output)
+{
+    return group_by_aggregate<T>(group_by_aggregate<T>::maximum, input, output);
+}
+
+/// Returns an aggregate which writes the number of values in each group.
+template<class T>
+inline group_by_aggregate<T>
+aggregate_count(const buffer_iterator<T> &output)
+{
+    return group_by_aggregate<T>(group_by_aggregate<T>::count, output, output);
+}
+
+/// Returns an aggregate which computes the mean of the values in each group.
+/// For integer types the result is rounded towards zero.
+template<class T>
+inline group_by_aggregate<T>
+aggregate_mean(const buffer_iterator<T> &input, const buffer_iterator<T> &output)
+{
+    return group_by_aggregate<T>(group_by_aggregate<T>::mean, input, output);
+}
+
+namespace detail {
+
+inline std::string group_by_accumulator_name(size_t i)
+{
+    std::stringstream name;
+    name << "acc" << i;
+    return name.str();
+}
+
+template<class T>
+inline bool group_by_needs_counts(const std::vector<group_by_aggregate<T> > &aggregates)
+{
+    for(size_t i = 0; i < aggregates.size(); i++){
+        if(aggregates[i].op() == group_by_aggregate<T>::count ||
+           aggregates[i].op() == group_by_aggregate<T>::mean){
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sort-based aggregation. The keys are sorted together with a permutation
+// of their indices, the segments of equal keys are labeled with the scan
+// from reduce_by_key_with_scan and then one work-item per group reduces the
+// values for all of the aggregates in a single pass over its segment.
+template<class InputKeyIterator, class OutputKeyIterator, class T>
+inline size_t group_by_with_sort(InputKeyIterator keys_first,
+                                 InputKeyIterator keys_last,
+                                 const std::vector<group_by_aggregate<T> > &aggregates,
+                                 OutputKeyIterator keys_result,
+                                 command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef group_by_aggregate<T> aggregate_type;
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        return 0;
+    }
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    // sort the keys along with their original positions
+    vector<key_type> sorted_keys(keys_first, keys_last, queue);
+    vector<uint_> permutation(count, context);
+    ::boost::compute::iota(permutation.begin(), permutation.end(), uint_(0), queue);
+    ::boost::compute::sort_by_key(
+        sorted_keys.begin(), sorted_keys.end(), permutation.begin(), queue
+    );
+
+    // label each segment of equal keys with its group index
+    const size_t work_group_size = (std::min)(
+        size_t(256), device.get_info<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE)
+    );
+    vector<uint_> group_ids(count, context);
+    generate_uint_keys(
+        sorted_keys.begin(), count, equal_to<key_type>(), group_ids.begin(),
+        work_group_size, queue
+    );
+    const size_t groups = static_cast<size_t>(
+        read_single_value<uint_>(group_ids.get_buffer(), count - 1, queue)
+    ) + 1;
+
+    // find the start of each segment and write out the unique keys
+    vector<uint_> starts(groups + 1, context);
+    ::boost::compute::fill_n(starts.end() - 1, 1, uint_(count), queue);
+
+    meta_kernel starts_kernel("group_by_segment_starts");
+    starts_kernel <<
+        starts_kernel.decl<const uint_>("i") << " = get_global_id(0);\n" <<
+        starts_kernel.decl<const uint_>("group") << " = " <<
+            group_ids.begin()[starts_kernel.var<const uint_>("i")] << ";\n" <<
+        "if(i == 0 || group != " <<
+            group_ids.begin()[starts_kernel.var<const uint_>("i - 1")] << "){\n" <<
+        "    " << starts.begin()[starts_kernel.var<const uint_>("group")] <<
+            " = i;\n" <<
+        "    " << keys_result[starts_kernel.var<const uint_>("group")] <<
+            " = " << sorted_keys.begin()[starts_kernel.var<const uint_>("i")] << ";\n" <<
+        "}\n";
+    starts_kernel.exec_1d(queue, 0, count);
+
+    if(aggregates.empty()){
+        return groups;
+    }
+
+    // reduce every aggregate for each group in one pass over its values
+    meta_kernel k("group_by_with_sort");
+    k << k.decl<const uint_>("g") << " = get_global_id(0);\n"
+      << k.decl<const uint_>("start") << " = "
+      <<     starts.begin()[k.var<const uint_>("g")] << ";\n"
+      << k.decl<const uint_>("end") << " = "
+      <<     starts.begin()[k.var<const uint_>("g + 1")] << ";\n"
+      << k.decl<uint_>("idx") << " = "
+      <<     permutation.begin()[k.var<const uint_>("start")] << ";\n";
+
+    for(size_t i = 0; i < aggregates.size(); i++){
+        // counts are computed from the segment bounds, the input of a count
+        // aggregate is its output so it must not be read by element index
+        if(aggregates[i].op() == aggregate_type::count){
+            continue;
+        }
+
+        const std::string acc = group_by_accumulator_name(i);
+        k << k.decl<T>(acc) << " = "
+          << aggregates[i].input()[k.var<const uint_>("idx")] << ";\n";
+    }
+
+    k << "for(uint j = start + 1; j < end; j++){\n"
+      << "    idx = " << permutation.begin()[k.var<const uint_>("j")] << ";\n";
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        const std::string acc = group_by_accumulator_name(i);
+
+        switch(aggregate.op()){
+        case aggregate_type::sum:
+        case aggregate_type::mean:
+            k << "    " << acc << " += "
+              << aggregate.input()[k.var<const uint_>("idx")] << ";\n";
+            break;
+        case aggregate_type::minimum:
+        case aggregate_type::maximum:
+            k << "    {\n"
+              << "        " << k.decl<const T>("value") << " = "
+              <<              aggregate.input()[k.var<const uint_>("idx")] << ";\n"
+              << "        if(" << (aggregate.op() == aggregate_type::minimum ?
+                                   "value < " + acc : acc + " < value")
+              <<           "){\n"
+              << "            " << acc << " = value;\n"
+              << "        }\n"
+              << "    }\n";
+            break;
+        case aggregate_type::count:
+            break;
+        }
+    }
+    k << "}\n";
+
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        const std::string acc = group_by_accumulator_name(i);
+
+        k << aggregate.output()[k.var<const uint_>("g")] << " = ";
+        switch(aggregate.op()){
+        case aggregate_type::count:
+            k << "(" << type_name<T>() << ")(end - start);\n";
+            break;
+        case aggregate_type::mean:
+            k << acc << " / (" << type_name<T>() << ")(end - start);\n";
+            break;
+        default:
+            k << acc << ";\n";
+            break;
+        }
+    }
+
+    k.exec_1d(queue, 0, groups);
+
+    return groups;
+}
+
+// Finds the distinct keys in [keys_first, keys_last) with a hash table
+// sized for at most max_groups keys. The keys are written to distinct and
+// their number is returned, or max_groups + 1 once more than max_groups
+// distinct keys are seen. After an overflow the remaining work-items stop
+// early so inputs with many groups only pay for one pass over the keys.
+template<class InputKeyIterator>
+inline size_t group_by_distinct_keys(InputKeyIterator keys_first,
+                                     InputKeyIterator keys_last,
+                                     size_t max_groups,
+                                     vector<
+                                         typename std::iterator_traits<
+                                             InputKeyIterator
+                                         >::value_type
+                                     > &distinct,
+                                     command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef unordered_map<key_type, uint_> table_type;
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0){
+        return 0;
+    }
+
+    const context &context = queue.get_context();
+
+    // at least twice as many slots as keys kept, so no probe sequence fills
+    // the table before the overflow is detected
+    size_t slots = 2;
+    while(slots < 2 * (std::min)(max_groups, count)){
+        slots *= 2;
+    }
+
+    vector<key_type> table_keys(slots, context);
+    ::boost::compute::fill(
+        table_keys.begin(), table_keys.end(), table_type::empty_key(), queue
+    );
+    distinct.resize((std::max)(max_groups, size_t(1)), queue);
+
+    // state[0] counts the distinct keys and state[1] flags an overflow
+    vector<uint_> state(2, context);
+    ::boost::compute::fill(state.begin(), state.end(), uint_(0), queue);
+
+    meta_kernel k("group_by_distinct_keys");
+    k.add_set_arg<const key_type>("empty_key", table_type::empty_key());
+    k.add_set_arg<const uint_>("mask", static_cast<uint_>(slots - 1));
+    k.add_set_arg<const uint_>("max_groups", static_cast<uint_>(max_groups));
+
+    const std::string keys =
+        k.get_buffer_identifier<key_type>(table_keys.get_buffer());
+    const std::string flags =
+        k.get_buffer_identifier<uint_>(state.get_buffer());
+
+    k << "if(" << flags << "[1]){\n"
+      << "    return;\n"
+      << "}\n"
+      << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+      << k.decl<const key_type>("key") << " = "
+      <<     keys_first[k.var<const uint_>("i")] << ";\n"
+      << "uint slot = (uint)("
+      <<     ::boost::compute::hash<key_type>()(k.var<const key_type>("key"))
+      <<     ") & mask;\n"
+      << "for(uint probe = 0; probe <= mask; probe++){\n"
+      << "    " << k.decl<const key_type>("prev") << " = "
+      <<          atomic_cmpxchg<key_type>()(
+                      k.expr<key_type *>("&" + keys + "[slot]"),
+                      k.var<const key_type>("empty_key"),
+                      k.var<const key_type>("key")
+                  ) << ";\n"
+      << "    if(prev == empty_key){\n"
+      << "        " << k.decl<const uint_>("index") << " = "
+      <<              atomic_inc<uint_>()(
+                          k.expr<uint_ *>("&" + flags + "[0]")
+                      ) << ";\n"
+      << "        if(index < max_groups){\n"
+      << "            " << distinct.begin()[k.var<const uint_>("index")]
+      <<                  " = key;\n"
+      << "        }\n"
+      << "        else {\n"
+      << "            " << flags << "[1] = 1;\n"
+      << "        }\n"
+      << "        return;\n"
+      << "    }\n"
+      << "    else if(prev == key){\n"
+      << "        return;\n"
+      << "    }\n"
+      << "    slot = (slot + 1) & mask;\n"
+      << "}\n"
+      << flags << "[1] = 1;\n";
+    k.exec_1d(queue, 0, count);
+
+    uint_ host_state[2];
+    ::boost::compute::copy(state.begin(), state.end(), host_state, queue);
+    if(host_state[1] || host_state[0] > max_groups){
+        return max_groups + 1;
+    }
+
+    return static_cast<size_t>(host_state[0]);
+}
+
+// Emits an atomic update of target with value, where target is an lvalue in
+// the given address space. Integer types use the built-in atomic functions
+// and float uses a compare-and-swap loop on the bits of the value.
+template<class T>
+inline void group_by_emit_atomic_update(meta_kernel &k,
+                                        typename group_by_aggregate<T>::operation op,
+                                        const std::string &address_space,
+                                        const std::string &target,
+                                        const std::string &value)
+{
+    typedef group_by_aggregate<T> aggregate_type;
+
+    if(boost::is_same<T, float_>::value){
+        std::string update;
+        if(op == aggregate_type::minimum){
+            update = "fmin(as_float(assumed), " + value + ")";
+        }
+        else if(op == aggregate_type::maximum){
+            update = "fmax(as_float(assumed), " + value + ")";
+        }
+        else {
+            update = "as_float(assumed) + " + value;
+        }
+
+        k << "{\n"
+          << "    volatile " << address_space << " uint *ptr = (volatile "
+          <<      address_space << " uint *) &" << target << ";\n"
+          << "    uint old = *ptr;\n"
+          << "    uint assumed;\n"
+          << "    do {\n"
+          << "        assumed = old;\n"
+          << "        old = " BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "cmpxchg(ptr, assumed, "
+          <<              "as_uint(" << update << "));\n"
+          << "    } while(old != assumed);\n"
+          << "}\n";
+    }
+    else {
+        const char *function = BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "add";
+        if(op == aggregate_type::minimum){
+            function = BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "min";
+        }
+        else if(op == aggregate_type::maximum){
+            function = BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "max";
+        }
+
+        k << function << "(&" << target << ", " << value << ");\n";
+    }
+}
+
+// Returns the expression for element index of the global buffer at it.
+template<class T>
+inline std::string group_by_global_element(meta_kernel &k,
+                                           const buffer_iterator<T> &it,
+                                           const std::string &index)
+{
+    std::stringstream element;
+    element << k.get_buffer_identifier<T>(it.get_buffer())
+            << "[" << it.get_index() << " + " << index << "]";
+    return element.str();
+}
+
+// Returns the initial value of the output of an aggregate.
+template<class T>
+inline T group_by_initial_value(typename group_by_aggregate<T>::operation op)
+{
+    typedef group_by_aggregate<T> aggregate_type;
+
+    if(op == aggregate_type::minimum){
+        return (std::numeric_limits<T>::max)();
+    }
+    else if(op == aggregate_type::maximum){
+        return std::numeric_limits<T>::is_integer ?
+                   (std::numeric_limits<T>::min)() :
+                   -(std::numeric_limits<T>::max)();
+    }
+
+    return T(0);
+}
+
+// Combines each value into its group with atomic operations on the outputs
+// in global memory.
+template<class T>
+inline void group_by_hash_global(vector<uint_> &group_ids,
+                                 size_t count,
+                                 const std::vector<group_by_aggregate<T> > &aggregates,
+                                 vector<uint_> &counts,
+                                 bool needs_counts,
+                                 command_queue &queue)
+{
+    typedef group_by_aggregate<T> aggregate_type;
+
+    meta_kernel k("group_by_with_hash");
+    k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+      << k.decl<const uint_>("g") << " = "
+      <<     group_ids.begin()[k.var<const uint_>("i")] << ";\n";
+    if(needs_counts){
+        k << BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "inc(&"
+          << counts.begin()[k.var<const uint_>("g")] << ");\n";
+    }
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        if(aggregate.op() == aggregate_type::count){
+            continue;
+        }
+
+        std::stringstream value;
+        value << "value" << i;
+        k << k.decl<const T>(value.str()) << " = "
+          << aggregate.input()[k.var<const uint_>("i")] << ";\n";
+        group_by_emit_atomic_update<T>(
+            k, aggregate.op(), "__global",
+            group_by_global_element(k, aggregate.output(), "g"),
+            value.str()
+        );
+    }
+    k.exec_1d(queue, 0, count);
+}
+
+// Combines the values into per work-group copies of the outputs in local
+// memory and then merges each copy into the global outputs. This keeps the
+// contended atomic operations in local memory when there are few groups.
+template<class T>
+inline void group_by_hash_local(vector<uint_> &group_ids,
+                                size_t count,
+                                size_t groups,
+                                const std::vector<group_by_aggregate<T> > &aggregates,
+                                vector<uint_> &counts,
+                                bool needs_counts,
+                                size_t work_group_size,
+                                command_queue &queue)
+{
+    typedef group_by_aggregate<T> aggregate_type;
+
+    const device &device = queue.get_device();
+
+    meta_kernel k("group_by_with_hash_local");
+    k.add_set_arg<const uint_>("count", static_cast<uint_>(count));
+    k.add_set_arg<const uint_>("groups", static_cast<uint_>(groups));
+
+    std::vector<size_t> local_args(aggregates.size());
+    for(size_t i = 0; i < aggregates.size(); i++){
+        if(aggregates[i].op() != aggregate_type::count){
+            local_args[i] = k.add_arg<T *>(
+                memory_object::local_memory, "l" + group_by_accumulator_name(i)
+            );
+        }
+    }
+    size_t local_counts_arg = 0;
+    if(needs_counts){
+        local_counts_arg =
+            k.add_arg<uint_ *>(memory_object::local_memory, "lcounts");
+    }
+
+    // initialize the local copies of the outputs
+    k << "for(uint g = get_local_id(0); g < groups; g += get_local_size(0)){\n";
+    if(needs_counts){
+        k << "    lcounts[g] = 0;\n";
+    }
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        if(aggregate.op() != aggregate_type::count){
+            k << "    l" << group_by_accumulator_name(i) << "[g] = "
+              << k.lit(group_by_initial_value<T>(aggregate.op())) << ";\n";
+        }
+    }
+    k << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n";
+
+    // combine the values into the local copies
+    k << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n"
+      << "    " << k.decl<const uint_>("g") << " = "
+      <<          group_ids.begin()[k.var<const uint_>("i")] << ";\n";
+    if(needs_counts){
+        k << "    " BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "inc(&lcounts[g]);\n";
+    }
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        if(aggregate.op() == aggregate_type::count){
+            continue;
+        }
+
+        std::stringstream value;
+        value << "value" << i;
+        k << "    " << k.decl<const T>(value.str()) << " = "
+          << aggregate.input()[k.var<const uint_>("i")] << ";\n";
+        group_by_emit_atomic_update<T>(
+            k, aggregate.op(), "__local",
+            "l" + group_by_accumulator_name(i) + "[g]", value.str()
+        );
+    }
+    k << "}\n"
+      << "barrier(CLK_LOCAL_MEM_FENCE);\n";
+
+    // merge the local copies into the outputs
+    k << "for(uint g = get_local_id(0); g < groups; g += get_local_size(0)){\n";
+    if(needs_counts){
+        k << "    if(lcounts[g] == 0){\n"
+          << "        continue;\n"
+          << "    }\n"
+          << "    " BOOST_COMPUTE_DETAIL_ATOMIC_PREFIX "add(&"
+          <<          counts.begin()[k.var<const uint_>("g")] << ", lcounts[g]);\n";
+    }
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        if(aggregate.op() == aggregate_type::count){
+            continue;
+        }
+
+        group_by_emit_atomic_update<T>(
+            k, aggregate.op(), "__global",
+            group_by_global_element(k, aggregate.output(), "g"),
+            "l" + group_by_accumulator_name(i) + "[g]"
+        );
+    }
+    k << "}\n";
+
+    ::boost::compute::kernel kernel = k.compile(queue.get_context());
+    for(size_t i = 0; i < aggregates.size(); i++){
+        if(aggregates[i].op() != aggregate_type::count){
+            kernel.set_arg(local_args[i], local_buffer<T>(groups));
+        }
+    }
+    if(needs_counts){
+        kernel.set_arg(local_counts_arg, local_buffer<uint_>(groups));
+    }
+
+    // enough work-groups to fill the device, each one striding over the
+    // values so the merge is paid once per work-group
+    const size_t max_work_groups = 4 * device.compute_units();
+    const size_t work_groups = (std::min)(
+        max_work_groups, (count + work_group_size - 1) / work_group_size
+    );
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_groups * work_group_size, work_group_size
+    );
+}
+
+// Hash-based aggregation. The distinct keys are sorted and relabeled with
+// their index, then each value is combined into its group with atomic
+// operations in a single pass over the input. With few enough groups to fit
+// in local memory the values are first combined per work-group.
+template<class InputKeyIterator, class OutputKeyIterator, class T>
+inline size_t group_by_with_hash(vector<
+                                     typename std::iterator_traits<
+                                         InputKeyIterator
+                                     >::value_type
+                                 > &unique_keys,
+                                 size_t groups,
+                                 InputKeyIterator keys_first,
+                                 InputKeyIterator keys_last,
+                                 const std::vector<group_by_aggregate<T> > &aggregates,
+                                 OutputKeyIterator keys_result,
+                                 command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef group_by_aggregate<T> aggregate_type;
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count == 0 || groups == 0){
+        return 0;
+    }
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    // sort the distinct keys so the groups are in the same order as with
+    // the sort-based algorithm
+    ::boost::compute::sort(
+        unique_keys.begin(), unique_keys.begin() + groups, queue
+    );
+    ::boost::compute::copy(
+        unique_keys.begin(), unique_keys.begin() + groups, keys_result, queue
+    );
+
+    if(aggregates.empty()){
+        return groups;
+    }
+
+    // map each key to the index of its group
+    unordered_map<key_type, uint_> table(context);
+    table.insert(
+        unique_keys.begin(), unique_keys.begin() + groups,
+        make_counting_iterator<uint_>(0),
+        queue
+    );
+    vector<uint_> group_ids(count, context);
+    table.find(keys_first, keys_last, group_ids.begin(), uint_(0), queue);
+
+    // initialize the outputs
+    for(size_t i = 0; i < aggregates.size(); i++){
+        const aggregate_type &aggregate = aggregates[i];
+        if(aggregate.op() != aggregate_type::count){
+            ::boost::compute::fill_n(
+                aggregate.output(), groups,
+                group_by_initial_value<T>(aggregate.op()), queue
+            );
+        }
+    }
+
+    const bool needs_counts = group_by_needs_counts(aggregates);
+    vector<uint_> counts(needs_counts ? groups : 1, context);
+    if(needs_counts){
+        ::boost::compute::fill_n(counts.begin(), groups, uint_(0), queue);
+    }
+
+    // combine each value into its group, privatizing the outputs in local
+    // memory when they fit and the local atomic functions are available
+    const std::string cache_key =
+        std::string("__boost_group_by_") + type_name<key_type>();
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+    const size_t local_max_groups =
+        static_cast<size_t>(parameters->get(cache_key, "local_max_groups", 1024));
+
+    size_t local_accumulators = 0;
+    for(size_t i = 0; i < aggregates.size(); i++){
+        if(aggregates[i].op() != aggregate_type::count){
+            local_accumulators++;
+        }
+    }
+    const size_t local_bytes =
+        groups * (local_accumulators * sizeof(T) +
+                  (needs_counts ? sizeof(uint_) : 0));
+    const size_t work_group_size = (std::min)(
+        size_t(256), device.get_info<size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE)
+    );
+
+    if(groups <= local_max_groups &&
+       local_bytes <= device.local_memory_size() &&
+       device.check_version(1, 1) &&
+       count > work_group_size){
+        group_by_hash_local(
+            group_ids, count, groups, aggregates, counts, needs_counts,
+            work_group_size, queue
+        );
+    }
+    else {
+        group_by_hash_global(
+            group_ids, count, aggregates, counts, needs_counts, queue
+        );
+    }
+
+    // write counts and divide the sums for the means
+    if(needs_counts){
+        meta_kernel finish_kernel("group_by_with_hash_counts");
+        finish_kernel <<
+            finish_kernel.decl<const uint_>("g") << " = get_global_id(0);\n" <<
+            finish_kernel.decl<const T>("n") << " = (" << type_name<T>() << ") " <<
+                counts.begin()[finish_kernel.var<const uint_>("g")] << ";\n";
+        for(size_t i = 0; i < aggregates.size(); i++){
+            const aggregate_type &aggregate = aggregates[i];
+            if(aggregate.op() == aggregate_type::count){
+                finish_kernel <<
+                    aggregate.output()[finish_kernel.var<const uint_>("g")] <<
+                    " = n;\n";
+            }
+            else if(aggregate.op() == aggregate_type::mean){
+                finish_kernel <<
+                    aggregate.output()[finish_kernel.var<const uint_>("g")] <<
+                    " /= n;\n";
+            }
+        }
+        finish_kernel.exec_1d(queue, 0, groups);
+    }
+
+    return groups;
+}
+
+template<class Key, class T>
+struct group_by_hash_supported
+    : boost::mpl::bool_<
+          (boost::is_same<Key, int_>::value ||
+           boost::is_same<Key, uint_>::value) &&
+          (boost::is_same<T, int_>::value ||
+           boost::is_same<T, uint_>::value ||
+           boost::is_same<T, float_>::value)
+      >
+{
+};
+
+template<class InputKeyIterator, class OutputKeyIterator, class T>
+inline size_t dispatch_group_by(InputKeyIterator keys_first,
+                                InputKeyIterator keys_last,
+                                const std::vector<group_by_aggregate<T> > &aggregates,
+                                OutputKeyIterator keys_result,
+                                command_queue &queue,
+                                boost::mpl::false_)
+{
+    return group_by_with_sort(
+        keys_first, keys_last, aggregates, keys_result, queue
+    );
+}
+
+template<class InputKeyIterator, class OutputKeyIterator, class T>
+inline size_t dispatch_group_by(InputKeyIterator keys_first,
+                                InputKeyIterator keys_last,
+                                const std::vector<group_by_aggregate<T> > &aggregates,
+                                OutputKeyIterator keys_result,
+                                command_queue &queue,
+                                boost::mpl::true_)
+{
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+
+    const std::string cache_key =
+        std::string("__boost_group_by_") + type_name<key_type>();
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    // the largest number of groups for which hash-based aggregation is used,
+    // above it the atomic updates are spread too thin and sorting wins
+    const size_t max_groups =
+        static_cast<size_t>(parameters->get(cache_key, "hash_max_groups", 4096));
+
+    // the two largest keys are reserved by the hash table to mark empty and
+    // erased slots, they are never stored so inputs with them are sorted
+    using ::boost::compute::lambda::_1;
+    typedef unordered_map<key_type, uint_> table_type;
+    if(::boost::compute::any_of(keys_first, keys_last,
+                                _1 >= table_type::erased_key(), queue)){
+        return group_by_with_sort(
+            keys_first, keys_last, aggregates, keys_result, queue
+        );
+    }
+
+    // find the distinct keys, giving up as soon as there are too many
+    vector<key_type> unique_keys(queue.get_context());
+    const size_t groups = group_by_distinct_keys(
+        keys_first, keys_last, max_groups, unique_keys, queue
+    );
+
+    if(groups > max_groups){
+        return group_by_with_sort(
+            keys_first, keys_last, aggregates, keys_result, queue
+        );
+    }
+
+    return group_by_with_hash(
+        unique_keys, groups, keys_first, keys_last, aggregates, keys_result, queue
+    );
+}
+
+} // end detail namespace
+
+/// Groups the values by the unsorted keys in the range [\p keys_first,
+/// \p keys_last) and computes each of the \p aggregates for every group.
+///
+/// The distinct keys are written in ascending order to \p keys_result and
+/// the result of each aggregate for the i'th key is written to the i'th
+/// element of its output range. Returns the number of groups.
+///
+/// All of the aggregates are computed together in a single pass over the
+/// values. For \c int_ and \c uint_ keys with a small number of distinct
+/// keys the values are combined through a hash table with atomic operations,
+/// otherwise the keys are sorted along with a permutation and each segment
+/// of equal keys is reduced. The largest number of groups for which the
+/// hash-based algorithm is used is tunable with the \c "hash_max_groups"
+/// parameter, the distinct keys are counted in a table of that size and the
+/// keys are sorted as soon as it overflows. Up to \c "local_max_groups"
+/// groups (and as many as fit in local memory) are first combined per
+/// work-group in local memory. Inputs containing the two largest values of
+/// the key type, which the hash table reserves, are always sorted.
+///
+/// For example, to compute the sum, maximum and mean of a column of values
+/// for each key:
+///
+/// \code
+/// std::vector<boost::compute::group_by_aggregate<float> > aggregates;
+/// aggregates.push_back(boost::compute::aggregate_sum(values.begin(), sums.begin()));
+/// aggregates.push_back(boost::compute::aggregate_max(values.begin(), maxs.begin()));
+/// aggregates.push_back(boost::compute::aggregate_mean(values.begin(), means.begin()));
+///
+/// size_t groups = boost::compute::group_by(
+///     keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+/// );
+/// \endcode
+///
+/// Space complexity: \Omega(n)
+///
+/// \see reduce_by_key()
+template<class InputKeyIterator, class OutputKeyIterator, class T>
+inline size_t group_by(InputKeyIterator keys_first,
+                       InputKeyIterator keys_last,
+                       const std::vector<group_by_aggregate<T> > &aggregates,
+                       OutputKeyIterator keys_result,
+                       command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputKeyIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputKeyIterator>::value);
+    typedef typename std::iterator_traits<InputKeyIterator>::value_type key_type;
+
+    if(keys_first == keys_last){
+        return 0;
+    }
+
+    return detail::dispatch_group_by(
+        keys_first, keys_last, aggregates, keys_result, queue,
+        detail::group_by_hash_supported<key_type, T>()
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_GROUP_BY_HPP
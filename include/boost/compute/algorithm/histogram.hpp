@@ -0,0 +1,317 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+#define BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+
+#include <iterator>
+#include <string>
+
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/algorithm/detail/histogram_with_local_bins.hpp>
+#include <boost/compute/algorithm/detail/histogram_with_sort.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// bin index for equal width bins over [lo, hi)
+template<class InputIterator>
+class histogram_uniform_bin_index
+{
+public:
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename boost::mpl::if_<
+        boost::is_same<value_type, double_>, double_, float_
+    >::type working_type;
+
+    histogram_uniform_bin_index(InputIterator first,
+                                working_type lo,
+                                working_type range,
+                                uint_ num_bins)
+        : m_first(first),
+          m_lo(lo),
+          m_range(range),
+          m_num_bins(num_bins)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        const std::string type = type_name<working_type>();
+
+        k.add_set_arg<const working_type>("lo", m_lo);
+        k.add_set_arg<const working_type>("range", m_range);
+        k.add_set_arg<const uint_>("uniform_bins", m_num_bins);
+        k.add_function(
+            "boost_histogram_uniform_bin",
+            "inline uint boost_histogram_uniform_bin(" + type + " x, " +
+                type + " lo, " + type + " range, uint num_bins)\n"
+            "{\n"
+            "    const " + type + " f = ((x - lo) * num_bins) / range;\n"
+            "    return (f >= 0 && f < num_bins) ? (uint) f : num_bins;\n"
+            "}\n"
+        );
+
+        k << "boost_histogram_uniform_bin((" << type << ")("
+          << m_first[k.var<const uint_>("i")] << "), lo, range, uniform_bins)";
+    }
+
+private:
+    InputIterator m_first;
+    working_type m_lo;
+    working_type m_range;
+    uint_ m_num_bins;
+};
+
+// bin index computed by a user-defined function
+template<class InputIterator, class BinFunction>
+class histogram_function_bin_index
+{
+public:
+    histogram_function_bin_index(InputIterator first, BinFunction function)
+        : m_first(first),
+          m_function(function)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k << m_function(m_first[k.var<const uint_>("i")]);
+    }
+
+private:
+    InputIterator m_first;
+    BinFunction m_function;
+};
+
+// bin index within the row of bins for the key of each value
+template<class KeyIterator, class InputIterator, class BinFunction>
+class histogram_by_key_bin_index
+{
+public:
+    histogram_by_key_bin_index(KeyIterator keys_first,
+                               InputIterator values_first,
+                               uint_ num_keys,
+                               uint_ bins_per_key,
+                               BinFunction function)
+        : m_keys_first(keys_first),
+          m_values_first(values_first),
+          m_num_keys(num_keys),
+          m_bins_per_key(bins_per_key),
+          m_function(function)
+    {
+    }
+
+    void operator()(meta_kernel &k) const
+    {
+        k.add_set_arg<const uint_>("num_keys", m_num_keys);
+        k.add_set_arg<const uint_>("bins_per_key", m_bins_per_key);
+        k.add_function(
+            "boost_histogram_by_key_bin",
+            "inline uint boost_histogram_by_key_bin(uint key, uint bin,\n"
+            "                                       uint num_keys,\n"
+            "                                       uint bins_per_key)\n"
+            "{\n"
+            "    return (key < num_keys && bin < bins_per_key) ?\n"
+            "               key * bins_per_key + bin : num_keys * bins_per_key;\n"
+            "}\n"
+        );
+
+        k << "boost_histogram_by_key_bin("
+          << "(uint)(" << m_keys_first[k.var<const uint_>("i")] << "), "
+          << "(uint)(" << m_function(m_values_first[k.var<const uint_>("i")]) << "), "
+          << "num_keys, bins_per_key)";
+    }
+
+private:
+    KeyIterator m_keys_first;
+    InputIterator m_values_first;
+    uint_ m_num_keys;
+    uint_ m_bins_per_key;
+    BinFunction m_function;
+};
+
+template<class BinIndex, class OutputIterator>
+inline void dispatch_histogram(const BinIndex &bin_index,
+                               size_t count,
+                               OutputIterator bins_result,
+                               size_t num_bins,
+                               command_queue &queue)
+{
+    if(num_bins == 0){
+        return;
+    }
+    if(count == 0){
+        ::boost::compute::fill_n(bins_result, num_bins, uint_(0), queue);
+        return;
+    }
+
+    if(histogram_with_local_bins_requirements_met(num_bins, queue)){
+        histogram_with_local_bins(bin_index, count, bins_result, num_bins, queue);
+    }
+    else {
+        histogram_with_sort(bin_index, count, bins_result, num_bins, queue);
+    }
+}
+
+} // end detail namespace
+
+/// Counts the values in the range [\p first, \p last) which fall into each
+/// of \p num_bins equal width bins spanning [\p lo, \p hi) and writes the
+/// counts to \p bins_result. Values outside of [\p lo, \p hi) are not
+/// counted.
+///
+/// \p bins_result must be a buffer iterator to \c uint_ values.
+///
+/// Each work-group counts into a private copy of the bins in local memory
+/// which is merged into the result at the end, so frequently hit bins do
+/// not serialize on global atomics. When the bins do not fit in local memory
+/// the bin of each value is sorted and counted with reduce_by_key().
+///
+/// For example, to build a histogram with ten bins of values in [0, 1):
+///
+/// \code
+/// boost::compute::vector<uint_> bins(10, context);
+/// boost::compute::histogram(
+///     values.begin(), values.end(), bins.begin(), 10, 0.0f, 1.0f, queue
+/// );
+/// \endcode
+///
+/// Space complexity: \Omega(1)<br>
+/// Space complexity when the bins do not fit in local memory: \Omega(3n)
+///
+/// \see histogram_by_key()
+template<class InputIterator, class OutputIterator>
+inline void histogram(InputIterator first,
+                      InputIterator last,
+                      OutputIterator bins_result,
+                      size_t num_bins,
+                      typename std::iterator_traits<InputIterator>::value_type lo,
+                      typename std::iterator_traits<InputIterator>::value_type hi,
+                      command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef detail::histogram_uniform_bin_index<InputIterator> bin_index_type;
+    typedef typename bin_index_type::working_type working_type;
+
+    const working_type range =
+        static_cast<working_type>(hi) - static_cast<working_type>(lo);
+
+    detail::dispatch_histogram(
+        bin_index_type(
+            first, static_cast<working_type>(lo), range, static_cast<uint_>(num_bins)
+        ),
+        detail::iterator_range_size(first, last),
+        bins_result,
+        num_bins,
+        queue
+    );
+}
+
+/// Counts the values in the range [\p first, \p last) for each of
+/// \p num_bins bins where \p bin_function returns the bin index for a value.
+/// Values for which \p bin_function returns an index outside of
+/// [0, \p num_bins) are not counted.
+///
+/// \p bins_result must be a buffer iterator to \c uint_ values.
+///
+/// For example, to count the values by their lowest four bits:
+///
+/// \code
+/// BOOST_COMPUTE_FUNCTION(uint_, low_bits, (uint_ x),
+/// {
+///     return x & 0xf;
+/// });
+///
+/// boost::compute::histogram(
+///     values.begin(), values.end(), bins.begin(), 16, low_bits, queue
+/// );
+/// \endcode
+template<class InputIterator, class OutputIterator, class BinFunction>
+inline void histogram(InputIterator first,
+                      InputIterator last,
+                      OutputIterator bins_result,
+                      size_t num_bins,
+                      BinFunction bin_function,
+                      command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::dispatch_histogram(
+        detail::histogram_function_bin_index<InputIterator, BinFunction>(
+            first, bin_function
+        ),
+        detail::iterator_range_size(first, last),
+        bins_result,
+        num_bins,
+        queue
+    );
+}
+
+/// Builds a separate histogram of \p bins_per_key bins for each of the
+/// \p num_keys keys. The key of each value is read from the range
+/// [\p keys_first, \p keys_last) and its bin is returned by
+/// \p bin_function.
+///
+/// The histograms are written one after another to \p bins_result, the
+/// count for bin \c b of key \c k is at index <tt>k * bins_per_key + b</tt>.
+/// Values with a key outside of [0, \p num_keys) or a bin outside of
+/// [0, \p bins_per_key) are not counted.
+///
+/// \p bins_result must be a buffer iterator to \c uint_ values.
+///
+/// \see histogram()
+template<class KeyIterator, class InputIterator,
+         class OutputIterator, class BinFunction>
+inline void histogram_by_key(KeyIterator keys_first,
+                             KeyIterator keys_last,
+                             InputIterator values_first,
+                             OutputIterator bins_result,
+                             size_t num_keys,
+                             size_t bins_per_key,
+                             BinFunction bin_function,
+                             command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<KeyIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::dispatch_histogram(
+        detail::histogram_by_key_bin_index<KeyIterator, InputIterator, BinFunction>(
+            keys_first,
+            values_first,
+            static_cast<uint_>(num_keys),
+            static_cast<uint_>(bins_per_key),
+            bin_function
+        ),
+        detail::iterator_range_size(keys_first, keys_last),
+        bins_result,
+        num_keys * bins_per_key,
+        queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
@@ -45,6 +45,9 @@ namespace compute {
 ///
 /// \snippet test/test_scan.cpp inclusive_scan_int_multiplies
 ///
+/// Inputs smaller than an opt-in per-device threshold are scanned on the
+/// host instead (see host_dispatch).
+///
 /// Space complexity on GPUs: \Omega(n)<br>
 /// Space complexity on GPUs when \p first == \p result: \Omega(2n)<br>
 /// Space complexity on CPUs: \Omega(1)
@@ -97,6 +97,79 @@ inline T inner_product(InputIterator1 first1,
                                         queue);
 }
 
+/// Asynchronous version of inner_product(). Enqueues the computation and a
+/// non-blocking read of its result and returns a future for the result
+/// without waiting for the device.
+///
+/// Space complexity: \Omega(1)<br>
+/// Space complexity when binary operator is recognized as associative: \Omega(n)
+///
+/// \see inner_product(), accumulate_async()
+template<class InputIterator1, class InputIterator2, class T>
+inline future<T> inner_product_async(InputIterator1 first1,
+                                     InputIterator1 last1,
+                                     InputIterator2 first2,
+                                     T init,
+                                     command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator1>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator2>::value);
+    typedef typename std::iterator_traits<InputIterator1>::value_type input_type;
+
+    ptrdiff_t n = std::distance(first1, last1);
+
+    return ::boost::compute::accumulate_async(
+        ::boost::compute::make_transform_iterator(
+            ::boost::compute::make_zip_iterator(
+                boost::make_tuple(first1, first2)
+            ),
+            detail::unpack(multiplies<input_type>())
+        ),
+        ::boost::compute::make_transform_iterator(
+            ::boost::compute::make_zip_iterator(
+                boost::make_tuple(last1, first2 + n)
+            ),
+            detail::unpack(multiplies<input_type>())
+        ),
+        init,
+        queue
+    );
+}
+
+/// \overload
+template<class InputIterator1,
+         class InputIterator2,
+         class T,
+         class BinaryAccumulateFunction,
+         class BinaryTransformFunction>
+inline future<T> inner_product_async(InputIterator1 first1,
+                                     InputIterator1 last1,
+                                     InputIterator2 first2,
+                                     T init,
+                                     BinaryAccumulateFunction accumulate_function,
+                                     BinaryTransformFunction transform_function,
+                                     command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator1>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator2>::value);
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+
+    size_t count = detail::iterator_range_size(first1, last1);
+    vector<value_type> result(count, queue.get_context());
+    transform(first1,
+              last1,
+              first2,
+              result.begin(),
+              transform_function,
+              queue);
+
+    return ::boost::compute::accumulate_async(result.begin(),
+                                              result.end(),
+                                              init,
+                                              accumulate_function,
+                                              queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
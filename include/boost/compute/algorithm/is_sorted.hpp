@@ -12,12 +12,17 @@
 #define BOOST_COMPUTE_ALGORITHM_IS_SORTED_HPP
 
 #include <boost/static_assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/system.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/functional/bind.hpp>
 #include <boost/compute/functional/operator.hpp>
 #include <boost/compute/algorithm/adjacent_find.hpp>
+#include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
@@ -65,6 +70,56 @@ inline bool is_sorted(InputIterator first,
     );
 }
 
+/// Asynchronous version of is_sorted(). Returns a future which is \c true if
+/// the values in the range [\p first, \p last) are in sorted order.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see is_sorted()
+template<class InputIterator, class Compare>
+inline future<bool> is_sorted_async(InputIterator first,
+                                    InputIterator last,
+                                    Compare compare,
+                                    command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    using ::boost::compute::placeholders::_1;
+    using ::boost::compute::placeholders::_2;
+
+    size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
+        return future<bool>(true, queue.enqueue_marker());
+    }
+
+    // search for the first adjacent pair which is out of order
+    boost::shared_ptr<uint_> index = boost::make_shared<uint_>(0);
+    event event_ = detail::find_index_with_atomics_async(
+        detail::make_adjacent_index_condition(
+            first, ::boost::compute::bind(compare, _2, _1)
+        ),
+        count - 1, index, queue
+    );
+
+    return future<bool>(
+        event_,
+        detail::found_index_test(index, static_cast<uint_>(count - 1), false)
+    );
+}
+
+/// \overload
+template<class InputIterator>
+inline future<bool> is_sorted_async(InputIterator first,
+                                    InputIterator last,
+                                    command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    return ::boost::compute::is_sorted_async(
+        first, last, ::boost::compute::less<value_type>(), queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -0,0 +1,124 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_K_WAY_MERGE_HPP
+#define BOOST_COMPUTE_ALGORITHM_K_WAY_MERGE_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/k_way_merge_with_partition.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Merges the sorted runs of \p input_first into a single sorted range
+/// beginning at \p result and returns an iterator to the end of the result.
+///
+/// The runs are delimited by the offsets in the range [\p offsets_first,
+/// \p offsets_last): run \c i spans the values from
+/// <tt>input_first + offsets[i]</tt> to <tt>input_first + offsets[i + 1]</tt>.
+/// The offsets must be non-decreasing and there is one more offset than
+/// there are runs. The merge is stable, values which compare equal are
+/// ordered by run and then by their position in the run.
+///
+/// Unlike repeated calls to merge(), which need log2(k) passes over the data
+/// for k runs, all of the runs are merged at once. The output is split into
+/// tiles whose boundaries are located in every run with a multi-sequence
+/// partition and then each tile is merged independently.
+///
+/// \param offsets_first first offset of the runs (\c uint_ values)
+/// \param offsets_last end of the offsets
+/// \param input_first start of the range containing the runs
+/// \param result start of the merged range
+/// \param comp comparison function (by default \c less)
+/// \param queue command queue to perform the operation
+///
+/// For example, to merge three runs of a vector:
+///
+/// \code
+/// // values = { 1, 4, 9, 2, 3, 8, 5, 6, 7 }
+/// // offsets = { 0, 3, 6, 9 }
+/// boost::compute::k_way_merge(
+///     offsets.begin(), offsets.end(), values.begin(), result.begin(), queue
+/// );
+/// // result = { 1, 2, 3, 4, 5, 6, 7, 8, 9 }
+/// \endcode
+///
+/// Space complexity: \Omega(k * n / t) where t is the tile size
+///
+/// \see merge()
+template<class OffsetIterator, class InputIterator,
+         class OutputIterator, class Compare>
+inline OutputIterator k_way_merge(OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  InputIterator input_first,
+                                  OutputIterator result,
+                                  Compare comp,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<OffsetIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type result_difference_type;
+
+    const size_t offsets_count = detail::iterator_range_size(offsets_first, offsets_last);
+    if(offsets_count < 2){
+        return result;
+    }
+    const size_t runs = offsets_count - 1;
+
+    // read the bounds of the input
+    std::vector<uint_> offsets(offsets_count);
+    ::boost::compute::copy(offsets_first, offsets_last, offsets.begin(), queue);
+    const size_t total = offsets[runs] - offsets[0];
+
+    if(runs == 1 || total == 0){
+        return ::boost::compute::copy(
+            input_first + offsets[0], input_first + offsets[runs], result, queue
+        );
+    }
+
+    detail::k_way_merge_with_partition(
+        offsets_first, runs, total, input_first, result, comp, queue
+    );
+
+    return result + static_cast<result_difference_type>(total);
+}
+
+/// \overload
+template<class OffsetIterator, class InputIterator, class OutputIterator>
+inline OutputIterator k_way_merge(OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  InputIterator input_first,
+                                  OutputIterator result,
+                                  command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    return ::boost::compute::k_way_merge(
+        offsets_first, offsets_last, input_first, result,
+        less<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_K_WAY_MERGE_HPP
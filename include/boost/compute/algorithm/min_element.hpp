@@ -15,6 +15,7 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/algorithm/detail/find_extrema.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
@@ -46,6 +47,9 @@ namespace compute {
 ///     boost::compute::min_element(data.begin(), data.end(), compare_first, queue);
 /// \endcode
 ///
+/// Inputs smaller than an opt-in per-device threshold are searched on the
+/// host instead (see host_dispatch).
+///
 /// Space complexity on CPUs: \Omega(1)<br>
 /// Space complexity on GPUs: \Omega(N)
 ///
@@ -76,6 +80,42 @@ min_element(InputIterator first,
     );
 }
 
+/// Asynchronous version of min_element(). Enqueues the search and returns a future
+/// for an iterator pointing to the first element in the range
+/// [\p first, \p last) with the minimum value.
+///
+/// The minimum value is found with reduce() followed by a search for its
+/// first occurrence, neither of which blocks the calling thread.
+///
+/// Space complexity: \Omega(N)
+///
+/// \see min_element(), max_element_async()
+template<class InputIterator, class Compare>
+inline future<InputIterator>
+min_element_async(InputIterator first,
+                  InputIterator last,
+                  Compare compare,
+                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    return detail::find_extrema_async(first, last, compare, true, queue);
+}
+
+///\overload
+template<class InputIterator>
+inline future<InputIterator>
+min_element_async(InputIterator first,
+                  InputIterator last,
+                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    return ::boost::compute::min_element_async(
+        first, last, ::boost::compute::less<value_type>(), queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -14,6 +14,7 @@
 #include <boost/static_assert.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
@@ -36,6 +37,23 @@ inline bool none_of(InputIterator first,
     return ::boost::compute::find_if(first, last, predicate, queue) == last;
 }
 
+/// Asynchronous version of none_of(). Returns a future which is \c true if
+/// \p predicate returns \c true for none of the elements in the range
+/// [\p first, \p last).
+///
+/// Space complexity: \Omega(1)
+///
+/// \see none_of()
+template<class InputIterator, class UnaryPredicate>
+inline future<bool> none_of_async(InputIterator first,
+                                  InputIterator last,
+                                  UnaryPredicate predicate,
+                                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    return detail::find_if_test_async(first, last, predicate, false, queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_PERMUTE_AXES_HPP
+#define BOOST_COMPUTE_ALGORITHM_PERMUTE_AXES_HPP
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/transpose.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/utility/extents.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Copies the N-dimensional array stored in row-major order (i.e. with the
+/// last axis varying fastest) in the range beginning at \p first to the
+/// range beginning at \p result with its axes reordered. Axis \c i of the
+/// result is axis \c axes[i] of the input, which has \c shape[i] values
+/// along axis \c i.
+///
+/// Axes of extent one are ignored and axes which stay adjacent and in the
+/// same order are merged. Permutations which are then a transpose of the
+/// two remaining axes, or of the two last axes, are done with the tiled
+/// kernel of batched_transpose(). Other permutations gather each value of
+/// the result from the input.
+///
+/// The input and result ranges must not overlap and \p axes must be a
+/// permutation of <tt>[0, N)</tt>.
+///
+/// \param first first element in the input range
+/// \param result first element in the result range
+/// \param shape extents of the input array
+/// \param axes the input axis for each axis of the result
+/// \param queue command queue to perform the operation
+///
+/// For example, to convert images from NHWC to NCHW layout:
+///
+/// \snippet test/test_transpose.cpp permute_axes_nhwc
+///
+/// Space complexity: \Omega(1)
+///
+/// \see transpose(), batched_transpose(), extents
+template<class InputIterator, class OutputIterator, size_t N>
+inline void permute_axes(InputIterator first,
+                         OutputIterator result,
+                         const extents<N> &shape,
+                         const extents<N> &axes,
+                         command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    #ifndef NDEBUG
+    extents<N> sorted_axes = axes;
+    std::sort(sorted_axes.begin(), sorted_axes.end());
+    for(size_t i = 0; i < N; i++){
+        BOOST_ASSERT(sorted_axes[i] == i);
+    }
+    #endif
+
+    detail::permute_axes(first, result, shape.data(), axes.data(), N, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_PERMUTE_AXES_HPP
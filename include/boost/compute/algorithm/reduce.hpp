@@ -14,18 +14,24 @@
 #include <iterator>
 
 #include <boost/static_assert.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/host_dispatch.hpp>
 #include <boost/compute/algorithm/detail/inplace_reduce.hpp>
 #include <boost/compute/algorithm/detail/reduce_on_gpu.hpp>
 #include <boost/compute/algorithm/detail/reduce_on_cpu.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
 #include <boost/compute/type_traits/result_of.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
@@ -131,7 +137,15 @@ inline vector<
             typename std::iterator_traits<InputIterator>::value_type,
             typename std::iterator_traits<InputIterator>::value_type
         )
-    >::type
+    >::type,
+    scratch_allocator<
+        typename boost::compute::result_of<
+            BinaryFunction(
+                typename std::iterator_traits<InputIterator>::value_type,
+                typename std::iterator_traits<InputIterator>::value_type
+            )
+        >::type
+    >
 >
 block_reduce(InputIterator first,
              size_t count,
@@ -149,7 +163,8 @@ block_reduce(InputIterator first,
     const context &context = queue.get_context();
     size_t total_block_count =
         static_cast<size_t>(std::ceil(float(count) / 2.f / float(block_size)));
-    vector<result_type> result_vector(total_block_count, context);
+    vector<result_type, scratch_allocator<result_type> >
+        result_vector(total_block_count, context);
 
     reduce(first, count, result_vector.begin(), block_size, function, queue);
 
@@ -185,7 +200,8 @@ inline void generic_reduce(InputIterator first,
         size_t block_size = 256;
 
         // first pass
-        vector<result_type> results = detail::block_reduce(first,
+        vector<result_type, scratch_allocator<result_type> > results =
+            detail::block_reduce(first,
                                                            count,
                                                            block_size,
                                                            function,
@@ -235,6 +251,20 @@ inline void dispatch_reduce(InputIterator first,
     generic_reduce(first, last, result, function, queue);
 }
 
+// the future type returned by reduce_async(), the function type is checked
+// first so that reduce_async(first, last, queue) does not try to invoke the
+// command queue as a function
+template<class InputIterator, class BinaryFunction>
+struct reduce_async_result
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type input_type;
+    typedef future<
+        typename boost::compute::result_of<
+            BinaryFunction(input_type, input_type)
+        >::type
+    > type;
+};
+
 } // end detail namespace
 
 /// Returns the result of applying \p function to the elements in the
@@ -268,6 +298,9 @@ inline void dispatch_reduce(InputIterator first,
 /// efficient on parallel hardware. For more information, see the documentation
 /// on the \c accumulate() algorithm.
 ///
+/// Inputs smaller than an opt-in per-device threshold are reduced on the
+/// host instead (see host_dispatch).
+///
 /// Space complexity on GPUs: \Omega(n)<br>
 /// Space complexity on CPUs: \Omega(1)
 ///
@@ -284,6 +317,11 @@ inline void reduce(InputIterator first,
         return;
     }
 
+    if(detail::use_host_path("reduce", first, last, function, queue)){
+        detail::host_reduce(first, last, result, function, queue);
+        return;
+    }
+
     detail::dispatch_reduce(first, last, result, function, queue);
 }
 
@@ -301,9 +339,75 @@ inline void reduce(InputIterator first,
         return;
     }
 
+    if(detail::use_host_path("reduce", first, last, plus<T>(), queue)){
+        detail::host_reduce(first, last, result, plus<T>(), queue);
+        return;
+    }
+
     detail::dispatch_reduce(first, last, result, plus<T>(), queue);
 }
 
+/// Asynchronous version of reduce(). Enqueues the reduction and a
+/// non-blocking read of its result and returns a future for the result
+/// without waiting for the device. If the range is empty the future holds a
+/// default constructed value.
+///
+/// For example, to issue several reductions and only wait for their results
+/// afterwards:
+///
+/// \code
+/// future<int> sum = reduce_async(a.begin(), a.end(), plus<int>(), queue);
+/// future<int> max = reduce_async(b.begin(), b.end(), max<int>(), queue);
+/// int result = sum.get() + max.get();
+/// \endcode
+///
+/// Space complexity on GPUs: \Omega(n)<br>
+/// Space complexity on CPUs: \Omega(1)
+///
+/// \see reduce()
+template<class InputIterator, class BinaryFunction>
+inline typename boost::lazy_disable_if<
+    boost::is_same<BinaryFunction, command_queue>,
+    detail::reduce_async_result<InputIterator, BinaryFunction>
+>::type
+reduce_async(InputIterator first,
+             InputIterator last,
+             BinaryFunction function,
+             command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type input_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(input_type, input_type)>::type
+        result_type;
+
+    if(first == last){
+        return future<result_type>(result_type(), queue.enqueue_marker());
+    }
+
+    // reduce to a temporary buffer on the device, it is kept alive by the
+    // device until the read is complete
+    array<result_type, 1> value(queue.get_context());
+    detail::dispatch_reduce(first, last, value.begin(), function, queue);
+
+    return detail::read_single_value_async<result_type>(
+        value.get_buffer(), 0, queue
+    );
+}
+
+/// \overload
+template<class InputIterator>
+inline future<typename std::iterator_traits<InputIterator>::value_type>
+reduce_async(InputIterator first,
+             InputIterator last,
+             command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::reduce_async(first, last, plus<T>(), queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
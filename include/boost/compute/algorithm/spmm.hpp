@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SPMM_HPP
+#define BOOST_COMPUTE_ALGORITHM_SPMM_HPP
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes each value of y with one work-item. the work-items for the
+// columns of a row are adjacent, so they read the same entries of a and
+// adjacent values of x.
+template<class T, class InputIterator, class OutputIterator>
+inline void spmm(const csr_matrix<T> &a,
+                 InputIterator x,
+                 size_t n,
+                 OutputIterator y,
+                 command_queue &queue)
+{
+    meta_kernel k("spmm");
+    k.add_set_arg<const uint_>("n", static_cast<uint_>(n));
+
+    k << "const uint col = get_global_id(0);\n"
+      << "const uint row = get_global_id(1);\n"
+      << "const uint end = "
+      <<     a.row_offsets().begin()[k.expr<uint_>("row + 1")] << ";\n"
+      << k.decl<T>("acc") << " = 0;\n"
+      << "for(uint j = " << a.row_offsets().begin()[k.var<uint_>("row")]
+      <<     "; j < end; j++){\n"
+      << "    const uint c = "
+      <<          a.column_indices().begin()[k.var<uint_>("j")] << ";\n"
+      << "    acc += " << a.values().begin()[k.var<uint_>("j")] << " * "
+      <<          x[k.expr<uint_>("c * n + col")] << ";\n"
+      << "}\n"
+      << y[k.expr<uint_>("row * n + col")] << " = acc;\n";
+
+    kernel kernel = k.compile(queue.get_context());
+
+    const size_t global_work_size[] = { n, a.rows() };
+    queue.enqueue_nd_range_kernel(kernel, 2, 0, global_work_size, 0);
+}
+
+} // end detail namespace
+
+/// Computes the product <tt>Y = A * X</tt> of the sparse matrix \p a and
+/// the dense <tt>a.cols()</tt> x \p n matrix \c X stored in row-major order
+/// in the range beginning at \p x. The dense <tt>a.rows()</tt> x \p n
+/// result \c Y is stored in row-major order in the range beginning at
+/// \p y, which does not need to be initialized.
+///
+/// Each value of the result is computed by one work-item, so multiplying
+/// with \p n vectors at once reads the entries of the sparse matrix once
+/// for all of them instead of once for each vector with spmv().
+///
+/// \param a the sparse matrix
+/// \param x first element of the dense input matrix
+/// \param n number of columns in the dense matrices
+/// \param y first element of the dense result matrix
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(1)
+///
+/// \see csr_matrix, spmv()
+template<class T, class InputIterator, class OutputIterator>
+inline void spmm(const csr_matrix<T> &a,
+                 InputIterator x,
+                 size_t n,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    if(a.rows() == 0 || n == 0){
+        return;
+    }
+
+    detail::spmm(a, x, n, y, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SPMM_HPP
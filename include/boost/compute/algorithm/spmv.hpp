@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SPMV_HPP
+#define BOOST_COMPUTE_ALGORITHM_SPMV_HPP
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/spmv.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Computes the sparse matrix-vector product <tt>y = A * x</tt>, where
+/// \c A is the sparse matrix \p a, \c x is the vector of <tt>a.cols()</tt>
+/// values beginning at \p x and \c y is the vector of <tt>a.rows()</tt>
+/// values beginning at \p y. \c y does not need to be initialized.
+///
+/// The kernel is chosen from the device and the shape of the matrix. On
+/// CPUs each row is computed by a single work-item. On other devices
+/// matrices with at least 32 entries per row on average are computed with
+/// a group of work-items for each row. Other matrices are split into equal
+/// amounts of rows and entries for each work-item with the merge path, so
+/// that rows with very different lengths do not stall the device.
+///
+/// \param a the sparse matrix
+/// \param x first element of the input vector
+/// \param y first element of the result vector
+/// \param queue command queue to perform the operation
+///
+/// For example, to multiply a small sparse matrix with a vector:
+///
+/// \snippet test/test_spmv.cpp spmv
+///
+/// The number of work-items for each row can be tuned with the
+/// \c "vector_size" parameter of \c "__boost_spmv_vector_<type>" and the
+/// number of rows and entries for each work-item with the \c "tile"
+/// parameter of \c "__boost_spmv_merge_path_<type>" in the parameter cache.
+///
+/// Space complexity: \Omega(1) for the row kernels, \Omega(n / tile) for
+/// the merge path kernel
+///
+/// \see csr_matrix, spmm()
+template<class T, class InputIterator, class OutputIterator>
+inline void spmv(const csr_matrix<T> &a,
+                 InputIterator x,
+                 OutputIterator y,
+                 command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    if(a.rows() == 0){
+        return;
+    }
+
+    detail::spmv(a, x, y, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SPMV_HPP
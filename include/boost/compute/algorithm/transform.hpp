@@ -11,18 +11,124 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_TRANSFORM_HPP
 #define BOOST_COMPUTE_ALGORITHM_TRANSFORM_HPP
 
+#include <iterator>
+
 #include <boost/static_assert.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/transform_with_registered_kernel.hpp>
+#include <boost/compute/algorithm/detail/vectorized_transform.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 #include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
+namespace detail {
+
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator dispatch_transform(InputIterator first,
+                                         InputIterator last,
+                                         OutputIterator result,
+                                         UnaryOperator op,
+                                         command_queue &queue,
+                                         boost::false_type)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count != 0 && try_vectorized_transform(first, count, result, op, queue)){
+        return result + count;
+    }
+
+    return copy(
+               ::boost::compute::make_transform_iterator(first, op),
+               ::boost::compute::make_transform_iterator(last, op),
+               result,
+               queue
+           );
+}
+
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator dispatch_transform(InputIterator first,
+                                         InputIterator last,
+                                         OutputIterator result,
+                                         UnaryOperator op,
+                                         command_queue &queue,
+                                         boost::true_type)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+    if(prefer_vectorized_transform<OutputIterator>(count, queue) &&
+       try_vectorized_transform(first, count, result, op, queue)){
+        return result + count;
+    }
+    if(count != 0){
+        transform_with_registered_kernel(first, count, result, op, queue);
+    }
+
+    return result + count;
+}
+
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator dispatch_transform(InputIterator1 first1,
+                                         InputIterator1 last1,
+                                         InputIterator2 first2,
+                                         OutputIterator result,
+                                         BinaryOperator op,
+                                         command_queue &queue,
+                                         boost::false_type)
+{
+    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
+
+    difference_type n = std::distance(first1, last1);
+
+    const size_t count = static_cast<size_t>(n);
+    if(count != 0 &&
+       try_vectorized_transform(first1, count, first2, result, op, queue)){
+        return result + count;
+    }
+
+    return dispatch_transform(
+               ::boost::compute::make_zip_iterator(boost::make_tuple(first1, first2)),
+               ::boost::compute::make_zip_iterator(boost::make_tuple(last1, first2 + n)),
+               result,
+               detail::unpack(op),
+               queue,
+               boost::false_type()
+           );
+}
+
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator dispatch_transform(InputIterator1 first1,
+                                         InputIterator1 last1,
+                                         InputIterator2 first2,
+                                         OutputIterator result,
+                                         BinaryOperator op,
+                                         command_queue &queue,
+                                         boost::true_type)
+{
+    const size_t count = detail::iterator_range_size(first1, last1);
+    if(prefer_vectorized_transform<OutputIterator>(count, queue) &&
+       try_vectorized_transform(first1, count, first2, result, op, queue)){
+        return result + count;
+    }
+    if(count != 0){
+        transform_with_registered_kernel(first1, count, first2, result, op, queue);
+    }
+
+    return result + count;
+}
+
+} // end detail namespace
 
 /// Transforms the elements in the range [\p first, \p last) using
 /// operator \p op and stores the results in the range beginning at
@@ -32,6 +138,18 @@ namespace compute {
 ///
 /// \snippet test/test_transform.cpp transform_abs
 ///
+/// When the ranges are plain buffers and \p op is one of the built-in
+/// functions or operators the kernel is only generated once per context and
+/// repeated calls just bind its arguments, which makes calls on small ranges
+/// considerably cheaper.
+///
+/// When the ranges are buffers of built-in scalar types, the values are
+/// read and written with \c vloadN() and \c vstoreN(). The vector width
+/// defaults to the preferred vector width of the device and is stored in
+/// the parameter cache as \c "vw" of
+/// \c "__boost_vectorized_transform_<output type>" (a width of one
+/// disables vectorized access).
+///
 /// Space complexity: \Omega(1)
 ///
 /// \see copy()
@@ -44,11 +162,15 @@ inline OutputIterator transform(InputIterator first,
 {
     BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
     BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
-    return copy(
-               ::boost::compute::make_transform_iterator(first, op),
-               ::boost::compute::make_transform_iterator(last, op),
-               result,
-               queue
+    typedef boost::integral_constant<
+        bool,
+        detail::can_transform_with_registered_kernel<
+            InputIterator, OutputIterator, UnaryOperator
+        >::value
+    > use_registered_kernel;
+
+    return detail::dispatch_transform(
+               first, last, result, op, queue, use_registered_kernel()
            );
 }
 
@@ -67,17 +189,15 @@ inline OutputIterator transform(InputIterator1 first1,
     BOOST_STATIC_ASSERT(is_device_iterator<InputIterator1>::value);
     BOOST_STATIC_ASSERT(is_device_iterator<InputIterator2>::value);
     BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef boost::integral_constant<
+        bool,
+        detail::can_binary_transform_with_registered_kernel<
+            InputIterator1, InputIterator2, OutputIterator, BinaryOperator
+        >::value
+    > use_registered_kernel;
 
-    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
-
-    difference_type n = std::distance(first1, last1);
-
-    return transform(
-               ::boost::compute::make_zip_iterator(boost::make_tuple(first1, first2)),
-               ::boost::compute::make_zip_iterator(boost::make_tuple(last1, first2 + n)),
-               result,
-               detail::unpack(op),
-               queue
+    return detail::dispatch_transform(
+               first1, last1, first2, result, op, queue, use_registered_kernel()
            );
 }
 
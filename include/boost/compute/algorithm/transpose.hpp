@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_TRANSPOSE_HPP
+#define BOOST_COMPUTE_ALGORITHM_TRANSPOSE_HPP
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/transpose.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Transposes the \p rows x \p cols matrix stored in row-major order in the
+/// range beginning at \p first and stores the \p cols x \p rows result in
+/// the range beginning at \p result.
+///
+/// The matrix is transposed in tiles which are staged in local memory, so
+/// that both the reads from the input and the writes to the result are
+/// coalesced. This is much faster than copying through a strided_iterator.
+///
+/// The input and result ranges must not overlap.
+///
+/// \param first first element in the input range
+/// \param result first element in the result range
+/// \param rows number of rows in the input matrix
+/// \param cols number of columns in the input matrix
+/// \param queue command queue to perform the operation
+///
+/// For example, to convert a 3x4 matrix to column-major order:
+///
+/// \snippet test/test_transpose.cpp transpose_matrix
+///
+/// The size of the tiles can be tuned with the \c "tile" and
+/// \c "block_rows" parameters of \c "__boost_transpose_<type>" in the
+/// parameter cache.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see batched_transpose(), permute_axes()
+template<class InputIterator, class OutputIterator>
+inline void transpose(InputIterator first,
+                      OutputIterator result,
+                      size_t rows,
+                      size_t cols,
+                      command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    detail::tiled_transpose(first, result, 1, rows, cols, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_TRANSPOSE_HPP
@@ -16,6 +16,9 @@
 /// Meta-header to include all Boost.Compute allocator headers.
 
 #include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/allocator/host_mapped_allocator.hpp>
 #include <boost/compute/allocator/pinned_allocator.hpp>
+#include <boost/compute/allocator/scratch_allocator.hpp>
+#include <boost/compute/allocator/scratch_pool.hpp>
 
 #endif // BOOST_COMPUTE_ALLOCATOR_HPP
@@ -0,0 +1,193 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_HOST_MAPPED_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_HOST_MAPPED_ALLOCATOR_HPP
+
+#include <new>
+#include <cstdlib>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/detail/buffer_host_memory.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class host_mapped_allocator
+/// \brief An allocator for buffers which are stored in host memory.
+///
+/// On devices which share memory with the host (CPU devices and devices
+/// reporting \c CL_DEVICE_HOST_UNIFIED_MEMORY) the host_mapped_allocator
+/// allocates page-aligned host memory and creates the buffers with
+/// \c CL_MEM_USE_HOST_PTR, so that kernels operate directly on the host
+/// memory and mapping the buffer does not copy it. The host memory is
+/// released when the buffer is destroyed. On other devices the buffers are
+/// created with \c CL_MEM_ALLOC_HOST_PTR (as with pinned_allocator).
+///
+/// For example, to create a vector whose values can be read on the host
+/// without copying them:
+///
+/// \snippet test/test_host_mapped_allocator.cpp read_in_place
+///
+/// Copying between the host memory of such a buffer and the buffer itself
+/// (e.g. with copy()) only maps and unmaps the buffer.
+///
+/// Using \c CL_MEM_USE_HOST_PTR requires OpenCL 1.1 (to release the host
+/// memory once the buffer is destroyed).
+///
+/// \see mapped_span, pinned_allocator
+template<class T>
+class host_mapped_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::value_type value_type;
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::const_pointer const_pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+    typedef typename buffer_allocator<T>::difference_type difference_type;
+
+    /// Creates a host mapped allocator for \p context.
+    explicit host_mapped_allocator(const context &context)
+        : buffer_allocator<T>(context),
+          m_use_host_ptr(shares_host_memory(context))
+    {
+        buffer_allocator<T>::set_mem_flags(
+            buffer::read_write | buffer::alloc_host_ptr
+        );
+    }
+
+    host_mapped_allocator(const host_mapped_allocator<T> &other)
+        : buffer_allocator<T>(other),
+          m_use_host_ptr(other.m_use_host_ptr)
+    {
+    }
+
+    host_mapped_allocator<T>& operator=(const host_mapped_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+            m_use_host_ptr = other.m_use_host_ptr;
+        }
+
+        return *this;
+    }
+
+    ~host_mapped_allocator()
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        if(!m_use_host_ptr){
+            return buffer_allocator<T>::allocate(n);
+        }
+
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+        // CL_MEM_USE_HOST_PTR buffers are zero-copy for page-aligned
+        // memory whose size is a multiple of the page size
+        const size_t size =
+            ((std::max)(n * sizeof(T), size_t(1)) + page_size - 1) & ~(page_size - 1);
+        void *memory = allocate_host_memory(size);
+
+        buffer buf;
+        try {
+            buf = buffer(
+                buffer_allocator<T>::get_context(),
+                size,
+                buffer::read_write | buffer::use_host_ptr,
+                memory
+            );
+        }
+        catch(...){
+            free_host_memory(0, memory);
+            throw;
+        }
+        buf.set_destructor_callback(free_host_memory, memory);
+        detail::buffer_host_memory_registry::insert(buf, memory);
+
+        clRetainMemObject(buf.get());
+        return detail::device_ptr<T>(buf);
+    #else
+        return buffer_allocator<T>::allocate(n);
+    #endif // BOOST_COMPUTE_CL_VERSION_1_1
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if(m_use_host_ptr){
+            detail::buffer_host_memory_registry::erase(p.get_buffer());
+        }
+
+        buffer_allocator<T>::deallocate(p, n);
+    }
+
+    /// Returns \c true if the buffers are created with
+    /// \c CL_MEM_USE_HOST_PTR on memory shared with the device.
+    bool is_zero_copy() const
+    {
+        return m_use_host_ptr;
+    }
+
+private:
+    static const size_t page_size = 4096;
+
+    static bool shares_host_memory(const context &context)
+    {
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+        const device device = context.get_device();
+
+        return (device.type() & device::cpu) ||
+               device.get_info<CL_DEVICE_HOST_UNIFIED_MEMORY>();
+    #else
+        (void) context;
+
+        return false;
+    #endif
+    }
+
+    // allocates size bytes aligned to the page size. the pointer returned
+    // by malloc() is stored just before the aligned block.
+    static void* allocate_host_memory(size_t size)
+    {
+        void *block = std::malloc(size + page_size + sizeof(void *));
+        if(!block){
+            throw std::bad_alloc();
+        }
+
+        const boost::uintptr_t aligned =
+            (reinterpret_cast<boost::uintptr_t>(block) + sizeof(void *) + page_size - 1) &
+            ~static_cast<boost::uintptr_t>(page_size - 1);
+
+        void **memory = reinterpret_cast<void **>(aligned);
+        memory[-1] = block;
+
+        return memory;
+    }
+
+    static void BOOST_COMPUTE_CL_CALLBACK free_host_memory(cl_mem, void *memory)
+    {
+        std::free(static_cast<void **>(memory)[-1]);
+    }
+
+private:
+    bool m_use_host_ptr;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_HOST_MAPPED_ALLOCATOR_HPP
@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_SCRATCH_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_SCRATCH_ALLOCATOR_HPP
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/allocator/scratch_pool.hpp>
+#include <boost/compute/detail/device_ptr.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class scratch_allocator
+/// \brief Allocates temporary buffers from the active \ref scratch_pool
+///
+/// The scratch_allocator class is used by the algorithms for their
+/// temporary buffers. If a scratch_pool for the same context is active on
+/// the calling thread when the allocator is created, buffers are taken from
+/// and returned to that pool. Otherwise it behaves like buffer_allocator.
+///
+/// Buffers from the pool are rounded up to a power of two and are kept by
+/// the pool after they are deallocated, so the allocator should only be
+/// used for containers which are destroyed before the pool is released.
+///
+/// \see buffer_allocator, scratch_pool
+template<class T>
+class scratch_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+
+    explicit scratch_allocator(const context &context)
+        : buffer_allocator<T>(context),
+          m_pool(scratch_pool::active())
+    {
+        if(m_pool && m_pool->get_context() != context){
+            m_pool = 0;
+        }
+    }
+
+    scratch_allocator(const scratch_allocator<T> &other)
+        : buffer_allocator<T>(other),
+          m_pool(other.m_pool)
+    {
+    }
+
+    scratch_allocator<T>& operator=(const scratch_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+            m_pool = other.m_pool;
+        }
+
+        return *this;
+    }
+
+    ~scratch_allocator()
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        if(!m_pool){
+            return buffer_allocator<T>::allocate(n);
+        }
+
+        buffer buf = m_pool->allocate(n * sizeof(T));
+        clRetainMemObject(buf.get());
+        return detail::device_ptr<T>(buf);
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if(!m_pool){
+            buffer_allocator<T>::deallocate(p, n);
+            return;
+        }
+
+        m_pool->deallocate(p.get_buffer());
+        clReleaseMemObject(p.get_buffer().get());
+    }
+
+    /// Returns the pool the buffers are taken from, or \c 0 if they are
+    /// allocated as usual.
+    scratch_pool* get_pool() const
+    {
+        return m_pool;
+    }
+
+private:
+    scratch_pool *m_pool;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_SCRATCH_ALLOCATOR_HPP
@@ -0,0 +1,263 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_SCRATCH_POOL_HPP
+#define BOOST_COMPUTE_ALLOCATOR_SCRATCH_POOL_HPP
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/config.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class scratch_pool
+/// \brief A pool of reusable buffers for temporary memory.
+///
+/// Many algorithms allocate temporary buffers (e.g. for the partial results
+/// of a reduction) with \ref scratch_allocator and release them before
+/// returning. While a scratch_pool is active on the calling thread (see
+/// scoped_activation and execution_policy), these buffers are instead taken
+/// from and returned to the pool so that repeated calls do not allocate
+/// new device memory. Containers using the default \ref buffer_allocator
+/// never use the pool.
+///
+/// Buffer sizes are rounded up to the next power of two and a buffer is
+/// only reused for requests of the same rounded size. A buffer returned to
+/// the pool may still be used by pending commands, so it is only handed out
+/// again after the event passed to the following call to release() is
+/// complete. An execution_policy scope calls release() with the event of
+/// its final marker. Buffers stay in the pool after they are released, so
+/// the pool holds the largest amount of memory used at once until clear()
+/// is called.
+///
+/// \see scratch_allocator, execution_policy
+class scratch_pool : boost::noncopyable
+{
+public:
+    /// \class scoped_activation
+    /// \brief Activates a scratch_pool on the calling thread until it is
+    ///        destroyed.
+    class scoped_activation : boost::noncopyable
+    {
+    public:
+        /// Activates \p pool. If \p pool is null, no pool is active within
+        /// the scope.
+        explicit scoped_activation(scratch_pool *pool)
+            : m_previous(scratch_pool::active())
+        {
+            scratch_pool::active_ref() = pool;
+        }
+
+        /// Restores the previously active pool.
+        ~scoped_activation()
+        {
+            scratch_pool::active_ref() = m_previous;
+        }
+
+    private:
+        scratch_pool *m_previous;
+    };
+
+    /// Creates a new, empty scratch pool for \p context.
+    explicit scratch_pool(const context &context)
+        : m_context(context)
+    {
+    }
+
+    /// Destroys the scratch pool and releases its buffers. Buffers which
+    /// are still in use remain valid until they are released.
+    ~scratch_pool()
+    {
+    }
+
+    /// Returns a buffer of at least \p size bytes from the pool. The
+    /// buffer is created if no released buffer of the same rounded size is
+    /// available.
+    buffer allocate(size_t size)
+    {
+        size = rounded_size(size);
+
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        for(size_t i = 0; i < m_entries.size(); i++){
+            entry &e = m_entries[i];
+            if(e.size == size && is_free(e)){
+                e.state = in_use;
+                e.ready = event();
+                return e.buf;
+            }
+        }
+
+        entry e;
+        e.buf = buffer(m_context, size, buffer::read_write);
+        e.size = size;
+        e.state = in_use;
+        m_entries.push_back(e);
+
+        return e.buf;
+    }
+
+    /// Returns \p buf to the pool. The buffer is not reused until the
+    /// commands using it are known to be complete (see release()). Returns
+    /// \c false if \p buf was not allocated from the pool.
+    bool deallocate(const buffer &buf)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        for(size_t i = 0; i < m_entries.size(); i++){
+            entry &e = m_entries[i];
+            if(e.buf.get() == buf.get()){
+                e.state = returned;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// Allows the buffers returned to the pool since the last call to be
+    /// reused once \p event is complete. The event must follow all commands
+    /// using these buffers (e.g. a marker enqueued after them). If
+    /// \p event is null, the buffers can be reused immediately.
+    void release(const event &event = ::boost::compute::event())
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        for(size_t i = 0; i < m_entries.size(); i++){
+            entry &e = m_entries[i];
+            if(e.state == returned){
+                e.state = released;
+                e.ready = event;
+            }
+        }
+    }
+
+    /// Destroys the released buffers held by the pool whose commands are
+    /// complete.
+    void clear()
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        std::vector<entry> in_use;
+        for(size_t i = 0; i < m_entries.size(); i++){
+            if(!is_free(m_entries[i])){
+                in_use.push_back(m_entries[i]);
+            }
+        }
+        m_entries.swap(in_use);
+    }
+
+    /// Returns the number of buffers held by the pool.
+    size_t size() const
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        return m_entries.size();
+    }
+
+    /// Returns the total size in bytes of the buffers held by the pool.
+    size_t memory_size() const
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        size_t total = 0;
+        for(size_t i = 0; i < m_entries.size(); i++){
+            total += m_entries[i].size;
+        }
+        return total;
+    }
+
+    /// Returns the context for the pool.
+    const context& get_context() const
+    {
+        return m_context;
+    }
+
+    /// Returns the scratch pool active on the calling thread or \c 0 if no
+    /// pool is active.
+    static scratch_pool* active()
+    {
+        return active_ref();
+    }
+
+private:
+    enum entry_state
+    {
+        in_use,
+        returned,
+        released
+    };
+
+    struct entry
+    {
+        buffer buf;
+        size_t size;
+        entry_state state;
+        event ready;
+    };
+
+    // returns true if the buffer was released and the commands using it
+    // are complete
+    static bool is_free(entry &e)
+    {
+        if(e.state != released){
+            return false;
+        }
+        if(e.ready.get() && e.ready.status() > CL_COMPLETE){
+            return false;
+        }
+
+        e.ready = event();
+        return true;
+    }
+
+    static size_t rounded_size(size_t size)
+    {
+        size_t rounded = 256;
+        while(rounded < size){
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    static scratch_pool*& active_ref()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(scratch_pool *, pool, (0));
+
+        return pool;
+    }
+
+private:
+    context m_context;
+    std::vector<entry> m_entries;
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+    mutable detail::mutex m_mutex;
+#endif
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_SCRATCH_POOL_HPP
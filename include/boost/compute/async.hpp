@@ -15,7 +15,9 @@
 ///
 /// Meta-header to include all Boost.Compute async headers.
 
+#include <boost/compute/async/execution_policy.hpp>
 #include <boost/compute/async/future.hpp>
+#include <boost/compute/async/queue_pool.hpp>
 #include <boost/compute/async/wait_guard.hpp>
 
 #endif // BOOST_COMPUTE_ASYNC_HPP
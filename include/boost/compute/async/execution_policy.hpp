@@ -0,0 +1,327 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_EXECUTION_POLICY_HPP
+#define BOOST_COMPUTE_ASYNC_EXECUTION_POLICY_HPP
+
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/allocator/scratch_pool.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class execution_policy
+/// \brief Controls how the algorithms called within a scope are executed.
+///
+/// An execution_policy bundles the command queue for a sequence of
+/// algorithm calls with:
+///
+/// - the events the sequence depends on (depends_on()),
+/// - whether to wait for the sequence to complete (set_async()),
+/// - a \ref scratch_pool for the temporary buffers of the algorithms
+///   called within the sequence (set_scratch_pool()),
+/// - tuning parameters which override those in the parameter cache
+///   (set_parameter()).
+///
+/// The dependencies and the final marker are enqueued to the policy's
+/// queue. The scratch pool and the parameter overrides are per thread:
+/// while a policy scope is alive they apply to the algorithms called on
+/// the calling thread, whatever queue they use. This avoids adding an
+/// extra overload to each algorithm. Only the temporary buffers which the
+/// algorithms allocate with \ref scratch_allocator come from the pool;
+/// containers created by the caller within the scope are allocated as
+/// usual. The buffers returned to the pool within a scope are only reused
+/// once the scope's final marker is complete. The easiest way to create a
+/// scope is execute():
+///
+/// \code
+/// boost::compute::execution_policy policy(queue);
+/// policy.depends_on(upload_event).set_async();
+///
+/// boost::compute::event done = policy.execute(
+///     [&](boost::compute::command_queue &queue){
+///         boost::compute::sort(vec.begin(), vec.end(), queue);
+///         boost::compute::inclusive_scan(vec.begin(), vec.end(), vec.begin(), queue);
+///     }
+/// );
+/// \endcode
+///
+/// When entering a scope, the dependencies are enqueued as a barrier (or,
+/// for devices without OpenCL 1.2, waited for on the host) and then
+/// cleared. When leaving a scope, a marker is enqueued and its event is
+/// stored as the policy's event (see get_event()). Unless the policy is
+/// asynchronous, the scope then waits for the marker. This allows
+/// sequences on different queues to be chained through events without
+/// synchronizing with the host:
+///
+/// \code
+/// other_policy.depends_on(policy.get_event());
+/// \endcode
+///
+/// Within an asynchronous scope small inputs are not processed on the host
+/// (see \ref host_dispatch) since that requires waiting for the queue.
+/// Algorithms returning a value to the host (e.g. reduce() into a host
+/// iterator) still block until their result is available.
+///
+/// \see scratch_pool, wait_list
+class execution_policy
+{
+public:
+    /// \class scope
+    /// \brief Activates an execution_policy on the calling thread until it
+    ///        is destroyed.
+    class scope : boost::noncopyable
+    {
+    public:
+        /// Enqueues the dependencies of \p policy and activates its scratch
+        /// pool and tuning parameters.
+        explicit scope(execution_policy &policy)
+            : m_policy(policy),
+              m_previous_overrides(detail::parameter_cache::active_overrides()),
+              m_pool(policy.m_scratch_pool ? policy.m_scratch_pool.get()
+                                           : scratch_pool::active()),
+              m_mode(policy.m_async ? host_dispatch::force_device : host_dispatch::mode()),
+              m_finished(false)
+        {
+            policy.enqueue_dependencies();
+
+            if(!policy.m_parameters.empty()){
+                detail::parameter_cache::active_overrides() = &policy.m_parameters;
+            }
+        }
+
+        /// Enqueues a marker for the commands enqueued within the scope,
+        /// stores its event in the policy and waits for it unless the
+        /// policy is asynchronous. Then restores the previous state.
+        ///
+        /// Errors are not reported from the destructor. Call finish() at
+        /// the end of the scope to have them thrown.
+        ~scope()
+        {
+            try {
+                finish();
+            }
+            catch(...){
+            }
+        }
+
+        /// Enqueues the final marker and, unless the policy is asynchronous,
+        /// waits for it. Throws if the marker can not be enqueued or if the
+        /// commands fail. Further calls have no effect.
+        void finish()
+        {
+            if(m_finished){
+                return;
+            }
+            m_finished = true;
+
+            detail::parameter_cache::active_overrides() = m_previous_overrides;
+
+            m_policy.m_event = m_policy.m_queue.enqueue_marker();
+
+            // the pool's buffers returned within the scope can be reused
+            // once the commands using them are complete
+            scratch_pool *pool = scratch_pool::active();
+            if(pool){
+                pool->release(m_policy.m_event);
+            }
+
+            if(!m_policy.m_async){
+                m_policy.m_event.wait();
+            }
+        }
+
+    private:
+        execution_policy &m_policy;
+        const detail::parameter_cache::parameter_map *m_previous_overrides;
+        scratch_pool::scoped_activation m_pool;
+        host_dispatch::scoped_mode m_mode;
+        bool m_finished;
+    };
+
+    /// Creates a new execution policy for \p queue.
+    explicit execution_policy(command_queue &queue = system::default_queue())
+        : m_queue(queue),
+          m_async(false)
+    {
+    }
+
+    /// Creates a new execution policy object as a copy of \p other.
+    execution_policy(const execution_policy &other)
+        : m_queue(other.m_queue),
+          m_dependencies(other.m_dependencies),
+          m_async(other.m_async),
+          m_scratch_pool(other.m_scratch_pool),
+          m_parameters(other.m_parameters),
+          m_event(other.m_event)
+    {
+    }
+
+    /// Copies the execution policy object from \p other to \c *this.
+    execution_policy& operator=(const execution_policy &other)
+    {
+        if(this != &other){
+            m_queue = other.m_queue;
+            m_dependencies = other.m_dependencies;
+            m_async = other.m_async;
+            m_scratch_pool = other.m_scratch_pool;
+            m_parameters = other.m_parameters;
+            m_event = other.m_event;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the execution policy object.
+    ~execution_policy()
+    {
+    }
+
+    /// Returns the command queue for the policy.
+    command_queue& get_queue()
+    {
+        return m_queue;
+    }
+
+    /// Adds \p event to the events the next scope depends on.
+    execution_policy& depends_on(const event &event)
+    {
+        if(event.get()){
+            m_dependencies.insert(event);
+        }
+
+        return *this;
+    }
+
+    /// Adds \p events to the events the next scope depends on.
+    execution_policy& depends_on(const wait_list &events)
+    {
+        for(size_t i = 0; i < events.size(); i++){
+            depends_on(events[i]);
+        }
+
+        return *this;
+    }
+
+    /// Returns the events the next scope depends on.
+    const wait_list& get_dependencies() const
+    {
+        return m_dependencies;
+    }
+
+    /// Sets whether scopes return without waiting for their commands to
+    /// complete. Policies are synchronous by default.
+    execution_policy& set_async(bool async = true)
+    {
+        m_async = async;
+
+        return *this;
+    }
+
+    /// Returns \c true if the policy is asynchronous.
+    bool is_async() const
+    {
+        return m_async;
+    }
+
+    /// Sets the scratch pool for the temporary buffers of the algorithms
+    /// called within scopes on the calling thread. The pool must be for the context of the policy's
+    /// queue. If \p pool is null, buffers are allocated as usual.
+    execution_policy& set_scratch_pool(const boost::shared_ptr<scratch_pool> &pool)
+    {
+        BOOST_ASSERT(!pool || pool->get_context() == m_queue.get_context());
+
+        m_scratch_pool = pool;
+
+        return *this;
+    }
+
+    /// Returns the scratch pool for the policy.
+    boost::shared_ptr<scratch_pool> get_scratch_pool() const
+    {
+        return m_scratch_pool;
+    }
+
+    /// Sets the tuning parameter \p parameter of \p object (e.g.
+    /// \c "wgs" of \c "__boost_reduce_cpu_int") to \p value within scopes,
+    /// overriding the value in the parameter cache for all devices used on
+    /// the calling thread.
+    execution_policy& set_parameter(const std::string &object,
+                                    const std::string &parameter,
+                                    uint_ value)
+    {
+        m_parameters[std::make_pair(object, parameter)] = value;
+
+        return *this;
+    }
+
+    /// Returns the event for the marker enqueued at the end of the last
+    /// scope, or a null event if no scope has ended yet.
+    event get_event() const
+    {
+        return m_event;
+    }
+
+    /// Calls \p function with the policy's queue within a scope and returns
+    /// the event for the end of the scope.
+    template<class Function>
+    event execute(Function function)
+    {
+        {
+            scope scope(*this);
+            function(m_queue);
+            scope.finish();
+        }
+
+        return m_event;
+    }
+
+private:
+    void enqueue_dependencies()
+    {
+        if(m_dependencies.empty()){
+            return;
+        }
+
+        #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+        if(m_queue.check_device_version(1, 2)){
+            m_queue.enqueue_barrier(m_dependencies);
+        } else
+        #endif // BOOST_COMPUTE_CL_VERSION_1_2
+        {
+            m_dependencies.wait();
+        }
+
+        m_dependencies.clear();
+    }
+
+private:
+    command_queue m_queue;
+    wait_list m_dependencies;
+    bool m_async;
+    boost::shared_ptr<scratch_pool> m_scratch_pool;
+    detail::parameter_cache::parameter_map m_parameters;
+    event m_event;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_EXECUTION_POLICY_HPP
@@ -11,6 +11,8 @@
 #ifndef BOOST_COMPUTE_ASYNC_FUTURE_HPP
 #define BOOST_COMPUTE_ASYNC_FUTURE_HPP
 
+#include <boost/function.hpp>
+
 #include <boost/compute/event.hpp>
 
 namespace boost {
@@ -35,9 +37,22 @@ public:
     {
     }
 
+    /// \internal_
+    ///
+    /// Creates a future whose result is not known until \p event is
+    /// complete (e.g. a non-blocking read of the result). Once the event is
+    /// complete the result is obtained by calling \p deferred.
+    future(const event &event, const boost::function<T ()> &deferred)
+        : m_result(),
+          m_event(event),
+          m_deferred(deferred)
+    {
+    }
+
     future(const future<T> &other)
         : m_result(other.m_result),
-          m_event(other.m_event)
+          m_event(other.m_event),
+          m_deferred(other.m_deferred)
     {
     }
 
@@ -46,6 +61,7 @@ public:
         if(this != &other){
             m_result = other.m_result;
             m_event = other.m_event;
+            m_deferred = other.m_deferred;
         }
 
         return *this;
@@ -61,6 +77,11 @@ public:
     {
         wait();
 
+        if(m_deferred){
+            m_result = m_deferred();
+            m_deferred.clear();
+        }
+
         return m_result;
     }
 
@@ -100,6 +121,7 @@ public:
 private:
     T m_result;
     event m_event;
+    boost::function<T ()> m_deferred;
 };
 
 /// \internal_
@@ -0,0 +1,352 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_QUEUE_POOL_HPP
+#define BOOST_COMPUTE_ASYNC_QUEUE_POOL_HPP
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+#if defined(BOOST_COMPUTE_THREAD_SAFE) && \
+    (defined(BOOST_COMPUTE_CL_VERSION_1_1) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED))
+
+#include <deque>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/throw_exception.hpp>
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+#  include <thread>
+#else
+#  include <boost/thread/thread.hpp>
+#endif
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/command_queue.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class queue_pool
+/// \brief Runs jobs on a pool of command queues.
+///
+/// All algorithms called with the default queue are serialized on the one
+/// queue returned by system::default_queue(). A queue_pool instead owns
+/// several command queues (e.g. one for each sub-device of a CPU) and a
+/// worker thread for each of them. Jobs submitted to the pool are
+/// functions which enqueue commands to the queue they are called with:
+///
+/// \snippet test/test_queue_pool.cpp submit_jobs
+///
+/// Each job is assigned to the queue with the fewest pending and running
+/// jobs. A worker without pending jobs steals the most recently submitted
+/// job of the queue with the most pending jobs. Since a job may run on any
+/// of the queues, all of them must belong to the same context, where the
+/// memory objects used by the jobs are valid. Jobs are run on the worker
+/// threads, so they
+/// may block (e.g. when reading a result to the host) without delaying the
+/// jobs on the other queues.
+///
+/// submit() returns a user event which is completed once all commands
+/// enqueued by the job are complete, or set to an error status if the job
+/// throws an exception.
+///
+/// The queue_pool class requires \c BOOST_COMPUTE_THREAD_SAFE and OpenCL
+/// 1.1.
+///
+/// \see command_queue, execution_policy
+class queue_pool : boost::noncopyable
+{
+public:
+    typedef boost::function<void (command_queue &)> job_type;
+
+    /// Creates a queue pool for \p queues.
+    ///
+    /// Throws \c std::invalid_argument if \p queues is empty or if the
+    /// queues do not all belong to the same context.
+    explicit queue_pool(const std::vector<command_queue> &queues)
+        : m_queues(queues)
+    {
+        start();
+    }
+
+    /// Creates a queue pool with \p count queues for the device of
+    /// \p context with \p properties (e.g.
+    /// \c command_queue::enable_out_of_order_execution).
+    ///
+    /// Throws \c std::invalid_argument if \p count is zero.
+    queue_pool(const context &context,
+               size_t count,
+               cl_command_queue_properties properties = 0)
+    {
+        for(size_t i = 0; i < count; i++){
+            m_queues.push_back(
+                command_queue(context, context.get_device(), properties)
+            );
+        }
+
+        start();
+    }
+
+    #if defined(BOOST_COMPUTE_CL_VERSION_1_2) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+    /// Creates a queue pool with one queue for each sub-device of
+    /// \p device partitioned by \p domain (e.g.
+    /// \c CL_DEVICE_AFFINITY_DOMAIN_NUMA) with \p properties.
+    ///
+    /// \opencl_version_warning{1,2}
+    ///
+    /// \see device::partition_by_affinity_domain()
+    queue_pool(const device &device,
+               cl_device_affinity_domain domain,
+               cl_command_queue_properties properties = 0)
+    {
+        const std::vector< ::boost::compute::device > sub_devices =
+            device.partition_by_affinity_domain(domain);
+        const context context(sub_devices);
+
+        for(size_t i = 0; i < sub_devices.size(); i++){
+            m_queues.push_back(command_queue(context, sub_devices[i], properties));
+        }
+
+        start();
+    }
+    #endif // BOOST_COMPUTE_CL_VERSION_1_2
+
+    /// Waits for all submitted jobs to complete and destroys the queue
+    /// pool.
+    ~queue_pool()
+    {
+        wait();
+
+        {
+            detail::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+
+        for(size_t i = 0; i < m_threads.size(); i++){
+            m_threads[i]->join();
+        }
+    }
+
+    /// Submits \p job to the pool and returns an event which is completed
+    /// once the commands enqueued by the job are complete.
+    event submit(const job_type &job)
+    {
+        detail::scoped_lock lock(m_mutex);
+
+        // assign the job to the least loaded queue
+        size_t index = 0;
+        for(size_t i = 1; i < m_queues.size(); i++){
+            if(load(i) < load(index)){
+                index = i;
+            }
+        }
+
+        job_entry entry;
+        entry.job = job;
+        entry.done = user_event(m_queues[index].get_context());
+        m_jobs[index].push_back(entry);
+        m_outstanding++;
+
+        lock.unlock();
+        m_condition.notify_all();
+
+        return entry.done;
+    }
+
+    /// Blocks until all submitted jobs are complete.
+    void wait()
+    {
+        detail::scoped_lock lock(m_mutex);
+        while(m_outstanding != 0){
+            m_condition.wait(lock);
+        }
+    }
+
+    /// Returns the number of queues in the pool.
+    size_t size() const
+    {
+        return m_queues.size();
+    }
+
+    /// Returns the queue at \p index.
+    command_queue& get_queue(size_t index)
+    {
+        return m_queues[index];
+    }
+
+    /// Returns the number of jobs which have been submitted but not yet
+    /// completed.
+    size_t outstanding() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_outstanding;
+    }
+
+    /// Returns the number of jobs which were run on another queue than the
+    /// one they were assigned to.
+    size_t stolen() const
+    {
+        detail::scoped_lock lock(m_mutex);
+        return m_stolen;
+    }
+
+private:
+    struct job_entry
+    {
+        job_type job;
+        event done;
+    };
+
+    #ifdef BOOST_COMPUTE_USE_CPP11
+    typedef std::thread thread_type;
+    #else
+    typedef ::boost::thread thread_type;
+    #endif
+
+    void start()
+    {
+        m_stop = false;
+        m_outstanding = 0;
+        m_stolen = 0;
+        m_jobs.resize(m_queues.size());
+        m_running.resize(m_queues.size(), 0);
+
+        // jobs are run on any of the queues, so their memory objects must
+        // be valid on all of them
+        if(m_queues.empty()){
+            BOOST_THROW_EXCEPTION(
+                std::invalid_argument("a queue pool needs at least one queue")
+            );
+        }
+        for(size_t i = 1; i < m_queues.size(); i++){
+            if(m_queues[i].get_context() != m_queues[0].get_context()){
+                BOOST_THROW_EXCEPTION(
+                    std::invalid_argument("the queues of a queue pool must share a context")
+                );
+            }
+        }
+
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_threads.push_back(
+                boost::make_shared<thread_type>(
+                    boost::bind(&queue_pool::run_worker, this, i)
+                )
+            );
+        }
+    }
+
+    // returns the number of pending and running jobs for the queue at
+    // index. must be called with the mutex locked.
+    size_t load(size_t index) const
+    {
+        return m_jobs[index].size() + m_running[index];
+    }
+
+    // takes the next job for the worker at index, stealing from the queue
+    // with the most pending jobs if its own are exhausted. must be called with the mutex locked.
+    bool take_job(size_t index, job_entry &entry)
+    {
+        if(!m_jobs[index].empty()){
+            entry = m_jobs[index].front();
+            m_jobs[index].pop_front();
+            return true;
+        }
+
+        size_t victim = index;
+        for(size_t i = 0; i < m_jobs.size(); i++){
+            if(m_jobs[i].size() > m_jobs[victim].size()){
+                victim = i;
+            }
+        }
+        if(victim == index){
+            return false;
+        }
+
+        entry = m_jobs[victim].back();
+        m_jobs[victim].pop_back();
+        m_stolen++;
+        return true;
+    }
+
+    void run_worker(size_t index)
+    {
+        command_queue &queue = m_queues[index];
+
+        for(;;){
+            job_entry entry;
+            {
+                detail::scoped_lock lock(m_mutex);
+                while(!take_job(index, entry)){
+                    if(m_stop){
+                        return;
+                    }
+                    m_condition.wait(lock);
+                }
+                m_running[index]++;
+            }
+
+            try {
+                entry.job(queue);
+
+                // complete the job's event once its commands are complete
+                event marker = queue.enqueue_marker();
+                marker.set_callback(
+                    boost::bind(&queue_pool::complete_job, this, index, entry.done, CL_COMPLETE)
+                );
+                queue.flush();
+            }
+            catch(...){
+                complete_job(index, entry.done, CL_INVALID_OPERATION);
+            }
+        }
+    }
+
+    // sets the status of the job's user event. this may be called from an
+    // event callback, so errors can not be reported by throwing.
+    void complete_job(size_t index, event done, cl_int status)
+    {
+        clSetUserEventStatus(done.get(), status);
+
+        detail::scoped_lock lock(m_mutex);
+        m_running[index]--;
+        m_outstanding--;
+        m_condition.notify_all();
+    }
+
+private:
+    std::vector<command_queue> m_queues;
+    std::vector<std::deque<job_entry> > m_jobs;
+    std::vector<size_t> m_running;
+    std::vector<boost::shared_ptr<thread_type> > m_threads;
+    mutable detail::mutex m_mutex;
+    detail::condition_variable m_condition;
+    size_t m_outstanding;
+    size_t m_stolen;
+    bool m_stop;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_THREAD_SAFE && BOOST_COMPUTE_CL_VERSION_1_1
+
+#endif // BOOST_COMPUTE_ASYNC_QUEUE_POOL_HPP
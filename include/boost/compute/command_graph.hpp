@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_COMMAND_GRAPH_HPP
+#define BOOST_COMPUTE_COMMAND_GRAPH_HPP
+
+#include <cstring>
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/config.hpp>
+#include <boost/compute/memory_object.hpp>
+#include <boost/compute/type_traits/is_fundamental.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class command_graph
+/// \brief A recorded sequence of commands which can be replayed.
+///
+/// A command graph is created by recording the commands enqueued to a
+/// command queue between calls to command_queue::begin_recording() and
+/// command_queue::end_recording(). It stores the kernels which were
+/// launched together with the values of their arguments and keeps all of the
+/// buffers they use (including temporary buffers allocated by algorithms)
+/// alive. Replaying the graph with command_queue::enqueue_command_graph()
+/// re-submits the recorded commands without generating, looking up or
+/// compiling any kernels and without allocating any memory.
+///
+/// For example, to record a sequence of algorithms once and then run it
+/// again in each iteration of a loop:
+///
+/// \code
+/// queue.begin_recording();
+/// boost::compute::sort(keys.begin(), keys.end(), queue);
+/// boost::compute::exclusive_scan(keys.begin(), keys.end(), sums.begin(), queue);
+/// boost::compute::command_graph graph = queue.end_recording();
+///
+/// for(int i = 0; i < iterations; i++){
+///     // ... write new input to keys
+///     queue.enqueue_command_graph(graph);
+/// }
+/// \endcode
+///
+/// The commands are executed while they are recorded. Kernel launches,
+/// buffer copies, fills and writes are recorded. Reads to host memory are
+/// only performed while recording, and any decisions an algorithm makes on
+/// the host (e.g. based on values it reads from the device) are fixed to
+/// those made during the recording. Algorithms which do so should not be
+/// recorded if their input changes between replays.
+///
+/// Buffers used by the graph can be replaced with rebind() and the value of
+/// an argument of a recorded kernel can be changed with set_arg().
+///
+/// Copies of a command graph share the same recorded commands. A graph
+/// must not be destroyed before the commands enqueued by a replay of it are
+/// complete.
+///
+/// \see command_queue::begin_recording(), command_queue::enqueue_command_graph()
+class command_graph
+{
+public:
+    /// Creates an empty command graph.
+    command_graph()
+    {
+    }
+
+    /// \internal_
+    explicit command_graph(const boost::shared_ptr<detail::command_recorder> &recorder)
+        : m_recorder(recorder)
+    {
+    }
+
+    /// Returns the number of recorded commands.
+    size_t size() const
+    {
+        return m_recorder ? m_recorder->nodes().size() : 0;
+    }
+
+    /// Returns \c true if the graph contains no commands.
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Returns the number of recorded kernel launches.
+    size_t kernel_count() const
+    {
+        size_t count = 0;
+        for(size_t i = 0; i < size(); i++){
+            if(m_recorder->nodes()[i].type == detail::command_recorder::kernel_node){
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /// Replaces each use of the memory object \p from in the recorded
+    /// commands with \p to.
+    ///
+    /// This allows a recorded sequence to be replayed with different input
+    /// or output buffers of the same size.
+    void rebind(const memory_object &from, const memory_object &to)
+    {
+        if(m_recorder){
+            m_recorder->rebind(from.get(), to.get());
+        }
+    }
+
+    /// Sets the argument at \p index of the kernel launched by the command
+    /// at \p command to \p value.
+    ///
+    /// \p value must have a built-in scalar or vector type. Memory objects
+    /// are replaced with rebind().
+    template<class T>
+    void set_arg(size_t command, size_t index, const T &value)
+    {
+        BOOST_STATIC_ASSERT(is_fundamental<T>::value);
+        BOOST_ASSERT(command < size());
+
+        detail::command_recorder::node &node = m_recorder->nodes()[command];
+        BOOST_ASSERT(node.type == detail::command_recorder::kernel_node);
+
+        detail::command_recorder::kernel_arg *arg = 0;
+        for(size_t i = 0; i < node.args.size(); i++){
+            if(node.args[i].index == index){
+                arg = &node.args[i];
+            }
+        }
+        if(!arg){
+            node.args.push_back(detail::command_recorder::kernel_arg());
+            arg = &node.args.back();
+            arg->index = index;
+        }
+
+        arg->size = sizeof(T);
+        arg->is_null = false;
+        arg->is_memory_object = false;
+        arg->value.resize(sizeof(T));
+        std::memcpy(&arg->value[0], &value, sizeof(T));
+    }
+
+    /// \internal_
+    const detail::command_recorder* get_recorder() const
+    {
+        return m_recorder.get();
+    }
+
+private:
+    boost::shared_ptr<detail::command_recorder> m_recorder;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_COMMAND_GRAPH_HPP
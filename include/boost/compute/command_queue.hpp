@@ -13,12 +13,15 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <stdexcept>
 
 #include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <boost/compute/config.hpp>
 #include <boost/compute/event.hpp>
 #include <boost/compute/buffer.hpp>
+#include <boost/compute/command_graph.hpp>
 #include <boost/compute/device.hpp>
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/context.hpp>
@@ -28,11 +31,16 @@
 #include <boost/compute/image/image3d.hpp>
 #include <boost/compute/image/image_object.hpp>
 #include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
 #include <boost/compute/detail/diagnostic.hpp>
 #include <boost/compute/utility/extents.hpp>
 
+#ifdef BOOST_COMPUTE_ENABLE_TRACING
+#include <boost/compute/utility/tracer.hpp>
+#endif
+
 namespace boost {
 namespace compute {
 namespace detail {
@@ -304,6 +312,7 @@ public:
         BOOST_ASSERT(size <= buffer.size());
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
+        check_not_recording("enqueue_read_buffer");
 
         event event_;
 
@@ -323,6 +332,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_transfer("read_buffer", size, event_);
+        #endif
+
         return event_;
     }
 
@@ -342,6 +355,7 @@ public:
         BOOST_ASSERT(size <= buffer.size());
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
+        check_not_recording("enqueue_read_buffer_async");
 
         event event_;
 
@@ -361,6 +375,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_transfer("read_buffer", size, event_);
+        #endif
+
         return event_;
     }
 
@@ -385,6 +403,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
+        check_not_recording("enqueue_read_buffer_rect");
 
         event event_;
 
@@ -432,6 +451,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
+        check_not_recording("enqueue_read_buffer_rect_async");
 
         event event_;
 
@@ -494,6 +514,14 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(detail::command_recorder *recorder = detail::command_recorder::active(m_queue)){
+            recorder->record_write_buffer(buffer.get(), offset, size, host_ptr);
+        }
+
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_transfer("write_buffer", size, event_);
+        #endif
+
         return event_;
     }
 
@@ -532,6 +560,14 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(detail::command_recorder *recorder = detail::command_recorder::active(m_queue)){
+            recorder->record_write_buffer(buffer.get(), offset, size, host_ptr);
+        }
+
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_transfer("write_buffer", size, event_);
+        #endif
+
         return event_;
     }
 
@@ -556,6 +592,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
+        check_not_recording("enqueue_write_buffer_rect");
 
         event event_;
 
@@ -603,6 +640,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(buffer.get_context() == this->get_context());
         BOOST_ASSERT(host_ptr != 0);
+        check_not_recording("enqueue_write_buffer_rect_async");
 
         event event_;
 
@@ -668,6 +706,16 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(detail::command_recorder *recorder = detail::command_recorder::active(m_queue)){
+            recorder->record_copy_buffer(
+                src_buffer.get(), dst_buffer.get(), src_offset, dst_offset, size
+            );
+        }
+
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_transfer("copy_buffer", size, event_);
+        #endif
+
         return event_;
     }
 
@@ -692,6 +740,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(src_buffer.get_context() == this->get_context());
         BOOST_ASSERT(dst_buffer.get_context() == this->get_context());
+        check_not_recording("enqueue_copy_buffer_rect");
 
         event event_;
 
@@ -756,6 +805,16 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(detail::command_recorder *recorder = detail::command_recorder::active(m_queue)){
+            recorder->record_fill_buffer(
+                buffer.get(), pattern, pattern_size, offset, size
+            );
+        }
+
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_transfer("fill_buffer", size, event_);
+        #endif
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_2
@@ -775,6 +834,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(offset + size <= buffer.size());
         BOOST_ASSERT(buffer.get_context() == this->get_context());
+        check_not_recording("enqueue_map_buffer");
 
         cl_int ret = 0;
         void *pointer = clEnqueueMapBuffer(
@@ -826,6 +886,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(offset + size <= buffer.size());
         BOOST_ASSERT(buffer.get_context() == this->get_context());
+        check_not_recording("enqueue_map_buffer_async");
 
         cl_int ret = 0;
         void *pointer = clEnqueueMapBuffer(
@@ -868,6 +929,7 @@ public:
                                    const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_unmap_mem_object");
 
         event event_;
 
@@ -899,6 +961,7 @@ public:
                              const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_read_image");
 
         event event_;
 
@@ -958,6 +1021,7 @@ public:
                               const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_write_image");
 
         event event_;
 
@@ -1022,6 +1086,7 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(image.get_context() == this->get_context());
+        check_not_recording("enqueue_map_image");
 
         cl_int ret = 0;
         void *pointer = clEnqueueMapImage(
@@ -1123,6 +1188,7 @@ public:
     {
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(image.get_context() == this->get_context());
+        check_not_recording("enqueue_map_image_async");
 
         cl_int ret = 0;
         void *pointer = clEnqueueMapImage(
@@ -1195,6 +1261,7 @@ public:
                              const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_copy_image");
 
         event event_;
 
@@ -1255,6 +1322,7 @@ public:
                                        const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_copy_image_to_buffer");
 
         event event_;
 
@@ -1288,6 +1356,7 @@ public:
                                        const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_copy_buffer_to_image");
 
         event event_;
 
@@ -1323,6 +1392,7 @@ public:
                              const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_fill_image");
 
         event event_;
 
@@ -1376,6 +1446,7 @@ public:
                                          const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_migrate_memory_objects");
 
         event event_;
 
@@ -1428,6 +1499,20 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(detail::command_recorder *recorder = detail::command_recorder::active(m_queue)){
+            recorder->record_kernel(kernel.get(),
+                                    work_dim,
+                                    global_work_offset,
+                                    global_work_size,
+                                    local_work_size);
+        }
+
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().record_kernel(
+            kernel, work_dim, global_work_size, local_work_size, event_
+        );
+        #endif
+
         return event_;
     }
 
@@ -1495,6 +1580,16 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        if(detail::command_recorder *recorder = detail::command_recorder::active(m_queue)){
+            const size_t one = 1;
+            recorder->record_kernel(kernel.get(), 1, 0, &one, &one);
+        }
+
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        const size_t one = 1;
+        tracer::global().record_kernel(kernel, 1, &one, &one, event_);
+        #endif
+
         return event_;
     }
 
@@ -1508,6 +1603,7 @@ public:
                                 const wait_list &events = wait_list())
     {
         BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_native_kernel");
 
         event event_;
         cl_int ret = clEnqueueNativeKernel(
@@ -1664,6 +1760,169 @@ public:
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_2
 
+    /// Starts recording the commands enqueued to the queue.
+    ///
+    /// The commands are executed as usual and the kernel launches, buffer
+    /// copies, fills and writes (along with the kernel arguments and the
+    /// buffers they use) are stored until end_recording() is called. Only
+    /// one command queue may be recording in each thread at a time.
+    ///
+    /// The supported commands are enqueue_write_buffer(),
+    /// enqueue_write_buffer_async(), enqueue_copy_buffer(),
+    /// enqueue_fill_buffer(), enqueue_nd_range_kernel(),
+    /// enqueue_1d_range_kernel() and enqueue_task(). Markers and barriers
+    /// are allowed but not stored. Every other command, including reads,
+    /// maps and unmaps, rectangular copies, image and SVM commands, throws
+    /// \c std::logic_error while the queue is recording.
+    ///
+    /// \see end_recording(), command_graph
+    void begin_recording()
+    {
+        BOOST_ASSERT(m_queue != 0);
+
+        detail::command_recorder *&recorder = detail::command_recorder::active();
+        if(recorder){
+            BOOST_THROW_EXCEPTION(
+                std::logic_error("a command queue is already recording")
+            );
+        }
+
+        recorder = new detail::command_recorder(m_queue);
+    }
+
+    /// Stops recording and returns the recorded commands.
+    ///
+    /// \see begin_recording(), enqueue_command_graph()
+    command_graph end_recording()
+    {
+        detail::command_recorder *recorder = detail::command_recorder::active(m_queue);
+        if(!recorder){
+            BOOST_THROW_EXCEPTION(
+                std::logic_error("the command queue is not recording")
+            );
+        }
+
+        detail::command_recorder::active() = 0;
+
+        return command_graph(boost::shared_ptr<detail::command_recorder>(recorder));
+    }
+
+    /// Returns \c true if the queue is recording commands.
+    bool is_recording() const
+    {
+        return detail::command_recorder::active(m_queue) != 0;
+    }
+
+    /// Enqueues the commands recorded in \p graph. The first command waits
+    /// for \p events and the returned event is the event of the last command.
+    ///
+    /// Only the stored kernel arguments are set before each kernel launch,
+    /// no kernels are generated or built and no memory is allocated. A graph
+    /// cannot be enqueued while the queue is recording.
+    ///
+    /// \see begin_recording(), command_graph
+    event enqueue_command_graph(const command_graph &graph,
+                                const wait_list &events = wait_list())
+    {
+        BOOST_ASSERT(m_queue != 0);
+        check_not_recording("enqueue_command_graph");
+
+        typedef detail::command_recorder::node node_type;
+        typedef detail::command_recorder::kernel_arg kernel_arg;
+
+        event event_;
+
+        if(graph.empty()){
+            return event_;
+        }
+
+        const std::vector<node_type> &nodes = graph.get_recorder()->nodes();
+        for(size_t i = 0; i < nodes.size(); i++){
+            const node_type &node = nodes[i];
+            const bool first = i == 0;
+            const bool last = i + 1 == nodes.size();
+            const cl_uint num_events = first ? events.size() : 0;
+            const cl_event *event_list = first ? events.get_event_ptr() : 0;
+            cl_event *node_event = last ? &event_.get() : 0;
+
+            cl_int ret = CL_SUCCESS;
+            switch(node.type){
+            case detail::command_recorder::kernel_node:
+                for(size_t j = 0; j < node.args.size(); j++){
+                    const kernel_arg &arg = node.args[j];
+                    ret = clSetKernelArg(
+                        node.kernel,
+                        static_cast<cl_uint>(arg.index),
+                        arg.size,
+                        arg.is_null ? 0 : static_cast<const void *>(&arg.value[0])
+                    );
+                    if(ret != CL_SUCCESS){
+                        BOOST_THROW_EXCEPTION(opencl_error(ret));
+                    }
+                }
+                ret = clEnqueueNDRangeKernel(
+                    m_queue,
+                    node.kernel,
+                    node.work_dim,
+                    node.has_offset ? node.offset : 0,
+                    node.global_size,
+                    node.has_local_size ? node.local_size : 0,
+                    num_events,
+                    event_list,
+                    node_event
+                );
+                break;
+            case detail::command_recorder::copy_buffer_node:
+                ret = clEnqueueCopyBuffer(
+                    m_queue,
+                    node.src,
+                    node.dst,
+                    node.src_offset,
+                    node.dst_offset,
+                    node.size,
+                    num_events,
+                    event_list,
+                    node_event
+                );
+                break;
+            case detail::command_recorder::fill_buffer_node:
+                #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+                ret = clEnqueueFillBuffer(
+                    m_queue,
+                    node.dst,
+                    &node.data[0],
+                    node.data.size(),
+                    node.dst_offset,
+                    node.size,
+                    num_events,
+                    event_list,
+                    node_event
+                );
+                #endif // BOOST_COMPUTE_CL_VERSION_1_2
+                break;
+            case detail::command_recorder::write_buffer_node:
+                ret = clEnqueueWriteBuffer(
+                    m_queue,
+                    node.dst,
+                    CL_FALSE,
+                    node.dst_offset,
+                    node.size,
+                    &node.data[0],
+                    num_events,
+                    event_list,
+                    node_event
+                );
+                break;
+            }
+
+            if(ret != CL_SUCCESS){
+                BOOST_THROW_EXCEPTION(opencl_error(ret));
+            }
+        }
+
+        return event_;
+    }
+
     #if defined(BOOST_COMPUTE_CL_VERSION_2_0) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
     /// Enqueues a command to copy \p size bytes of data from \p src_ptr to
     /// \p dst_ptr.
@@ -1676,6 +1935,8 @@ public:
                              size_t size,
                              const wait_list &events = wait_list())
     {
+        check_not_recording("enqueue_svm_memcpy");
+
         event event_;
 
         cl_int ret = clEnqueueSVMMemcpy(
@@ -1707,6 +1968,8 @@ public:
                                    size_t size,
                                    const wait_list &events = wait_list())
     {
+        check_not_recording("enqueue_svm_memcpy_async");
+
         event event_;
 
         cl_int ret = clEnqueueSVMMemcpy(
@@ -1740,6 +2003,8 @@ public:
                            const wait_list &events = wait_list())
 
     {
+        check_not_recording("enqueue_svm_fill");
+
         event event_;
 
         cl_int ret = clEnqueueSVMMemFill(
@@ -1770,6 +2035,8 @@ public:
     event enqueue_svm_free(void *svm_ptr,
                            const wait_list &events = wait_list())
     {
+        check_not_recording("enqueue_svm_free");
+
         event event_;
 
         cl_int ret = clEnqueueSVMFree(
@@ -1800,6 +2067,8 @@ public:
                           cl_map_flags flags,
                           const wait_list &events = wait_list())
     {
+        check_not_recording("enqueue_svm_map");
+
         event event_;
 
         cl_int ret = clEnqueueSVMMap(
@@ -1828,6 +2097,8 @@ public:
     event enqueue_svm_unmap(void *svm_ptr,
                             const wait_list &events = wait_list())
     {
+        check_not_recording("enqueue_svm_unmap");
+
         event event_;
 
         cl_int ret = clEnqueueSVMUnmap(
@@ -1864,6 +2135,8 @@ public:
                                      const wait_list &events = wait_list())
     {
         BOOST_ASSERT(svm_ptrs.size() == sizes.size() || sizes.size() == 0);
+        check_not_recording("enqueue_svm_migrate_memory");
+
         event event_;
 
         cl_int ret = clEnqueueSVMMigrateMem(
@@ -1899,6 +2172,8 @@ public:
                                      const cl_mem_migration_flags flags = 0,
                                      const wait_list &events = wait_list())
     {
+        check_not_recording("enqueue_svm_migrate_memory");
+
         event event_;
 
         cl_int ret = clEnqueueSVMMigrateMem(
@@ -1945,6 +2220,19 @@ public:
     }
 
 private:
+    // throws if the queue is recording, used by the commands which cannot
+    // be stored in a command graph
+    void check_not_recording(const char *command) const
+    {
+        if(detail::command_recorder::active(m_queue)){
+            BOOST_THROW_EXCEPTION(
+                std::logic_error(
+                    std::string(command) + "() cannot be recorded in a command graph"
+                )
+            );
+        }
+    }
+
     cl_command_queue m_queue;
 };
 
@@ -17,11 +17,18 @@
 
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/basic_string.hpp>
+#include <boost/compute/container/coo_matrix.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+#include <boost/compute/container/distributed_vector.hpp>
 #include <boost/compute/container/dynamic_bitset.hpp>
 #include <boost/compute/container/flat_map.hpp>
 #include <boost/compute/container/flat_set.hpp>
+#include <boost/compute/container/mapped_span.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/soa_vector.hpp>
 #include <boost/compute/container/string.hpp>
+#include <boost/compute/container/unordered_map.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/vector_builder.hpp>
 
 #endif // BOOST_COMPUTE_CONTAINER_HPP
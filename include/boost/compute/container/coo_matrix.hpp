@@ -0,0 +1,228 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_COO_MATRIX_HPP
+#define BOOST_COMPUTE_CONTAINER_COO_MATRIX_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class coo_matrix
+/// \brief A sparse matrix in coordinate format.
+///
+/// The coo_matrix class stores the non-zero values of a sparse matrix as
+/// three vectors on the device with the row index, the column index and the
+/// value of each entry. The entries may be in any order and entries with
+/// the same row and column are summed by the operations on the matrix.
+///
+/// The coordinate format is convenient to assemble a matrix (e.g. from the
+/// edges of a graph). For computations the matrix is converted to a
+/// csr_matrix, whose constructor sorts the entries by row:
+///
+/// \snippet test/test_sparse_matrix.cpp coo_to_csr
+///
+/// \see csr_matrix, spmv()
+template<class T>
+class coo_matrix
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef vector<uint_> index_vector;
+    typedef vector<T> value_vector;
+
+    /// Creates an empty matrix in \p context.
+    explicit coo_matrix(const context &context = system::default_context())
+        : m_rows(0),
+          m_cols(0),
+          m_row_indices(context),
+          m_column_indices(context),
+          m_values(context)
+    {
+    }
+
+    /// Creates a \p rows x \p cols matrix with storage for \p nonzeros
+    /// entries in \p context. The entries are not initialized.
+    coo_matrix(size_type rows,
+               size_type cols,
+               size_type nonzeros,
+               const context &context = system::default_context())
+        : m_rows(rows),
+          m_cols(cols),
+          m_row_indices(nonzeros, context),
+          m_column_indices(nonzeros, context),
+          m_values(nonzeros, context)
+    {
+    }
+
+    /// Creates a \p rows x \p cols matrix with the entries whose row
+    /// indices are in the range [\p row_first, \p row_last) and whose
+    /// column indices and values are in the ranges beginning at
+    /// \p column_first and \p value_first. The ranges may be on the host
+    /// or on the device.
+    template<class RowIterator, class ColumnIterator, class ValueIterator>
+    coo_matrix(size_type rows,
+               size_type cols,
+               RowIterator row_first,
+               RowIterator row_last,
+               ColumnIterator column_first,
+               ValueIterator value_first,
+               command_queue &queue = system::default_queue())
+        : m_rows(rows),
+          m_cols(cols),
+          m_row_indices(row_first, row_last, queue),
+          m_column_indices(m_row_indices.size(), queue.get_context()),
+          m_values(m_row_indices.size(), queue.get_context())
+    {
+        typedef typename
+            std::iterator_traits<ColumnIterator>::difference_type column_difference;
+        typedef typename
+            std::iterator_traits<ValueIterator>::difference_type value_difference;
+
+        const size_type count = m_row_indices.size();
+
+        ::boost::compute::copy(
+            column_first,
+            column_first + static_cast<column_difference>(count),
+            m_column_indices.begin(),
+            queue
+        );
+        ::boost::compute::copy(
+            value_first,
+            value_first + static_cast<value_difference>(count),
+            m_values.begin(),
+            queue
+        );
+    }
+
+    /// Creates a new matrix as a copy of \p other.
+    coo_matrix(const coo_matrix &other)
+        : m_rows(other.m_rows),
+          m_cols(other.m_cols),
+          m_row_indices(other.m_row_indices),
+          m_column_indices(other.m_column_indices),
+          m_values(other.m_values)
+    {
+    }
+
+    /// Copies the matrix from \p other to \c *this.
+    coo_matrix& operator=(const coo_matrix &other)
+    {
+        if(this != &other){
+            m_rows = other.m_rows;
+            m_cols = other.m_cols;
+            m_row_indices = other.m_row_indices;
+            m_column_indices = other.m_column_indices;
+            m_values = other.m_values;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the matrix.
+    ~coo_matrix()
+    {
+    }
+
+    /// Returns the number of rows in the matrix.
+    size_type rows() const
+    {
+        return m_rows;
+    }
+
+    /// Returns the number of columns in the matrix.
+    size_type cols() const
+    {
+        return m_cols;
+    }
+
+    /// Returns the number of stored entries in the matrix.
+    size_type nonzeros() const
+    {
+        return m_values.size();
+    }
+
+    /// Resizes the matrix to \p rows x \p cols with storage for
+    /// \p nonzeros entries.
+    void resize(size_type rows,
+                size_type cols,
+                size_type nonzeros,
+                command_queue &queue = system::default_queue())
+    {
+        m_rows = rows;
+        m_cols = cols;
+        m_row_indices.resize(nonzeros, queue);
+        m_column_indices.resize(nonzeros, queue);
+        m_values.resize(nonzeros, queue);
+    }
+
+    /// Returns the row index of each entry.
+    index_vector& row_indices()
+    {
+        return m_row_indices;
+    }
+
+    /// \overload
+    const index_vector& row_indices() const
+    {
+        return m_row_indices;
+    }
+
+    /// Returns the column index of each entry.
+    index_vector& column_indices()
+    {
+        return m_column_indices;
+    }
+
+    /// \overload
+    const index_vector& column_indices() const
+    {
+        return m_column_indices;
+    }
+
+    /// Returns the value of each entry.
+    value_vector& values()
+    {
+        return m_values;
+    }
+
+    /// \overload
+    const value_vector& values() const
+    {
+        return m_values;
+    }
+
+    /// Returns the context for the matrix.
+    context get_context() const
+    {
+        return m_values.get_buffer().get_context();
+    }
+
+private:
+    size_type m_rows;
+    size_type m_cols;
+    index_vector m_row_indices;
+    index_vector m_column_indices;
+    value_vector m_values;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_COO_MATRIX_HPP
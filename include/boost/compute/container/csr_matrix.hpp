@@ -0,0 +1,356 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_CSR_MATRIX_HPP
+#define BOOST_COMPUTE_CONTAINER_CSR_MATRIX_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/coo_matrix.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes the offsets of the rows of a csr matrix from the sorted row
+// indices of its entries. the work-item for each entry writes the offsets
+// of the rows which begin with it, the work-item for the last entry also
+// writes the offsets of the trailing empty rows and the end offset.
+inline void csr_row_offsets(const vector<uint_> &sorted_rows,
+                            size_t rows,
+                            vector<uint_> &offsets,
+                            command_queue &queue)
+{
+    const size_t nonzeros = sorted_rows.size();
+
+    if(nonzeros == 0){
+        ::boost::compute::fill(offsets.begin(), offsets.end(), uint_(0), queue);
+        return;
+    }
+
+    meta_kernel k("csr_row_offsets");
+    k.add_set_arg<const uint_>("rows", static_cast<uint_>(rows));
+    k.add_set_arg<const uint_>("nonzeros", static_cast<uint_>(nonzeros));
+
+    k << "const uint i = get_global_id(0);\n"
+      << "const uint row = " << sorted_rows.begin()[k.var<uint_>("i")] << ";\n"
+      << "const uint first = i == 0 ? 0 : "
+      <<     sorted_rows.begin()[k.expr<uint_>("i - 1")] << " + 1;\n"
+      << "for(uint r = first; r <= row; r++){\n"
+      << "    " << offsets.begin()[k.var<uint_>("r")] << " = i;\n"
+      << "}\n"
+      << "if(i == nonzeros - 1){\n"
+      << "    for(uint r = row + 1; r <= rows; r++){\n"
+      << "        " << offsets.begin()[k.var<uint_>("r")] << " = nonzeros;\n"
+      << "    }\n"
+      << "}\n";
+
+    k.exec_1d(queue, 0, nonzeros);
+}
+
+// sorts the entries of a coo matrix by row and column and stores them in
+// csr format. the entries are sorted by a 64-bit (row, column) key with
+// sort_by_key() and then gathered in the sorted order.
+template<class T>
+inline void coo_to_csr(const coo_matrix<T> &coo,
+                       vector<uint_> &offsets,
+                       vector<uint_> &columns,
+                       vector<T> &values,
+                       command_queue &queue)
+{
+    const size_t nonzeros = coo.nonzeros();
+    const context &context = queue.get_context();
+
+    offsets.resize(coo.rows() + 1, queue);
+    columns.resize(nonzeros, queue);
+    values.resize(nonzeros, queue);
+
+    vector<uint_> sorted_rows(nonzeros, context);
+    if(nonzeros != 0){
+        vector<ulong_> keys(nonzeros, context);
+
+        meta_kernel k("coo_sort_keys");
+        k.add_set_arg<const ulong_>("cols", static_cast<ulong_>(coo.cols()));
+        k << keys.begin()[k.get_global_id(0)] << " = "
+          << "(ulong)" << coo.row_indices().begin()[k.get_global_id(0)]
+          << " * cols + "
+          << coo.column_indices().begin()[k.get_global_id(0)] << ";\n";
+        k.exec_1d(queue, 0, nonzeros);
+
+        vector<uint_> permutation(nonzeros, context);
+        ::boost::compute::iota(
+            permutation.begin(), permutation.end(), uint_(0), queue
+        );
+        ::boost::compute::sort_by_key(
+            keys.begin(), keys.end(), permutation.begin(), queue
+        );
+
+        ::boost::compute::gather(
+            permutation.begin(), permutation.end(),
+            coo.row_indices().begin(), sorted_rows.begin(), queue
+        );
+        ::boost::compute::gather(
+            permutation.begin(), permutation.end(),
+            coo.column_indices().begin(), columns.begin(), queue
+        );
+        ::boost::compute::gather(
+            permutation.begin(), permutation.end(),
+            coo.values().begin(), values.begin(), queue
+        );
+    }
+
+    csr_row_offsets(sorted_rows, coo.rows(), offsets, queue);
+}
+
+// expands the row offsets of a csr matrix to the row index of each entry
+inline void csr_row_indices(const vector<uint_> &offsets,
+                            size_t rows,
+                            vector<uint_> &row_indices,
+                            command_queue &queue)
+{
+    if(rows == 0){
+        return;
+    }
+
+    meta_kernel k("csr_row_indices");
+    k << "const uint row = get_global_id(0);\n"
+      << "const uint end = " << offsets.begin()[k.expr<uint_>("row + 1")] << ";\n"
+      << "for(uint j = " << offsets.begin()[k.var<uint_>("row")] << "; j < end; j++){\n"
+      << "    " << row_indices.begin()[k.var<uint_>("j")] << " = row;\n"
+      << "}\n";
+
+    k.exec_1d(queue, 0, rows);
+}
+
+} // end detail namespace
+
+/// \class csr_matrix
+/// \brief A sparse matrix in compressed sparse row format.
+///
+/// The csr_matrix class stores the non-zero values of a sparse matrix as
+/// three vectors on the device: the offset of the first entry of each row
+/// (and of the end of the last row), the column index of each entry and the
+/// value of each entry. The entries of each row are stored consecutively.
+///
+/// A csr_matrix can be created from arrays in compressed sparse row format
+/// or from a coo_matrix:
+///
+/// \snippet test/test_sparse_matrix.cpp coo_to_csr
+///
+/// Sparse matrix-vector and matrix-matrix products are computed with
+/// spmv() and spmm().
+///
+/// \see coo_matrix, spmv(), spmm()
+template<class T>
+class csr_matrix
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef vector<uint_> index_vector;
+    typedef vector<T> value_vector;
+
+    /// Creates an empty matrix in \p context.
+    explicit csr_matrix(const context &context = system::default_context())
+        : m_rows(0),
+          m_cols(0),
+          m_row_offsets(1, context),
+          m_column_indices(context),
+          m_values(context)
+    {
+        // the end offset of an empty matrix is zero
+        command_queue queue(context, context.get_device());
+        ::boost::compute::fill(
+            m_row_offsets.begin(), m_row_offsets.end(), uint_(0), queue
+        );
+        queue.finish();
+    }
+
+    /// Creates a \p rows x \p cols matrix with storage for \p nonzeros
+    /// entries in \p context. The entries and row offsets are not
+    /// initialized.
+    csr_matrix(size_type rows,
+               size_type cols,
+               size_type nonzeros,
+               const context &context = system::default_context())
+        : m_rows(rows),
+          m_cols(cols),
+          m_row_offsets(rows + 1, context),
+          m_column_indices(nonzeros, context),
+          m_values(nonzeros, context)
+    {
+    }
+
+    /// Creates a \p rows x \p cols matrix from the <tt>rows + 1</tt> row
+    /// offsets beginning at \p offset_first and the \p nonzeros column
+    /// indices and values beginning at \p column_first and \p value_first.
+    /// The ranges may be on the host or on the device.
+    template<class OffsetIterator, class ColumnIterator, class ValueIterator>
+    csr_matrix(size_type rows,
+               size_type cols,
+               size_type nonzeros,
+               OffsetIterator offset_first,
+               ColumnIterator column_first,
+               ValueIterator value_first,
+               command_queue &queue = system::default_queue())
+        : m_rows(rows),
+          m_cols(cols),
+          m_row_offsets(rows + 1, queue.get_context()),
+          m_column_indices(nonzeros, queue.get_context()),
+          m_values(nonzeros, queue.get_context())
+    {
+        ::boost::compute::copy_n(offset_first, rows + 1, m_row_offsets.begin(), queue);
+        ::boost::compute::copy_n(column_first, nonzeros, m_column_indices.begin(), queue);
+        ::boost::compute::copy_n(value_first, nonzeros, m_values.begin(), queue);
+    }
+
+    /// Creates a matrix with the entries of \p other, sorted by row and
+    /// column.
+    explicit csr_matrix(const coo_matrix<T> &other,
+                        command_queue &queue = system::default_queue())
+        : m_rows(other.rows()),
+          m_cols(other.cols()),
+          m_row_offsets(queue.get_context()),
+          m_column_indices(queue.get_context()),
+          m_values(queue.get_context())
+    {
+        detail::coo_to_csr(other, m_row_offsets, m_column_indices, m_values, queue);
+    }
+
+    /// Creates a new matrix as a copy of \p other.
+    csr_matrix(const csr_matrix &other)
+        : m_rows(other.m_rows),
+          m_cols(other.m_cols),
+          m_row_offsets(other.m_row_offsets),
+          m_column_indices(other.m_column_indices),
+          m_values(other.m_values)
+    {
+    }
+
+    /// Copies the matrix from \p other to \c *this.
+    csr_matrix& operator=(const csr_matrix &other)
+    {
+        if(this != &other){
+            m_rows = other.m_rows;
+            m_cols = other.m_cols;
+            m_row_offsets = other.m_row_offsets;
+            m_column_indices = other.m_column_indices;
+            m_values = other.m_values;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the matrix.
+    ~csr_matrix()
+    {
+    }
+
+    /// Returns the number of rows in the matrix.
+    size_type rows() const
+    {
+        return m_rows;
+    }
+
+    /// Returns the number of columns in the matrix.
+    size_type cols() const
+    {
+        return m_cols;
+    }
+
+    /// Returns the number of stored entries in the matrix.
+    size_type nonzeros() const
+    {
+        return m_values.size();
+    }
+
+    /// Returns the offset of the first entry of each row, followed by the
+    /// number of entries.
+    index_vector& row_offsets()
+    {
+        return m_row_offsets;
+    }
+
+    /// \overload
+    const index_vector& row_offsets() const
+    {
+        return m_row_offsets;
+    }
+
+    /// Returns the column index of each entry.
+    index_vector& column_indices()
+    {
+        return m_column_indices;
+    }
+
+    /// \overload
+    const index_vector& column_indices() const
+    {
+        return m_column_indices;
+    }
+
+    /// Returns the value of each entry.
+    value_vector& values()
+    {
+        return m_values;
+    }
+
+    /// \overload
+    const value_vector& values() const
+    {
+        return m_values;
+    }
+
+    /// Returns the context for the matrix.
+    context get_context() const
+    {
+        return m_values.get_buffer().get_context();
+    }
+
+    /// Stores the entries of the matrix in \p result in coordinate format.
+    void copy_to(coo_matrix<T> &result,
+                 command_queue &queue = system::default_queue()) const
+    {
+        result.resize(m_rows, m_cols, nonzeros(), queue);
+
+        detail::csr_row_indices(m_row_offsets, m_rows, result.row_indices(), queue);
+        ::boost::compute::copy(
+            m_column_indices.begin(), m_column_indices.end(),
+            result.column_indices().begin(), queue
+        );
+        ::boost::compute::copy(
+            m_values.begin(), m_values.end(), result.values().begin(), queue
+        );
+    }
+
+private:
+    size_type m_rows;
+    size_type m_cols;
+    index_vector m_row_offsets;
+    index_vector m_column_indices;
+    value_vector m_values;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_CSR_MATRIX_HPP
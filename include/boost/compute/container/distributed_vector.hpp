@@ -0,0 +1,743 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_DISTRIBUTED_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_DISTRIBUTED_VECTOR_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/for_each.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+
+namespace boost {
+namespace compute {
+
+// forward declaration for distributed_vector
+template<class T, class Alloc = buffer_allocator<T> >
+class distributed_vector;
+
+namespace detail {
+
+// copies count values from src at src_index (using src_queue) to dst at
+// dst_index (using dst_queue). vectors in different contexts are copied
+// through host memory. blocks until the copy is complete.
+template<class T, class Alloc>
+inline void copy_between_shards(vector<T, Alloc> &src,
+                                size_t src_index,
+                                command_queue &src_queue,
+                                vector<T, Alloc> &dst,
+                                size_t dst_index,
+                                command_queue &dst_queue,
+                                size_t count)
+{
+    if(count == 0){
+        return;
+    }
+
+    if(src_queue.get_context() == dst_queue.get_context()){
+        ::boost::compute::copy(
+            src.begin() + src_index,
+            src.begin() + src_index + count,
+            dst.begin() + dst_index,
+            dst_queue
+        );
+        dst_queue.finish();
+    }
+    else {
+        std::vector<T> host(count);
+        ::boost::compute::copy(
+            src.begin() + src_index,
+            src.begin() + src_index + count,
+            host.begin(),
+            src_queue
+        );
+        ::boost::compute::copy(
+            host.begin(), host.end(), dst.begin() + dst_index, dst_queue
+        );
+    }
+}
+
+// copies the host range beginning at first to the shards. the copies for
+// contiguous ranges are enqueued for all shards before waiting.
+template<class InputIterator, class T, class Alloc>
+inline void copy_to_shards(InputIterator first,
+                           distributed_vector<T, Alloc> &vector,
+                           boost::true_type)
+{
+    std::vector<future<typename distributed_vector<T, Alloc>::iterator> > futures;
+    for(size_t i = 0; i < vector.shard_count(); i++){
+        if(vector.shard_size(i) == 0){
+            continue;
+        }
+
+        InputIterator shard_first = first;
+        std::advance(shard_first, vector.shard_offset(i));
+        InputIterator shard_last = shard_first;
+        std::advance(shard_last, vector.shard_size(i));
+
+        futures.push_back(
+            ::boost::compute::copy_async(
+                shard_first, shard_last, vector.begin(i), vector.get_queue(i)
+            )
+        );
+    }
+
+    for(size_t i = 0; i < futures.size(); i++){
+        futures[i].wait();
+    }
+}
+
+template<class InputIterator, class T, class Alloc>
+inline void copy_to_shards(InputIterator first,
+                           distributed_vector<T, Alloc> &vector,
+                           boost::false_type)
+{
+    for(size_t i = 0; i < vector.shard_count(); i++){
+        InputIterator shard_last = first;
+        std::advance(shard_last, vector.shard_size(i));
+
+        ::boost::compute::copy(
+            first, shard_last, vector.begin(i), vector.get_queue(i)
+        );
+        first = shard_last;
+    }
+}
+
+template<class T, class Alloc, class OutputIterator>
+inline OutputIterator copy_from_shards(distributed_vector<T, Alloc> &vector,
+                                       OutputIterator result,
+                                       boost::true_type)
+{
+    std::vector<future<OutputIterator> > futures;
+    for(size_t i = 0; i < vector.shard_count(); i++){
+        if(vector.shard_size(i) == 0){
+            continue;
+        }
+
+        OutputIterator shard_result = result;
+        std::advance(shard_result, vector.shard_offset(i));
+
+        futures.push_back(
+            ::boost::compute::copy_async(
+                vector.begin(i), vector.end(i), shard_result, vector.get_queue(i)
+            )
+        );
+    }
+
+    for(size_t i = 0; i < futures.size(); i++){
+        futures[i].wait();
+    }
+
+    std::advance(result, vector.size());
+    return result;
+}
+
+template<class T, class Alloc, class OutputIterator>
+inline OutputIterator copy_from_shards(distributed_vector<T, Alloc> &vector,
+                                       OutputIterator result,
+                                       boost::false_type)
+{
+    for(size_t i = 0; i < vector.shard_count(); i++){
+        result = ::boost::compute::copy(
+            vector.begin(i), vector.end(i), result, vector.get_queue(i)
+        );
+    }
+
+    return result;
+}
+
+} // end detail namespace
+
+/// \class distributed_vector
+/// \brief A vector whose values are sharded across several command queues.
+///
+/// The distributed_vector class splits one logical range of values into
+/// contiguous shards, each of which is stored in a \ref vector in the
+/// context of its own command queue. The queues may be for different
+/// devices (e.g. several GPUs) or for sub-devices of one device (e.g. the
+/// NUMA domains of a CPU, see device::partition_by_affinity_domain()).
+///
+/// The for_each(), transform(), reduce() and copy() overloads for
+/// distributed vectors enqueue their work for each shard on the shard's
+/// queue, so that the devices process the shards concurrently, and then
+/// combine the results:
+///
+/// \snippet test/test_distributed_vector.cpp sub_devices
+///
+/// Each shard may be surrounded by a halo of \c width values on both sides
+/// (see set_halo_width()), which exchange_halos() fills with the adjacent
+/// values of the neighboring shards. This allows stencil operations on
+/// shard(i) to read the values next to its owned range.
+///
+/// The values can be redistributed among the shards with reshard().
+///
+/// \see vector
+template<class T, class Alloc>
+class distributed_vector
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef vector<T, Alloc> shard_type;
+    typedef typename shard_type::iterator iterator;
+
+    /// Creates a distributed vector with \p size values sharded across
+    /// \p queues. The number of values in each shard is proportional to the
+    /// number of compute units of its queue's device.
+    distributed_vector(size_type size,
+                       const std::vector<command_queue> &queues)
+        : m_queues(queues),
+          m_halo(0)
+    {
+        allocate(balanced_shard_sizes(size));
+    }
+
+    /// Creates a distributed vector with \p shard_sizes[i] values in the
+    /// shard for \p queues[i].
+    distributed_vector(const std::vector<size_type> &shard_sizes,
+                       const std::vector<command_queue> &queues)
+        : m_queues(queues),
+          m_halo(0)
+    {
+        BOOST_ASSERT(shard_sizes.size() == queues.size());
+
+        allocate(shard_sizes);
+    }
+
+    /// Creates a distributed vector with the values in the host range
+    /// [\p first, \p last) sharded across \p queues.
+    template<class InputIterator>
+    distributed_vector(InputIterator first,
+                       InputIterator last,
+                       const std::vector<command_queue> &queues)
+        : m_queues(queues),
+          m_halo(0)
+    {
+        allocate(balanced_shard_sizes(detail::iterator_range_size(first, last)));
+
+        detail::copy_to_shards(
+            first,
+            *this,
+            typename detail::is_contiguous_iterator<InputIterator>::type()
+        );
+    }
+
+    /// Creates a distributed vector as a copy of \p other with the same
+    /// queues and shards.
+    distributed_vector(const distributed_vector &other)
+        : m_queues(other.m_queues),
+          m_offsets(other.m_offsets),
+          m_halo(other.m_halo)
+    {
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_shards.push_back(
+                boost::make_shared<shard_type>(*other.m_shards[i], m_queues[i])
+            );
+        }
+        finish();
+    }
+
+    /// Copies the values, queues and shards from \p other to \c *this.
+    distributed_vector& operator=(const distributed_vector &other)
+    {
+        if(this != &other){
+            distributed_vector copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    /// Destroys the distributed vector.
+    ~distributed_vector()
+    {
+    }
+
+    /// Swaps the contents of \c *this with \p other.
+    void swap(distributed_vector &other)
+    {
+        std::swap(m_queues, other.m_queues);
+        std::swap(m_shards, other.m_shards);
+        std::swap(m_offsets, other.m_offsets);
+        std::swap(m_halo, other.m_halo);
+    }
+
+    /// Returns the number of values in the distributed vector.
+    size_type size() const
+    {
+        return m_offsets.back();
+    }
+
+    /// Returns \c true if the distributed vector is empty.
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Returns the number of shards.
+    size_type shard_count() const
+    {
+        return m_shards.size();
+    }
+
+    /// Returns the vector storing the shard at \p index, including its
+    /// halos.
+    shard_type& shard(size_type index)
+    {
+        return *m_shards[index];
+    }
+
+    /// \overload
+    const shard_type& shard(size_type index) const
+    {
+        return *m_shards[index];
+    }
+
+    /// Returns the number of values owned by the shard at \p index.
+    size_type shard_size(size_type index) const
+    {
+        return m_offsets[index + 1] - m_offsets[index];
+    }
+
+    /// Returns the index of the first value owned by the shard at \p index.
+    size_type shard_offset(size_type index) const
+    {
+        return m_offsets[index];
+    }
+
+    /// Returns the number of values owned by each shard.
+    std::vector<size_type> shard_sizes() const
+    {
+        std::vector<size_type> sizes(shard_count());
+        for(size_t i = 0; i < sizes.size(); i++){
+            sizes[i] = shard_size(i);
+        }
+
+        return sizes;
+    }
+
+    /// Returns the command queue for the shard at \p index.
+    command_queue& get_queue(size_type index)
+    {
+        return m_queues[index];
+    }
+
+    /// Returns the command queues for the shards.
+    const std::vector<command_queue>& get_queues() const
+    {
+        return m_queues;
+    }
+
+    /// Returns an iterator to the first value owned by the shard at
+    /// \p index.
+    iterator begin(size_type index)
+    {
+        return m_shards[index]->begin() + m_halo;
+    }
+
+    /// Returns an iterator one past the last value owned by the shard at
+    /// \p index.
+    iterator end(size_type index)
+    {
+        return begin(index) + shard_size(index);
+    }
+
+    /// Returns the width of the halos.
+    size_type halo_width() const
+    {
+        return m_halo;
+    }
+
+    /// Sets the width of the halos to \p width values. The halos are not
+    /// filled until exchange_halos() is called.
+    void set_halo_width(size_type width)
+    {
+        if(width != m_halo){
+            redistribute(shard_sizes(), width);
+        }
+    }
+
+    /// Fills the halos of each shard with the adjacent values owned by the
+    /// neighboring shards. The outer halos of the first and last shard are
+    /// left unchanged. Each shard must own at least halo_width() values.
+    void exchange_halos()
+    {
+        if(m_halo == 0){
+            return;
+        }
+
+        finish();
+
+        for(size_t i = 0; i < shard_count(); i++){
+            BOOST_ASSERT(shard_size(i) >= m_halo);
+
+            if(i > 0){
+                detail::copy_between_shards(
+                    *m_shards[i - 1], shard_size(i - 1), m_queues[i - 1],
+                    *m_shards[i], 0, m_queues[i],
+                    m_halo
+                );
+            }
+            if(i + 1 < shard_count()){
+                detail::copy_between_shards(
+                    *m_shards[i + 1], m_halo, m_queues[i + 1],
+                    *m_shards[i], m_halo + shard_size(i), m_queues[i],
+                    m_halo
+                );
+            }
+        }
+    }
+
+    /// Redistributes the values so that the shard at \p i owns
+    /// \p shard_sizes[i] values. The sizes must add up to size().
+    void reshard(const std::vector<size_type> &shard_sizes)
+    {
+        BOOST_ASSERT(shard_sizes.size() == shard_count());
+
+        redistribute(shard_sizes, m_halo);
+    }
+
+    /// Redistributes the values in proportion to the number of compute
+    /// units of each shard's device.
+    void reshard()
+    {
+        reshard(balanced_shard_sizes(size()));
+    }
+
+    /// Blocks until all commands enqueued to the shards' queues are
+    /// complete.
+    void finish()
+    {
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_queues[i].finish();
+        }
+    }
+
+private:
+    std::vector<size_type> balanced_shard_sizes(size_type size) const
+    {
+        size_t total_units = 0;
+        for(size_t i = 0; i < m_queues.size(); i++){
+            total_units += m_queues[i].get_device().compute_units();
+        }
+
+        std::vector<size_type> sizes(m_queues.size());
+        size_type assigned = 0;
+        size_t units = 0;
+        for(size_t i = 0; i < m_queues.size(); i++){
+            units += m_queues[i].get_device().compute_units();
+
+            const size_type end = total_units == 0 ?
+                size * (i + 1) / m_queues.size() :
+                static_cast<size_type>(double(size) * units / total_units);
+
+            sizes[i] = end - assigned;
+            assigned = end;
+        }
+        sizes.back() += size - assigned;
+
+        return sizes;
+    }
+
+    void allocate(const std::vector<size_type> &shard_sizes)
+    {
+        BOOST_ASSERT(!m_queues.empty());
+
+        m_offsets.assign(1, 0);
+        m_shards.clear();
+        for(size_t i = 0; i < shard_sizes.size(); i++){
+            m_offsets.push_back(m_offsets.back() + shard_sizes[i]);
+            m_shards.push_back(
+                boost::make_shared<shard_type>(
+                    shard_sizes[i] + 2 * m_halo, m_queues[i].get_context()
+                )
+            );
+        }
+    }
+
+    // moves the values to new shards with shard_sizes and halo
+    void redistribute(const std::vector<size_type> &shard_sizes, size_type halo)
+    {
+        finish();
+
+        distributed_vector other(*this, shard_sizes, halo);
+        for(size_t i = 0; i < shard_count(); i++){
+            for(size_t j = 0; j < other.shard_count(); j++){
+                const size_type first =
+                    (std::max)(shard_offset(i), other.shard_offset(j));
+                const size_type last =
+                    (std::min)(m_offsets[i + 1], other.m_offsets[j + 1]);
+
+                if(first < last){
+                    detail::copy_between_shards(
+                        *m_shards[i],
+                        m_halo + first - shard_offset(i),
+                        m_queues[i],
+                        *other.m_shards[j],
+                        other.m_halo + first - other.shard_offset(j),
+                        other.m_queues[j],
+                        last - first
+                    );
+                }
+            }
+        }
+
+        swap(other);
+    }
+
+    // creates uninitialized shards with the queues of other
+    distributed_vector(const distributed_vector &other,
+                       const std::vector<size_type> &shard_sizes,
+                       size_type halo)
+        : m_queues(other.m_queues),
+          m_halo(halo)
+    {
+        BOOST_ASSERT(shard_sizes.size() == m_queues.size());
+
+        allocate(shard_sizes);
+
+        BOOST_ASSERT(size() == other.size());
+    }
+
+private:
+    std::vector<command_queue> m_queues;
+    std::vector<boost::shared_ptr<shard_type> > m_shards;
+    std::vector<size_type> m_offsets;
+    size_type m_halo;
+};
+
+/// Calls \p function on each value of \p vector. The shards are processed
+/// concurrently on their queues. Blocks until all shards are processed.
+///
+/// \see distributed_vector
+template<class T, class Alloc, class UnaryFunction>
+inline void for_each(distributed_vector<T, Alloc> &vector,
+                     UnaryFunction function)
+{
+    for(size_t i = 0; i < vector.shard_count(); i++){
+        ::boost::compute::for_each(
+            vector.begin(i), vector.end(i), function, vector.get_queue(i)
+        );
+    }
+
+    vector.finish();
+}
+
+/// Stores the result of \p op for each value of \p input in the value with
+/// the same index in \p output. Both vectors must have the same shards
+/// (i.e. queues and shard sizes). Blocks until all shards are processed.
+///
+/// \see distributed_vector
+template<class InputType, class InputAlloc,
+         class OutputType, class OutputAlloc,
+         class UnaryOperator>
+inline void transform(distributed_vector<InputType, InputAlloc> &input,
+                      distributed_vector<OutputType, OutputAlloc> &output,
+                      UnaryOperator op)
+{
+    BOOST_ASSERT(input.shard_count() == output.shard_count());
+
+    for(size_t i = 0; i < input.shard_count(); i++){
+        BOOST_ASSERT(input.shard_size(i) == output.shard_size(i));
+
+        ::boost::compute::transform(
+            input.begin(i), input.end(i), output.begin(i), op, output.get_queue(i)
+        );
+    }
+
+    output.finish();
+}
+
+/// Stores the result of \p op for each pair of values of \p input1 and
+/// \p input2 in \p output. All vectors must have the same shards.
+///
+/// \see distributed_vector
+template<class InputType, class InputAlloc,
+         class OutputType, class OutputAlloc,
+         class BinaryOperator>
+inline void transform(distributed_vector<InputType, InputAlloc> &input1,
+                      distributed_vector<InputType, InputAlloc> &input2,
+                      distributed_vector<OutputType, OutputAlloc> &output,
+                      BinaryOperator op)
+{
+    BOOST_ASSERT(input1.shard_count() == output.shard_count());
+    BOOST_ASSERT(input2.shard_count() == output.shard_count());
+
+    for(size_t i = 0; i < output.shard_count(); i++){
+        BOOST_ASSERT(input1.shard_size(i) == output.shard_size(i));
+        BOOST_ASSERT(input2.shard_size(i) == output.shard_size(i));
+
+        ::boost::compute::transform(
+            input1.begin(i),
+            input1.end(i),
+            input2.begin(i),
+            output.begin(i),
+            op,
+            output.get_queue(i)
+        );
+    }
+
+    output.finish();
+}
+
+/// Reduces the values of \p vector with \p function and stores the result
+/// at \p result. Each shard is reduced concurrently on its queue, then the
+/// partial results are reduced on the queue of the first shard (so
+/// \p result must be a host iterator or a device iterator in its context).
+///
+/// \see distributed_vector
+template<class T, class Alloc, class OutputIterator, class BinaryFunction>
+inline void reduce(distributed_vector<T, Alloc> &vector,
+                   OutputIterator result,
+                   BinaryFunction function)
+{
+    typedef typename
+        ::boost::compute::result_of<BinaryFunction(T, T)>::type result_type;
+
+    // reduce each non-empty shard to a value in its context
+    std::vector<size_t> reduced;
+    std::vector<boost::shared_ptr< ::boost::compute::vector<result_type> > > partials;
+    for(size_t i = 0; i < vector.shard_count(); i++){
+        if(vector.shard_size(i) == 0){
+            continue;
+        }
+
+        command_queue &queue = vector.get_queue(i);
+        partials.push_back(
+            boost::make_shared< ::boost::compute::vector<result_type> >(
+                size_t(1), queue.get_context()
+            )
+        );
+        ::boost::compute::reduce(
+            vector.begin(i), vector.end(i), partials.back()->begin(), function, queue
+        );
+        reduced.push_back(i);
+    }
+
+    // combine the partial results
+    std::vector<result_type> host_partials(partials.size());
+    for(size_t i = 0; i < partials.size(); i++){
+        ::boost::compute::copy(
+            partials[i]->begin(),
+            partials[i]->end(),
+            host_partials.begin() + i,
+            vector.get_queue(reduced[i])
+        );
+    }
+
+    command_queue &queue = vector.get_queue(0);
+    ::boost::compute::vector<result_type> values(
+        host_partials.begin(), host_partials.end(), queue
+    );
+    ::boost::compute::reduce(values.begin(), values.end(), result, function, queue);
+}
+
+/// Reduces the values of \p vector with \c plus<T>.
+///
+/// \see distributed_vector
+template<class T, class Alloc, class OutputIterator>
+inline void reduce(distributed_vector<T, Alloc> &vector,
+                   OutputIterator result)
+{
+    ::boost::compute::reduce(vector, result, ::boost::compute::plus<T>());
+}
+
+/// Copies the values in the host range [\p first, \p last) to \p vector.
+/// The range must have size() values. For contiguous ranges the shards are
+/// written concurrently. Blocks until the copy is complete.
+///
+/// \see distributed_vector
+template<class InputIterator, class T, class Alloc>
+inline void copy(InputIterator first,
+                 InputIterator last,
+                 distributed_vector<T, Alloc> &vector)
+{
+    BOOST_ASSERT(detail::iterator_range_size(first, last) == vector.size());
+    (void) last;
+
+    detail::copy_to_shards(
+        first,
+        vector,
+        typename detail::is_contiguous_iterator<InputIterator>::type()
+    );
+}
+
+/// Copies the values of \p vector to the host range beginning at
+/// \p result and returns an iterator one past the last value written.
+/// Blocks until the copy is complete.
+///
+/// \see distributed_vector
+template<class T, class Alloc, class OutputIterator>
+inline OutputIterator copy(distributed_vector<T, Alloc> &vector,
+                           OutputIterator result)
+{
+    return detail::copy_from_shards(
+        vector,
+        result,
+        typename detail::is_contiguous_iterator<OutputIterator>::type()
+    );
+}
+
+/// Copies the values of \p input to \p output, which may have different
+/// queues and shard sizes but must have the same size.
+///
+/// \see distributed_vector
+template<class T, class Alloc>
+inline void copy(distributed_vector<T, Alloc> &input,
+                 distributed_vector<T, Alloc> &output)
+{
+    BOOST_ASSERT(input.size() == output.size());
+
+    input.finish();
+
+    for(size_t i = 0; i < input.shard_count(); i++){
+        for(size_t j = 0; j < output.shard_count(); j++){
+            const size_t first =
+                (std::max)(input.shard_offset(i), output.shard_offset(j));
+            const size_t last =
+                (std::min)(input.shard_offset(i) + input.shard_size(i),
+                           output.shard_offset(j) + output.shard_size(j));
+
+            if(first < last){
+                detail::copy_between_shards(
+                    input.shard(i),
+                    input.halo_width() + first - input.shard_offset(i),
+                    input.get_queue(i),
+                    output.shard(j),
+                    output.halo_width() + first - output.shard_offset(j),
+                    output.get_queue(j),
+                    last - first
+                );
+            }
+        }
+    }
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_DISTRIBUTED_VECTOR_HPP
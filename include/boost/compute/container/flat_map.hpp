@@ -19,14 +19,25 @@
 #include <boost/throw_exception.hpp>
 
 #include <boost/compute/exception.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/find.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/algorithm/scatter_if.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/merge_with_merge_path.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/functional/get.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/types/pair.hpp>
 #include <boost/compute/detail/buffer_value.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 
 namespace boost {
 namespace compute {
@@ -200,6 +211,73 @@ public:
         return result;
     }
 
+    /// Inserts the key-value pairs in the range [\p first, \p last) into
+    /// the map.
+    ///
+    /// The pairs are sorted by key on the device and merged with the current
+    /// contents of the map in a single pass. As with insert() for a single
+    /// value, keys which are already in the map keep their current value and
+    /// only the first pair for a key which appears more than once in the
+    /// range is inserted.
+    ///
+    /// Returns the number of pairs which were inserted.
+    template<class InputIterator>
+    size_type insert(InputIterator first,
+                     InputIterator last,
+                     command_queue &queue)
+    {
+        using ::boost::compute::lambda::_1;
+        using ::boost::compute::lambda::_2;
+        using ::boost::compute::lambda::get;
+
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return 0;
+        }
+
+        const context &context = queue.get_context();
+
+        // sort the new pairs by key (keeping their relative order)
+        vector_type values(first, last, queue);
+        ::boost::compute::stable_sort(
+            values.begin(), values.end(), get<0>(_1) < get<0>(_2), queue
+        );
+
+        // merge with the current pairs, for equal keys the pairs already in
+        // the map are placed first
+        vector_type merged(size() + count, context);
+        ::boost::compute::detail::merge_with_merge_path(
+            m_vector.begin(), m_vector.end(),
+            values.begin(), values.end(),
+            merged.begin(),
+            get<0>(_1) < get<0>(_2),
+            queue
+        );
+
+        // keep the first pair for each key
+        vector_type result(merged.size(), context);
+        iterator result_end = ::boost::compute::unique_copy(
+            merged.begin(), merged.end(), result.begin(),
+            get<0>(_1) == get<0>(_2),
+            queue
+        );
+        result.resize(std::distance(result.begin(), result_end), queue);
+
+        const size_type inserted = result.size() - size();
+        m_vector.swap(result);
+        return inserted;
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        size_type inserted = insert(first, last, queue);
+        queue.finish();
+        return inserted;
+    }
+
     iterator erase(const const_iterator &position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -241,6 +319,89 @@ public:
         }
     }
 
+    /// Removes the pairs for each of the keys in the range [\p first,
+    /// \p last) from the map.
+    ///
+    /// Each pair in the map is checked against the sorted keys with a binary
+    /// search and the remaining pairs are compacted with a single scan.
+    ///
+    /// Returns the number of pairs which were removed.
+    template<class InputIterator>
+    size_type erase_keys(InputIterator first,
+                         InputIterator last,
+                         command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0 || empty()){
+            return 0;
+        }
+
+        const context &context = queue.get_context();
+
+        // sort the keys to remove
+        ::boost::compute::vector<Key> keys(first, last, queue);
+        ::boost::compute::sort(keys.begin(), keys.end(), queue);
+
+        // flag the pairs to keep, the extra flag at the end is set to zero so
+        // that the scan below produces the number of remaining pairs
+        ::boost::compute::vector<uint_> flags(size() + 1, context);
+        ::boost::compute::fill_n(flags.end() - 1, 1, uint_(0), queue);
+
+        detail::meta_kernel k("flat_map_erase_keys");
+        k.add_set_arg<const uint_>("count", static_cast<uint_>(keys.size()));
+        k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+          << k.decl<const Key>("key") << " = "
+          <<     m_vector.begin()[k.var<const uint_>("i")] << ".first;\n"
+          << "uint lo = 0;\n"
+          << "uint hi = count;\n"
+          << "while(lo < hi){\n"
+          << "    const uint mid = (lo + hi) / 2;\n"
+          << "    if(" << keys.begin()[k.var<const uint_>("mid")] << " < key){\n"
+          << "        lo = mid + 1;\n"
+          << "    }\n"
+          << "    else {\n"
+          << "        hi = mid;\n"
+          << "    }\n"
+          << "}\n"
+          << flags.begin()[k.var<const uint_>("i")] << " = "
+          << "!(lo < count && "
+          <<     keys.begin()[k.var<const uint_>("lo")] << " == key);\n";
+        k.exec_1d(queue, 0, size());
+
+        // compute the destination of each remaining pair
+        ::boost::compute::vector<uint_> indices(flags.size(), context);
+        ::boost::compute::exclusive_scan(
+            flags.begin(), flags.end(), indices.begin(), queue
+        );
+        const size_type remaining = static_cast<size_type>(
+            detail::read_single_value<uint_>(
+                indices.get_buffer(), indices.size() - 1, queue
+            )
+        );
+
+        vector_type result(remaining, context);
+        ::boost::compute::scatter_if(
+            m_vector.begin(), m_vector.end(),
+            indices.begin(), flags.begin(),
+            result.begin(),
+            queue
+        );
+
+        const size_type erased = size() - remaining;
+        m_vector.swap(result);
+        return erased;
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type erase_keys(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        size_type erased = erase_keys(first, last, queue);
+        queue.finish();
+        return erased;
+    }
+
     iterator find(const key_type &value, command_queue &queue)
     {
         ::boost::compute::get<0> get_key;
@@ -16,8 +16,14 @@
 
 #include <boost/compute/algorithm/find.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/algorithm/set_difference.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/merge_with_merge_path.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -189,6 +195,62 @@ public:
         return result;
     }
 
+    /// Inserts the values in the range [\p first, \p last) into the set.
+    ///
+    /// The values are sorted on the device and merged with the current
+    /// contents of the set in a single pass, so the cost does not depend on
+    /// the number of values inserted one at a time. Values which are already
+    /// in the set (or appear more than once in the range) are inserted once.
+    ///
+    /// Returns the number of values which were inserted.
+    template<class InputIterator>
+    size_type insert(InputIterator first,
+                     InputIterator last,
+                     command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0){
+            return 0;
+        }
+
+        const context &context = queue.get_context();
+
+        // sort the new values
+        vector<T> values(first, last, queue);
+        ::boost::compute::sort(values.begin(), values.end(), queue);
+
+        // merge with the current values
+        vector<T> merged(size() + count, context);
+        ::boost::compute::detail::merge_with_merge_path(
+            m_vector.begin(), m_vector.end(),
+            values.begin(), values.end(),
+            merged.begin(),
+            ::boost::compute::less<T>(),
+            queue
+        );
+
+        // remove duplicate values
+        vector<T> result(merged.size(), context);
+        iterator result_end = ::boost::compute::unique_copy(
+            merged.begin(), merged.end(), result.begin(), queue
+        );
+        result.resize(std::distance(result.begin(), result_end), queue);
+
+        const size_type inserted = result.size() - size();
+        m_vector.swap(result);
+        return inserted;
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type insert(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        size_type inserted = insert(first, last, queue);
+        queue.finish();
+        return inserted;
+    }
+
     iterator erase(const const_iterator &position, command_queue &queue)
     {
         return erase(position, position + 1, queue);
@@ -238,6 +300,48 @@ public:
         return result;
     }
 
+    /// Removes each of the values in the range [\p first, \p last) from
+    /// the set with a single set_difference() pass.
+    ///
+    /// Returns the number of values which were removed.
+    template<class InputIterator>
+    size_type erase_keys(InputIterator first,
+                         InputIterator last,
+                         command_queue &queue)
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+        if(count == 0 || empty()){
+            return 0;
+        }
+
+        // sort the values to remove
+        vector<T> keys(first, last, queue);
+        ::boost::compute::sort(keys.begin(), keys.end(), queue);
+
+        vector<T> result(size(), queue.get_context());
+        iterator result_end = ::boost::compute::set_difference(
+            m_vector.begin(), m_vector.end(),
+            keys.begin(), keys.end(),
+            result.begin(),
+            queue
+        );
+        result.resize(std::distance(result.begin(), result_end), queue);
+
+        const size_type erased = size() - result.size();
+        m_vector.swap(result);
+        return erased;
+    }
+
+    /// \overload
+    template<class InputIterator>
+    size_type erase_keys(InputIterator first, InputIterator last)
+    {
+        command_queue queue = m_vector.default_queue();
+        size_type erased = erase_keys(first, last, queue);
+        queue.finish();
+        return erased;
+    }
+
     iterator find(const key_type &value, command_queue &queue)
     {
         return ::boost::compute::find(begin(), end(), value, queue);
@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_MAPPED_SPAN_HPP
+#define BOOST_COMPUTE_CONTAINER_MAPPED_SPAN_HPP
+
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class mapped_span
+/// \brief A range of device values mapped into host memory.
+///
+/// The mapped_span class maps the range of a buffer into the host address
+/// space when it is created and unmaps it when it is destroyed. While the
+/// range is mapped its values can be read (and, depending on the map flags,
+/// written) on the host through ordinary pointers.
+///
+/// For buffers in memory shared with the host (see host_mapped_allocator)
+/// mapping does not copy the values, which makes mapped_span the cheapest
+/// way to read results on the host.
+///
+/// \snippet test/test_host_mapped_allocator.cpp read_in_place
+///
+/// The buffer must not be used by the device while it is mapped.
+///
+/// \see host_mapped_allocator, mapped_view
+template<class T>
+class mapped_span : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    /// Maps the range [\p first, \p last) with \p flags using \p queue.
+    /// Blocks until the range is mapped.
+    mapped_span(const buffer_iterator<T> &first,
+                const buffer_iterator<T> &last,
+                cl_map_flags flags = CL_MAP_READ | CL_MAP_WRITE,
+                command_queue &queue = system::default_queue())
+        : m_buffer(first.get_buffer()),
+          m_queue(queue),
+          m_size(detail::iterator_range_size(first, last)),
+          m_ptr(0)
+    {
+        if(m_size != 0){
+            m_ptr = static_cast<T *>(
+                queue.enqueue_map_buffer(
+                    m_buffer, flags, first.get_index() * sizeof(T), m_size * sizeof(T)
+                )
+            );
+        }
+    }
+
+    /// Unmaps the range and destroys the mapped span.
+    ~mapped_span()
+    {
+        unmap();
+    }
+
+    /// Unmaps the range and waits for the unmap to complete. Afterwards the
+    /// span is empty.
+    void unmap()
+    {
+        if(m_ptr){
+            event unmap_event = m_queue.enqueue_unmap_buffer(m_buffer, m_ptr);
+            unmap_event.wait();
+
+            m_ptr = 0;
+            m_size = 0;
+        }
+    }
+
+    /// Returns a pointer to the first mapped value.
+    T* data()
+    {
+        return m_ptr;
+    }
+
+    /// \overload
+    const T* data() const
+    {
+        return m_ptr;
+    }
+
+    /// Returns the number of mapped values.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if no values are mapped.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    iterator begin()
+    {
+        return m_ptr;
+    }
+
+    const_iterator begin() const
+    {
+        return m_ptr;
+    }
+
+    iterator end()
+    {
+        return m_ptr + m_size;
+    }
+
+    const_iterator end() const
+    {
+        return m_ptr + m_size;
+    }
+
+    reference operator[](size_type index)
+    {
+        return m_ptr[index];
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        return m_ptr[index];
+    }
+
+private:
+    buffer m_buffer;
+    command_queue m_queue;
+    size_type m_size;
+    T *m_ptr;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_MAPPED_SPAN_HPP
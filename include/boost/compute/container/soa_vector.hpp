@@ -0,0 +1,704 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
+
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+#include <boost/mpl/back_inserter.hpp>
+#include <boost/mpl/push_front.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/types/struct.hpp>
+#include <boost/compute/detail/mpl_vector_to_tuple.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+
+namespace boost {
+namespace compute {
+
+// forward declaration for soa_vector
+template<class T>
+class soa_vector;
+
+namespace detail {
+
+// stores one vector for each member in Pointers (a boost::tuples::cons
+// list of member pointers, see adapted_struct_members) and applies
+// functions to each vector along with its member pointer
+template<class Pointers>
+struct soa_columns;
+
+template<class Struct, class T, class Tail>
+struct soa_columns<boost::tuples::cons<T Struct::*, Tail> >
+{
+    typedef T value_type;
+    typedef soa_columns<Tail> tail_type;
+    typedef boost::tuples::cons<
+        buffer_iterator<T>, typename tail_type::iterator_cons
+    > iterator_cons;
+    typedef typename
+        mpl::push_front<typename tail_type::value_types, T>::type value_types;
+
+    soa_columns(size_t size, const context &context)
+        : head(size, context),
+          tail(size, context)
+    {
+    }
+
+    soa_columns(const soa_columns &other, command_queue &queue)
+        : head(other.head, queue),
+          tail(other.tail, queue)
+    {
+    }
+
+    iterator_cons begin()
+    {
+        return iterator_cons(head.begin(), tail.begin());
+    }
+
+    iterator_cons end()
+    {
+        return iterator_cons(head.end(), tail.end());
+    }
+
+    template<class Function, class Pointers>
+    void for_each(Function &function, const Pointers &pointers)
+    {
+        function(head, pointers.get_head());
+        tail.for_each(function, pointers.get_tail());
+    }
+
+    vector<T> head;
+    tail_type tail;
+};
+
+template<>
+struct soa_columns<boost::tuples::null_type>
+{
+    typedef boost::tuples::null_type iterator_cons;
+    typedef mpl::vector<> value_types;
+
+    soa_columns(size_t, const context &)
+    {
+    }
+
+    soa_columns(const soa_columns &, command_queue &)
+    {
+    }
+
+    iterator_cons begin()
+    {
+        return iterator_cons();
+    }
+
+    iterator_cons end()
+    {
+        return iterator_cons();
+    }
+
+    template<class Function>
+    void for_each(Function &, const boost::tuples::null_type &)
+    {
+    }
+};
+
+// returns the N-th column of soa_columns
+template<size_t N, class Columns>
+struct soa_column_at
+{
+    typedef soa_column_at<N - 1, typename Columns::tail_type> next;
+    typedef typename next::type type;
+
+    static type& get(Columns &columns)
+    {
+        return next::get(columns.tail);
+    }
+};
+
+template<class Columns>
+struct soa_column_at<0, Columns>
+{
+    typedef vector<typename Columns::value_type> type;
+
+    static type& get(Columns &columns)
+    {
+        return columns.head;
+    }
+};
+
+struct soa_resize
+{
+    soa_resize(size_t size, command_queue &queue)
+        : m_size(size),
+          m_queue(queue)
+    {
+    }
+
+    template<class T, class Pointer>
+    void operator()(vector<T> &column, Pointer)
+    {
+        column.resize(m_size, m_queue);
+    }
+
+    size_t m_size;
+    command_queue &m_queue;
+};
+
+struct soa_reserve
+{
+    soa_reserve(size_t size, command_queue &queue)
+        : m_size(size),
+          m_queue(queue)
+    {
+    }
+
+    template<class T, class Pointer>
+    void operator()(vector<T> &column, Pointer)
+    {
+        column.reserve(m_size, m_queue);
+    }
+
+    size_t m_size;
+    command_queue &m_queue;
+};
+
+template<class Struct>
+struct soa_fill
+{
+    soa_fill(const Struct &value, command_queue &queue)
+        : m_value(value),
+          m_queue(queue)
+    {
+    }
+
+    template<class T>
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        ::boost::compute::fill(
+            column.begin(), column.end(), m_value.*member, m_queue
+        );
+    }
+
+    const Struct &m_value;
+    command_queue &m_queue;
+};
+
+template<class Struct>
+struct soa_push_back
+{
+    soa_push_back(const Struct &value, command_queue &queue)
+        : m_value(value),
+          m_queue(queue)
+    {
+    }
+
+    template<class T>
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        column.push_back(m_value.*member, m_queue);
+    }
+
+    const Struct &m_value;
+    command_queue &m_queue;
+};
+
+template<class Struct>
+struct soa_read_value
+{
+    soa_read_value(Struct &value, size_t index, command_queue &queue)
+        : m_value(value),
+          m_index(index),
+          m_queue(queue)
+    {
+    }
+
+    template<class T>
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        m_value.*member =
+            read_single_value<T>(column.get_buffer(), m_index, m_queue);
+    }
+
+    Struct &m_value;
+    size_t m_index;
+    command_queue &m_queue;
+};
+
+template<class Struct>
+struct soa_write_value
+{
+    soa_write_value(const Struct &value, size_t index, command_queue &queue)
+        : m_value(value),
+          m_index(index),
+          m_queue(queue)
+    {
+    }
+
+    template<class T>
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        write_single_value<T>(
+            m_value.*member, column.get_buffer(), m_index, m_queue
+        );
+    }
+
+    const Struct &m_value;
+    size_t m_index;
+    command_queue &m_queue;
+};
+
+// copies one member of each host value to its column
+template<class Struct>
+struct soa_scatter
+{
+    soa_scatter(const std::vector<Struct> &values, command_queue &queue)
+        : m_values(values),
+          m_queue(queue)
+    {
+    }
+
+    template<class T>
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        std::vector<T> host_column(m_values.size());
+        for(size_t i = 0; i < m_values.size(); i++){
+            host_column[i] = m_values[i].*member;
+        }
+
+        ::boost::compute::copy(
+            host_column.begin(), host_column.end(), column.begin(), m_queue
+        );
+    }
+
+    const std::vector<Struct> &m_values;
+    command_queue &m_queue;
+};
+
+// copies each column to one member of the host values
+template<class Struct>
+struct soa_gather
+{
+    soa_gather(std::vector<Struct> &values, command_queue &queue)
+        : m_values(values),
+          m_queue(queue)
+    {
+    }
+
+    template<class T>
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        std::vector<T> host_column(m_values.size());
+        ::boost::compute::copy(
+            column.begin(), column.begin() + host_column.size(), host_column.begin(), m_queue
+        );
+
+        for(size_t i = 0; i < m_values.size(); i++){
+            m_values[i].*member = host_column[i];
+        }
+    }
+
+    std::vector<Struct> &m_values;
+    command_queue &m_queue;
+};
+
+// finds the column for a member pointer
+template<class Struct, class T>
+struct soa_find_column
+{
+    soa_find_column(T Struct::*member)
+        : m_member(member),
+          m_column(0)
+    {
+    }
+
+    void operator()(vector<T> &column, T Struct::*member)
+    {
+        if(member == m_member){
+            m_column = &column;
+        }
+    }
+
+    template<class U, class Pointer>
+    void operator()(vector<U> &, Pointer)
+    {
+    }
+
+    T Struct::*m_member;
+    vector<T> *m_column;
+};
+
+// reference to a value in a soa_vector. reading or writing the value
+// transfers each of its members with a temporary command queue.
+template<class T>
+class soa_vector_reference
+{
+public:
+    soa_vector_reference(soa_vector<T> &vector, size_t index)
+        : m_vector(vector),
+          m_index(index)
+    {
+    }
+
+    operator T() const
+    {
+        const context &context = m_vector.get_context();
+        command_queue queue(context, context.get_device());
+
+        return m_vector.get(m_index, queue);
+    }
+
+    soa_vector_reference& operator=(const T &value)
+    {
+        const context &context = m_vector.get_context();
+        command_queue queue(context, context.get_device());
+
+        m_vector.set(m_index, value, queue);
+
+        return *this;
+    }
+
+    soa_vector_reference& operator=(const soa_vector_reference &other)
+    {
+        return *this = static_cast<T>(other);
+    }
+
+private:
+    soa_vector<T> &m_vector;
+    size_t m_index;
+};
+
+} // end detail namespace
+
+/// \class soa_vector
+/// \brief A resizable array of adapted structs stored as one buffer per
+///        member.
+///
+/// The soa_vector class stores values of a struct type adapted with
+/// BOOST_COMPUTE_ADAPT_STRUCT() in "struct of arrays" layout, i.e. each
+/// member of the struct is stored in its own \ref vector (a column). An
+/// algorithm which only uses some members of the struct can then be called
+/// with just their columns, which avoids loading the other members:
+///
+/// \snippet test/test_soa_vector.cpp reduce_column
+///
+/// The values as a whole can be accessed through begin() and end(), which
+/// return \ref zip_iterator "zip iterators" over all columns (their value
+/// type is a \c boost::tuple with the members of the struct in order). On
+/// the host the values are read and written as \c T, either with
+/// operator[] or with assign() and copy_to() for whole ranges.
+///
+/// All members of \c T must be scalar or vector types (not arrays). The
+/// zip iterators support structs with up to
+/// <tt>BOOST_COMPUTE_MAX_ARITY - 1</tt> members.
+///
+/// \see vector, zip_iterator, BOOST_COMPUTE_ADAPT_STRUCT()
+template<class T>
+class soa_vector
+{
+private:
+    typedef detail::adapted_struct_members<T> members_type;
+    typedef typename members_type::pointers_type pointers_type;
+    typedef detail::soa_columns<pointers_type> columns_type;
+    typedef typename
+        detail::mpl_vector_to_tuple<
+            typename mpl::transform<
+                typename columns_type::value_types,
+                buffer_iterator<mpl::_1>,
+                mpl::back_inserter<mpl::vector<> >
+            >::type
+        >::type iterator_tuple;
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef detail::soa_vector_reference<T> reference;
+    typedef zip_iterator<iterator_tuple> iterator;
+
+    /// Creates an empty soa_vector in \p context.
+    explicit soa_vector(const context &context = system::default_context())
+        : m_columns(0, context)
+    {
+    }
+
+    /// Creates a soa_vector with space for \p count values in \p context.
+    explicit soa_vector(size_type count,
+                        const context &context = system::default_context())
+        : m_columns(count, context)
+    {
+    }
+
+    /// Creates a soa_vector with \p count copies of \p value.
+    soa_vector(size_type count,
+               const T &value,
+               command_queue &queue = system::default_queue())
+        : m_columns(count, queue.get_context())
+    {
+        detail::soa_fill<T> fill(value, queue);
+        m_columns.for_each(fill, members_type::pointers());
+    }
+
+    /// Creates a soa_vector with the values in the host range [\p first,
+    /// \p last).
+    template<class InputIterator>
+    soa_vector(InputIterator first,
+               InputIterator last,
+               command_queue &queue = system::default_queue())
+        : m_columns(0, queue.get_context())
+    {
+        assign(first, last, queue);
+    }
+
+    /// Creates a soa_vector as a copy of \p other.
+    soa_vector(const soa_vector &other,
+               command_queue &queue = system::default_queue())
+        : m_columns(other.m_columns, queue)
+    {
+    }
+
+    /// Copies the values from \p other to \c *this.
+    soa_vector& operator=(const soa_vector &other)
+    {
+        if(this != &other){
+            m_columns = other.m_columns;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the soa_vector.
+    ~soa_vector()
+    {
+    }
+
+    /// Returns the number of values in the soa_vector.
+    size_type size() const
+    {
+        return m_columns.head.size();
+    }
+
+    /// Returns \c true if the soa_vector is empty.
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Returns the context for the soa_vector.
+    context get_context() const
+    {
+        return m_columns.head.get_buffer().get_context();
+    }
+
+    /// Resizes the soa_vector to \p size values.
+    void resize(size_type size, command_queue &queue)
+    {
+        detail::soa_resize resize(size, queue);
+        m_columns.for_each(resize, members_type::pointers());
+    }
+
+    /// \overload
+    void resize(size_type size)
+    {
+        command_queue queue = default_queue();
+        resize(size, queue);
+        queue.finish();
+    }
+
+    /// Reserves space for \p size values in each column.
+    void reserve(size_type size, command_queue &queue)
+    {
+        detail::soa_reserve reserve(size, queue);
+        m_columns.for_each(reserve, members_type::pointers());
+    }
+
+    /// \overload
+    void reserve(size_type size)
+    {
+        command_queue queue = default_queue();
+        reserve(size, queue);
+        queue.finish();
+    }
+
+    /// Removes all values from the soa_vector.
+    void clear()
+    {
+        resize(0);
+    }
+
+    /// Appends \p value to the end of the soa_vector.
+    void push_back(const T &value, command_queue &queue)
+    {
+        detail::soa_push_back<T> push_back(value, queue);
+        m_columns.for_each(push_back, members_type::pointers());
+    }
+
+    /// \overload
+    void push_back(const T &value)
+    {
+        command_queue queue = default_queue();
+        push_back(value, queue);
+        queue.finish();
+    }
+
+    /// Returns the value at \p index, reading each of its members with
+    /// \p queue.
+    T get(size_type index, command_queue &queue)
+    {
+        BOOST_ASSERT(index < size());
+
+        T value;
+        detail::soa_read_value<T> read(value, index, queue);
+        m_columns.for_each(read, members_type::pointers());
+
+        return value;
+    }
+
+    /// Sets the value at \p index to \p value, writing each of its members
+    /// with \p queue.
+    void set(size_type index, const T &value, command_queue &queue)
+    {
+        BOOST_ASSERT(index < size());
+
+        detail::soa_write_value<T> write(value, index, queue);
+        m_columns.for_each(write, members_type::pointers());
+    }
+
+    /// Returns a reference to the value at \p index which converts to and
+    /// can be assigned from \c T.
+    reference operator[](size_type index)
+    {
+        return reference(*this, index);
+    }
+
+    /// Returns a reference to the value at \p index. Throws
+    /// \c std::out_of_range if \p index is not less than size().
+    reference at(size_type index)
+    {
+        if(index >= size()){
+            BOOST_THROW_EXCEPTION(std::out_of_range("index out of range"));
+        }
+
+        return operator[](index);
+    }
+
+    /// Replaces the values with the values in the host range [\p first,
+    /// \p last).
+    template<class InputIterator>
+    void assign(InputIterator first,
+                InputIterator last,
+                command_queue &queue = system::default_queue())
+    {
+        const std::vector<T> values(first, last);
+
+        resize(values.size(), queue);
+
+        detail::soa_scatter<T> scatter(values, queue);
+        m_columns.for_each(scatter, members_type::pointers());
+    }
+
+    /// Copies the values to the host range beginning at \p result and
+    /// returns an iterator one past the last value written.
+    template<class OutputIterator>
+    OutputIterator copy_to(OutputIterator result,
+                           command_queue &queue = system::default_queue())
+    {
+        std::vector<T> values(size());
+
+        detail::soa_gather<T> gather(values, queue);
+        m_columns.for_each(gather, members_type::pointers());
+
+        return std::copy(values.begin(), values.end(), result);
+    }
+
+    /// Returns the column storing the \p N-th member of \c T.
+    template<size_t N>
+    typename detail::soa_column_at<N, columns_type>::type& column()
+    {
+        return detail::soa_column_at<N, columns_type>::get(m_columns);
+    }
+
+    /// Returns the column storing \p member. For example:
+    /// \code
+    /// boost::compute::vector<float> &x = particles.column(&Particle::x);
+    /// \endcode
+    template<class Member>
+    vector<Member>& column(Member T::*member)
+    {
+        detail::soa_find_column<T, Member> find(member);
+        m_columns.for_each(find, members_type::pointers());
+
+        if(!find.m_column){
+            BOOST_THROW_EXCEPTION(
+                std::invalid_argument("member is not adapted")
+            );
+        }
+
+        return *find.m_column;
+    }
+
+    /// Returns the number of columns (i.e. the number of adapted members
+    /// of \c T).
+    static size_type column_count()
+    {
+        return boost::tuples::length<pointers_type>::value;
+    }
+
+    /// Returns the name of the member stored in the column at \p index.
+    static const char* column_name(size_type index)
+    {
+        BOOST_ASSERT(index < column_count());
+
+        return members_type::name(index);
+    }
+
+    /// Returns an iterator to the first value as a tuple of its members.
+    iterator begin()
+    {
+        return iterator(iterator_tuple(m_columns.begin()));
+    }
+
+    /// Returns an iterator one past the last value.
+    iterator end()
+    {
+        return iterator(iterator_tuple(m_columns.end()));
+    }
+
+private:
+    command_queue default_queue() const
+    {
+        const context &context = get_context();
+        command_queue queue(context, context.get_device());
+        return queue;
+    }
+
+private:
+    columns_type m_columns;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
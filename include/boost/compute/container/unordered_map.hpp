@@ -0,0 +1,658 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
+#define BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/functional/hash.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class unordered_map
+/// \brief A hash table mapping keys to values stored on a compute device.
+///
+/// The unordered_map class stores its elements in an open-addressing hash
+/// table with linear probing. Unlike flat_map, which inserts one element at
+/// a time into a sorted vector, all of the operations on unordered_map work
+/// on ranges of keys and are executed with a single kernel which uses atomic
+/// compare-and-swap to claim slots in the table.
+///
+/// For example, to insert a range of keys and values and then look them up:
+/// \code
+/// boost::compute::unordered_map<int, float> map(context);
+/// map.insert(keys.begin(), keys.end(), values.begin(), queue);
+/// map.find(keys.begin(), keys.end(), results.begin(), -1.f, queue);
+/// \endcode
+///
+/// The key type must be \c int_ or \c uint_. The two largest values of the
+/// key type (returned by empty_key() and erased_key()) are reserved to mark
+/// free and erased slots and are ignored when passed to any of the
+/// operations.
+///
+/// The table is automatically rehashed into a larger one when an insert
+/// would raise the load factor above max_load_factor().
+///
+/// \see \ref flat_map "flat_map<Key, T>"
+template<class Key, class T>
+class unordered_map
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef ::boost::compute::hash<Key> hasher;
+    typedef typename ::boost::compute::vector<Key>::size_type size_type;
+
+    BOOST_STATIC_ASSERT_MSG(
+        (boost::is_same<Key, int_>::value || boost::is_same<Key, uint_>::value),
+        "unordered_map only supports int_ and uint_ keys"
+    );
+
+    /// Creates a new, empty unordered map in \p context.
+    explicit unordered_map(const context &context = system::default_context())
+        : m_keys(context),
+          m_values(context),
+          m_size(0),
+          m_erased(0),
+          m_max_load_factor(0.5f)
+    {
+    }
+
+    /// Creates a new, empty unordered map with at least \p bucket_count
+    /// slots.
+    unordered_map(size_type bucket_count, command_queue &queue)
+        : m_keys(queue.get_context()),
+          m_values(queue.get_context()),
+          m_size(0),
+          m_erased(0),
+          m_max_load_factor(0.5f)
+    {
+        rehash(bucket_count, queue);
+    }
+
+    /// Creates a new unordered map as a copy of \p other.
+    unordered_map(const unordered_map<Key, T> &other)
+        : m_keys(other.m_keys),
+          m_values(other.m_values),
+          m_size(other.m_size),
+          m_erased(other.m_erased),
+          m_max_load_factor(other.m_max_load_factor)
+    {
+    }
+
+    /// Copies the elements of \p other to \c *this.
+    unordered_map<Key, T>& operator=(const unordered_map<Key, T> &other)
+    {
+        if(this != &other){
+            m_keys = other.m_keys;
+            m_values = other.m_values;
+            m_size = other.m_size;
+            m_erased = other.m_erased;
+            m_max_load_factor = other.m_max_load_factor;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the unordered map.
+    ~unordered_map()
+    {
+    }
+
+    /// Returns the number of elements in the map.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the map contains no elements.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the number of slots in the hash table.
+    size_type bucket_count() const
+    {
+        return m_keys.size();
+    }
+
+    /// Returns the ratio of elements to slots in the hash table.
+    float load_factor() const
+    {
+        return bucket_count() == 0 ? 0.f : float(m_size) / float(bucket_count());
+    }
+
+    /// Returns the maximum load factor.
+    float max_load_factor() const
+    {
+        return m_max_load_factor;
+    }
+
+    /// Sets the maximum load factor to \p factor. Throws
+    /// \c std::invalid_argument if \p factor is not in (0, 1), since the
+    /// probing relies on the table never being full.
+    void max_load_factor(float factor)
+    {
+        if(!(factor > 0.f && factor < 1.f)){
+            BOOST_THROW_EXCEPTION(
+                std::invalid_argument("max_load_factor must be in (0, 1)")
+            );
+        }
+
+        m_max_load_factor = factor;
+    }
+
+    /// Returns the key value used to mark empty slots.
+    static key_type empty_key()
+    {
+        return (std::numeric_limits<key_type>::max)();
+    }
+
+    /// Returns the key value used to mark erased slots.
+    static key_type erased_key()
+    {
+        return empty_key() - 1;
+    }
+
+    /// Inserts the keys in the range [\p keys_first, \p keys_last) with the
+    /// values from the range beginning at \p values_first. Keys which are
+    /// already present in the map keep their current value. If a key appears
+    /// more than once in the range one of its values is inserted.
+    ///
+    /// Returns the number of newly inserted keys.
+    template<class KeyIterator, class ValueIterator>
+    size_type insert(KeyIterator keys_first,
+                     KeyIterator keys_last,
+                     ValueIterator values_first,
+                     command_queue &queue)
+    {
+        const size_t count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0){
+            return 0;
+        }
+
+        reserve_for(m_size + m_erased + count, queue);
+
+        const size_type inserted = insert_impl(
+            keys_first, count, values_first, m_keys, m_values, queue
+        );
+        m_size += inserted;
+
+        return inserted;
+    }
+
+    /// \overload
+    template<class KeyIterator, class ValueIterator>
+    size_type insert(KeyIterator keys_first,
+                     KeyIterator keys_last,
+                     ValueIterator values_first)
+    {
+        command_queue queue = m_keys.default_queue();
+        size_type inserted = insert(keys_first, keys_last, values_first, queue);
+        queue.finish();
+        return inserted;
+    }
+
+    /// Looks up each key in the range [\p keys_first, \p keys_last) and
+    /// writes its value to the range beginning at \p result. Keys which are
+    /// not in the map produce \p default_value.
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        const mapped_type &default_value,
+                        command_queue &queue) const
+    {
+        const size_t count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0){
+            return result;
+        }
+
+        detail::meta_kernel k("unordered_map_find");
+        k.add_set_arg<const key_type>("empty_key", empty_key());
+        k.add_set_arg<const key_type>("erased_key", erased_key());
+        k.add_set_arg<const uint_>("mask", mask());
+        k.add_set_arg<const mapped_type>("default_value", default_value);
+
+        const std::string table_keys =
+            k.get_buffer_identifier<key_type>(m_keys.get_buffer());
+        const std::string table_values =
+            k.get_buffer_identifier<mapped_type>(m_values.get_buffer());
+
+        k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+          << k.decl<const key_type>("key") << " = "
+          <<     keys_first[k.var<const uint_>("i")] << ";\n"
+          << k.decl<mapped_type>("value") << " = default_value;\n"
+          << "if(key != empty_key && key != erased_key && mask != 0){\n"
+          << "    uint slot = (uint)("
+          <<          hasher()(k.var<const key_type>("key")) << ") & mask;\n"
+          << "    for(uint probe = 0; probe <= mask; probe++){\n"
+          << "        const " << k.type<key_type>() << " current = "
+          <<              table_keys << "[slot];\n"
+          << "        if(current == key){\n"
+          << "            value = " << table_values << "[slot];\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        else if(current == empty_key){\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        slot = (slot + 1) & mask;\n"
+          << "    }\n"
+          << "}\n"
+          << result[k.var<const uint_>("i")] << " = value;\n";
+
+        k.exec_1d(queue, 0, count);
+
+        return result + count;
+    }
+
+    /// \overload
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator find(KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        const mapped_type &default_value) const
+    {
+        command_queue queue = m_keys.default_queue();
+        OutputIterator iter =
+            find(keys_first, keys_last, result, default_value, queue);
+        queue.finish();
+        return iter;
+    }
+
+    /// Writes \c 1 to the range beginning at \p result for each key in the
+    /// range [\p keys_first, \p keys_last) which is in the map and \c 0 for
+    /// each key which is not.
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator contains(KeyIterator keys_first,
+                            KeyIterator keys_last,
+                            OutputIterator result,
+                            command_queue &queue) const
+    {
+        const size_t count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0){
+            return result;
+        }
+
+        detail::meta_kernel k("unordered_map_contains");
+        k.add_set_arg<const key_type>("empty_key", empty_key());
+        k.add_set_arg<const key_type>("erased_key", erased_key());
+        k.add_set_arg<const uint_>("mask", mask());
+
+        const std::string table_keys =
+            k.get_buffer_identifier<key_type>(m_keys.get_buffer());
+
+        k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+          << k.decl<const key_type>("key") << " = "
+          <<     keys_first[k.var<const uint_>("i")] << ";\n"
+          << "uint found = 0;\n"
+          << "if(key != empty_key && key != erased_key && mask != 0){\n"
+          << "    uint slot = (uint)("
+          <<          hasher()(k.var<const key_type>("key")) << ") & mask;\n"
+          << "    for(uint probe = 0; probe <= mask; probe++){\n"
+          << "        const " << k.type<key_type>() << " current = "
+          <<              table_keys << "[slot];\n"
+          << "        if(current == key){\n"
+          << "            found = 1;\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        else if(current == empty_key){\n"
+          << "            break;\n"
+          << "        }\n"
+          << "        slot = (slot + 1) & mask;\n"
+          << "    }\n"
+          << "}\n"
+          << result[k.var<const uint_>("i")] << " = found;\n";
+
+        k.exec_1d(queue, 0, count);
+
+        return result + count;
+    }
+
+    /// \overload
+    template<class KeyIterator, class OutputIterator>
+    OutputIterator contains(KeyIterator keys_first,
+                            KeyIterator keys_last,
+                            OutputIterator result) const
+    {
+        command_queue queue = m_keys.default_queue();
+        OutputIterator iter = contains(keys_first, keys_last, result, queue);
+        queue.finish();
+        return iter;
+    }
+
+    /// Removes each key in the range [\p keys_first, \p keys_last) from the
+    /// map.
+    ///
+    /// Returns the number of keys which were removed.
+    template<class KeyIterator>
+    size_type erase(KeyIterator keys_first,
+                    KeyIterator keys_last,
+                    command_queue &queue)
+    {
+        const size_t count = detail::iterator_range_size(keys_first, keys_last);
+        if(count == 0 || m_size == 0){
+            return 0;
+        }
+
+        detail::meta_kernel k("unordered_map_erase");
+        size_t counter_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "counter");
+        k.add_set_arg<const key_type>("empty_key", empty_key());
+        k.add_set_arg<const key_type>("erased_key", erased_key());
+        k.add_set_arg<const uint_>("mask", mask());
+
+        const std::string table_keys =
+            k.get_buffer_identifier<key_type>(m_keys.get_buffer());
+
+        k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+          << k.decl<const key_type>("key") << " = "
+          <<     keys_first[k.var<const uint_>("i")] << ";\n"
+          << "if(key == empty_key || key == erased_key){\n"
+          << "    return;\n"
+          << "}\n"
+          << "uint slot = (uint)("
+          <<     hasher()(k.var<const key_type>("key")) << ") & mask;\n"
+          << "for(uint probe = 0; probe <= mask; probe++){\n"
+          << "    const " << k.type<key_type>() << " current = "
+          <<          table_keys << "[slot];\n"
+          << "    if(current == key){\n"
+          << "        if(" << atomic_cmpxchg<key_type>()(
+                                  k.expr<key_type *>("&" + table_keys + "[slot]"),
+                                  k.var<const key_type>("key"),
+                                  k.var<const key_type>("erased_key")
+                              ) << " == key){\n"
+          << "            " << atomic_inc<uint_>()(k.var<uint_ *>("counter")) << ";\n"
+          << "        }\n"
+          << "        return;\n"
+          << "    }\n"
+          << "    else if(current == empty_key){\n"
+          << "        return;\n"
+          << "    }\n"
+          << "    slot = (slot + 1) & mask;\n"
+          << "}\n";
+
+        detail::scalar<uint_> counter(queue.get_context());
+        counter.write(0, queue);
+        k.set_arg(counter_arg, counter.get_buffer());
+
+        k.exec_1d(queue, 0, count);
+
+        const size_type erased = counter.read(queue);
+        m_size -= erased;
+        m_erased += erased;
+
+        return erased;
+    }
+
+    /// \overload
+    template<class KeyIterator>
+    size_type erase(KeyIterator keys_first, KeyIterator keys_last)
+    {
+        command_queue queue = m_keys.default_queue();
+        size_type erased = erase(keys_first, keys_last, queue);
+        queue.finish();
+        return erased;
+    }
+
+    /// Copies all of the keys in the map to the range beginning at
+    /// \p keys_result and their values to the range beginning at
+    /// \p values_result. The order of the elements is unspecified.
+    ///
+    /// Returns the number of elements copied (i.e. \c size()).
+    template<class KeyOutputIterator, class ValueOutputIterator>
+    size_type retrieve_all(KeyOutputIterator keys_result,
+                           ValueOutputIterator values_result,
+                           command_queue &queue) const
+    {
+        if(m_size == 0){
+            return 0;
+        }
+
+        detail::meta_kernel k("unordered_map_retrieve_all");
+        size_t counter_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "counter");
+        k.add_set_arg<const key_type>("empty_key", empty_key());
+        k.add_set_arg<const key_type>("erased_key", erased_key());
+
+        k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+          << k.decl<const key_type>("key") << " = "
+          <<     m_keys.begin()[k.var<const uint_>("i")] << ";\n"
+          << "if(key != empty_key && key != erased_key){\n"
+          << "    " << k.decl<const uint_>("j") << " = "
+          <<          atomic_inc<uint_>()(k.var<uint_ *>("counter")) << ";\n"
+          << "    " << keys_result[k.var<const uint_>("j")] << " = key;\n"
+          << "    " << values_result[k.var<const uint_>("j")] << " = "
+          <<          m_values.begin()[k.var<const uint_>("i")] << ";\n"
+          << "}\n";
+
+        detail::scalar<uint_> counter(queue.get_context());
+        counter.write(0, queue);
+        k.set_arg(counter_arg, counter.get_buffer());
+
+        k.exec_1d(queue, 0, bucket_count());
+
+        return counter.read(queue);
+    }
+
+    /// \overload
+    template<class KeyOutputIterator, class ValueOutputIterator>
+    size_type retrieve_all(KeyOutputIterator keys_result,
+                           ValueOutputIterator values_result) const
+    {
+        command_queue queue = m_keys.default_queue();
+        size_type count = retrieve_all(keys_result, values_result, queue);
+        queue.finish();
+        return count;
+    }
+
+    /// Rebuilds the hash table with at least \p bucket_count slots (rounded
+    /// up to a power of two and to fit the current elements). This also
+    /// discards the slots of erased elements.
+    void rehash(size_type bucket_count, command_queue &queue)
+    {
+        const size_type required = slots_for(m_size);
+        size_type new_bucket_count = 16;
+        while(new_bucket_count < bucket_count || new_bucket_count < required){
+            new_bucket_count *= 2;
+        }
+
+        ::boost::compute::vector<Key> new_keys(
+            new_bucket_count, queue.get_context()
+        );
+        ::boost::compute::vector<T> new_values(
+            new_bucket_count, queue.get_context()
+        );
+        ::boost::compute::fill(
+            new_keys.begin(), new_keys.end(), empty_key(), queue
+        );
+
+        if(m_size != 0){
+            // reserved keys are skipped so only live elements are reinserted
+            insert_impl(
+                m_keys.begin(), m_keys.size(), m_values.begin(),
+                new_keys, new_values, queue
+            );
+        }
+
+        m_keys.swap(new_keys);
+        m_values.swap(new_values);
+        m_erased = 0;
+    }
+
+    /// \overload
+    void rehash(size_type bucket_count)
+    {
+        command_queue queue = m_keys.default_queue();
+        rehash(bucket_count, queue);
+        queue.finish();
+    }
+
+    /// Resizes the hash table to hold at least \p count elements without
+    /// exceeding max_load_factor().
+    void reserve(size_type count, command_queue &queue)
+    {
+        if(slots_for(count) > bucket_count()){
+            rehash(slots_for(count), queue);
+        }
+    }
+
+    /// \overload
+    void reserve(size_type count)
+    {
+        command_queue queue = m_keys.default_queue();
+        reserve(count, queue);
+        queue.finish();
+    }
+
+    /// Removes all elements from the map. The number of slots is unchanged.
+    void clear(command_queue &queue)
+    {
+        if(!m_keys.empty()){
+            ::boost::compute::fill(
+                m_keys.begin(), m_keys.end(), empty_key(), queue
+            );
+        }
+
+        m_size = 0;
+        m_erased = 0;
+    }
+
+    /// \overload
+    void clear()
+    {
+        command_queue queue = m_keys.default_queue();
+        clear(queue);
+        queue.finish();
+    }
+
+    /// Returns the buffer containing the key of each slot.
+    const buffer& get_keys_buffer() const
+    {
+        return m_keys.get_buffer();
+    }
+
+    /// Returns the buffer containing the value of each slot.
+    const buffer& get_values_buffer() const
+    {
+        return m_values.get_buffer();
+    }
+
+private:
+    /// \internal_
+    uint_ mask() const
+    {
+        return bucket_count() == 0 ? 0 : static_cast<uint_>(bucket_count() - 1);
+    }
+
+    /// \internal_
+    size_type slots_for(size_type count) const
+    {
+        return static_cast<size_type>(
+            std::ceil(static_cast<double>(count) / m_max_load_factor)
+        );
+    }
+
+    /// \internal_
+    void reserve_for(size_type occupied, command_queue &queue)
+    {
+        if(slots_for(occupied) > bucket_count()){
+            rehash(slots_for(occupied - m_erased), queue);
+        }
+    }
+
+    /// \internal_
+    template<class KeyIterator, class ValueIterator>
+    static size_type insert_impl(KeyIterator keys_first,
+                                 size_t count,
+                                 ValueIterator values_first,
+                                 ::boost::compute::vector<Key> &table_keys,
+                                 ::boost::compute::vector<T> &table_values,
+                                 command_queue &queue)
+    {
+        detail::meta_kernel k("unordered_map_insert");
+        size_t counter_arg =
+            k.add_arg<uint_ *>(memory_object::global_memory, "counter");
+        k.add_set_arg<const key_type>("empty_key", empty_key());
+        k.add_set_arg<const key_type>("erased_key", erased_key());
+        k.add_set_arg<const uint_>("mask", static_cast<uint_>(table_keys.size() - 1));
+
+        const std::string keys =
+            k.get_buffer_identifier<key_type>(table_keys.get_buffer());
+
+        k << k.decl<const uint_>("i") << " = get_global_id(0);\n"
+          << k.decl<const key_type>("key") << " = "
+          <<     keys_first[k.var<const uint_>("i")] << ";\n"
+          << "if(key == empty_key || key == erased_key){\n"
+          << "    return;\n"
+          << "}\n"
+          << "uint slot = (uint)("
+          <<     hasher()(k.var<const key_type>("key")) << ") & mask;\n"
+          << "for(uint probe = 0; probe <= mask; probe++){\n"
+          << "    " << k.decl<const key_type>("prev") << " = "
+          <<          atomic_cmpxchg<key_type>()(
+                          k.expr<key_type *>("&" + keys + "[slot]"),
+                          k.var<const key_type>("empty_key"),
+                          k.var<const key_type>("key")
+                      ) << ";\n"
+          << "    if(prev == empty_key){\n"
+          << "        " << table_values.begin()[k.var<uint_>("slot")] << " = "
+          <<              values_first[k.var<const uint_>("i")] << ";\n"
+          << "        " << atomic_inc<uint_>()(k.var<uint_ *>("counter")) << ";\n"
+          << "        return;\n"
+          << "    }\n"
+          << "    else if(prev == key){\n"
+          << "        return;\n"
+          << "    }\n"
+          << "    slot = (slot + 1) & mask;\n"
+          << "}\n";
+
+        detail::scalar<uint_> counter(queue.get_context());
+        counter.write(0, queue);
+        k.set_arg(counter_arg, counter.get_buffer());
+
+        k.exec_1d(queue, 0, count);
+
+        return counter.read(queue);
+    }
+
+private:
+    ::boost::compute::vector<Key> m_keys;
+    ::boost::compute::vector<T> m_values;
+    size_type m_size;
+    size_type m_erased;
+    float m_max_load_factor;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_UNORDERED_MAP_HPP
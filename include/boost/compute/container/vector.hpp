@@ -592,7 +592,8 @@ public:
     /// is inefficient as there is a non-trivial overhead in performing a data
     /// transfer to the device. It is usually better to store a set of values
     /// on the host (for example, in a \c std::vector) and then transfer them
-    /// in bulk using the \c insert() method or the copy() algorithm.
+    /// in bulk using the \c insert() method or the copy() algorithm, or to
+    /// append them with a \ref vector_builder which does this automatically.
     void push_back(const T &value, command_queue &queue)
     {
         insert(end(), value, queue);
@@ -0,0 +1,207 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_VECTOR_BUILDER_HPP
+#define BOOST_COMPUTE_CONTAINER_VECTOR_BUILDER_HPP
+
+#include <algorithm>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/allocator/buffer_allocator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class vector_builder
+/// \brief Appends values to a vector in large batches.
+///
+/// Each call to vector::push_back() enqueues a separate write of a single
+/// value. The vector_builder class instead stores appended values in a
+/// staging buffer in pinned host memory and writes them to the end of the
+/// vector with a single command once the staging buffer is full (or when
+/// flush() is called).
+///
+/// Two staging buffers are used so that values can be appended while the
+/// previous batch is written. Writes are enqueued to the builder's command
+/// queue without waiting for them to complete, so commands enqueued to the
+/// same queue afterwards see the written values. The vector must not be
+/// used with other queues until wait() was called.
+///
+/// For example, to append values received on the host:
+///
+/// \snippet test/test_vector_builder.cpp append_values
+///
+/// Values which have not been flushed are not part of the vector. The
+/// builder flushes and waits for all writes when it is destroyed.
+///
+/// \see vector
+template<class T, class Alloc = buffer_allocator<T> >
+class vector_builder : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+
+    /// Creates a vector builder which appends values to \p vector with
+    /// \p queue. Up to \p batch_size values are written at once.
+    explicit vector_builder(vector<T, Alloc> &vector,
+                            command_queue &queue = system::default_queue(),
+                            size_type batch_size = 65536)
+        : m_vector(vector),
+          m_queue(queue),
+          m_batch_size((std::max)(batch_size, size_type(1))),
+          m_staged(0),
+          m_current(0)
+    {
+        const context &context = queue.get_context();
+
+        for(size_t i = 0; i < 2; i++){
+            m_staging[i] = buffer(
+                context,
+                m_batch_size * sizeof(T),
+                buffer::read_write | buffer::alloc_host_ptr
+            );
+
+            m_staging_ptr[i] = static_cast<T *>(
+                queue.enqueue_map_buffer(
+                    m_staging[i], CL_MAP_WRITE, 0, m_batch_size * sizeof(T)
+                )
+            );
+        }
+    }
+
+    /// Flushes the remaining values, waits for all writes to complete and
+    /// destroys the vector builder.
+    ~vector_builder()
+    {
+        flush();
+        wait();
+
+        for(size_t i = 0; i < 2; i++){
+            m_queue.enqueue_unmap_buffer(m_staging[i], m_staging_ptr[i]);
+        }
+    }
+
+    /// Appends \p value.
+    void push_back(const T &value)
+    {
+        m_staging_ptr[m_current][m_staged++] = value;
+
+        if(m_staged == m_batch_size){
+            flush();
+        }
+    }
+
+    /// Appends the values in the host range [\p first, \p last).
+    template<class InputIterator>
+    void append(InputIterator first, InputIterator last)
+    {
+        while(first != last){
+            T *staging = m_staging_ptr[m_current];
+            while(first != last && m_staged < m_batch_size){
+                staging[m_staged++] = *first++;
+            }
+
+            if(m_staged == m_batch_size){
+                flush();
+            }
+        }
+    }
+
+    /// Enqueues a write of the staged values to the end of the vector.
+    void flush()
+    {
+        if(m_staged == 0){
+            return;
+        }
+
+        const size_type offset = m_vector.size();
+        m_vector.resize(offset + m_staged, m_queue);
+
+        m_events[m_current] = m_queue.enqueue_write_buffer_async(
+            m_vector.get_buffer(),
+            offset * sizeof(T),
+            m_staged * sizeof(T),
+            m_staging_ptr[m_current]
+        );
+
+        m_staged = 0;
+        m_current = 1 - m_current;
+
+        // the other staging buffer may still be read by its previous write
+        if(m_events[m_current].get()){
+            m_events[m_current].wait();
+        }
+    }
+
+    /// Waits for the enqueued writes to complete.
+    void wait()
+    {
+        for(size_t i = 0; i < 2; i++){
+            if(m_events[i].get()){
+                m_events[i].wait();
+            }
+        }
+    }
+
+    /// Returns the number of values in the vector plus the number of
+    /// staged values.
+    size_type size() const
+    {
+        return m_vector.size() + m_staged;
+    }
+
+    /// Returns the number of values which have not been flushed yet.
+    size_type staged() const
+    {
+        return m_staged;
+    }
+
+    /// Returns the number of values which are written at once.
+    size_type batch_size() const
+    {
+        return m_batch_size;
+    }
+
+    /// Flushes the staged values and returns the vector.
+    vector<T, Alloc>& get_vector()
+    {
+        flush();
+
+        return m_vector;
+    }
+
+    /// Returns the command queue for the vector builder.
+    command_queue& get_queue()
+    {
+        return m_queue;
+    }
+
+private:
+    vector<T, Alloc> &m_vector;
+    command_queue m_queue;
+    size_type m_batch_size;
+    size_type m_staged;
+    size_t m_current;
+    buffer m_staging[2];
+    T *m_staging_ptr[2];
+    event m_events[2];
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_VECTOR_BUILDER_HPP
@@ -16,6 +16,7 @@
 /// Meta-header to include all Boost.Compute core headers.
 
 #include <boost/compute/buffer.hpp>
+#include <boost/compute/command_graph.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/config.hpp>
 #include <boost/compute/context.hpp>
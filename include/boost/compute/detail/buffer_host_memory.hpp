@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_BUFFER_HOST_MEMORY_HPP
+#define BOOST_COMPUTE_DETAIL_BUFFER_HOST_MEMORY_HPP
+
+#include <functional>
+#include <map>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/config.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// the host memory of the buffers created with CL_MEM_USE_HOST_PTR by
+// host_mapped_allocator. copies only compare host pointers with the host
+// memory of these buffers, so that other copies do not query the buffer.
+class buffer_host_memory_registry
+{
+public:
+    static void insert(const buffer &buffer, const void *host_ptr)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(get_mutex());
+    #endif
+        get_entries()[buffer.get()] = host_ptr;
+    }
+
+    static void erase(const buffer &buffer)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(get_mutex());
+    #endif
+        get_entries().erase(buffer.get());
+    }
+
+    // returns the host memory of buffer or null if it was not registered
+    static const void* find(const buffer &buffer)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(get_mutex());
+    #endif
+        const entry_map &entries = get_entries();
+        if(entries.empty()){
+            return 0;
+        }
+
+        entry_map::const_iterator i = entries.find(buffer.get());
+
+        return i != entries.end() ? i->second : 0;
+    }
+
+private:
+    typedef std::map<cl_mem, const void *> entry_map;
+
+    static entry_map& get_entries()
+    {
+        BOOST_COMPUTE_DETAIL_SHARED_STATIC(entry_map, entries, ((std::less<cl_mem>())));
+
+        return entries;
+    }
+
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+    static detail::mutex& get_mutex()
+    {
+        static detail::mutex entries_mutex;
+
+        return entries_mutex;
+    }
+    #endif
+};
+
+// returns true if host_ptr points to the host memory of buffer at offset
+// (in bytes). this is only detected for the host memory of buffers
+// created by host_mapped_allocator.
+inline bool is_buffer_host_memory(const buffer &buffer,
+                                  size_t offset,
+                                  const void *host_ptr)
+{
+    const char *buffer_host_ptr =
+        static_cast<const char *>(buffer_host_memory_registry::find(buffer));
+
+    return buffer_host_ptr &&
+           buffer_host_ptr + offset == static_cast<const char *>(host_ptr);
+}
+
+// synchronizes size bytes at offset of the buffer and its host memory by
+// mapping and unmapping them with flags (CL_MAP_READ to make the values
+// of the buffer visible to the host and CL_MAP_WRITE for the opposite).
+// for buffers in memory shared with the device this does not copy.
+inline void synchronize_buffer_host_memory(const buffer &buffer,
+                                           size_t offset,
+                                           size_t size,
+                                           cl_map_flags flags,
+                                           command_queue &queue,
+                                           const wait_list &events)
+{
+    void *ptr = queue.enqueue_map_buffer(buffer, flags, offset, size, events);
+
+    event unmap_event = queue.enqueue_unmap_buffer(buffer, ptr);
+    unmap_event.wait();
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_BUFFER_HOST_MEMORY_HPP
@@ -0,0 +1,316 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_COMMAND_RECORDER_HPP
+#define BOOST_COMPUTE_DETAIL_COMMAND_RECORDER_HPP
+
+#include <map>
+#include <vector>
+#include <cstring>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// stores the commands enqueued to a command queue while it is recording.
+//
+// kernel arguments cannot be queried from OpenCL so every argument set while
+// recording is kept (by value) and the arguments of a kernel are copied into
+// its node when it is enqueued. all kernels and memory objects referenced by
+// the recorded commands are retained so that temporary buffers allocated by
+// the algorithms stay alive for as long as the recording does.
+class command_recorder : boost::noncopyable
+{
+public:
+    enum node_type {
+        kernel_node,
+        copy_buffer_node,
+        fill_buffer_node,
+        write_buffer_node
+    };
+
+    struct kernel_arg
+    {
+        size_t index;
+        size_t size;
+        bool is_null;
+        bool is_memory_object;
+        std::vector<unsigned char> value;
+    };
+
+    struct node
+    {
+        node_type type;
+
+        // kernel_node
+        cl_kernel kernel;
+        cl_uint work_dim;
+        bool has_offset;
+        bool has_local_size;
+        size_t offset[3];
+        size_t global_size[3];
+        size_t local_size[3];
+        std::vector<kernel_arg> args;
+
+        // copy_buffer_node, fill_buffer_node and write_buffer_node
+        cl_mem src;
+        cl_mem dst;
+        size_t src_offset;
+        size_t dst_offset;
+        size_t size;
+        std::vector<unsigned char> data;
+    };
+
+    explicit command_recorder(cl_command_queue queue)
+        : m_queue(queue)
+    {
+    }
+
+    ~command_recorder()
+    {
+        for(size_t i = 0; i < m_kernels.size(); i++){
+            clReleaseKernel(m_kernels[i]);
+        }
+        for(size_t i = 0; i < m_memory_objects.size(); i++){
+            clReleaseMemObject(m_memory_objects[i]);
+        }
+    }
+
+    cl_command_queue queue() const
+    {
+        return m_queue;
+    }
+
+    const std::vector<node>& nodes() const
+    {
+        return m_nodes;
+    }
+
+    std::vector<node>& nodes()
+    {
+        return m_nodes;
+    }
+
+    void record_arg(cl_kernel kernel, size_t index, size_t size, const void *value)
+    {
+        std::map<cl_kernel, std::map<size_t, kernel_arg> >::iterator iter =
+            m_args.find(kernel);
+        if(iter == m_args.end()){
+            // the kernel is retained so that its handle is not reused by
+            // another kernel while recording
+            retain_kernel(kernel);
+            iter = m_args.insert(
+                std::make_pair(kernel, std::map<size_t, kernel_arg>())
+            ).first;
+        }
+
+        kernel_arg &arg = iter->second[index];
+        arg.index = index;
+        arg.size = size;
+        arg.is_null = value == 0;
+        arg.is_memory_object = false;
+        if(value){
+            const unsigned char *bytes = static_cast<const unsigned char *>(value);
+            arg.value.assign(bytes, bytes + size);
+        }
+        else {
+            arg.value.clear();
+        }
+    }
+
+    void record_memory_arg(cl_kernel kernel, size_t index, cl_mem mem)
+    {
+        record_arg(kernel, index, sizeof(cl_mem), &mem);
+        m_args[kernel][index].is_memory_object = true;
+        retain_memory_object(mem);
+    }
+
+    void record_kernel(cl_kernel kernel,
+                       size_t work_dim,
+                       const size_t *global_work_offset,
+                       const size_t *global_work_size,
+                       const size_t *local_work_size)
+    {
+        node n = make_node(kernel_node);
+        n.kernel = kernel;
+        n.work_dim = static_cast<cl_uint>(work_dim);
+        n.has_offset = global_work_offset != 0;
+        n.has_local_size = local_work_size != 0;
+        for(size_t i = 0; i < work_dim && i < 3; i++){
+            n.offset[i] = global_work_offset ? global_work_offset[i] : 0;
+            n.global_size[i] = global_work_size[i];
+            n.local_size[i] = local_work_size ? local_work_size[i] : 0;
+        }
+
+        std::map<cl_kernel, std::map<size_t, kernel_arg> >::const_iterator iter =
+            m_args.find(kernel);
+        if(iter != m_args.end()){
+            std::map<size_t, kernel_arg>::const_iterator arg;
+            for(arg = iter->second.begin(); arg != iter->second.end(); ++arg){
+                n.args.push_back(arg->second);
+            }
+        }
+        else {
+            retain_kernel(kernel);
+        }
+
+        m_nodes.push_back(n);
+    }
+
+    void record_copy_buffer(cl_mem src,
+                            cl_mem dst,
+                            size_t src_offset,
+                            size_t dst_offset,
+                            size_t size)
+    {
+        node n = make_node(copy_buffer_node);
+        n.src = src;
+        n.dst = dst;
+        n.src_offset = src_offset;
+        n.dst_offset = dst_offset;
+        n.size = size;
+        retain_memory_object(src);
+        retain_memory_object(dst);
+
+        m_nodes.push_back(n);
+    }
+
+    void record_fill_buffer(cl_mem dst,
+                            const void *pattern,
+                            size_t pattern_size,
+                            size_t offset,
+                            size_t size)
+    {
+        node n = make_node(fill_buffer_node);
+        n.dst = dst;
+        n.dst_offset = offset;
+        n.size = size;
+        const unsigned char *bytes = static_cast<const unsigned char *>(pattern);
+        n.data.assign(bytes, bytes + pattern_size);
+        retain_memory_object(dst);
+
+        m_nodes.push_back(n);
+    }
+
+    // the host data is copied so that it is written again on each replay
+    void record_write_buffer(cl_mem dst,
+                             size_t offset,
+                             size_t size,
+                             const void *host_ptr)
+    {
+        node n = make_node(write_buffer_node);
+        n.dst = dst;
+        n.dst_offset = offset;
+        n.size = size;
+        const unsigned char *bytes = static_cast<const unsigned char *>(host_ptr);
+        n.data.assign(bytes, bytes + size);
+        retain_memory_object(dst);
+
+        m_nodes.push_back(n);
+    }
+
+    // replaces all uses of the memory object from with to
+    void rebind(cl_mem from, cl_mem to)
+    {
+        bool used = false;
+        for(size_t i = 0; i < m_nodes.size(); i++){
+            node &n = m_nodes[i];
+            for(size_t j = 0; j < n.args.size(); j++){
+                kernel_arg &arg = n.args[j];
+                if(arg.is_memory_object &&
+                   std::memcmp(&arg.value[0], &from, sizeof(cl_mem)) == 0){
+                    std::memcpy(&arg.value[0], &to, sizeof(cl_mem));
+                    used = true;
+                }
+            }
+            if(n.src == from){
+                n.src = to;
+                used = true;
+            }
+            if(n.dst == from){
+                n.dst = to;
+                used = true;
+            }
+        }
+
+        if(used){
+            retain_memory_object(to);
+        }
+    }
+
+    // returns the recorder of the command queue which is recording in the
+    // calling thread (or null if there is none)
+    static command_recorder*& active()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(command_recorder *, recorder, (0));
+
+        return recorder;
+    }
+
+    // returns the active recorder if it is recording queue
+    static command_recorder* active(cl_command_queue queue)
+    {
+        command_recorder *recorder = active();
+        if(recorder && recorder->m_queue == queue){
+            return recorder;
+        }
+
+        return 0;
+    }
+
+private:
+    static node make_node(node_type type)
+    {
+        node n;
+        n.type = type;
+        n.kernel = 0;
+        n.work_dim = 0;
+        n.has_offset = false;
+        n.has_local_size = false;
+        n.src = 0;
+        n.dst = 0;
+        n.src_offset = 0;
+        n.dst_offset = 0;
+        n.size = 0;
+        return n;
+    }
+
+    void retain_kernel(cl_kernel kernel)
+    {
+        clRetainKernel(kernel);
+        m_kernels.push_back(kernel);
+    }
+
+    void retain_memory_object(cl_mem mem)
+    {
+        if(mem){
+            clRetainMemObject(mem);
+            m_memory_objects.push_back(mem);
+        }
+    }
+
+private:
+    cl_command_queue m_queue;
+    std::vector<node> m_nodes;
+    std::map<cl_kernel, std::map<size_t, kernel_arg> > m_args;
+    std::vector<cl_kernel> m_kernels;
+    std::vector<cl_mem> m_memory_objects;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_COMMAND_RECORDER_HPP
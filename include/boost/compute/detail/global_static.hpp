@@ -34,4 +34,12 @@
      static type name ctor;
 #endif
 
+// BOOST_COMPUTE_DETAIL_SHARED_STATIC declares a static object which, unlike
+// BOOST_COMPUTE_DETAIL_GLOBAL_STATIC, is shared by all threads. Its
+// initialization is thread-safe (as for any function-local static) but
+// accesses to it must be synchronized by the caller when
+// BOOST_COMPUTE_THREAD_SAFE is defined.
+#define BOOST_COMPUTE_DETAIL_SHARED_STATIC(type, name, ctor) \
+  static type name ctor;
+
 #endif // BOOST_COMPUTE_DETAIL_GLOBAL_STATIC_HPP
@@ -0,0 +1,125 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_KERNEL_REGISTRY_HPP
+#define BOOST_COMPUTE_DETAIL_KERNEL_REGISTRY_HPP
+
+#include <map>
+#include <utility>
+
+#include <boost/noncopyable.hpp>
+#include <boost/mpl/has_xxx.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/detail/global_static.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// function objects whose generated source depends only on their type (the
+// built-in operators and functions) declare a nested type_keyed_source
+// typedef. kernels using them can be registered by type.
+BOOST_MPL_HAS_XXX_TRAIT_DEF(type_keyed_source)
+
+template<class Function>
+struct is_type_keyed_function : has_type_keyed_source<Function>
+{
+};
+
+// returns a key which is unique for each type without requiring rtti
+template<class Key>
+struct kernel_registry_key
+{
+    static const void* get()
+    {
+        static const char key = 0;
+        return &key;
+    }
+};
+
+// a cache of prepared kernel objects keyed by a type and a context.
+//
+// unlike meta_kernel::compile(), which generates the complete source for
+// each call and looks it up by its sha1 hash, a kernel registered by type is
+// found with a single pointer comparison and its source is only generated
+// the first time it is used with a context. the kernel source must therefore
+// be fully determined by the key type, with all other values (buffers,
+// offsets, sizes) passed as kernel arguments.
+class kernel_registry : boost::noncopyable
+{
+public:
+    typedef std::pair<const void *, cl_context> key_type;
+
+    kernel_registry(size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_kernels.size();
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    void clear()
+    {
+        m_kernels.clear();
+    }
+
+    // returns the kernel for Key in context. if it is not yet registered
+    // the kernel is created by calling generator(context)
+    template<class Key, class Generator>
+    kernel& get_or_create(const context &context, Generator generator)
+    {
+        const key_type key(kernel_registry_key<Key>::get(), context.get());
+
+        std::map<key_type, kernel>::iterator iter = m_kernels.find(key);
+        if(iter == m_kernels.end()){
+            kernel k = generator(context);
+
+            // the registry only grows with new types and contexts, when it
+            // is full it is simply emptied (this also releases the contexts
+            // which are no longer used)
+            if(m_kernels.size() >= m_capacity){
+                m_kernels.clear();
+            }
+
+            iter = m_kernels.insert(std::make_pair(key, k)).first;
+        }
+
+        return iter->second;
+    }
+
+    // returns the registry for the calling thread. kernel objects hold
+    // their argument values so they are not shared between threads, the
+    // programs they are created from are shared through the program cache.
+    static kernel_registry& get_global_registry()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(kernel_registry, registry, (128));
+
+        return registry;
+    }
+
+private:
+    size_t m_capacity;
+    std::map<key_type, kernel> m_kernels;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_KERNEL_REGISTRY_HPP
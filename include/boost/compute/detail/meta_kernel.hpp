@@ -39,6 +39,10 @@
 #include <boost/compute/detail/sha1.hpp>
 #include <boost/compute/utility/program_cache.hpp>
 
+#ifdef BOOST_COMPUTE_ENABLE_TRACING
+#include <boost/compute/utility/tracer.hpp>
+#endif
+
 namespace boost {
 namespace compute {
 namespace detail {
@@ -376,6 +380,10 @@ public:
         // create kernel
         ::boost::compute::kernel kernel = program.create_kernel(name());
 
+        #ifdef BOOST_COMPUTE_ENABLE_TRACING
+        tracer::global().set_cache_key(kernel, cache_key);
+        #endif
+
         // bind stored args
         for(size_t i = 0; i < m_stored_args.size(); i++){
             const detail::meta_kernel_stored_arg &arg = m_stored_args[i];
@@ -0,0 +1,48 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_MUTEX_HPP
+#define BOOST_COMPUTE_DETAIL_MUTEX_HPP
+
+#include <boost/compute/config.hpp>
+
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+#  ifdef BOOST_COMPUTE_USE_CPP11
+#    include <mutex>
+#    include <condition_variable>
+#  else
+#    include <boost/thread/mutex.hpp>
+#    include <boost/thread/locks.hpp>
+#    include <boost/thread/condition_variable.hpp>
+#  endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// synchronization primitives for the state shared between threads when
+// BOOST_COMPUTE_THREAD_SAFE is defined
+#ifdef BOOST_COMPUTE_USE_CPP11
+typedef std::mutex mutex;
+typedef std::unique_lock<std::mutex> scoped_lock;
+typedef std::condition_variable condition_variable;
+#else
+typedef ::boost::mutex mutex;
+typedef ::boost::unique_lock< ::boost::mutex> scoped_lock;
+typedef ::boost::condition_variable condition_variable;
+#endif
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_THREAD_SAFE
+
+#endif // BOOST_COMPUTE_DETAIL_MUTEX_HPP
@@ -12,6 +12,7 @@
 #define BOOST_COMPUTE_DETAIL_PARAMETER_CACHE_HPP
 
 #include <algorithm>
+#include <map>
 #include <string>
 
 #include <boost/shared_ptr.hpp>
@@ -21,6 +22,7 @@
 #include <boost/compute/config.hpp>
 #include <boost/compute/device.hpp>
 #include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
 #include <boost/compute/version.hpp>
 
 #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
@@ -38,6 +40,9 @@ namespace detail {
 class parameter_cache : boost::noncopyable
 {
 public:
+    // (object, parameter) -> value
+    typedef std::map<std::pair<std::string, std::string>, uint_> parameter_map;
+
     parameter_cache(const device &device)
         : m_dirty(false),
           m_device_name(device.name())
@@ -62,6 +67,9 @@ public:
 
     void set(const std::string &object, const std::string &parameter, uint_ value)
     {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        scoped_lock lock(m_mutex);
+    #endif
         m_cache[std::make_pair(object, parameter)] = value;
 
         // set the dirty flag to true. this will cause the updated parameters
@@ -71,7 +79,19 @@ public:
 
     uint_ get(const std::string &object, const std::string &parameter, uint_ default_value)
     {
-        std::map<std::pair<std::string, std::string>, uint_>::iterator
+        // parameters overridden on the calling thread take precedence
+        if(const parameter_map *overrides = active_overrides()){
+            parameter_map::const_iterator
+                iter = overrides->find(std::make_pair(object, parameter));
+            if(iter != overrides->end()){
+                return iter->second;
+            }
+        }
+
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        scoped_lock lock(m_mutex);
+    #endif
+        parameter_map::iterator
             iter = m_cache.find(std::make_pair(object, parameter));
         if(iter != m_cache.end()){
             return iter->second;
@@ -81,12 +101,40 @@ public:
         }
     }
 
+    // removes the value of parameter for object (if it was set)
+    void remove(const std::string &object, const std::string &parameter)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        scoped_lock lock(m_mutex);
+    #endif
+        if(m_cache.erase(std::make_pair(object, parameter))){
+            m_dirty = true;
+        }
+    }
+
+    // stores the parameters to the offline cache now instead of when the
+    // cache is destroyed. does nothing if the offline cache is not enabled.
+    void flush()
+    {
+    #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        scoped_lock lock(m_mutex);
+    #endif
+        write_to_disk();
+    #endif // BOOST_COMPUTE_USE_OFFLINE_CACHE
+    }
+
+    // returns the parameter cache for device, shared by all threads
     static boost::shared_ptr<parameter_cache> get_global_cache(const device &device)
     {
         // device name -> parameter cache
         typedef std::map<std::string, boost::shared_ptr<parameter_cache> > cache_map;
 
-        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(cache_map, caches, ((std::less<std::string>())));
+        BOOST_COMPUTE_DETAIL_SHARED_STATIC(cache_map, caches, ((std::less<std::string>())));
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        static mutex caches_mutex;
+        scoped_lock lock(caches_mutex);
+    #endif
 
         cache_map::iterator iter = caches.find(device.name());
         if(iter == caches.end()){
@@ -102,6 +150,15 @@ public:
         }
     }
 
+    // returns the parameters which override the cached parameters of every
+    // device on the calling thread (null if none). set by execution_policy.
+    static const parameter_map*& active_overrides()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(const parameter_map *, overrides, (0));
+
+        return overrides;
+    }
+
 private:
 #ifdef BOOST_COMPUTE_USE_OFFLINE_CACHE
     // returns a string containing a cannoical device name
@@ -213,7 +270,10 @@ private:
     bool m_dirty;
     std::string m_device_name;
     std::string m_file_name;
-    std::map<std::pair<std::string, std::string>, uint_> m_cache;
+    parameter_map m_cache;
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+    mutex m_mutex;
+#endif
 };
 
 } // end detail namespace
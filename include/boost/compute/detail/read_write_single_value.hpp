@@ -11,12 +11,15 @@
 #ifndef BOOST_COMPUTE_DETAIL_READ_WRITE_SINGLE_VALUE_HPP
 #define BOOST_COMPUTE_DETAIL_READ_WRITE_SINGLE_VALUE_HPP
 
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/throw_exception.hpp>
 
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/event.hpp>
 #include <boost/compute/exception.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/async/future.hpp>
 
 namespace boost {
 namespace compute {
@@ -46,6 +49,79 @@ inline T read_single_value(const buffer &buffer, command_queue &queue)
     return read_single_value<T>(buffer, 0, queue);
 }
 
+// returns the value pointed to by a shared pointer, used to defer reading the
+// result of a future until its event is complete
+template<class T>
+struct shared_value_reader
+{
+    typedef T result_type;
+
+    shared_value_reader(const boost::shared_ptr<T> &value)
+        : m_value(value)
+    {
+    }
+
+    T operator()() const
+    {
+        return *m_value;
+    }
+
+    boost::shared_ptr<T> m_value;
+};
+
+// holds a reference to a shared value, used to keep the host memory of a
+// non-blocking read alive until the read is complete
+template<class T>
+struct shared_value_holder
+{
+    shared_value_holder(const boost::shared_ptr<T> &value)
+        : m_value(value)
+    {
+    }
+
+    void operator()() const
+    {
+    }
+
+    boost::shared_ptr<T> m_value;
+};
+
+// keeps value alive until event is complete. the future returned for a
+// non-blocking read may be destroyed before the read is complete, so the
+// future alone cannot own the memory the read is writing to. without event
+// callbacks this waits for the event instead.
+template<class T>
+inline void hold_until_complete(const event &event_,
+                                const boost::shared_ptr<T> &value)
+{
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+    event(event_).set_callback(shared_value_holder<T>(value));
+    #else
+    event_.wait();
+    (void) value;
+    #endif
+}
+
+// enqueues a non-blocking read of the value at index in the buffer and
+// returns a future for it
+template<class T>
+inline future<T> read_single_value_async(const buffer &buffer,
+                                         size_t index,
+                                         command_queue &queue)
+{
+    BOOST_ASSERT(index < buffer.size() / sizeof(T));
+    BOOST_ASSERT(buffer.get_context() == queue.get_context());
+
+    boost::shared_ptr<T> value = boost::make_shared<T>();
+    event event_ = queue.enqueue_read_buffer_async(buffer,
+                                                   sizeof(T) * index,
+                                                   sizeof(T),
+                                                   value.get());
+    hold_until_complete(event_, value);
+
+    return future<T>(event_, shared_value_reader<T>(value));
+}
+
 // writes a single value at index to the buffer
 template<class T>
 inline event write_single_value(const T &value,
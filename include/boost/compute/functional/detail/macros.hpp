@@ -21,6 +21,8 @@
     class name : public function<signature> \
     { \
     public: \
+        typedef void type_keyed_source; \
+        \
         (name)() : function<signature>(BOOST_PP_STRINGIZE(name)) { } \
     };
 
@@ -29,6 +31,8 @@
     class BOOST_PP_CAT(name, _) : public function<signature> \
     { \
     public: \
+        typedef void type_keyed_source; \
+        \
         BOOST_PP_CAT(name, _)() : function<signature>(BOOST_PP_STRINGIZE(name)) { } \
     };
 
@@ -59,6 +59,8 @@ struct invoked_binary_operator
     class name : public function<return_type (arg_type, arg_type)> \
     { \
     public: \
+        typedef void type_keyed_source; \
+        \
         name() : function<return_type (arg_type, arg_type)>(BOOST_PP_STRINGIZE(name)) { } \
         \
         template<class Arg1, class Arg2> \
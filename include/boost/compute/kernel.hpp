@@ -24,6 +24,7 @@
 #include <boost/compute/program.hpp>
 #include <boost/compute/platform.hpp>
 #include <boost/compute/type_traits/is_fundamental.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
 #include <boost/compute/detail/diagnostic.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
@@ -342,6 +343,10 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        if(detail::command_recorder *recorder = detail::command_recorder::active()){
+            recorder->record_arg(m_kernel, index, size, value);
+        }
     }
 
     /// Sets the argument at \p index to \p value.
@@ -388,6 +393,10 @@ public:
     void set_arg(size_t index, const cl_mem mem)
     {
         set_arg(index, sizeof(cl_mem), static_cast<const void *>(&mem));
+
+        if(detail::command_recorder *recorder = detail::command_recorder::active()){
+            recorder->record_memory_arg(m_kernel, index, mem);
+        }
     }
 
     /// \internal_
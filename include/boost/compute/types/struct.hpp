@@ -14,11 +14,17 @@
 #include <sstream>
 
 #include <boost/static_assert.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/typeof/typeof.hpp>
 
 #include <boost/preprocessor/expr_if.hpp>
 #include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <boost/preprocessor/seq/enum.hpp>
 #include <boost/preprocessor/seq/fold_left.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/for_each_i.hpp>
+#include <boost/preprocessor/seq/size.hpp>
 #include <boost/preprocessor/seq/transform.hpp>
 
 #include <boost/compute/type_traits/type_definition.hpp>
@@ -47,6 +53,13 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
     return s.str();
 }
 
+// describes the members of a struct adapted with BOOST_COMPUTE_ADAPT_STRUCT().
+// pointers_type is a boost::tuples::cons list of the member pointer types
+// (in the order of the members), pointers() returns the member pointers and
+// name() returns the name of the member at index.
+template<class Struct>
+struct adapted_struct_members;
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -61,6 +74,60 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
 #define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_STREAM_MEMBER(r, data, i, elem) \
     BOOST_PP_EXPR_IF(i, << ", ") << data.elem
 
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_MEMBER_CONS(r, type, member) \
+    ::boost::tuples::cons<BOOST_TYPEOF(&type::member),
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_CLOSE_CONS(z, n, unused) >
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_TAIL(z, n, unused) .tail
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_SET_POINTER(r, type, i, member) \
+    pointers BOOST_PP_REPEAT(i, BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_TAIL, ~) \
+        .head = &type::member;
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_MEMBER_NAME(s, data, member) \
+    BOOST_PP_STRINGIZE(member)
+
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_MEMBERS(type, members_) \
+    template<> \
+    struct adapted_struct_members<type> \
+    { \
+        typedef BOOST_PP_SEQ_FOR_EACH( \
+                    BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_MEMBER_CONS, type, members_ \
+                ) \
+                ::boost::tuples::null_type \
+                BOOST_PP_REPEAT( \
+                    BOOST_PP_SEQ_SIZE(members_), \
+                    BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_CLOSE_CONS, \
+                    ~ \
+                ) pointers_type; \
+        static pointers_type pointers() \
+        { \
+            pointers_type pointers; \
+            BOOST_PP_SEQ_FOR_EACH_I( \
+                BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_SET_POINTER, type, members_ \
+            ) \
+            return pointers; \
+        } \
+        static const char* name(size_t index) \
+        { \
+            static const char *names[] = { \
+                BOOST_PP_SEQ_ENUM( \
+                    BOOST_PP_SEQ_TRANSFORM( \
+                        BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_MEMBER_NAME, ~, members_ \
+                    ) \
+                ) \
+            }; \
+            return names[index]; \
+        } \
+    };
+
 /// \internal_
 #define BOOST_COMPUTE_DETAIL_STRUCT_MEMBER_SIZE(s, struct_, member_) \
     sizeof(((struct_ *)0)->member_)
@@ -128,7 +195,10 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
 /// device compiler, the \c BOOST_COMPUTE_ADAPT_STRUCT() macro requires that
 /// the adapted struct is packed (i.e. no padding bytes between members).
 ///
-/// \see type_name()
+/// Adapted structs can also be stored with one buffer per member in a
+/// \ref soa_vector.
+///
+/// \see type_name(), soa_vector
 #define BOOST_COMPUTE_ADAPT_STRUCT(type, name, members) \
     BOOST_STATIC_ASSERT_MSG( \
         BOOST_COMPUTE_DETAIL_STRUCT_IS_PACKED(type, BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members)), \
@@ -168,6 +238,9 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
                ) \
                << "}"; \
     } \
+    BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_MEMBERS( \
+        type, BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+    ) \
     }}}
 
 #endif // BOOST_COMPUTE_TYPES_STRUCT_HPP
@@ -11,11 +11,16 @@
 #ifndef BOOST_COMPUTE_UTILITY_HPP
 #define BOOST_COMPUTE_UTILITY_HPP
 
+#include <boost/compute/utility/autotuner.hpp>
 #include <boost/compute/utility/dim.hpp>
 #include <boost/compute/utility/extents.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
 #include <boost/compute/utility/invoke.hpp>
+#include <boost/compute/utility/pipeline.hpp>
 #include <boost/compute/utility/program_cache.hpp>
+#include <boost/compute/utility/segments.hpp>
 #include <boost/compute/utility/source.hpp>
+#include <boost/compute/utility/tracer.hpp>
 #include <boost/compute/utility/wait_list.hpp>
 
 #endif // BOOST_COMPUTE_UTILITY_HPP
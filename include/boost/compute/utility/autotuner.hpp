@@ -0,0 +1,698 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_AUTOTUNER_HPP
+#define BOOST_COMPUTE_UTILITY_AUTOTUNER_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/exception.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/min_element.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/array.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class autotuner
+/// \brief Measures the tuning parameters of the algorithms for a device.
+///
+/// Several algorithms read tuning parameters (e.g. the number of threads per
+/// block and the number of values per thread) from the parameter cache of
+/// the device they run on and fall back to defaults if the parameters have
+/// not been set. The autotuner sweeps the candidate values of these
+/// parameters, times each of them with profiling events and stores the
+/// fastest value in the parameter cache, where the algorithms pick it up.
+///
+/// When \c BOOST_COMPUTE_USE_OFFLINE_CACHE is defined the parameters are
+/// persisted by save() to the offline cache (e.g.
+/// \c ~/.boost_compute/tune/<device>.json) and loaded automatically by
+/// later programs using the same device.
+///
+/// Thresholds which choose between two ways of running an algorithm are
+/// tuned by timing both ways for growing sizes (see tune_map_copy() and
+/// tune_host_dispatch()).
+///
+/// For example, to tune sort() for \c int values on the default device:
+///
+/// \code
+/// boost::compute::autotuner tuner(queue);
+/// tuner.tune_sort<int>(1 << 22);
+/// tuner.save();
+/// \endcode
+///
+/// The \c autotune example program tunes all of the supported algorithms
+/// from the command line.
+class autotuner
+{
+public:
+    /// Creates an autotuner for the device of \p queue. The measurements
+    /// are made with a separate profiling command queue. Each candidate
+    /// value is timed \p trials times and its fastest time is used.
+    explicit autotuner(const command_queue &queue, size_t trials = 3)
+        : m_queue(queue.get_context(),
+                  queue.get_device(),
+                  command_queue::enable_profiling),
+          m_trials((std::max)(trials, size_t(1))),
+          m_parameters(
+              detail::parameter_cache::get_global_cache(queue.get_device())
+          )
+    {
+    }
+
+    /// Returns the profiling command queue used for the measurements.
+    command_queue& get_queue()
+    {
+        return m_queue;
+    }
+
+    /// Sets \p parameter of \p object to each of \p values in turn, times
+    /// \p function and stores the fastest value. Returns the stored value.
+    ///
+    /// \p function is called with the profiling command queue. After its
+    /// first call with each value, which is not timed so that the time to
+    /// build programs is not included, \p check is called with the queue and
+    /// must return \c false if the result is invalid. Values for which
+    /// \p function throws an opencl_error (e.g. for an invalid work-group
+    /// size) or \p check returns \c false are skipped. If no value is valid
+    /// the previous value is restored and zero is returned.
+    template<class Function, class Check>
+    uint_ tune(const std::string &object,
+               const std::string &parameter,
+               const std::vector<uint_> &values,
+               Function function,
+               Check check)
+    {
+        const uint_ not_set = (std::numeric_limits<uint_>::max)();
+        const uint_ previous = m_parameters->get(object, parameter, not_set);
+
+        double best_time = (std::numeric_limits<double>::max)();
+        uint_ best_value = 0;
+
+        for(size_t i = 0; i < values.size(); i++){
+            m_parameters->set(object, parameter, values[i]);
+
+            try {
+                // build the programs and check the results
+                function(m_queue);
+                if(!check(m_queue)){
+                    continue;
+                }
+
+                double time = (std::numeric_limits<double>::max)();
+                for(size_t trial = 0; trial < m_trials; trial++){
+                    time = (std::min)(time, measure(function));
+                }
+
+                if(time < best_time){
+                    best_time = time;
+                    best_value = values[i];
+                }
+            }
+            catch(opencl_error&){
+                // invalid value for this device, skip
+                m_queue.finish();
+            }
+        }
+
+        if(best_value != 0){
+            m_parameters->set(object, parameter, best_value);
+        }
+        else if(previous != not_set){
+            m_parameters->set(object, parameter, previous);
+        }
+        else {
+            m_parameters->remove(object, parameter);
+        }
+
+        return best_value;
+    }
+
+    /// \overload
+    template<class Function>
+    uint_ tune(const std::string &object,
+               const std::string &parameter,
+               const std::vector<uint_> &values,
+               Function function)
+    {
+        return tune(object, parameter, values, function, always_valid());
+    }
+
+    /// Tunes the radix sort used by sort() on GPUs for values of type \c T
+    /// with \p size values. The threads per block ("tpb") are tuned first
+    /// and then the number of bits sorted per pass ("k"). Does nothing for
+    /// other devices, which do not use the radix sort.
+    template<class T>
+    void tune_sort(size_t size)
+    {
+        if(!(m_queue.get_device().type() & device::gpu)){
+            return;
+        }
+
+        const std::string key = std::string("__boost_radix_sort_") + type_name<T>();
+
+        std::vector<T> host(size);
+        for(size_t i = 0; i < size; i++){
+            host[i] = static_cast<T>(std::rand());
+        }
+
+        vector<T> input(host.begin(), host.end(), m_queue);
+        vector<T> output(size, m_queue.get_context());
+        sort_function<T> function(input, output);
+        sorted_check<T> check(output);
+
+        tune(key, "tpb", make_values(32, 1024), function, check);
+        // radix_sort() supports 1, 2 and 4 bits per pass
+        tune(key, "k", make_values(1, 4), function, check);
+    }
+
+    /// Tunes reduce() on GPUs for values of type \c T with \p size values.
+    /// The threads per block ("tpb") are tuned first and then the values
+    /// per thread ("vpt"). Does nothing for CPU devices, which use another
+    /// reduction.
+    template<class T>
+    void tune_reduce(size_t size)
+    {
+        if(m_queue.get_device().type() & device::cpu){
+            return;
+        }
+
+        const std::string key = std::string("__boost_reduce_on_gpu_") + type_name<T>();
+
+        std::vector<T> host(size, T(1));
+        vector<T> input(host.begin(), host.end(), m_queue);
+        array<T, 1> output(m_queue.get_context());
+        reduce_function<T> function(input, output);
+        value_check<T> check(output, static_cast<T>(size));
+
+        tune(key, "tpb", make_values(32, 1024), function, check);
+        tune(key, "vpt", make_values(1, 64), function, check);
+    }
+
+    /// Tunes the copy kernel used by copy() on the device for values of
+    /// type \c T with \p size values. The threads per block ("tpb") are
+    /// tuned first and then the values per thread ("vpt").
+    ///
+    /// Copies between buffers of the same type are made with
+    /// \c clEnqueueCopyBuffer, so the kernel is timed by copying through a
+    /// transform_iterator, as copy() does for other device iterators.
+    template<class T>
+    void tune_copy(size_t size)
+    {
+        const std::string key =
+            "__boost_copy_kernel_" + boost::lexical_cast<std::string>(sizeof(T));
+
+        vector<T> input(size, m_queue.get_context());
+        vector<T> output(size, m_queue.get_context());
+        copy_function<T> function(input, output);
+
+        tune(key, "tpb", make_values(32, 1024), function);
+        tune(key, "vpt", make_values(1, 64), function);
+    }
+
+    /// Tunes the size in bytes below which copy() maps the device memory
+    /// ("map_copy_threshold") instead of converting the values on the host
+    /// and writing (or reading) them, for copies of up to \p size values
+    /// between host values of type \c HostType and device values of type
+    /// \c DeviceType. Both directions are tuned.
+    ///
+    /// Both copies are timed for sizes doubling from 4 KB, and the
+    /// threshold is the first size for which mapping is slower. Copies
+    /// between values of the same type never map, so the types must
+    /// differ. Returns the threshold for copies to the device.
+    template<class HostType, class DeviceType>
+    uint_ tune_map_copy(size_t size)
+    {
+        BOOST_STATIC_ASSERT((!boost::is_same<HostType, DeviceType>::value));
+
+        std::vector<HostType> host(size);
+        vector<DeviceType> device(size, m_queue.get_context());
+
+        copy_to_device_function<HostType, DeviceType> to_device(host, device);
+        const uint_ threshold = tune_threshold(
+            std::string("__boost_compute_copy_to_device_") +
+                type_name<HostType>() + "_" + type_name<DeviceType>(),
+            to_device,
+            sizeof(HostType),
+            size
+        );
+
+        copy_to_host_function<HostType, DeviceType> to_host(host, device);
+        tune_threshold(
+            std::string("__boost_compute_copy_to_host_") +
+                type_name<DeviceType>() + "_" + type_name<HostType>(),
+            to_host,
+            sizeof(DeviceType),
+            size
+        );
+
+        return threshold;
+    }
+
+    /// Tunes the host_dispatch thresholds of the \c "reduce", \c "scan",
+    /// \c "count" and \c "find_extrema" algorithms for values of type \c T
+    /// with up to \p size values.
+    ///
+    /// Each algorithm is timed on the host and on the device for sizes
+    /// doubling from one value, and its threshold is the first size for
+    /// which the device is faster. If the host is faster for all sizes the
+    /// threshold is the first power of two above \p size.
+    template<class T>
+    void tune_host_dispatch(size_t size)
+    {
+        std::vector<T> host(size, T(1));
+        vector<T> input(host.begin(), host.end(), m_queue);
+        vector<T> output(size, m_queue.get_context());
+
+        reduce_n_function<T> reduce(input, output);
+        tune_dispatch_threshold("reduce", reduce, size);
+
+        scan_n_function<T> scan(input, output);
+        tune_dispatch_threshold("scan", scan, size);
+
+        count_n_function<T> count(input);
+        tune_dispatch_threshold("count", count, size);
+
+        min_element_n_function<T> min_element(input);
+        tune_dispatch_threshold("find_extrema", min_element, size);
+    }
+
+    /// Stores the tuned parameters to the offline cache. Does nothing if
+    /// \c BOOST_COMPUTE_USE_OFFLINE_CACHE is not defined.
+    void save()
+    {
+        m_parameters->flush();
+    }
+
+private:
+    template<class T>
+    struct sort_function
+    {
+        sort_function(const vector<T> &input, vector<T> &output)
+            : m_input(&input), m_output(&output)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::copy(
+                m_input->begin(), m_input->end(), m_output->begin(), queue
+            );
+            ::boost::compute::sort(m_output->begin(), m_output->end(), queue);
+        }
+
+        const vector<T> *m_input;
+        vector<T> *m_output;
+    };
+
+    template<class T>
+    struct sorted_check
+    {
+        sorted_check(const vector<T> &values)
+            : m_values(&values)
+        {
+        }
+
+        bool operator()(command_queue &queue) const
+        {
+            return ::boost::compute::is_sorted(
+                m_values->begin(), m_values->end(), queue
+            );
+        }
+
+        const vector<T> *m_values;
+    };
+
+    template<class T>
+    struct reduce_function
+    {
+        reduce_function(const vector<T> &input, array<T, 1> &output)
+            : m_input(&input), m_output(&output)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::reduce(
+                m_input->begin(), m_input->end(), m_output->begin(), queue
+            );
+        }
+
+        const vector<T> *m_input;
+        array<T, 1> *m_output;
+    };
+
+    template<class T>
+    struct value_check
+    {
+        value_check(const array<T, 1> &value, T expected)
+            : m_value(&value), m_expected(expected)
+        {
+        }
+
+        bool operator()(command_queue &queue) const
+        {
+            T value;
+            ::boost::compute::copy(
+                m_value->begin(), m_value->end(), &value, queue
+            );
+
+            return value == m_expected;
+        }
+
+        const array<T, 1> *m_value;
+        T m_expected;
+    };
+
+    template<class T>
+    struct copy_function
+    {
+        copy_function(const vector<T> &input, vector<T> &output)
+            : m_input(&input), m_output(&output)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::copy(
+                ::boost::compute::make_transform_iterator(m_input->begin(), identity<T>()),
+                ::boost::compute::make_transform_iterator(m_input->end(), identity<T>()),
+                m_output->begin(),
+                queue
+            );
+        }
+
+        const vector<T> *m_input;
+        vector<T> *m_output;
+    };
+
+    template<class HostType, class DeviceType>
+    struct copy_to_device_function
+    {
+        copy_to_device_function(const std::vector<HostType> &host,
+                                vector<DeviceType> &device)
+            : m_host(&host), m_device(&device), m_count(0)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::copy(
+                m_host->begin(), m_host->begin() + m_count, m_device->begin(), queue
+            );
+        }
+
+        const std::vector<HostType> *m_host;
+        vector<DeviceType> *m_device;
+        size_t m_count;
+    };
+
+    template<class HostType, class DeviceType>
+    struct copy_to_host_function
+    {
+        copy_to_host_function(std::vector<HostType> &host,
+                              const vector<DeviceType> &device)
+            : m_host(&host), m_device(&device), m_count(0)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::copy(
+                m_device->begin(), m_device->begin() + m_count, m_host->begin(), queue
+            );
+        }
+
+        std::vector<HostType> *m_host;
+        const vector<DeviceType> *m_device;
+        size_t m_count;
+    };
+
+    template<class T>
+    struct reduce_n_function
+    {
+        reduce_n_function(const vector<T> &input, vector<T> &output)
+            : m_input(&input), m_output(&output), m_count(0)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::reduce(
+                m_input->begin(), m_input->begin() + m_count,
+                m_output->begin(), queue
+            );
+        }
+
+        const vector<T> *m_input;
+        vector<T> *m_output;
+        size_t m_count;
+    };
+
+    template<class T>
+    struct scan_n_function
+    {
+        scan_n_function(const vector<T> &input, vector<T> &output)
+            : m_input(&input), m_output(&output), m_count(0)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::inclusive_scan(
+                m_input->begin(), m_input->begin() + m_count,
+                m_output->begin(), queue
+            );
+        }
+
+        const vector<T> *m_input;
+        vector<T> *m_output;
+        size_t m_count;
+    };
+
+    template<class T>
+    struct count_n_function
+    {
+        count_n_function(const vector<T> &input)
+            : m_input(&input), m_count(0)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::count(
+                m_input->begin(), m_input->begin() + m_count, T(1), queue
+            );
+        }
+
+        const vector<T> *m_input;
+        size_t m_count;
+    };
+
+    template<class T>
+    struct min_element_n_function
+    {
+        min_element_n_function(const vector<T> &input)
+            : m_input(&input), m_count(0)
+        {
+        }
+
+        void operator()(command_queue &queue) const
+        {
+            ::boost::compute::min_element(
+                m_input->begin(), m_input->begin() + m_count, queue
+            );
+        }
+
+        const vector<T> *m_input;
+        size_t m_count;
+    };
+
+    struct always_valid
+    {
+        bool operator()(command_queue&) const
+        {
+            return true;
+        }
+    };
+
+    // times function with the map path of copy() forced on and off for
+    // counts doubling up to max_count and stores the first size in bytes
+    // for which mapping is slower as the map_copy_threshold of object. the
+    // direct_copy_threshold is raised while measuring so that the other
+    // path is always the host conversion, and then restored.
+    template<class Function>
+    uint_ tune_threshold(const std::string &object,
+                         Function &function,
+                         size_t value_size,
+                         size_t max_count)
+    {
+        const uint_ not_set = (std::numeric_limits<uint_>::max)();
+        const uint_ previous_direct =
+            m_parameters->get(object, "direct_copy_threshold", not_set);
+        m_parameters->set(object, "direct_copy_threshold", not_set);
+
+        size_t count = (std::max)(size_t(4096) / value_size, size_t(1));
+        for(; count <= max_count; count *= 2){
+            function.m_count = count;
+
+            m_parameters->set(object, "map_copy_threshold", not_set);
+            const double map_time = measure_best(function);
+
+            m_parameters->set(object, "map_copy_threshold", 0);
+            const double write_time = measure_best(function);
+
+            if(write_time < map_time){
+                break;
+            }
+        }
+
+        // mapping is faster for all sizes below count
+        const uint_ threshold = static_cast<uint_>(
+            (std::min)(count * value_size, static_cast<size_t>(not_set))
+        );
+        m_parameters->set(object, "map_copy_threshold", threshold);
+
+        if(previous_direct != not_set){
+            m_parameters->set(object, "direct_copy_threshold", previous_direct);
+        }
+        else {
+            m_parameters->remove(object, "direct_copy_threshold");
+        }
+
+        return threshold;
+    }
+
+    // times function with host_dispatch forced to the host and to the
+    // device for counts doubling up to max_count and stores the first count
+    // for which the device is faster as the threshold of algorithm
+    template<class Function>
+    uint_ tune_dispatch_threshold(const char *algorithm,
+                                  Function &function,
+                                  size_t max_count)
+    {
+        size_t count = 1;
+        for(; count <= max_count; count *= 2){
+            function.m_count = count;
+
+            double host_time = 0;
+            double device_time = 0;
+            {
+                host_dispatch::scoped_mode mode(host_dispatch::force_host);
+                host_time = measure_best(function);
+            }
+            {
+                host_dispatch::scoped_mode mode(host_dispatch::force_device);
+                device_time = measure_best(function);
+            }
+
+            if(device_time < host_time){
+                break;
+            }
+        }
+
+        // the host is faster for all counts below count
+        const uint_ threshold = static_cast<uint_>(
+            (std::min)(
+                count,
+                static_cast<size_t>((std::numeric_limits<uint_>::max)())
+            )
+        );
+        host_dispatch::set_threshold(algorithm, m_queue.get_device(), threshold);
+
+        return threshold;
+    }
+
+    // returns the fastest time in nanoseconds of function, which may also
+    // work on the host, after an untimed call. the start marker is waited
+    // for so that the host work before the first command is included.
+    template<class Function>
+    double measure_best(Function &function)
+    {
+        function(m_queue);
+        m_queue.finish();
+
+        double time = (std::numeric_limits<double>::max)();
+        for(size_t trial = 0; trial < m_trials; trial++){
+            event start = m_queue.enqueue_marker();
+            start.wait();
+            function(m_queue);
+            event end = m_queue.enqueue_marker();
+            end.wait();
+
+            time = (std::min)(time, static_cast<double>(
+                end.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END) -
+                start.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END)
+            ));
+        }
+
+        return time;
+    }
+
+    // returns the powers of two in [first, last]
+    static std::vector<uint_> make_values(uint_ first, uint_ last)
+    {
+        std::vector<uint_> values;
+        for(uint_ value = first; value <= last; value *= 2){
+            values.push_back(value);
+        }
+
+        return values;
+    }
+
+    // returns the time in nanoseconds between markers enqueued before and
+    // after function
+    template<class Function>
+    double measure(Function &function)
+    {
+        event start = m_queue.enqueue_marker();
+        function(m_queue);
+        event end = m_queue.enqueue_marker();
+        end.wait();
+
+        return static_cast<double>(
+            end.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END) -
+            start.get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END)
+        );
+    }
+
+private:
+    command_queue m_queue;
+    size_t m_trials;
+    boost::shared_ptr<detail::parameter_cache> m_parameters;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_AUTOTUNER_HPP
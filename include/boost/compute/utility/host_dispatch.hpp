@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_HOST_DISPATCH_HPP
+#define BOOST_COMPUTE_UTILITY_HOST_DISPATCH_HPP
+
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class host_dispatch
+/// \brief Controls when algorithms run small inputs on the host.
+///
+/// For small inputs the cost of an algorithm is dominated by the fixed cost
+/// of running it on the device (looking up the program, allocating
+/// temporary buffers, launching kernels and reading back the result). When
+/// the number of elements is below a threshold, the following algorithms
+/// instead map the input buffer and compute the result on the host:
+///
+/// - \c "reduce": reduce()
+/// - \c "scan": inclusive_scan() and exclusive_scan()
+/// - \c "count": count()
+/// - \c "find_extrema": min_element(), max_element() and minmax_element()
+///
+/// The host path is only taken for ranges of buffer iterators with a
+/// scalar built-in value type and for the standard functions which can be
+/// evaluated on the host (e.g. \c plus, \c multiplies, \c min, \c max,
+/// \c less and \c greater). Other inputs always run on the device.
+///
+/// The host path is off by default: the thresholds are zero, so all
+/// inputs run on the device and algorithms writing their result to a
+/// device iterator do not block. To opt in, set the thresholds (in
+/// elements) with set_threshold(), e.g. to about 16384 elements for CPU
+/// devices, where mapping a buffer does not copy it, and 4096 elements for
+/// other devices:
+///
+/// \code
+/// boost::compute::host_dispatch::set_threshold("reduce", device, 4096);
+/// \endcode
+///
+/// The thresholds are stored per device in the parameter cache (and with
+/// \c BOOST_COMPUTE_USE_OFFLINE_CACHE in the offline cache). They can be
+/// measured for a device with autotuner::tune_host_dispatch(), which times
+/// each algorithm on the host and on the device for growing sizes.
+///
+/// The thresholds can be overridden for the calling thread with set_mode().
+/// For example, to run all supported inputs on the host within a scope:
+///
+/// \code
+/// boost::compute::host_dispatch::scoped_mode mode(
+///     boost::compute::host_dispatch::force_host
+/// );
+/// \endcode
+///
+/// Host dispatch blocks the calling thread until the input is ready, also
+/// when the result is written to a device iterator.
+///
+/// With \c force_host, inputs which cannot be processed on the host are
+/// processed with a single work-item on the device instead.
+///
+/// Commands enqueued to a queue which is recording a command_graph always
+/// run on the device.
+class host_dispatch
+{
+public:
+    /// Dispatch modes.
+    enum mode_type {
+        /// Run inputs smaller than the threshold on the host.
+        automatic,
+        /// Run all inputs on the host.
+        force_host,
+        /// Run all inputs on the device.
+        force_device
+    };
+
+    /// \class scoped_mode
+    /// \brief Sets the dispatch mode of the calling thread until it is
+    ///        destroyed.
+    class scoped_mode : boost::noncopyable
+    {
+    public:
+        /// Sets the dispatch mode to \p mode.
+        explicit scoped_mode(mode_type mode)
+            : m_previous(host_dispatch::mode())
+        {
+            host_dispatch::set_mode(mode);
+        }
+
+        /// Restores the previous dispatch mode.
+        ~scoped_mode()
+        {
+            host_dispatch::set_mode(m_previous);
+        }
+
+    private:
+        mode_type m_previous;
+    };
+
+    /// Returns the dispatch mode of the calling thread.
+    static mode_type mode()
+    {
+        return mode_ref();
+    }
+
+    /// Sets the dispatch mode of the calling thread to \p mode.
+    static void set_mode(mode_type mode)
+    {
+        mode_ref() = mode;
+    }
+
+    /// Returns the number of elements below which \p algorithm runs on the
+    /// host for \p device. The default is zero, which always runs
+    /// \p algorithm on the device.
+    static size_t threshold(const std::string &algorithm, const device &device)
+    {
+        boost::shared_ptr<detail::parameter_cache> parameters =
+            detail::parameter_cache::get_global_cache(device);
+
+        return parameters->get(cache_key(), algorithm, uint_(0));
+    }
+
+    /// Sets the number of elements below which \p algorithm runs on the
+    /// host for \p device to \p threshold. A threshold of zero always runs
+    /// \p algorithm on the device.
+    static void set_threshold(const std::string &algorithm,
+                              const device &device,
+                              size_t threshold)
+    {
+        boost::shared_ptr<detail::parameter_cache> parameters =
+            detail::parameter_cache::get_global_cache(device);
+
+        parameters->set(cache_key(), algorithm, static_cast<uint_>(threshold));
+    }
+
+private:
+    static const char* cache_key()
+    {
+        return "__boost_host_dispatch";
+    }
+
+    static mode_type& mode_ref()
+    {
+        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(mode_type, mode, (automatic));
+
+        return mode;
+    }
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_HOST_DISPATCH_HPP
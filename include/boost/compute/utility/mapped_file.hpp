@@ -0,0 +1,430 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_MAPPED_FILE_HPP
+#define BOOST_COMPUTE_UTILITY_MAPPED_FILE_HPP
+
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/buffer_host_memory.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the size of the file at path in bytes
+inline size_t file_size(const std::string &path)
+{
+    std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+    stream.seekg(0, std::ios::end);
+
+    const std::streamoff size = stream.tellg();
+
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+// returns the size in bytes of the chunks streamed between host memory and
+// buffers, read from the parameter cache as "chunk_size"
+inline size_t file_chunk_size(const device &device)
+{
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(device);
+
+    return (std::max)(
+        parameters->get("__boost_mapped_file", "chunk_size", uint_(1) << 22),
+        uint_(4096)
+    );
+}
+
+// double-buffered pinned staging memory for streaming chunks between host
+// memory and buffers. while one chunk is transferred by the device the
+// other one is copied on the host.
+class file_staging : boost::noncopyable
+{
+public:
+    file_staging(size_t chunk_size, command_queue &queue)
+        : m_queue(queue),
+          m_chunk_size(chunk_size)
+    {
+        for(size_t i = 0; i < 2; i++){
+            m_buffers[i] = buffer(
+                queue.get_context(),
+                chunk_size,
+                buffer::read_write | buffer::alloc_host_ptr
+            );
+
+            m_ptrs[i] = static_cast<char *>(
+                queue.enqueue_map_buffer(
+                    m_buffers[i], CL_MAP_READ | CL_MAP_WRITE, 0, chunk_size
+                )
+            );
+        }
+    }
+
+    ~file_staging()
+    {
+        wait(0);
+        wait(1);
+
+        for(size_t i = 0; i < 2; i++){
+            m_queue.enqueue_unmap_buffer(m_buffers[i], m_ptrs[i]).wait();
+        }
+    }
+
+    size_t chunk_size() const
+    {
+        return m_chunk_size;
+    }
+
+    char* ptr(size_t i)
+    {
+        return m_ptrs[i];
+    }
+
+    event& get_event(size_t i)
+    {
+        return m_events[i];
+    }
+
+    void wait(size_t i)
+    {
+        if(m_events[i].get()){
+            m_events[i].wait();
+            m_events[i] = event();
+        }
+    }
+
+private:
+    command_queue m_queue;
+    size_t m_chunk_size;
+    buffer m_buffers[2];
+    char *m_ptrs[2];
+    event m_events[2];
+};
+
+// writes size bytes from host_ptr to buffer at offset. on cpu devices the
+// host memory is wrapped in a buffer and copied by the device, otherwise
+// it is streamed through pinned staging memory.
+inline void stream_to_buffer(const void *host_ptr,
+                             size_t size,
+                             const buffer &buffer,
+                             size_t offset,
+                             command_queue &queue)
+{
+    if(size == 0){
+        return;
+    }
+
+    if(queue.get_device().type() & device::cpu){
+        const ::boost::compute::buffer host_buffer(
+            queue.get_context(),
+            size,
+            buffer::read_only | buffer::use_host_ptr,
+            const_cast<void *>(host_ptr)
+        );
+
+        queue.enqueue_copy_buffer(host_buffer, buffer, 0, offset, size).wait();
+        return;
+    }
+
+    const char *src = static_cast<const char *>(host_ptr);
+    file_staging staging(
+        (std::min)(file_chunk_size(queue.get_device()), size), queue
+    );
+
+    size_t i = 0;
+    for(size_t done = 0; done < size; done += staging.chunk_size(), i = 1 - i){
+        const size_t n = (std::min)(staging.chunk_size(), size - done);
+
+        // reading the host memory (i.e. the file) overlaps with the
+        // transfer of the previous chunk
+        staging.wait(i);
+        std::memcpy(staging.ptr(i), src + done, n);
+
+        staging.get_event(i) = queue.enqueue_write_buffer_async(
+            buffer, offset + done, n, staging.ptr(i)
+        );
+    }
+}
+
+// reads size bytes from buffer at offset to host_ptr
+inline void stream_from_buffer(const buffer &buffer,
+                               size_t offset,
+                               size_t size,
+                               void *host_ptr,
+                               command_queue &queue)
+{
+    if(size == 0){
+        return;
+    }
+
+    if(queue.get_device().type() & device::cpu){
+        const ::boost::compute::buffer host_buffer(
+            queue.get_context(),
+            size,
+            buffer::write_only | buffer::use_host_ptr,
+            host_ptr
+        );
+
+        event copy_event =
+            queue.enqueue_copy_buffer(buffer, host_buffer, offset, 0, size);
+        synchronize_buffer_host_memory(
+            host_buffer, 0, size, CL_MAP_READ, queue, wait_list(copy_event)
+        );
+        return;
+    }
+
+    char *dst = static_cast<char *>(host_ptr);
+    file_staging staging(
+        (std::min)(file_chunk_size(queue.get_device()), size), queue
+    );
+
+    size_t i = 0;
+    size_t previous_done = 0;
+    size_t previous_n = 0;
+    for(size_t done = 0; done < size; done += staging.chunk_size(), i = 1 - i){
+        const size_t n = (std::min)(staging.chunk_size(), size - done);
+
+        staging.get_event(i) = queue.enqueue_read_buffer_async(
+            buffer, offset + done, n, staging.ptr(i)
+        );
+
+        // writing the previous chunk to the host memory (i.e. the file)
+        // overlaps with the transfer of this chunk
+        if(previous_n != 0){
+            staging.wait(1 - i);
+            std::memcpy(dst + previous_done, staging.ptr(1 - i), previous_n);
+        }
+
+        previous_done = done;
+        previous_n = n;
+    }
+
+    staging.wait(1 - i);
+    std::memcpy(dst + previous_done, staging.ptr(1 - i), previous_n);
+}
+
+} // end detail namespace
+
+/// \class mapped_file
+/// \brief A read-only range of values stored in a memory-mapped file.
+///
+/// The mapped_file class maps the file at a path into the host address space
+/// and presents its contents as a range of values of type \c T. The values
+/// are read from disk on demand as the range is accessed, without an
+/// intermediate copy in a host container. Trailing bytes which do not make
+/// up a whole value are ignored.
+///
+/// This header uses Boost.Interprocess and is not included by
+/// \c <boost/compute.hpp>, it must be included explicitly.
+///
+/// The range can be passed to copy() like any other host range:
+/// \code
+/// boost::compute::mapped_file<float> file("column.bin");
+/// boost::compute::copy(file.begin(), file.end(), vec.begin(), queue);
+/// \endcode
+///
+/// Errors opening or mapping the file are reported by throwing
+/// \c boost::interprocess::interprocess_exception.
+///
+/// \see read_file_to_buffer(), write_buffer_to_file()
+template<class T>
+class mapped_file : boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef const T* iterator;
+    typedef const T* const_iterator;
+
+    /// Maps the file at \p path.
+    explicit mapped_file(const std::string &path)
+        : m_size(0),
+          m_data(0)
+    {
+        namespace ipc = ::boost::interprocess;
+
+        m_file = ipc::file_mapping(path.c_str(), ipc::read_only);
+
+        // empty files can not be mapped
+        m_size = detail::file_size(path) / sizeof(T);
+        if(m_size != 0){
+            m_region = ipc::mapped_region(
+                m_file, ipc::read_only, 0, m_size * sizeof(T)
+            );
+            m_data = static_cast<const T *>(m_region.get_address());
+        }
+    }
+
+    /// Unmaps the file.
+    ~mapped_file()
+    {
+    }
+
+    /// Returns a pointer to the first value in the file.
+    const T* data() const
+    {
+        return m_data;
+    }
+
+    /// Returns the number of values in the file.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the file does not contain any values.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return m_data;
+    }
+
+    const_iterator end() const
+    {
+        return m_data + m_size;
+    }
+
+    const T& operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+private:
+    ::boost::interprocess::file_mapping m_file;
+    ::boost::interprocess::mapped_region m_region;
+    size_type m_size;
+    const T *m_data;
+};
+
+/// Reads the values stored in the file at \p path to the range beginning at
+/// \p result using \p queue and returns an iterator one past the last value
+/// written. Blocks until the values have been written.
+///
+/// The file is mapped into memory and streamed to the device in chunks
+/// through pinned staging memory, so that reading the file overlaps with
+/// the transfer and no host copy of the whole file is made. On CPU devices
+/// the mapped file is wrapped in a buffer with \c CL_MEM_USE_HOST_PTR and
+/// copied by the device.
+///
+/// The size of the chunks can be tuned with the \c "chunk_size" parameter
+/// of \c "__boost_mapped_file" in the parameter cache.
+///
+/// \see mapped_file, write_buffer_to_file()
+template<class T>
+inline buffer_iterator<T>
+read_file_to_buffer(const std::string &path,
+                    const buffer_iterator<T> &result,
+                    command_queue &queue = system::default_queue())
+{
+    mapped_file<T> file(path);
+
+    detail::stream_to_buffer(file.data(),
+                             file.size() * sizeof(T),
+                             result.get_buffer(),
+                             result.get_index() * sizeof(T),
+                             queue);
+
+    return result + static_cast<std::ptrdiff_t>(file.size());
+}
+
+/// Resizes \p vector to the number of values stored in the file at \p path
+/// and reads them to the vector using \p queue.
+///
+/// For example, to load a column of floats:
+///
+/// \snippet test/test_mapped_file.cpp read_column
+template<class T, class Alloc>
+inline void read_file_to_buffer(const std::string &path,
+                                vector<T, Alloc> &vector,
+                                command_queue &queue = system::default_queue())
+{
+    mapped_file<T> file(path);
+
+    vector.resize(file.size(), queue);
+
+    detail::stream_to_buffer(file.data(),
+                             file.size() * sizeof(T),
+                             vector.get_buffer(),
+                             0,
+                             queue);
+}
+
+/// Writes the values in the range [\p first, \p last) to the file at
+/// \p path using \p queue, replacing its contents. Blocks until the file
+/// has been written.
+///
+/// The file is created with the size of the range and mapped into memory.
+/// The values are streamed from the device in chunks (see
+/// read_file_to_buffer()).
+///
+/// \see mapped_file, read_file_to_buffer()
+template<class T>
+inline void write_buffer_to_file(const buffer_iterator<T> &first,
+                                 const buffer_iterator<T> &last,
+                                 const std::string &path,
+                                 command_queue &queue = system::default_queue())
+{
+    namespace ipc = ::boost::interprocess;
+
+    const size_t size = detail::iterator_range_size(first, last) * sizeof(T);
+
+    // create the file with its final size
+    {
+        std::filebuf file;
+        file.open(path.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+        if(size != 0){
+            file.pubseekoff(size - 1, std::ios::beg);
+            file.sputc(0);
+        }
+    }
+
+    if(size == 0){
+        return;
+    }
+
+    ipc::file_mapping file(path.c_str(), ipc::read_write);
+    ipc::mapped_region region(file, ipc::read_write, 0, size);
+
+    detail::stream_from_buffer(first.get_buffer(),
+                               first.get_index() * sizeof(T),
+                               size,
+                               region.get_address(),
+                               queue);
+
+    region.flush();
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_MAPPED_FILE_HPP
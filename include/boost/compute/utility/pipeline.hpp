@@ -0,0 +1,474 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_PIPELINE_HPP
+#define BOOST_COMPUTE_UTILITY_PIPELINE_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// each stage of a pipeline emits the code for one value (at index i) into
+// the body of the kernel loop and returns the name of the variable holding
+// its result. the variables are named after the depth of the stage.
+template<class InputIterator>
+class pipeline_input_stage
+{
+public:
+    typedef typename std::iterator_traits<InputIterator>::value_type result_type;
+    static const size_t depth = 0;
+
+    pipeline_input_stage(InputIterator first)
+        : m_first(first)
+    {
+    }
+
+    std::string emit(meta_kernel &k) const
+    {
+        k << k.decl<const result_type>("_v0") << " = "
+          << m_first[k.var<const uint_>("i")] << ";\n";
+
+        return "_v0";
+    }
+
+private:
+    InputIterator m_first;
+};
+
+template<class Previous, class Function>
+class pipeline_transform_stage
+{
+public:
+    typedef typename Previous::result_type argument_type;
+    typedef typename
+        ::boost::compute::result_of<Function(argument_type)>::type result_type;
+    static const size_t depth = Previous::depth + 1;
+
+    pipeline_transform_stage(const Previous &previous, Function function)
+        : m_previous(previous),
+          m_function(function)
+    {
+    }
+
+    std::string emit(meta_kernel &k) const
+    {
+        const std::string input = m_previous.emit(k);
+        const std::string output = "_v" + boost::lexical_cast<std::string>(static_cast<size_t>(depth));
+
+        k << k.decl<const result_type>(output) << " = "
+          << m_function(k.var<argument_type>(input)) << ";\n";
+
+        return output;
+    }
+
+private:
+    Previous m_previous;
+    Function m_function;
+};
+
+template<class Previous, class Predicate>
+class pipeline_filter_stage
+{
+public:
+    typedef typename Previous::result_type result_type;
+    static const size_t depth = Previous::depth;
+
+    pipeline_filter_stage(const Previous &previous, Predicate predicate)
+        : m_previous(previous),
+          m_predicate(predicate)
+    {
+    }
+
+    std::string emit(meta_kernel &k) const
+    {
+        const std::string input = m_previous.emit(k);
+
+        k << "if(!(" << m_predicate(k.var<result_type>(input)) << ")){\n"
+          << "    continue;\n"
+          << "}\n";
+
+        return input;
+    }
+
+private:
+    Previous m_previous;
+    Predicate m_predicate;
+};
+
+template<class Previous, class OutputIterator>
+class pipeline_store_stage
+{
+public:
+    typedef typename Previous::result_type result_type;
+    static const size_t depth = Previous::depth;
+
+    pipeline_store_stage(const Previous &previous, OutputIterator result)
+        : m_previous(previous),
+          m_result(result)
+    {
+    }
+
+    std::string emit(meta_kernel &k) const
+    {
+        const std::string input = m_previous.emit(k);
+
+        k << m_result[k.var<const uint_>("i")] << " = "
+          << k.var<result_type>(input) << ";\n";
+
+        return input;
+    }
+
+private:
+    Previous m_previous;
+    OutputIterator m_result;
+};
+
+template<class Previous, class Function>
+class pipeline_for_each_stage
+{
+public:
+    typedef typename Previous::result_type result_type;
+    static const size_t depth = Previous::depth;
+
+    pipeline_for_each_stage(const Previous &previous, Function function)
+        : m_previous(previous),
+          m_function(function)
+    {
+    }
+
+    std::string emit(meta_kernel &k) const
+    {
+        const std::string input = m_previous.emit(k);
+
+        k << m_function(k.var<result_type>(input)) << ";\n";
+
+        return input;
+    }
+
+private:
+    Previous m_previous;
+    Function m_function;
+};
+
+// returns the work-group size and number of work-groups for running a
+// pipeline over count values
+inline void pipeline_work_size(size_t count,
+                               command_queue &queue,
+                               size_t &work_group_size,
+                               size_t &work_groups)
+{
+    const device &device = queue.get_device();
+
+    work_group_size = 128;
+    while(work_group_size > device.max_work_group_size()){
+        work_group_size /= 2;
+    }
+
+    work_groups = (count + work_group_size - 1) / work_group_size;
+    work_groups = (std::min)(work_groups, size_t(device.compute_units()) * 4);
+    work_groups = (std::max)(work_groups, size_t(1));
+}
+
+} // end detail namespace
+
+/// \class pipeline
+/// \brief A chain of element-wise operations executed as a single kernel.
+///
+/// A pipeline applies a sequence of stages to each value of an input range.
+/// No work is done while stages are added, the whole chain is generated as
+/// one kernel when a terminal operation (execute(), for_each(), count() or
+/// reduce()) is called. Each value is read from global memory once and no
+/// intermediate buffers are allocated, which for memory-bound chains saves
+/// a full round trip through global memory per stage compared to separate
+/// calls to transform().
+///
+/// Pipelines are created with make_pipeline(). For example, to sum the
+/// squares of the positive values in a vector:
+///
+/// \code
+/// using boost::compute::lambda::_1;
+///
+/// float sum = boost::compute::make_pipeline(vec.begin(), vec.end(), queue)
+///     .filter(_1 > 0)
+///     .transform(_1 * _1)
+///     .reduce(boost::compute::plus<float>());
+/// \endcode
+///
+/// \see make_pipeline()
+template<class Stage>
+class pipeline
+{
+public:
+    /// The type of the values produced by the last stage.
+    typedef typename Stage::result_type value_type;
+
+    /// \internal_
+    pipeline(const Stage &stage, size_t count, command_queue &queue)
+        : m_stage(stage),
+          m_count(count),
+          m_queue(queue)
+    {
+    }
+
+    /// Returns a new pipeline which applies \p function to each value.
+    template<class Function>
+    pipeline<detail::pipeline_transform_stage<Stage, Function> >
+    transform(Function function) const
+    {
+        typedef detail::pipeline_transform_stage<Stage, Function> stage_type;
+
+        return pipeline<stage_type>(
+            stage_type(m_stage, function), m_count, m_queue
+        );
+    }
+
+    /// Returns a new pipeline which drops the values for which
+    /// \p predicate returns \c false. Later stages only see the values
+    /// which pass.
+    template<class Predicate>
+    pipeline<detail::pipeline_filter_stage<Stage, Predicate> >
+    filter(Predicate predicate) const
+    {
+        typedef detail::pipeline_filter_stage<Stage, Predicate> stage_type;
+
+        return pipeline<stage_type>(
+            stage_type(m_stage, predicate), m_count, m_queue
+        );
+    }
+
+    /// Returns a new pipeline which also writes each value reaching this
+    /// stage to \p result, at the same position as its input value. This
+    /// allows a single pass to produce several outputs.
+    template<class OutputIterator>
+    pipeline<detail::pipeline_store_stage<Stage, OutputIterator> >
+    store(OutputIterator result) const
+    {
+        BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+        typedef detail::pipeline_store_stage<Stage, OutputIterator> stage_type;
+
+        return pipeline<stage_type>(
+            stage_type(m_stage, result), m_count, m_queue
+        );
+    }
+
+    /// Runs the pipeline. This is only useful if it contains store() stages.
+    void execute() const
+    {
+        if(m_count == 0){
+            return;
+        }
+
+        size_t work_group_size = 0;
+        size_t work_groups = 0;
+        detail::pipeline_work_size(m_count, m_queue, work_group_size, work_groups);
+
+        detail::meta_kernel k("pipeline");
+        k.add_set_arg<const uint_>("count", static_cast<uint_>(m_count));
+        k << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n";
+        m_stage.emit(k);
+        k << "}\n";
+
+        k.exec_1d(m_queue, 0, work_groups * work_group_size, work_group_size);
+    }
+
+    /// Runs the pipeline and calls \p function with each value reaching the
+    /// end of it.
+    template<class Function>
+    void for_each(Function function) const
+    {
+        typedef detail::pipeline_for_each_stage<Stage, Function> stage_type;
+
+        pipeline<stage_type>(
+            stage_type(m_stage, function), m_count, m_queue
+        ).execute();
+    }
+
+    /// Runs the pipeline and returns the number of values reaching the end
+    /// of it.
+    size_t count() const
+    {
+        std::string source =
+            std::string("inline uint boost_pipeline_one(") +
+            type_name<value_type>() + " x)\n"
+            "{\n"
+            "    return 1;\n"
+            "}\n";
+        function<uint_(value_type)> one =
+            make_function_from_source<uint_(value_type)>("boost_pipeline_one", source);
+
+        return transform(one).reduce(uint_(0), plus<uint_>());
+    }
+
+    /// Runs the pipeline and returns the reduction of the values reaching
+    /// the end of it with \p function, or a default constructed value if no
+    /// value reaches it. \p function must be associative and commutative.
+    template<class BinaryFunction>
+    value_type reduce(BinaryFunction function) const
+    {
+        return reduce_impl(value_type(), false, function);
+    }
+
+    /// Runs the pipeline and returns the reduction of \p init and the values
+    /// reaching the end of it with \p function.
+    template<class BinaryFunction>
+    value_type reduce(value_type init, BinaryFunction function) const
+    {
+        return reduce_impl(init, true, function);
+    }
+
+private:
+    template<class BinaryFunction>
+    value_type reduce_impl(value_type init,
+                           bool use_init,
+                           BinaryFunction function) const
+    {
+        if(m_count == 0){
+            return init;
+        }
+
+        const context &context = m_queue.get_context();
+
+        size_t work_group_size = 0;
+        size_t work_groups = 0;
+        detail::pipeline_work_size(m_count, m_queue, work_group_size, work_groups);
+
+        // the last element holds the final result
+        vector<value_type> partials(work_groups + 1, context);
+        vector<uint_> flags(work_groups + 1, context);
+
+        // reduce the values of each work-group. work-items which do not see
+        // any values are flagged as empty so that no identity is required
+        detail::meta_kernel k("pipeline_reduce");
+        k.add_set_arg<const uint_>("count", static_cast<uint_>(m_count));
+        size_t scratch_arg = k.add_arg<value_type *>(memory_object::local_memory, "scratch");
+        size_t scratch_flags_arg = k.add_arg<uint_ *>(memory_object::local_memory, "scratch_flags");
+
+        k << k.decl<value_type>("acc") << ";\n"
+          << "uint has = 0;\n"
+          << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n";
+        const std::string value = m_stage.emit(k);
+        k << "    if(has){\n"
+          << "        acc = " << function(k.var<value_type>("acc"),
+                                          k.var<value_type>(value)) << ";\n"
+          << "    }\n"
+          << "    else {\n"
+          << "        acc = " << value << ";\n"
+          << "        has = 1;\n"
+          << "    }\n"
+          << "}\n"
+          << "const uint lid = get_local_id(0);\n"
+          << "scratch[lid] = acc;\n"
+          << "scratch_flags[lid] = has;\n"
+          << "for(uint offset = get_local_size(0) / 2; offset > 0; offset /= 2){\n"
+          << "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+          << "    if(lid < offset && scratch_flags[lid + offset]){\n"
+          << "        if(scratch_flags[lid]){\n"
+          << "            scratch[lid] = "
+          <<                  function(k.var<value_type>("scratch[lid]"),
+                                       k.var<value_type>("scratch[lid + offset]")) << ";\n"
+          << "        }\n"
+          << "        else {\n"
+          << "            scratch[lid] = scratch[lid + offset];\n"
+          << "            scratch_flags[lid] = 1;\n"
+          << "        }\n"
+          << "    }\n"
+          << "}\n"
+          << "if(lid == 0){\n"
+          << "    " << partials.begin()[k.var<uint_>("get_group_id(0)")] << " = scratch[0];\n"
+          << "    " << flags.begin()[k.var<uint_>("get_group_id(0)")] << " = scratch_flags[0];\n"
+          << "}\n";
+
+        kernel reduce_kernel = k.compile(context);
+        reduce_kernel.set_arg(scratch_arg, local_buffer<value_type>(work_group_size));
+        reduce_kernel.set_arg(scratch_flags_arg, local_buffer<uint_>(work_group_size));
+        m_queue.enqueue_1d_range_kernel(
+            reduce_kernel, 0, work_groups * work_group_size, work_group_size
+        );
+
+        // combine the results of the work-groups
+        detail::meta_kernel f("pipeline_reduce_final");
+        f.add_set_arg<const uint_>("groups", static_cast<uint_>(work_groups));
+        f.add_set_arg<const uint_>("use_init", use_init ? 1 : 0);
+        f.add_set_arg<const value_type>("init", init);
+        f << f.decl<value_type>("acc") << " = init;\n"
+          << "uint has = use_init;\n"
+          << "for(uint i = 0; i < groups; i++){\n"
+          << "    if(" << flags.begin()[f.var<uint_>("i")] << "){\n"
+          << "        if(has){\n"
+          << "            acc = " << function(f.var<value_type>("acc"),
+                                              partials.begin()[f.var<uint_>("i")]) << ";\n"
+          << "        }\n"
+          << "        else {\n"
+          << "            acc = " << partials.begin()[f.var<uint_>("i")] << ";\n"
+          << "            has = 1;\n"
+          << "        }\n"
+          << "    }\n"
+          << "}\n"
+          << partials.begin()[f.var<uint_>("groups")] << " = acc;\n"
+          << flags.begin()[f.var<uint_>("groups")] << " = has;\n";
+        f.exec(m_queue);
+
+        if(!detail::read_single_value<uint_>(flags.get_buffer(), work_groups, m_queue)){
+            return init;
+        }
+
+        return detail::read_single_value<value_type>(
+            partials.get_buffer(), work_groups, m_queue
+        );
+    }
+
+private:
+    Stage m_stage;
+    size_t m_count;
+    mutable command_queue m_queue;
+};
+
+/// Returns a pipeline over the values in the range [\p first, \p last)
+/// which executes on \p queue.
+///
+/// \see pipeline
+template<class InputIterator>
+inline pipeline<detail::pipeline_input_stage<InputIterator> >
+make_pipeline(InputIterator first,
+              InputIterator last,
+              command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    typedef detail::pipeline_input_stage<InputIterator> stage_type;
+
+    return pipeline<stage_type>(
+        stage_type(first), detail::iterator_range_size(first, last), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_PIPELINE_HPP
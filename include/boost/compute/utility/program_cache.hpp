@@ -11,17 +11,22 @@
 #ifndef BOOST_COMPUTE_UTILITY_PROGRAM_CACHE_HPP
 #define BOOST_COMPUTE_UTILITY_PROGRAM_CACHE_HPP
 
+#include <algorithm>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <boost/compute/context.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/detail/lru_cache.hpp>
 #include <boost/compute/detail/global_static.hpp>
+#include <boost/compute/detail/mutex.hpp>
 
 namespace boost {
 namespace compute {
@@ -55,8 +60,21 @@ public:
     /// Creates a new program cache with space for \p capacity number of
     /// program objects.
     program_cache(size_t capacity)
-        : m_cache(capacity)
+        : m_capacity(capacity)
     {
+        // with BOOST_COMPUTE_THREAD_SAFE large caches are split into shards
+        // with their own lock so that threads looking up different programs
+        // do not contend with each other. eviction is then least recently
+        // used per shard (small caches keep a single shard and exact LRU)
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        const size_t shards = (std::max)(size_t(1), (std::min)(capacity / 8, size_t(16)));
+    #else
+        const size_t shards = 1;
+    #endif
+        const size_t shard_capacity = (capacity + shards - 1) / shards;
+        for(size_t i = 0; i < shards; i++){
+            m_shards.push_back(boost::make_shared<shard>(shard_capacity));
+        }
     }
 
     /// Destroys the program cache.
@@ -67,33 +85,50 @@ public:
     /// Returns the number of program objects currently stored in the cache.
     size_t size() const
     {
-        return m_cache.size();
+        size_t size = 0;
+        for(size_t i = 0; i < m_shards.size(); i++){
+        #ifdef BOOST_COMPUTE_THREAD_SAFE
+            detail::scoped_lock lock(m_shards[i]->mutex);
+        #endif
+            size += m_shards[i]->cache.size();
+        }
+        return size;
     }
 
     /// Returns the total capacity of the cache.
     size_t capacity() const
     {
-        return m_cache.capacity();
+        return m_capacity;
     }
 
     /// Clears the program cache.
     void clear()
     {
-        m_cache.clear();
+        for(size_t i = 0; i < m_shards.size(); i++){
+        #ifdef BOOST_COMPUTE_THREAD_SAFE
+            detail::scoped_lock lock(m_shards[i]->mutex);
+        #endif
+            m_shards[i]->cache.clear();
+        }
     }
 
     /// Returns the program object with \p key. Returns a null optional if no
     /// program with \p key exists in the cache.
     boost::optional<program> get(const std::string &key)
     {
-        return m_cache.get(std::make_pair(key, std::string()));
+        return get(key, std::string());
     }
 
     /// Returns the program object with \p key and \p options. Returns a null
     /// optional if no program with \p key and \p options exists in the cache.
     boost::optional<program> get(const std::string &key, const std::string &options)
     {
-        return m_cache.get(std::make_pair(key, options));
+        const key_type cache_key(key, options);
+        shard &s = shard_for(cache_key);
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(s.mutex);
+    #endif
+        return s.cache.get(cache_key);
     }
 
     /// Inserts \p program into the cache with \p key.
@@ -105,7 +140,12 @@ public:
     /// Inserts \p program into the cache with \p key and \p options.
     void insert(const std::string &key, const std::string &options, const program &program)
     {
-        m_cache.insert(std::make_pair(key, options), program);
+        const key_type cache_key(key, options);
+        shard &s = shard_for(cache_key);
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(s.mutex);
+    #endif
+        s.cache.insert(cache_key, program);
     }
 
     /// Loads the program with \p key from the cache if it exists. Otherwise
@@ -126,11 +166,54 @@ public:
     /// }
     /// return *p;
     /// \endcode
+    ///
+    /// With \c BOOST_COMPUTE_THREAD_SAFE defined, concurrent calls which miss
+    /// on the same key build the program only once: the first caller builds
+    /// it while the others wait for the result. The returned program may be
+    /// shared between threads, kernels should be created from it by each
+    /// thread (as \ref program::create_kernel() does) rather than shared.
     program get_or_build(const std::string &key,
                          const std::string &options,
                          const std::string &source,
                          const context &context)
     {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        const key_type cache_key(key, options);
+        shard &s = shard_for(cache_key);
+
+        detail::scoped_lock lock(s.mutex);
+        for(;;){
+            boost::optional<program> p = s.cache.get(cache_key);
+            if(p){
+                return *p;
+            }
+            if(s.building.find(cache_key) == s.building.end()){
+                break;
+            }
+
+            // another thread is building the program, wait for it
+            s.built.wait(lock);
+        }
+        s.building.insert(cache_key);
+        lock.unlock();
+
+        program p;
+        try {
+            p = program::build_with_source(source, context, options);
+        }
+        catch(...){
+            lock.lock();
+            s.building.erase(cache_key);
+            s.built.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        s.cache.insert(cache_key, p);
+        s.building.erase(cache_key);
+        s.built.notify_all();
+        return p;
+    #else
         boost::optional<program> p = get(key, options);
         if(!p){
             p = program::build_with_source(source, context, options);
@@ -138,6 +221,7 @@ public:
             insert(key, options, *p);
         }
         return *p;
+    #endif
     }
 
     /// Returns the global program cache for \p context.
@@ -146,11 +230,18 @@ public:
     /// program objects used by its algorithms. All Boost.Compute programs are
     /// stored with a cache key beginning with \c "__boost". User programs
     /// should avoid using the same prefix in order to prevent collisions.
+    ///
+    /// The global caches are shared by all threads of the process, so each
+    /// program is only compiled once no matter how many threads use it.
     static boost::shared_ptr<program_cache> get_global_cache(const context &context)
     {
         typedef detail::lru_cache<cl_context, boost::shared_ptr<program_cache> > cache_map;
 
-        BOOST_COMPUTE_DETAIL_GLOBAL_STATIC(cache_map, caches, (8));
+        BOOST_COMPUTE_DETAIL_SHARED_STATIC(cache_map, caches, (8));
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        static detail::mutex caches_mutex;
+        detail::scoped_lock lock(caches_mutex);
+    #endif
 
         boost::optional<boost::shared_ptr<program_cache> > cache = caches.get(context.get());
         if(!cache){
@@ -163,7 +254,38 @@ public:
     }
 
 private:
-    detail::lru_cache<std::pair<std::string, std::string>, program> m_cache;
+    typedef std::pair<std::string, std::string> key_type;
+
+    struct shard
+    {
+        shard(size_t capacity)
+            : cache(capacity)
+        {
+        }
+
+        detail::lru_cache<key_type, program> cache;
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        mutable detail::mutex mutex;
+        detail::condition_variable built;
+        std::set<key_type> building;
+    #endif
+    };
+
+    shard& shard_for(const key_type &key)
+    {
+        if(m_shards.size() == 1){
+            return *m_shards[0];
+        }
+
+        size_t seed = 0;
+        boost::hash_combine(seed, key.first);
+        boost::hash_combine(seed, key.second);
+        return *m_shards[seed % m_shards.size()];
+    }
+
+private:
+    size_t m_capacity;
+    std::vector<boost::shared_ptr<shard> > m_shards;
 };
 
 } // end compute namespace
@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_SEGMENTS_HPP
+#define BOOST_COMPUTE_UTILITY_SEGMENTS_HPP
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class segments
+/// \brief Describes a batch of independent segments of a range.
+///
+/// The batched algorithms (e.g. batched_reduce()) process many independent
+/// segments of a range with a single kernel launch. The segments are
+/// described either by a uniform size and stride or by a buffer of offsets.
+///
+/// For example, to describe 1000 consecutive segments of 64 values each:
+///
+/// \code
+/// boost::compute::segments segments(1000, 64);
+/// \endcode
+///
+/// And to describe segments of different sizes, where segment \c i is the
+/// range [\c offsets[i], \c offsets[i+1]):
+///
+/// \code
+/// // offsets contains segments.count() + 1 values
+/// boost::compute::vector<boost::compute::uint_> offsets = ...;
+/// boost::compute::segments segments(offsets.begin(), offsets.end());
+/// \endcode
+///
+/// Offsets are relative to the first element of the range passed to the
+/// algorithm.
+///
+/// \see batched_reduce(), batched_inclusive_scan(), batched_exclusive_scan(),
+///      batched_min_element(), batched_max_element()
+class segments
+{
+public:
+    /// Creates \p count consecutive segments of \p size values.
+    segments(size_t count, size_t size)
+        : m_count(count),
+          m_size(size),
+          m_stride(size)
+    {
+    }
+
+    /// Creates \p count segments of \p size values where segment \c i starts
+    /// at \c i * \p stride.
+    segments(size_t count, size_t size, size_t stride)
+        : m_count(count),
+          m_size(size),
+          m_stride(stride)
+    {
+    }
+
+    /// Creates segments from the offsets in the range [\p first, \p last).
+    /// Segment \c i is the range [\c first[i], \c first[i+1]). The range
+    /// must contain at least one offset and the offsets must not decrease.
+    segments(const buffer_iterator<uint_> &first,
+             const buffer_iterator<uint_> &last)
+        : m_count(detail::iterator_range_size(first, last) - 1),
+          m_size(0),
+          m_stride(0),
+          m_offsets(first)
+    {
+        BOOST_ASSERT(first != last);
+    }
+
+    /// Returns the number of segments.
+    size_t count() const
+    {
+        return m_count;
+    }
+
+    /// Returns \c true if the segments are described by offsets.
+    bool has_offsets() const
+    {
+        return m_offsets.get_buffer().get() != 0;
+    }
+
+    /// Returns the size of each segment. Only valid if has_offsets() is
+    /// \c false.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /// Returns the distance between the starts of consecutive segments.
+    /// Only valid if has_offsets() is \c false.
+    size_t stride() const
+    {
+        return m_stride;
+    }
+
+    /// Returns an iterator to the offsets. Only valid if has_offsets() is
+    /// \c true.
+    const buffer_iterator<uint_>& offsets() const
+    {
+        return m_offsets;
+    }
+
+private:
+    size_t m_count;
+    size_t m_size;
+    size_t m_stride;
+    buffer_iterator<uint_> m_offsets;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_SEGMENTS_HPP
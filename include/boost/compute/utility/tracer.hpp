@@ -0,0 +1,369 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_TRACER_HPP
+#define BOOST_COMPUTE_UTILITY_TRACER_HPP
+
+#include <map>
+#include <limits>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <sstream>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/exception.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/detail/mutex.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class trace_record
+/// \brief A command recorded by the tracer.
+///
+/// \see tracer
+struct trace_record
+{
+    trace_record()
+        : work_dim(0),
+          bytes(0),
+          queued(0),
+          submit(0),
+          start(0),
+          end(0)
+    {
+        for(size_t i = 0; i < 3; i++){
+            global_work_size[i] = 0;
+            local_work_size[i] = 0;
+        }
+    }
+
+    /// The type of the command (\c "kernel", \c "read_buffer",
+    /// \c "write_buffer", \c "copy_buffer" or \c "fill_buffer").
+    std::string type;
+    /// The name of the kernel function (empty for memory commands).
+    std::string name;
+    /// The program cache key of kernels generated with meta_kernel.
+    std::string cache_key;
+    size_t work_dim;
+    size_t global_work_size[3];
+    size_t local_work_size[3];
+    /// The number of bytes moved by memory commands.
+    size_t bytes;
+    /// The event of the command.
+    event command_event;
+    /// The profiling timestamps (in nanoseconds) of the command. They are
+    /// zero if the command queue does not have profiling enabled.
+    ulong_ queued;
+    ulong_ submit;
+    ulong_ start;
+    ulong_ end;
+};
+
+/// \class tracer
+/// \brief Records every command enqueued by the library.
+///
+/// The tracer records the kernel launches and buffer transfers enqueued
+/// through command_queue, including those launched internally by the
+/// algorithms, along with their kernel name, meta_kernel cache key, work
+/// sizes, bytes moved and profiling timestamps. The records can be exported
+/// in the Chrome trace event format (viewable in chrome://tracing) or as CSV.
+///
+/// Tracing is only compiled in when \c BOOST_COMPUTE_ENABLE_TRACING is
+/// defined. Otherwise the hooks in command_queue are removed by the
+/// preprocessor and have no cost. Timestamps are only available for
+/// commands enqueued to queues created with
+/// command_queue::enable_profiling.
+///
+/// For example:
+///
+/// \code
+/// boost::compute::tracer &tracer = boost::compute::tracer::global();
+/// tracer.start();
+/// boost::compute::sort(vector.begin(), vector.end(), queue);
+/// tracer.stop();
+///
+/// std::ofstream file("sort.json");
+/// tracer.write_chrome_trace(file);
+/// \endcode
+class tracer : boost::noncopyable
+{
+public:
+    /// Creates a new, inactive, tracer.
+    tracer()
+        : m_active(false)
+    {
+    }
+
+    /// Starts recording commands.
+    void start()
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        m_active = true;
+    }
+
+    /// Stops recording commands.
+    void stop()
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        m_active = false;
+        m_cache_keys.clear();
+    }
+
+    /// Returns \c true if the tracer is recording commands.
+    bool is_active() const
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        return m_active;
+    }
+
+    /// Removes all records.
+    void clear()
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        m_records.clear();
+    }
+
+    /// Returns the number of records.
+    size_t size() const
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        return m_records.size();
+    }
+
+    /// Returns the records. This waits for the recorded commands to
+    /// complete in order to read their profiling timestamps.
+    std::vector<trace_record> records() const
+    {
+        std::vector<trace_record> records;
+        {
+        #ifdef BOOST_COMPUTE_THREAD_SAFE
+            detail::scoped_lock lock(m_mutex);
+        #endif
+            records = m_records;
+        }
+
+        for(size_t i = 0; i < records.size(); i++){
+            read_timestamps(records[i]);
+        }
+
+        return records;
+    }
+
+    /// Writes the records to \p stream in the Chrome trace event format.
+    /// Times are in microseconds relative to the first queued command.
+    void write_chrome_trace(std::ostream &stream) const
+    {
+        const std::vector<trace_record> records = this->records();
+        const ulong_ origin = first_timestamp(records);
+
+        stream << "{\"traceEvents\":[";
+        for(size_t i = 0; i < records.size(); i++){
+            const trace_record &r = records[i];
+
+            stream << (i ? ",\n" : "\n")
+                   << "{\"name\":\"" << (r.name.empty() ? r.type : r.name) << "\","
+                   << "\"cat\":\"" << r.type << "\","
+                   << "\"ph\":\"X\","
+                   << "\"pid\":0,"
+                   << "\"tid\":0,"
+                   << "\"ts\":" << microseconds(r.start, origin) << ","
+                   << "\"dur\":" << microseconds(r.end, r.start) << ","
+                   << "\"args\":{"
+                   << "\"cache_key\":\"" << r.cache_key << "\","
+                   << "\"global_work_size\":\"" << work_size(r, r.global_work_size) << "\","
+                   << "\"local_work_size\":\"" << work_size(r, r.local_work_size) << "\","
+                   << "\"bytes\":" << r.bytes << ","
+                   << "\"queued\":" << microseconds(r.queued, origin) << ","
+                   << "\"submit\":" << microseconds(r.submit, origin)
+                   << "}}";
+        }
+        stream << "\n]}\n";
+    }
+
+    /// Writes the records to \p stream as comma-separated values with a
+    /// header line. Timestamps are in nanoseconds.
+    void write_csv(std::ostream &stream) const
+    {
+        const std::vector<trace_record> records = this->records();
+
+        stream << "type,name,cache_key,global_work_size,local_work_size,"
+               << "bytes,queued,submit,start,end\n";
+        for(size_t i = 0; i < records.size(); i++){
+            const trace_record &r = records[i];
+
+            stream << r.type << ","
+                   << r.name << ","
+                   << r.cache_key << ","
+                   << work_size(r, r.global_work_size) << ","
+                   << work_size(r, r.local_work_size) << ","
+                   << r.bytes << ","
+                   << r.queued << ","
+                   << r.submit << ","
+                   << r.start << ","
+                   << r.end << "\n";
+        }
+    }
+
+    /// \internal_
+    void record_kernel(const kernel &kernel,
+                       size_t work_dim,
+                       const size_t *global_work_size,
+                       const size_t *local_work_size,
+                       const event &event_)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        if(!m_active){
+            return;
+        }
+
+        trace_record record;
+        record.type = "kernel";
+        record.name = kernel.name();
+        record.work_dim = work_dim;
+        for(size_t i = 0; i < work_dim && i < 3; i++){
+            record.global_work_size[i] = global_work_size[i];
+            record.local_work_size[i] = local_work_size ? local_work_size[i] : 0;
+        }
+        record.command_event = event_;
+
+        std::map<cl_kernel, std::string>::const_iterator iter =
+            m_cache_keys.find(kernel.get());
+        if(iter != m_cache_keys.end()){
+            record.cache_key = iter->second;
+        }
+
+        m_records.push_back(record);
+    }
+
+    /// \internal_
+    void record_transfer(const char *type, size_t bytes, const event &event_)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        if(!m_active){
+            return;
+        }
+
+        trace_record record;
+        record.type = type;
+        record.bytes = bytes;
+        record.command_event = event_;
+
+        m_records.push_back(record);
+    }
+
+    /// \internal_
+    void set_cache_key(const kernel &kernel, const std::string &cache_key)
+    {
+    #ifdef BOOST_COMPUTE_THREAD_SAFE
+        detail::scoped_lock lock(m_mutex);
+    #endif
+        if(m_active){
+            m_cache_keys[kernel.get()] = cache_key;
+        }
+    }
+
+    /// Returns the global tracer which records the commands enqueued by all
+    /// command queues.
+    static tracer& global()
+    {
+        static tracer global_tracer;
+
+        return global_tracer;
+    }
+
+private:
+    static void read_timestamps(trace_record &record)
+    {
+        if(!record.command_event.get()){
+            return;
+        }
+
+        record.command_event.wait();
+
+        try {
+            record.queued = record.command_event.get_profiling_info<ulong_>(
+                CL_PROFILING_COMMAND_QUEUED
+            );
+            record.submit = record.command_event.get_profiling_info<ulong_>(
+                CL_PROFILING_COMMAND_SUBMIT
+            );
+            record.start = record.command_event.get_profiling_info<ulong_>(
+                CL_PROFILING_COMMAND_START
+            );
+            record.end = record.command_event.get_profiling_info<ulong_>(
+                CL_PROFILING_COMMAND_END
+            );
+        }
+        catch(opencl_error&){
+            // profiling is not enabled for the command queue
+            record.queued = record.submit = record.start = record.end = 0;
+        }
+    }
+
+    static ulong_ first_timestamp(const std::vector<trace_record> &records)
+    {
+        ulong_ first = (std::numeric_limits<ulong_>::max)();
+        for(size_t i = 0; i < records.size(); i++){
+            if(records[i].queued != 0 && records[i].queued < first){
+                first = records[i].queued;
+            }
+        }
+
+        return first == (std::numeric_limits<ulong_>::max)() ? 0 : first;
+    }
+
+    static double microseconds(ulong_ time, ulong_ origin)
+    {
+        return time < origin ? 0.0 : static_cast<double>(time - origin) / 1e3;
+    }
+
+    static std::string work_size(const trace_record &record, const size_t *size)
+    {
+        std::stringstream s;
+        for(size_t i = 0; i < record.work_dim; i++){
+            s << (i ? "x" : "") << size[i];
+        }
+
+        return s.str();
+    }
+
+private:
+    bool m_active;
+    std::vector<trace_record> m_records;
+    std::map<cl_kernel, std::string> m_cache_keys;
+#ifdef BOOST_COMPUTE_THREAD_SAFE
+    mutable detail::mutex m_mutex;
+#endif
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_TRACER_HPP
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// compares reducing many short segments with one reduce() call per segment
+// and with a single batched_reduce() call. the first argument is the number
+// of segments, each of which has segment_size values
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/batched_reduce.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+const size_t segment_size = 256;
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "segments: " << PERF_N << std::endl;
+    std::cout << "segment size: " << segment_size << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    compute::vector<int> input(PERF_N * segment_size, 1, queue);
+    compute::vector<int> sums(PERF_N, context);
+    const compute::segments segments(PERF_N, segment_size);
+
+    // warm up, builds the programs
+    compute::reduce(
+        input.begin(), input.begin() + segment_size, sums.begin(), queue
+    );
+    compute::batched_reduce(input.begin(), segments, sums.begin(), queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        for(size_t i = 0; i < PERF_N; i++){
+            compute::reduce(
+                input.begin() + i * segment_size,
+                input.begin() + (i + 1) * segment_size,
+                sums.begin() + i,
+                queue
+            );
+        }
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "reduce() per segment: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::batched_reduce(input.begin(), segments, sums.begin(), queue);
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "batched_reduce(): " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // check the result
+    std::vector<int> host_sums(PERF_N);
+    compute::copy(sums.begin(), sums.end(), host_sums.begin(), queue);
+    for(size_t i = 0; i < PERF_N; i++){
+        if(host_sums[i] != static_cast<int>(segment_size)){
+            std::cerr << "ERROR: wrong sum for segment " << i << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
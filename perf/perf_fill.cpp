@@ -12,6 +12,7 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/detail/vectorized_transform.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #include "perf.hpp"
@@ -38,6 +39,28 @@ int main(int argc, char *argv[])
         t.stop();
     }
     std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+    std::cout << "bandwidth: "
+              << (PERF_N * sizeof(int)) / t.min_time() << " GB/s" << std::endl;
+
+    // fill with the kernel used when clEnqueueFillBuffer() is not available
+    std::cout << "vector width: "
+              << boost::compute::detail::vector_width<int>(
+                     "__boost_vectorized_transform_int", device
+                 )
+              << std::endl;
+
+    perf_timer kernel_t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        kernel_t.start();
+        boost::compute::detail::fill_with_copy(
+            vec.begin(), vec.size(), int(trial), queue
+        );
+        queue.finish();
+        kernel_t.stop();
+    }
+    std::cout << "kernel time: " << kernel_t.min_time() / 1e6 << " ms" << std::endl;
+    std::cout << "kernel bandwidth: "
+              << (PERF_N * sizeof(int)) / kernel_t.min_time() << " GB/s" << std::endl;
 
     return 0;
 }
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// measures gemm() with square matrices of about PERF_N values and compares
+// gemv() with one inner_product() call per row
+
+#include <cmath>
+#include <iostream>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/gemm.hpp>
+#include <boost/compute/algorithm/gemv.hpp>
+#include <boost/compute/algorithm/inner_product.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    const size_t size = static_cast<size_t>(std::sqrt(double(PERF_N)));
+    std::cout << "matrix: " << size << "x" << size << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    compute::vector<float> a(size * size, 1.f, queue);
+    compute::vector<float> b(size * size, 1.f, queue);
+    compute::vector<float> c(size * size, context);
+    compute::vector<float> x(size, 1.f, queue);
+    compute::vector<float> y(size, context);
+
+    // warm up, builds the programs
+    compute::gemm(
+        size, size, size, 1.f, a.begin(), size, b.begin(), size,
+        0.f, c.begin(), size, queue
+    );
+    compute::gemv(size, size, 1.f, a.begin(), size, x.begin(), 0.f, y.begin(), queue);
+    compute::inner_product(a.begin(), a.begin() + size, x.begin(), 0.f, queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::gemm(
+            size, size, size, 1.f, a.begin(), size, b.begin(), size,
+            0.f, c.begin(), size, queue
+        );
+        queue.finish();
+        t.stop();
+    }
+    const double gemm_time = t.min_time() / 1e9;
+    std::cout << "gemm(): " << gemm_time * 1e3 << " ms, "
+              << 2.0 * size * size * size / gemm_time / 1e9 << " GFLOPS"
+              << std::endl;
+
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::gemv(
+            size, size, 1.f, a.begin(), size, x.begin(), 0.f, y.begin(), queue
+        );
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "gemv(): " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        for(size_t i = 0; i < size; i++){
+            compute::inner_product(
+                a.begin() + i * size, a.begin() + (i + 1) * size, x.begin(), 0.f, queue
+            );
+        }
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "inner_product() per row: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // check the results
+    float c_value = 0;
+    float y_value = 0;
+    compute::copy_n(c.end() - 1, 1, &c_value, queue);
+    compute::copy_n(y.end() - 1, 1, &y_value, queue);
+    if(c_value != float(size) || y_value != float(size)){
+        std::cerr << "ERROR: wrong result" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
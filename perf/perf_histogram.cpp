@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+float rand_float()
+{
+    // skewed towards zero so that a few bins are hot
+    const float x = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    return x * x;
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    boost::compute::device device = boost::compute::system::default_device();
+    boost::compute::context context(device);
+    boost::compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    const size_t num_bins = 256;
+
+    // create vector of random numbers on the host
+    std::vector<float> host_vector(PERF_N);
+    std::generate(host_vector.begin(), host_vector.end(), rand_float);
+
+    // create vector on the device and copy the data
+    boost::compute::vector<float> device_vector(PERF_N, context);
+    boost::compute::copy(
+        host_vector.begin(),
+        host_vector.end(),
+        device_vector.begin(),
+        queue
+    );
+
+    boost::compute::vector<boost::compute::uint_> device_bins(num_bins, context);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        boost::compute::histogram(
+            device_vector.begin(),
+            device_vector.end(),
+            device_bins.begin(),
+            num_bins,
+            0.0f,
+            1.0f,
+            queue
+        );
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // verify histogram is correct
+    std::vector<boost::compute::uint_> host_bins(num_bins, 0);
+    for(size_t i = 0; i < PERF_N; i++){
+        const float f = (host_vector[i] * num_bins) / 1.0f;
+        if(f >= 0 && f < num_bins){
+            host_bins[static_cast<size_t>(f)]++;
+        }
+    }
+
+    std::vector<boost::compute::uint_> device_result(num_bins);
+    boost::compute::copy(
+        device_bins.begin(), device_bins.end(), device_result.begin(), queue
+    );
+    for(size_t i = 0; i < num_bins; i++){
+        if(device_result[i] != host_bins[i]){
+            std::cout << "ERROR: "
+                      << "device_bins[" << i << "] (" << device_result[i] << ") "
+                      << "!= "
+                      << "host_bins[" << i << "] (" << host_bins[i] << ")"
+                      << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/mapped_file.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    std::cout << "size: " << PERF_N << std::endl;
+
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    const char *path = "perf_read_file.bin";
+    {
+        std::vector<int> host_vector = generate_random_vector<int>(PERF_N);
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char *>(&host_vector[0]),
+                   host_vector.size() * sizeof(int));
+    }
+
+    compute::vector<int> device_vector(PERF_N, context);
+
+    // read the file to a std::vector and copy it to the device
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        std::vector<int> host_vector(PERF_N);
+        file.read(reinterpret_cast<char *>(&host_vector[0]), PERF_N * sizeof(int));
+        compute::copy(host_vector.begin(), host_vector.end(), device_vector.begin(), queue);
+        t.stop();
+    }
+    std::cout << "read + copy:         " << t.min_time() / 1e6 << " ms, "
+              << perf_rate<int>(PERF_N, t.min_time()) << " MB/s" << std::endl;
+
+    // stream the mapped file to the device
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::read_file_to_buffer(path, device_vector.begin(), queue);
+        t.stop();
+    }
+    std::cout << "read_file_to_buffer: " << t.min_time() / 1e6 << " ms, "
+              << perf_rate<int>(PERF_N, t.min_time()) << " MB/s" << std::endl;
+
+    // and back to the file
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::write_buffer_to_file(device_vector.begin(), device_vector.end(), path, queue);
+        t.stop();
+    }
+    std::cout << "write_buffer_to_file: " << t.min_time() / 1e6 << " ms, "
+              << perf_rate<int>(PERF_N, t.min_time()) << " MB/s" << std::endl;
+
+    std::remove(path);
+
+    return 0;
+}
@@ -18,6 +18,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/algorithm/detail/vectorized_transform.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #include "perf.hpp"
@@ -72,37 +73,32 @@ void tune_saxpy(const compute::vector<T>& x,
         params = compute::detail::parameter_cache::get_global_cache(queue.get_device());
 
     const std::string cache_key =
-        std::string("__boost_copy_kernel_") + boost::lexical_cast<std::string>(sizeof(T));
+        std::string("__boost_vectorized_transform_") + compute::type_name<T>();
 
-    const compute::uint_ tpbs[] = { 4, 8, 16, 32, 64, 128, 256, 512, 1024 };
-    const compute::uint_ vpts[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+    // a vector width of one uses the scalar copy kernel
+    const compute::uint_ vws[] = { 1, 2, 4, 8, 16 };
 
     double min_time = (std::numeric_limits<double>::max)();
-    compute::uint_ best_tpb = 0;
-    compute::uint_ best_vpt = 0;
-
-    for(size_t i = 0; i < sizeof(tpbs) / sizeof(*tpbs); i++){
-        params->set(cache_key, "tpb", tpbs[i]);
-        for(size_t j = 0; j < sizeof(vpts) / sizeof(*vpts); j++){
-            params->set(cache_key, "vpt", vpts[j]);
-
-            try {
-                const double t = perf_saxpy(x, y, alpha, trials, queue);
-                if(t < min_time){
-                    best_tpb = tpbs[i];
-                    best_vpt = vpts[j];
-                    min_time = t;
-                }
-            }
-            catch(compute::opencl_error&){
-                // invalid parameters for this device, skip
+    compute::uint_ best_vw = 1;
+
+    for(size_t i = 0; i < sizeof(vws) / sizeof(*vws); i++){
+        params->set(cache_key, "vw", vws[i]);
+
+        try {
+            const double t = perf_saxpy(x, y, alpha, trials, queue);
+            std::cout << "vw: " << vws[i] << ", time: " << t / 1e6 << " ms" << std::endl;
+            if(t < min_time){
+                best_vw = vws[i];
+                min_time = t;
             }
         }
+        catch(compute::opencl_error&){
+            // invalid parameters for this device, skip
+        }
     }
 
     // store optimal parameters
-    params->set(cache_key, "tpb", best_tpb);
-    params->set(cache_key, "vpt", best_vpt);
+    params->set(cache_key, "vw", best_vw);
 }
 
 int main(int argc, char *argv[])
@@ -156,7 +152,16 @@ int main(int argc, char *argv[])
 
     // run benchmark
     double t = perf_saxpy(x, y, alpha, trials, queue);
+    std::cout << "vector width: "
+              << compute::detail::vector_width<float>(
+                     "__boost_vectorized_transform_float", device
+                 )
+              << std::endl;
     std::cout << "time: " << t / 1e6 << " ms" << std::endl;
 
+    // two reads and one write per element
+    std::cout << "bandwidth: "
+              << (3 * size * sizeof(float)) / t << " GB/s" << std::endl;
+
     return 0;
 }
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// measures the number of transform() calls per second on small inputs, where
+// the time is dominated by the host-side cost of preparing the kernel
+
+#include <iostream>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+const size_t calls_per_trial = 1000;
+
+template<class Function>
+double calls_per_second(compute::vector<int> &a,
+                        compute::vector<int> &b,
+                        compute::vector<int> &c,
+                        Function function,
+                        compute::command_queue &queue)
+{
+    // warm up, builds the program
+    compute::transform(a.begin(), a.end(), b.begin(), c.begin(), function, queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        for(size_t i = 0; i < calls_per_trial; i++){
+            compute::transform(
+                a.begin(), a.end(), b.begin(), c.begin(), function, queue
+            );
+        }
+        queue.finish();
+        t.stop();
+    }
+
+    return calls_per_trial / (t.min_time() / 1e9);
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    compute::vector<int> a(PERF_N, 1, queue);
+    compute::vector<int> b(PERF_N, 2, queue);
+    compute::vector<int> c(PERF_N, context);
+
+    // built-in operator, uses the kernel registered by type
+    std::cout << "registered kernel: "
+              << calls_per_second(a, b, c, compute::plus<int>(), queue)
+              << " calls/s" << std::endl;
+
+    // lambda expression, generates and hashes the kernel source on each call
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+    std::cout << "generated kernel: "
+              << calls_per_second(a, b, c, _1 + _2, queue)
+              << " calls/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// measures the spmv() kernels with a random sparse matrix of about PERF_N
+// entries whose rows have very different lengths and checks the results
+// against a serial product on the host
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/spmv.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+typedef void (*spmv_function)(const compute::csr_matrix<float> &,
+                              compute::vector<float>::iterator,
+                              compute::vector<float>::iterator,
+                              compute::command_queue &);
+
+void host_spmv(const std::vector<compute::uint_> &offsets,
+               const std::vector<compute::uint_> &columns,
+               const std::vector<float> &values,
+               const std::vector<float> &x,
+               std::vector<float> &y)
+{
+    for(size_t row = 0; row + 1 < offsets.size(); row++){
+        float sum = 0;
+        for(compute::uint_ j = offsets[row]; j < offsets[row + 1]; j++){
+            sum += values[j] * x[columns[j]];
+        }
+        y[row] = sum;
+    }
+}
+
+bool run(const std::string &name,
+         spmv_function function,
+         const compute::csr_matrix<float> &a,
+         compute::vector<float> &x,
+         compute::vector<float> &y,
+         const std::vector<float> &expected,
+         compute::command_queue &queue)
+{
+    // warm up, builds the programs
+    function(a, x.begin(), y.begin(), queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        function(a, x.begin(), y.begin(), queue);
+        queue.finish();
+        t.stop();
+    }
+    std::cout << name << ": " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    std::vector<float> result(expected.size());
+    compute::copy(y.begin(), y.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        if(result[i] != expected[i]){
+            std::cerr << "ERROR: " << name << " row " << i << ": "
+                      << result[i] << " != " << expected[i] << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    // most rows have a few entries and every 64th row has a hundred times
+    // more, like the matrices of power-law graphs. the values are small
+    // integers so that the sums are exact
+    std::srand(1);
+    std::vector<compute::uint_> host_offsets(1, 0);
+    std::vector<compute::uint_> host_columns;
+    std::vector<float> host_values;
+    const size_t cols = (std::max)(PERF_N / 8, size_t(1));
+    while(host_values.size() < PERF_N){
+        const size_t row = host_offsets.size() - 1;
+        const size_t length =
+            row % 64 == 0 ? 100 + std::rand() % 800 : 1 + std::rand() % 8;
+        for(size_t i = 0; i < length; i++){
+            host_columns.push_back(static_cast<compute::uint_>(std::rand() % cols));
+            host_values.push_back(static_cast<float>(std::rand() % 5) - 2.f);
+        }
+        host_offsets.push_back(static_cast<compute::uint_>(host_values.size()));
+    }
+    const size_t rows = host_offsets.size() - 1;
+
+    std::vector<float> host_x(cols);
+    for(size_t i = 0; i < cols; i++){
+        host_x[i] = static_cast<float>(std::rand() % 4);
+    }
+
+    std::cout << "matrix: " << rows << "x" << cols << ", "
+              << host_values.size() << " entries" << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::vector<float> expected(rows);
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        host_spmv(host_offsets, host_columns, host_values, host_x, expected);
+        t.stop();
+    }
+    std::cout << "host: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    compute::csr_matrix<float> a(
+        rows, cols, host_values.size(),
+        host_offsets.begin(), host_columns.begin(), host_values.begin(), queue
+    );
+    compute::vector<float> x(host_x.begin(), host_x.end(), queue);
+    compute::vector<float> y(rows, context);
+
+    typedef compute::vector<float>::iterator iterator;
+    bool ok = true;
+    ok &= run("spmv()", &compute::spmv<float, iterator, iterator>,
+              a, x, y, expected, queue);
+    ok &= run("scalar", &compute::detail::spmv_scalar<float, iterator, iterator>,
+              a, x, y, expected, queue);
+    ok &= run("vector", &compute::detail::spmv_vector<float, iterator, iterator>,
+              a, x, y, expected, queue);
+    ok &= run("merge path", &compute::detail::spmv_merge_path<float, iterator, iterator>,
+              a, x, y, expected, queue);
+
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// compares transposing a square matrix of PERF_N values with copying it
+// and with a naive gather through a permutation_iterator
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/transpose.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/permutation_iterator.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+
+    const size_t size = static_cast<size_t>(std::sqrt(double(PERF_N)));
+    const size_t count = size * size;
+    std::cout << "matrix: " << size << "x" << size << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    compute::vector<float> input(count, context);
+    compute::iota(input.begin(), input.end(), 0.f, queue);
+    compute::vector<float> output(count, context);
+
+    // source index for each value of the transposed matrix
+    std::vector<compute::uint_> host_indices(count);
+    for(size_t i = 0; i < size; i++){
+        for(size_t j = 0; j < size; j++){
+            host_indices[j * size + i] = static_cast<compute::uint_>(i * size + j);
+        }
+    }
+    compute::vector<compute::uint_> indices(
+        host_indices.begin(), host_indices.end(), queue
+    );
+
+    // warm up, builds the programs
+    compute::copy(input.begin(), input.end(), output.begin(), queue);
+    compute::copy(
+        compute::make_permutation_iterator(input.begin(), indices.begin()),
+        compute::make_permutation_iterator(input.begin(), indices.end()),
+        output.begin(),
+        queue
+    );
+    compute::transpose(input.begin(), output.begin(), size, size, queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::copy(input.begin(), input.end(), output.begin(), queue);
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "copy(): " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::copy(
+            compute::make_permutation_iterator(input.begin(), indices.begin()),
+            compute::make_permutation_iterator(input.begin(), indices.end()),
+            output.begin(),
+            queue
+        );
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "gather: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    t.clear();
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        compute::transpose(input.begin(), output.begin(), size, size, queue);
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "transpose(): " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // check the result
+    std::vector<float> host_output(count);
+    compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+    for(size_t i = 0; i < count; i++){
+        if(host_output[i] != static_cast<float>(host_indices[i])){
+            std::cerr << "ERROR: wrong value at index " << i << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
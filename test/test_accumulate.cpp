@@ -299,4 +299,24 @@ BOOST_AUTO_TEST_CASE(std_accumulate_equality)
     }
 }
 
+BOOST_AUTO_TEST_CASE(accumulate_async)
+{
+    int data[] = { 2, 4, 6, 8 };
+    boost::compute::vector<int> vector(data, data + 4, queue);
+
+    boost::compute::future<int> sum = boost::compute::accumulate_async(
+        vector.begin(), vector.end(), 10, queue
+    );
+    boost::compute::future<int> product = boost::compute::accumulate_async(
+        vector.begin(), vector.end(), 1, boost::compute::multiplies<int>(), queue
+    );
+    boost::compute::future<int> empty = boost::compute::accumulate_async(
+        vector.begin(), vector.begin(), 3, queue
+    );
+
+    BOOST_CHECK_EQUAL(sum.get(), 30);
+    BOOST_CHECK_EQUAL(product.get(), 384);
+    BOOST_CHECK_EQUAL(empty.get(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -86,4 +86,22 @@ boost::compute::any_of(v.begin(), v.end(), _1 < 0, queue);
     BOOST_CHECK(result == false);
 }
 
+BOOST_AUTO_TEST_CASE(any_all_none_of_async)
+{
+    using boost::compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+    bc::vector<int> v(data, data + 6, queue);
+
+    bc::future<bool> any = bc::any_of_async(v.begin(), v.end(), _1 == 4, queue);
+    bc::future<bool> all = bc::all_of_async(v.begin(), v.end(), _1 > 0, queue);
+    bc::future<bool> none = bc::none_of_async(v.begin(), v.end(), _1 > 5, queue);
+    bc::future<bool> empty = bc::any_of_async(v.begin(), v.begin(), _1 > 0, queue);
+
+    BOOST_CHECK(any.get() == true);
+    BOOST_CHECK(all.get() == true);
+    BOOST_CHECK(none.get() == false);
+    BOOST_CHECK(empty.get() == false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAsyncExecutionPolicy
+#include <boost/test/unit_test.hpp>
+
+#include <boost/make_shared.hpp>
+
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/allocator/scratch_pool.hpp>
+#include <boost/compute/async/execution_policy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(synchronous_scope)
+{
+    compute::vector<int> vector(1000, context);
+
+    compute::execution_policy policy(queue);
+    BOOST_CHECK(!policy.is_async());
+    BOOST_CHECK(policy.get_event().get() == cl_event());
+
+    {
+        compute::execution_policy::scope scope(policy);
+        compute::iota(vector.begin(), vector.end(), 0, queue);
+    }
+
+    // the scope waits for the commands enqueued within it
+    BOOST_CHECK(policy.get_event().get() != cl_event());
+    BOOST_CHECK(policy.get_event().status() == CL_COMPLETE);
+
+    int sum = 0;
+    compute::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 499500);
+}
+
+// reduces a vector of floats into a host value
+struct reduce_to_host
+{
+    reduce_to_host(compute::vector<float> &vector, float *result)
+        : vector(vector), result(result)
+    {
+    }
+
+    void operator()(compute::command_queue &queue) const
+    {
+        compute::reduce(vector.begin(), vector.end(), result, queue);
+    }
+
+    compute::vector<float> &vector;
+    float *result;
+};
+
+BOOST_AUTO_TEST_CASE(scratch_pool_reuse)
+{
+    boost::shared_ptr<compute::scratch_pool> pool =
+        boost::make_shared<compute::scratch_pool>(context);
+
+    compute::execution_policy policy(queue);
+    policy.set_scratch_pool(pool);
+
+    compute::vector<float> vector(100000, context);
+    compute::fill(vector.begin(), vector.end(), 1.0f, queue);
+
+    float sum = 0;
+    policy.execute(reduce_to_host(vector, &sum));
+    BOOST_CHECK_CLOSE(sum, 100000.0f, 1e-4f);
+    const size_t buffers = pool->size();
+
+    // the temporary buffers of the second reduction come from the pool
+    policy.execute(reduce_to_host(vector, &sum));
+    BOOST_CHECK_CLOSE(sum, 100000.0f, 1e-4f);
+    BOOST_CHECK_EQUAL(pool->size(), buffers);
+}
+
+BOOST_AUTO_TEST_CASE(tuning_parameters)
+{
+    compute::execution_policy policy(queue);
+    policy.set_parameter("__boost_host_dispatch", "reduce", 12345);
+
+    {
+        compute::execution_policy::scope scope(policy);
+        BOOST_CHECK_EQUAL(compute::host_dispatch::threshold("reduce", device), size_t(12345));
+    }
+
+    BOOST_CHECK(compute::host_dispatch::threshold("reduce", device) != size_t(12345));
+}
+
+#ifdef BOOST_COMPUTE_CL_VERSION_1_2
+BOOST_AUTO_TEST_CASE(async_dependencies)
+{
+    // before OpenCL 1.2 the dependencies are waited for on the host,
+    // which would block on the user event completed below
+    REQUIRES_OPENCL_VERSION(1, 2);
+
+    compute::user_event ready(context);
+
+    compute::vector<int> vector(64, context);
+    compute::fill(vector.begin(), vector.end(), 0, queue);
+
+    compute::execution_policy policy(queue);
+    policy.depends_on(ready).set_async();
+    BOOST_CHECK_EQUAL(policy.get_dependencies().size(), size_t(1));
+
+    {
+        compute::execution_policy::scope scope(policy);
+        compute::fill(vector.begin(), vector.end(), 7, queue);
+    }
+
+    // the dependencies are consumed by the scope
+    BOOST_CHECK(policy.get_dependencies().empty());
+
+    // the scope does not wait for the commands enqueued within it
+    BOOST_CHECK(policy.get_event().status() != CL_COMPLETE);
+
+    ready.set_status(CL_COMPLETE);
+    policy.get_event().wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (7, 7, 7, 7));
+}
+#endif // BOOST_COMPUTE_CL_VERSION_1_2
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestAutotuner
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/utility/autotuner.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
+
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+struct count_calls
+{
+    count_calls(size_t *calls) : m_calls(calls) { }
+
+    void operator()(bc::command_queue &queue) const
+    {
+        (*m_calls)++;
+        queue.enqueue_marker();
+    }
+
+    size_t *m_calls;
+};
+
+struct reject_value
+{
+    bool operator()(bc::command_queue&) const
+    {
+        return false;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(tune_custom_parameter)
+{
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+
+    bc::autotuner tuner(queue, 2);
+
+    std::vector<bc::uint_> values;
+    values.push_back(1);
+    values.push_back(2);
+    values.push_back(4);
+
+    // each value is run once untimed and then once for each trial
+    size_t calls = 0;
+    bc::uint_ best = tuner.tune(
+        "__test_autotuner", "value", values, count_calls(&calls)
+    );
+    BOOST_CHECK_EQUAL(calls, size_t(9));
+    BOOST_CHECK(best == 1 || best == 2 || best == 4);
+    BOOST_CHECK_EQUAL(parameters->get("__test_autotuner", "value", 0), best);
+
+    // if all values are rejected the previous value is kept
+    bc::uint_ rejected = tuner.tune(
+        "__test_autotuner", "value", values, count_calls(&calls), reject_value()
+    );
+    BOOST_CHECK_EQUAL(rejected, bc::uint_(0));
+    BOOST_CHECK_EQUAL(parameters->get("__test_autotuner", "value", 0), best);
+
+    // and an unset value stays unset
+    tuner.tune(
+        "__test_autotuner", "other", values, count_calls(&calls), reject_value()
+    );
+    BOOST_CHECK_EQUAL(parameters->get("__test_autotuner", "other", 7), bc::uint_(7));
+}
+
+BOOST_AUTO_TEST_CASE(tune_sort)
+{
+    bc::autotuner tuner(queue, 1);
+    tuner.tune_sort<int>(4096);
+
+    // sort uses the tuned parameters
+    std::vector<int> host(4096);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>(host.size() - i);
+    }
+    bc::vector<int> vector(host.begin(), host.end(), queue);
+    bc::sort(vector.begin(), vector.end(), queue);
+    BOOST_CHECK(bc::is_sorted(vector.begin(), vector.end(), queue));
+}
+
+BOOST_AUTO_TEST_CASE(tune_map_copy)
+{
+    bc::autotuner tuner(queue, 1);
+    const bc::uint_ threshold = tuner.tune_map_copy<int, float>(16384);
+
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+    BOOST_CHECK_EQUAL(
+        parameters->get("__boost_compute_copy_to_device_int_float", "map_copy_threshold", 0),
+        threshold
+    );
+    BOOST_CHECK(threshold >= 4096);
+
+    // copies use the tuned threshold in both directions
+    std::vector<int> host(10000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>(i);
+    }
+    bc::vector<float> vector(host.size(), context);
+    bc::copy(host.begin(), host.end(), vector.begin(), queue);
+    std::vector<int> result(host.size());
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
+BOOST_AUTO_TEST_CASE(tune_host_dispatch)
+{
+    bc::autotuner tuner(queue, 1);
+    tuner.tune_host_dispatch<int>(1024);
+
+    // every threshold is a power of two up to the first one above the size
+    const char *algorithms[] = { "reduce", "scan", "count", "find_extrema" };
+    for(size_t i = 0; i < 4; i++){
+        const size_t threshold = bc::host_dispatch::threshold(algorithms[i], device);
+        BOOST_CHECK(threshold >= 1 && threshold <= 2048);
+        BOOST_CHECK_EQUAL(threshold & (threshold - 1), size_t(0));
+    }
+
+    // reduce uses the tuned threshold
+    bc::vector<int> vector(100, context);
+    bc::fill(vector.begin(), vector.end(), 2, queue);
+    int sum = 0;
+    bc::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 200);
+
+    for(size_t i = 0; i < 4; i++){
+        bc::host_dispatch::set_threshold(algorithms[i], device, 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBatched
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include <boost/compute/algorithm/batched_exclusive_scan.hpp>
+#include <boost/compute/algorithm/batched_inclusive_scan.hpp>
+#include <boost/compute/algorithm/batched_max_element.hpp>
+#include <boost/compute/algorithm/batched_min_element.hpp>
+#include <boost/compute/algorithm/batched_reduce.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/utility/segments.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(batched_reduce_rows)
+{
+    std::vector<int> host(1000 * 64);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>(i % 97);
+    }
+    bc::vector<int> matrix(host.begin(), host.end(), queue);
+
+//! [batched_reduce_rows]
+// sum each row of the 1000x64 matrix
+boost::compute::vector<int> sums(1000, context);
+boost::compute::batched_reduce(
+    matrix.begin(), boost::compute::segments(1000, 64), sums.begin(), queue
+);
+//! [batched_reduce_rows]
+
+    std::vector<int> host_sums(1000);
+    bc::copy(sums.begin(), sums.end(), host_sums.begin(), queue);
+    for(size_t row = 0; row < 1000; row++){
+        int expected = std::accumulate(
+            host.begin() + row * 64, host.begin() + (row + 1) * 64, 0
+        );
+        BOOST_CHECK_EQUAL(host_sums[row], expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_reduce_strided)
+{
+    // three segments of three values with a stride of four
+    int data[] = { 1, 2, 3, -1,
+                   4, 5, 6, -1,
+                   7, 8, 9, -1 };
+    bc::vector<int> input(data, data + 12, queue);
+
+    bc::vector<int> sums(3, context);
+    bc::batched_reduce(input.begin(), bc::segments(3, 3, 4), sums.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 3, sums, (6, 15, 24));
+
+    bc::vector<int> maximums(3, context);
+    bc::batched_reduce(
+        input.begin(), bc::segments(3, 3, 4), maximums.begin(), bc::max<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, maximums, (3, 6, 9));
+}
+
+BOOST_AUTO_TEST_CASE(batched_reduce_offsets)
+{
+    // segments of sizes 1, 0, 4, 200 and 3
+    std::vector<bc::uint_> offsets;
+    offsets.push_back(0);
+    offsets.push_back(1);
+    offsets.push_back(1);
+    offsets.push_back(5);
+    offsets.push_back(205);
+    offsets.push_back(208);
+    bc::vector<bc::uint_> device_offsets(offsets.begin(), offsets.end(), queue);
+
+    bc::vector<int> input(208, context);
+    bc::iota(input.begin(), input.end(), 0, queue);
+
+    bc::vector<int> sums(5, context);
+    bc::fill(sums.begin(), sums.end(), -1, queue);
+    bc::batched_reduce(
+        input.begin(),
+        bc::segments(device_offsets.begin(), device_offsets.end()),
+        sums.begin(),
+        queue
+    );
+
+    // the result of the empty segment is not written
+    CHECK_RANGE_EQUAL(int, 5, sums, (0, -1, 10, 20900, 618));
+}
+
+BOOST_AUTO_TEST_CASE(batched_reduce_order)
+{
+    // an associative but not commutative function which returns the last
+    // value of each segment if the order of the values is preserved
+    BOOST_COMPUTE_FUNCTION(int, second, (int x, int y),
+    {
+        return y;
+    });
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    bc::vector<int> input(data, data + 9, queue);
+
+    bc::vector<int> result(2, context);
+    bc::batched_reduce(
+        input.begin(), bc::segments(2, 4, 5), result.begin(), second, queue
+    );
+    CHECK_RANGE_EQUAL(int, 2, result, (4, 9));
+}
+
+BOOST_AUTO_TEST_CASE(batched_inclusive_scan)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    bc::vector<int> input(data, data + 8, queue);
+    bc::vector<int> output(8, context);
+
+    bc::batched_inclusive_scan(
+        input.begin(), bc::segments(2, 4), output.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 8, output, (1, 3, 6, 10, 5, 11, 18, 26));
+
+    bc::batched_inclusive_scan(
+        input.begin(), bc::segments(4, 2), output.begin(), bc::multiplies<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 8, output, (1, 2, 3, 12, 5, 30, 7, 56));
+}
+
+BOOST_AUTO_TEST_CASE(batched_exclusive_scan_in_place)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    bc::vector<int> vector(data, data + 8, queue);
+
+    bc::batched_exclusive_scan(
+        vector.begin(), bc::segments(2, 4), vector.begin(), 10, queue
+    );
+    CHECK_RANGE_EQUAL(int, 8, vector, (10, 11, 13, 16, 10, 15, 21, 28));
+}
+
+BOOST_AUTO_TEST_CASE(batched_scan_large_segments)
+{
+    const size_t segment_count = 37;
+    const size_t segment_size = 1000;
+
+    bc::vector<int> input(segment_count * segment_size, context);
+    bc::fill(input.begin(), input.end(), 1, queue);
+
+    bc::vector<int> output(input.size(), context);
+    bc::batched_inclusive_scan(
+        input.begin(), bc::segments(segment_count, segment_size), output.begin(), queue
+    );
+
+    std::vector<int> host(output.size());
+    bc::copy(output.begin(), output.end(), host.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<int>(i % segment_size) + 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_min_max_element)
+{
+    float data[] = { 3.f, 1.f, 4.f, 1.f,
+                     5.f, 9.f, 2.f, 9.f,
+                     6.f, 5.f, 3.f, 5.f };
+    bc::vector<float> input(data, data + 12, queue);
+
+    bc::vector<bc::uint_> positions(3, context);
+
+    // the position of the first extremum is found
+    bc::batched_min_element(input.begin(), bc::segments(3, 4), positions.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 3, positions, (1, 2, 2));
+
+    bc::batched_max_element(input.begin(), bc::segments(3, 4), positions.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 3, positions, (2, 1, 0));
+
+    bc::batched_min_element(
+        input.begin(), bc::segments(3, 4), positions.begin(), bc::greater<float>(), queue
+    );
+    CHECK_RANGE_EQUAL(bc::uint_, 3, positions, (2, 1, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
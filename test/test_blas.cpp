@@ -0,0 +1,236 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestBlas
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/axpby.hpp>
+#include <boost/compute/algorithm/batched_gemm.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/gemm.hpp>
+#include <boost/compute/algorithm/gemv.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/strided_iterator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// returns count values which are not too large to be summed exactly
+std::vector<float> make_values(size_t count, size_t seed)
+{
+    std::vector<float> values(count);
+    for(size_t i = 0; i < count; i++){
+        values[i] = static_cast<float>((i * 7 + seed * 3) % 11) - 5.f;
+    }
+    return values;
+}
+
+// computes c = alpha * a * b + beta * c on the host
+void host_gemm(size_t m, size_t n, size_t k,
+               float alpha,
+               const float *a, size_t lda,
+               const float *b, size_t ldb,
+               float beta,
+               float *c, size_t ldc)
+{
+    for(size_t i = 0; i < m; i++){
+        for(size_t j = 0; j < n; j++){
+            float sum = 0;
+            for(size_t p = 0; p < k; p++){
+                sum += a[i * lda + p] * b[p * ldb + j];
+            }
+            c[i * ldc + j] = alpha * sum + beta * c[i * ldc + j];
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gemv_float)
+{
+//! [gemv_dense_layer]
+// weights of a dense layer with four inputs and three outputs
+float weights[] = { 1, 0, 0, 1,
+                    0, 1, 0, 1,
+                    1, 1, 1, 1 };
+float inputs[] = { 1, 2, 3, 4 };
+float biases[] = { 10, 20, 30 };
+
+boost::compute::vector<float> w(weights, weights + 12, queue);
+boost::compute::vector<float> x(inputs, inputs + 4, queue);
+boost::compute::vector<float> y(biases, biases + 3, queue);
+
+// y = w * x + y
+boost::compute::gemv(3, 4, 1.f, w.begin(), 4, x.begin(), 1.f, y.begin(), queue);
+
+// y = { 15, 26, 40 }
+//! [gemv_dense_layer]
+
+    CHECK_RANGE_EQUAL(float, 3, y, (15, 26, 40));
+
+    // y is not read if beta is zero
+    compute::gemv(3, 4, 2.f, w.begin(), 4, x.begin(), 0.f, y.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 3, y, (10, 12, 20));
+}
+
+BOOST_AUTO_TEST_CASE(gemv_strided)
+{
+    // a 2x3 matrix with padded rows and a vector with a stride of two
+    float matrix[] = { 1, 2, 3, -1,
+                       4, 5, 6, -1 };
+    float values[] = { 1, -1, 1, -1, 1, -1 };
+
+    compute::vector<float> a(matrix, matrix + 8, queue);
+    compute::vector<float> x(values, values + 6, queue);
+    compute::vector<float> y(2, context);
+
+    compute::gemv(
+        2, 3, 1.f, a.begin(), 4,
+        compute::make_strided_iterator(x.begin(), 2), 0.f, y.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(float, 2, y, (6, 15));
+}
+
+BOOST_AUTO_TEST_CASE(gemv_long_rows)
+{
+    const size_t rows = 7;
+    const size_t cols = 1001;
+
+    std::vector<float> host_a = make_values(rows * cols, 1);
+    std::vector<float> host_x = make_values(cols, 2);
+
+    compute::vector<float> a(host_a.begin(), host_a.end(), queue);
+    compute::vector<float> x(host_x.begin(), host_x.end(), queue);
+    compute::vector<float> y(rows, context);
+
+    compute::gemv(rows, cols, 1.f, a.begin(), cols, x.begin(), 0.f, y.begin(), queue);
+
+    std::vector<float> expected(rows, 0.f);
+    host_gemm(rows, 1, cols, 1.f, &host_a[0], cols, &host_x[0], 1, 0.f, &expected[0], 1);
+
+    std::vector<float> result(rows);
+    compute::copy(y.begin(), y.end(), result.begin(), queue);
+    for(size_t i = 0; i < rows; i++){
+        BOOST_CHECK_EQUAL(result[i], expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gemm_float)
+{
+//! [gemm_float]
+// 2x3 and 3x2 matrices in row-major order
+float a_data[] = { 1, 2, 3,
+                   4, 5, 6 };
+float b_data[] = { 1, 0,
+                   0, 1,
+                   1, 1 };
+
+boost::compute::vector<float> a(a_data, a_data + 6, queue);
+boost::compute::vector<float> b(b_data, b_data + 6, queue);
+boost::compute::vector<float> c(4, context);
+
+// c = a * b
+boost::compute::gemm(
+    2, 2, 3, 1.f, a.begin(), 3, b.begin(), 2, 0.f, c.begin(), 2, queue
+);
+
+// c = { 4, 5,
+//       10, 11 }
+//! [gemm_float]
+
+    CHECK_RANGE_EQUAL(float, 4, c, (4, 5, 10, 11));
+}
+
+BOOST_AUTO_TEST_CASE(gemm_partial_tiles)
+{
+    // sizes which are not a multiple of the tile size and a result with
+    // padded rows
+    const size_t m = 37, n = 53, k = 19, ldc = 60;
+
+    std::vector<float> host_a = make_values(m * k, 1);
+    std::vector<float> host_b = make_values(k * n, 2);
+    std::vector<float> host_c = make_values(m * ldc, 3);
+
+    compute::vector<float> a(host_a.begin(), host_a.end(), queue);
+    compute::vector<float> b(host_b.begin(), host_b.end(), queue);
+    compute::vector<float> c(host_c.begin(), host_c.end(), queue);
+
+    compute::gemm(
+        m, n, k, 2.f, a.begin(), k, b.begin(), n, -1.f, c.begin(), ldc, queue
+    );
+    host_gemm(
+        m, n, k, 2.f, &host_a[0], k, &host_b[0], n, -1.f, &host_c[0], ldc
+    );
+
+    std::vector<float> result(m * ldc);
+    compute::copy(c.begin(), c.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], host_c[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_gemm_shared_weights)
+{
+    // three 4x5 inputs multiplied with the same 5x2 weights
+    const size_t batch = 3, m = 4, n = 2, k = 5;
+
+    std::vector<float> host_a = make_values(batch * m * k, 1);
+    std::vector<float> host_b = make_values(k * n, 2);
+    std::vector<float> host_c(batch * m * n, 0.f);
+
+    compute::vector<float> a(host_a.begin(), host_a.end(), queue);
+    compute::vector<float> b(host_b.begin(), host_b.end(), queue);
+    compute::vector<float> c(batch * m * n, context);
+
+    compute::batched_gemm(
+        batch, m, n, k, 1.f,
+        a.begin(), k, m * k,
+        b.begin(), n, 0,
+        0.f, c.begin(), n, m * n,
+        queue
+    );
+    for(size_t i = 0; i < batch; i++){
+        host_gemm(
+            m, n, k, 1.f, &host_a[i * m * k], k, &host_b[0], n,
+            0.f, &host_c[i * m * n], n
+        );
+    }
+
+    std::vector<float> result(c.size());
+    compute::copy(c.begin(), c.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], host_c[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(axpby_float)
+{
+//! [axpby]
+float x_data[] = { 1, 2, 3, 4 };
+float y_data[] = { 4, 3, 2, 1 };
+
+boost::compute::vector<float> x(x_data, x_data + 4, queue);
+boost::compute::vector<float> y(y_data, y_data + 4, queue);
+
+// y = 2 * x + 3 * y
+boost::compute::axpby(2.f, x.begin(), x.end(), 3.f, y.begin(), queue);
+
+// y = { 14, 13, 12, 11 }
+//! [axpby]
+
+    CHECK_RANGE_EQUAL(float, 4, y, (14, 13, 12, 11));
+
+    compute::axpby(0.5f, x.begin(), x.end(), 0.f, y.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 4, y, (0.5f, 1, 1.5f, 2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
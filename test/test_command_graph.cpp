@@ -0,0 +1,164 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCommandGraph
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/command_graph.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(record_and_replay_kernel)
+{
+    const char source[] =
+        "__kernel void scale(__global int *data, const int factor)\n"
+        "{\n"
+        "    const uint i = get_global_id(0);\n"
+        "    data[i] = data[i] * factor;\n"
+        "}\n";
+
+    bc::program program = bc::program::create_with_source(source, context);
+    program.build();
+    bc::kernel kernel(program, "scale");
+
+    int data[] = { 1, 2, 3, 4 };
+    bc::vector<int> vector(data, data + 4, queue);
+
+    queue.begin_recording();
+    BOOST_CHECK(queue.is_recording());
+    kernel.set_arg(0, vector);
+    kernel.set_arg(1, 2);
+    queue.enqueue_1d_range_kernel(kernel, 0, 4, 0);
+    bc::command_graph graph = queue.end_recording();
+    BOOST_CHECK(!queue.is_recording());
+
+    BOOST_CHECK_EQUAL(graph.size(), size_t(1));
+    BOOST_CHECK_EQUAL(graph.kernel_count(), size_t(1));
+    CHECK_RANGE_EQUAL(int, 4, vector, (2, 4, 6, 8));
+
+    // changing the kernel's arguments does not affect the recording
+    kernel.set_arg(1, 100);
+
+    queue.enqueue_command_graph(graph).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (4, 8, 12, 16));
+
+    // rebind the factor
+    graph.set_arg(0, 1, 3);
+    queue.enqueue_command_graph(graph).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (12, 24, 36, 48));
+}
+
+BOOST_AUTO_TEST_CASE(replay_algorithms)
+{
+    int data[] = { 5, 1, 4, 2, 3 };
+    bc::vector<int> input(data, data + 5, queue);
+    bc::vector<int> keys(5, context);
+    bc::vector<int> sums(5, context);
+
+    queue.begin_recording();
+    bc::copy(input.begin(), input.end(), keys.begin(), queue);
+    bc::sort(keys.begin(), keys.end(), queue);
+    bc::transform(
+        keys.begin(), keys.end(), keys.begin(), keys.begin(),
+        bc::plus<int>(), queue
+    );
+    bc::inclusive_scan(keys.begin(), keys.end(), sums.begin(), queue);
+    bc::command_graph graph = queue.end_recording();
+
+    BOOST_CHECK(!graph.empty());
+    CHECK_RANGE_EQUAL(int, 5, sums, (2, 6, 12, 20, 30));
+
+    // the recorded sequence reads its input from the same buffer
+    int new_data[] = { 10, 50, 30, 20, 40 };
+    bc::copy(new_data, new_data + 5, input.begin(), queue);
+    bc::fill(sums.begin(), sums.end(), 0, queue);
+
+    queue.enqueue_command_graph(graph).wait();
+    CHECK_RANGE_EQUAL(int, 5, sums, (20, 60, 120, 200, 300));
+}
+
+BOOST_AUTO_TEST_CASE(rebind_buffer)
+{
+    int data[] = { 1, 2, 3 };
+    bc::vector<int> a(data, data + 3, queue);
+    bc::vector<int> b(data, data + 3, queue);
+
+    queue.begin_recording();
+    bc::transform(
+        a.begin(), a.end(), a.begin(), a.begin(), bc::multiplies<int>(), queue
+    );
+    bc::command_graph graph = queue.end_recording();
+    CHECK_RANGE_EQUAL(int, 3, a, (1, 4, 9));
+
+    graph.rebind(a.get_buffer(), b.get_buffer());
+    queue.enqueue_command_graph(graph).wait();
+    CHECK_RANGE_EQUAL(int, 3, a, (1, 4, 9));
+    CHECK_RANGE_EQUAL(int, 3, b, (1, 4, 9));
+}
+
+BOOST_AUTO_TEST_CASE(nested_recording_error)
+{
+    queue.begin_recording();
+    BOOST_CHECK_THROW(queue.begin_recording(), std::logic_error);
+    queue.end_recording();
+    BOOST_CHECK_THROW(queue.end_recording(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(unrecorded_commands_error)
+{
+    int data[] = { 1, 2, 3, 4 };
+    bc::vector<int> vector(data, data + 4, queue);
+    int host[4];
+
+    queue.begin_recording();
+    BOOST_CHECK_THROW(
+        queue.enqueue_read_buffer(vector.get_buffer(), 0, sizeof(host), host),
+        std::logic_error
+    );
+    BOOST_CHECK_THROW(
+        queue.enqueue_map_buffer(
+            vector.get_buffer(), CL_MAP_READ, 0, sizeof(host)
+        ),
+        std::logic_error
+    );
+    queue.end_recording();
+}
+
+BOOST_AUTO_TEST_CASE(record_converting_copy)
+{
+    float data[] = { 1.f, 2.f, 3.f, 4.f };
+    bc::vector<int> vector(4, context);
+
+    // the values are converted on the host and written to the buffer
+    queue.begin_recording();
+    bc::copy(data, data + 4, vector.begin(), queue);
+    bc::command_graph graph = queue.end_recording();
+    BOOST_CHECK_EQUAL(graph.size(), size_t(1));
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 3, 4));
+
+    bc::fill(vector.begin(), vector.end(), 0, queue);
+    queue.enqueue_command_graph(graph).wait();
+    CHECK_RANGE_EQUAL(int, 4, vector, (1, 2, 3, 4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -218,4 +218,22 @@ BOOST_AUTO_TEST_CASE(count_if_with_reduce)
     );
 }
 
+BOOST_AUTO_TEST_CASE(count_async)
+{
+    using boost::compute::lambda::_1;
+
+    int data[] = { 1, 2, 1, 2, 3, 1 };
+    bc::vector<int> vector(data, data + 6, queue);
+
+    bc::future<size_t> ones = bc::count_async(vector.begin(), vector.end(), 1, queue);
+    bc::future<size_t> greater =
+        bc::count_if_async(vector.begin(), vector.end(), _1 > 1, queue);
+    bc::future<size_t> empty =
+        bc::count_async(vector.begin(), vector.begin(), 1, queue);
+
+    BOOST_CHECK_EQUAL(ones.get(), size_t(3));
+    BOOST_CHECK_EQUAL(greater.get(), size_t(3));
+    BOOST_CHECK_EQUAL(empty.get(), size_t(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestDistributedVector
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/distributed_vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/lambda.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// returns two queues for the default device
+static std::vector<compute::command_queue>
+make_queues(const compute::context &context, const compute::device &device)
+{
+    std::vector<compute::command_queue> queues;
+    queues.push_back(compute::command_queue(context, device));
+    queues.push_back(compute::command_queue(context, device));
+    return queues;
+}
+
+BOOST_AUTO_TEST_CASE(shards)
+{
+    std::vector<compute::command_queue> queues = make_queues(context, device);
+
+    compute::distributed_vector<int> vector(10, queues);
+    BOOST_CHECK_EQUAL(vector.size(), size_t(10));
+    BOOST_CHECK_EQUAL(vector.shard_count(), size_t(2));
+    BOOST_CHECK_EQUAL(vector.shard_size(0), size_t(5));
+    BOOST_CHECK_EQUAL(vector.shard_offset(1), size_t(5));
+    BOOST_CHECK_EQUAL(vector.shard_size(1), size_t(5));
+
+    std::vector<size_t> sizes;
+    sizes.push_back(3);
+    sizes.push_back(7);
+    compute::distributed_vector<int> uneven(sizes, queues);
+    BOOST_CHECK_EQUAL(uneven.size(), size_t(10));
+    BOOST_CHECK_EQUAL(uneven.shard_size(1), size_t(7));
+    BOOST_CHECK(uneven.end(1) - uneven.begin(1) == 7);
+}
+
+BOOST_AUTO_TEST_CASE(copy_transform_reduce)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    std::vector<compute::command_queue> queues = make_queues(context, device);
+
+    std::vector<int> host(1000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<int>(i);
+    }
+
+    compute::distributed_vector<int> input(host.begin(), host.end(), queues);
+    compute::distributed_vector<int> output(host.size(), queues);
+
+    compute::transform(input, output, _1 * 2);
+
+    std::vector<int> result(host.size());
+    compute::copy(output, result.begin());
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], 2 * host[i]);
+    }
+
+    compute::transform(input, output, output, _1 + _2);
+
+    int sum = 0;
+    compute::reduce(output, &sum);
+    BOOST_CHECK_EQUAL(sum, 3 * 499500);
+
+    int max = 0;
+    compute::reduce(input, &max, compute::max<int>());
+    BOOST_CHECK_EQUAL(max, 999);
+
+    compute::for_each(input, compute::lambda::_1);
+}
+
+BOOST_AUTO_TEST_CASE(reshard)
+{
+    std::vector<compute::command_queue> queues = make_queues(context, device);
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::distributed_vector<int> vector(data, data + 8, queues);
+
+    std::vector<size_t> sizes;
+    sizes.push_back(6);
+    sizes.push_back(2);
+    vector.reshard(sizes);
+    BOOST_CHECK_EQUAL(vector.shard_size(0), size_t(6));
+    CHECK_RANGE_EQUAL(int, 6, vector.shard(0), (1, 2, 3, 4, 5, 6));
+    CHECK_RANGE_EQUAL(int, 2, vector.shard(1), (7, 8));
+
+    // copy to a vector with other shards
+    compute::distributed_vector<int> other(8, queues);
+    compute::copy(vector, other);
+    CHECK_RANGE_EQUAL(int, 4, other.shard(1), (5, 6, 7, 8));
+}
+
+BOOST_AUTO_TEST_CASE(exchange_halos)
+{
+    std::vector<compute::command_queue> queues = make_queues(context, device);
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::distributed_vector<int> vector(data, data + 8, queues);
+
+    vector.set_halo_width(1);
+    BOOST_CHECK_EQUAL(vector.shard(0).size(), size_t(6));
+    BOOST_CHECK_EQUAL(int(vector.shard(1)[1]), 5);
+    BOOST_CHECK_EQUAL(int(vector.shard(1)[4]), 8);
+
+    vector.exchange_halos();
+    compute::vector<int> &left = vector.shard(0);
+    compute::vector<int> &right = vector.shard(1);
+    BOOST_CHECK_EQUAL(int(left[5]), 5);
+    BOOST_CHECK_EQUAL(int(right[0]), 4);
+
+    std::vector<int> result(8);
+    compute::copy(vector, result.begin());
+    BOOST_CHECK(std::equal(result.begin(), result.end(), data));
+}
+
+#ifdef BOOST_COMPUTE_CL_VERSION_1_2
+BOOST_AUTO_TEST_CASE(sub_devices)
+{
+    REQUIRES_OPENCL_VERSION(1, 2);
+
+    if(device.compute_units() < 2){
+        std::cout << "skipping test: "
+                  << "device does not have enough compute units"
+                  << std::endl;
+        return;
+    }
+
+    const std::vector<cl_device_partition_property> properties =
+        device.get_info<std::vector<cl_device_partition_property> >(
+            CL_DEVICE_PARTITION_PROPERTIES
+        );
+    if(std::find(properties.begin(), properties.end(),
+                 CL_DEVICE_PARTITION_EQUALLY) == properties.end()){
+        std::cout << "skipping test: "
+                  << "device does not support CL_DEVICE_PARTITION_EQUALLY"
+                  << std::endl;
+        return;
+    }
+
+    using compute::lambda::_1;
+
+    std::vector<float> host(100000, 1.f);
+
+//! [sub_devices]
+// split the device into two sub-devices with a queue for each
+std::vector<boost::compute::device> sub_devices =
+    device.partition_equally(device.compute_units() / 2);
+boost::compute::context sub_context(sub_devices);
+
+std::vector<boost::compute::command_queue> queues;
+for(size_t i = 0; i < sub_devices.size(); i++){
+    queues.push_back(boost::compute::command_queue(sub_context, sub_devices[i]));
+}
+
+// shard the values across the sub-devices
+boost::compute::distributed_vector<float> values(host.begin(), host.end(), queues);
+
+// scale and sum the values on all sub-devices concurrently
+boost::compute::transform(values, values, _1 * 2.f);
+
+float sum = 0;
+boost::compute::reduce(values, &sum);
+//! [sub_devices]
+
+    BOOST_CHECK_EQUAL(values.shard_count(), sub_devices.size());
+    BOOST_CHECK_CLOSE(sum, 200000.f, 1e-4);
+}
+#endif // BOOST_COMPUTE_CL_VERSION_1_2
+
+BOOST_AUTO_TEST_SUITE_END()
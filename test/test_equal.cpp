@@ -58,4 +58,23 @@ BOOST_AUTO_TEST_CASE(equal_different_range_sizes)
     BOOST_CHECK(boost::compute::equal(b.begin(), b.end(), b.begin(), b.end(), queue) == true);
 }
 
+BOOST_AUTO_TEST_CASE(equal_async)
+{
+    int data1[] = { 1, 2, 3, 4, 5, 6 };
+    int data2[] = { 1, 2, 3, 7, 5, 6 };
+
+    boost::compute::vector<int> vector1(data1, data1 + 6, queue);
+    boost::compute::vector<int> vector2(data2, data2 + 6, queue);
+
+    boost::compute::future<bool> equal = boost::compute::equal_async(
+        vector1.begin(), vector1.begin() + 3, vector2.begin(), queue
+    );
+    boost::compute::future<bool> not_equal = boost::compute::equal_async(
+        vector1.begin(), vector1.end(), vector2.begin(), queue
+    );
+
+    BOOST_CHECK(equal.get() == true);
+    BOOST_CHECK(not_equal.get() == false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -393,4 +393,21 @@ BOOST_AUTO_TEST_CASE(max_bits_set)
     BOOST_CHECK_EQUAL(uint_(*iter), uint_(7));
 }
 
+BOOST_AUTO_TEST_CASE(min_max_element_async)
+{
+    int data[] = { 9, 15, 1, 17, 1, 13, 17 };
+    bc::vector<int> vector(data, data + 7, queue);
+
+    bc::future<bc::vector<int>::iterator> min_iter =
+        bc::min_element_async(vector.begin(), vector.end(), queue);
+    bc::future<bc::vector<int>::iterator> max_iter =
+        bc::max_element_async(vector.begin(), vector.end(), queue);
+    bc::future<bc::vector<int>::iterator> greater_iter =
+        bc::min_element_async(vector.begin(), vector.end(), bc::greater<int>(), queue);
+
+    BOOST_CHECK(min_iter.get() == vector.begin() + 2);
+    BOOST_CHECK(max_iter.get() == vector.begin() + 3);
+    BOOST_CHECK(greater_iter.get() == vector.begin() + 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/svm.hpp>
 #include <boost/compute/type_traits.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -330,4 +331,21 @@ BOOST_AUTO_TEST_CASE(empty_fill)
     bc::fill_async(vec.begin(), vec.end(), 42, queue);
 }
 
+BOOST_AUTO_TEST_CASE(fill_with_vector_stores)
+{
+    boost::shared_ptr<bc::detail::parameter_cache> parameters =
+        bc::detail::parameter_cache::get_global_cache(device);
+    parameters->set("__boost_vectorized_transform_int", "vw", 4);
+
+    bc::vector<int> vec(11, context);
+    bc::detail::fill_with_copy(vec.begin(), 11, 0, queue);
+
+    // the kernel used when clEnqueueFillBuffer() is not available, the
+    // range starts and ends at unaligned indices
+    bc::detail::fill_with_copy(vec.begin() + 1, 9, 7, queue);
+    CHECK_RANGE_EQUAL(int, 11, vec, (0, 7, 7, 7, 7, 7, 7, 7, 7, 7, 0));
+
+    parameters->remove("__boost_vectorized_transform_int", "vw");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
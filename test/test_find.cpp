@@ -14,9 +14,12 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count.hpp>
 #include <boost/compute/algorithm/find.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
 #include <boost/compute/algorithm/find_if_not.hpp>
+#include <boost/compute/algorithm/max_element.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_buffer_iterator.hpp>
 
@@ -104,4 +107,43 @@ BOOST_AUTO_TEST_CASE(find_point_by_distance)
     BOOST_CHECK_EQUAL(value, float2_(4, 4));
 }
 
+BOOST_AUTO_TEST_CASE(find_async)
+{
+    using boost::compute::lambda::_1;
+
+    int data[] = { 9, 15, 1, 17, 13 };
+    bc::vector<int> vector(data, data + 5, queue);
+
+    bc::future<bc::vector<int>::iterator> found =
+        bc::find_async(vector.begin(), vector.end(), 17, queue);
+    bc::future<bc::vector<int>::iterator> not_found =
+        bc::find_async(vector.begin(), vector.end(), 4, queue);
+    bc::future<bc::vector<int>::iterator> less =
+        bc::find_if_async(vector.begin(), vector.end(), _1 < 10, queue);
+    bc::future<bc::vector<int>::iterator> not_less =
+        bc::find_if_not_async(vector.begin(), vector.end(), _1 < 10, queue);
+
+    BOOST_CHECK(found.get() == vector.begin() + 3);
+    BOOST_CHECK(not_found.get() == vector.end());
+    BOOST_CHECK(less.get() == vector.begin());
+    BOOST_CHECK(not_less.get() == vector.begin() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(drop_async_futures)
+{
+    int data[] = { 9, 15, 1, 17, 13 };
+    bc::vector<int> vector(data, data + 5, queue);
+
+    // the futures are destroyed before their reads are complete
+    bc::find_async(vector.begin(), vector.end(), 17, queue);
+    bc::count_async(vector.begin(), vector.end(), 15, queue);
+    bc::max_element_async(vector.begin(), vector.end(), queue);
+    bc::reduce_async(vector.begin(), vector.end(), queue);
+    queue.finish();
+
+    bc::future<bc::vector<int>::iterator> found =
+        bc::find_async(vector.begin(), vector.end(), 1, queue);
+    BOOST_CHECK(found.get() == vector.begin() + 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
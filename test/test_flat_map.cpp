@@ -17,6 +17,7 @@
 
 #include <boost/compute/source.hpp>
 #include <boost/compute/container/flat_map.hpp>
+#include <boost/compute/container/vector.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
 #include <boost/compute/type_traits/type_definition.hpp>
 
@@ -48,6 +49,57 @@ BOOST_AUTO_TEST_CASE(insert)
     BOOST_CHECK_EQUAL(map.size(), size_t(4));
 }
 
+BOOST_AUTO_TEST_CASE(insert_range)
+{
+    boost::compute::flat_map<int, float> map(context);
+    map.insert(std::make_pair(2, 2.2f), queue);
+    map.insert(std::make_pair(5, 5.5f), queue);
+
+    std::pair<int, float> pairs[] = {
+        std::make_pair(4, 4.4f),
+        std::make_pair(1, 1.1f),
+        std::make_pair(2, -2.2f),
+        std::make_pair(4, -4.4f),
+        std::make_pair(3, 3.3f)
+    };
+    boost::compute::vector<std::pair<int, float> > values(pairs, pairs + 5, queue);
+
+    size_t inserted = map.insert(values.begin(), values.end(), queue);
+    BOOST_CHECK_EQUAL(inserted, size_t(3));
+    BOOST_CHECK_EQUAL(map.size(), size_t(5));
+    BOOST_CHECK(map.find(1) == map.begin() + 0);
+    BOOST_CHECK(map.find(2) == map.begin() + 1);
+    BOOST_CHECK(map.find(3) == map.begin() + 2);
+    BOOST_CHECK(map.find(4) == map.begin() + 3);
+    BOOST_CHECK(map.find(5) == map.begin() + 4);
+
+    // existing keys and the first duplicate in the range keep their values
+    BOOST_CHECK_EQUAL(float(map.at(2)), float(2.2f));
+    BOOST_CHECK_EQUAL(float(map.at(4)), float(4.4f));
+}
+
+BOOST_AUTO_TEST_CASE(erase_keys)
+{
+    boost::compute::flat_map<int, float> map(context);
+    for(int i = 0; i < 8; i++){
+        map.insert(std::make_pair(i, float(i)), queue);
+    }
+
+    int keys_data[] = { 6, 1, 42, 3, 1 };
+    boost::compute::vector<int> keys(keys_data, keys_data + 5, queue);
+
+    size_t erased = map.erase_keys(keys.begin(), keys.end(), queue);
+    BOOST_CHECK_EQUAL(erased, size_t(3));
+    BOOST_CHECK_EQUAL(map.size(), size_t(5));
+    BOOST_CHECK(map.find(0) == map.begin() + 0);
+    BOOST_CHECK(map.find(1) == map.end());
+    BOOST_CHECK(map.find(2) == map.begin() + 1);
+    BOOST_CHECK(map.find(4) == map.begin() + 2);
+    BOOST_CHECK(map.find(5) == map.begin() + 3);
+    BOOST_CHECK(map.find(7) == map.begin() + 4);
+    BOOST_CHECK_EQUAL(float(map.at(7)), float(7.f));
+}
+
 BOOST_AUTO_TEST_CASE(at)
 {
     boost::compute::flat_map<int, float> map(context);
@@ -18,7 +18,9 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/container/flat_set.hpp>
+#include <boost/compute/container/vector.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 namespace bc = boost::compute;
@@ -110,6 +112,46 @@ BOOST_AUTO_TEST_CASE(erase)
     BOOST_CHECK_EQUAL(set.size(), size_t(0));
 }
 
+BOOST_AUTO_TEST_CASE(insert_range)
+{
+    bc::flat_set<int> set(context);
+    set.insert(5, queue);
+    set.insert(1, queue);
+
+    int data[] = { 7, 3, 5, 3, 0, 9 };
+    bc::vector<int> values(data, data + 6, queue);
+
+    size_t inserted = set.insert(values.begin(), values.end(), queue);
+    queue.finish();
+    BOOST_CHECK_EQUAL(inserted, size_t(4));
+    BOOST_CHECK_EQUAL(set.size(), size_t(6));
+    CHECK_RANGE_EQUAL(int, 6, set, (0, 1, 3, 5, 7, 9));
+
+    inserted = set.insert(values.begin(), values.end(), queue);
+    queue.finish();
+    BOOST_CHECK_EQUAL(inserted, size_t(0));
+    BOOST_CHECK_EQUAL(set.size(), size_t(6));
+}
+
+BOOST_AUTO_TEST_CASE(erase_keys)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    bc::vector<int> values(data, data + 8, queue);
+
+    bc::flat_set<int> set(context);
+    set.insert(values.begin(), values.end(), queue);
+    BOOST_CHECK_EQUAL(set.size(), size_t(8));
+
+    int keys_data[] = { 8, 2, 11, 5 };
+    bc::vector<int> keys(keys_data, keys_data + 4, queue);
+
+    size_t erased = set.erase_keys(keys.begin(), keys.end(), queue);
+    queue.finish();
+    BOOST_CHECK_EQUAL(erased, size_t(3));
+    BOOST_CHECK_EQUAL(set.size(), size_t(5));
+    CHECK_RANGE_EQUAL(int, 5, set, (1, 3, 4, 6, 7));
+}
+
 BOOST_AUTO_TEST_CASE(clear)
 {
     bc::flat_set<float> set;
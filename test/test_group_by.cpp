@@ -0,0 +1,293 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestGroupBy
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/group_by.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(group_by_int)
+{
+    int keys_data[] = { 3, 1, 3, 2, 1, 3, 2, 1 };
+    int values_data[] = { 5, 1, 7, 4, 2, 6, -2, 9 };
+    bc::vector<int> keys(keys_data, keys_data + 8, queue);
+    bc::vector<int> values(values_data, values_data + 8, queue);
+
+    bc::vector<int> unique_keys(8, context);
+    bc::vector<int> sums(3, context);
+    bc::vector<int> mins(3, context);
+    bc::vector<int> maxs(3, context);
+    bc::vector<int> counts(3, context);
+    bc::vector<int> means(3, context);
+
+    std::vector<bc::group_by_aggregate<int> > aggregates;
+    aggregates.push_back(bc::aggregate_sum(values.begin(), sums.begin()));
+    aggregates.push_back(bc::aggregate_min(values.begin(), mins.begin()));
+    aggregates.push_back(bc::aggregate_max(values.begin(), maxs.begin()));
+    aggregates.push_back(bc::aggregate_count(counts.begin()));
+    aggregates.push_back(bc::aggregate_mean(values.begin(), means.begin()));
+
+    size_t groups = bc::group_by(
+        keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(3));
+    CHECK_RANGE_EQUAL(int, 3, unique_keys, (1, 2, 3));
+    CHECK_RANGE_EQUAL(int, 3, sums, (12, 2, 18));
+    CHECK_RANGE_EQUAL(int, 3, mins, (1, -2, 5));
+    CHECK_RANGE_EQUAL(int, 3, maxs, (9, 4, 7));
+    CHECK_RANGE_EQUAL(int, 3, counts, (3, 2, 3));
+    CHECK_RANGE_EQUAL(int, 3, means, (4, 1, 6));
+}
+
+BOOST_AUTO_TEST_CASE(group_by_float_with_sort_and_hash)
+{
+    const size_t n = 4096;
+    std::vector<int> host_keys(n);
+    std::vector<float> host_values(n);
+    for(size_t i = 0; i < n; i++){
+        host_keys[i] = static_cast<int>((i * 7) % 10);
+        host_values[i] = static_cast<float>(i % 5);
+    }
+    bc::vector<int> keys(host_keys.begin(), host_keys.end(), queue);
+    bc::vector<float> values(host_values.begin(), host_values.end(), queue);
+
+    bc::vector<int> sort_keys(10, context);
+    bc::vector<float> sort_sums(10, context);
+    bc::vector<float> sort_maxs(10, context);
+    std::vector<bc::group_by_aggregate<float> > sort_aggregates;
+    sort_aggregates.push_back(bc::aggregate_sum(values.begin(), sort_sums.begin()));
+    sort_aggregates.push_back(bc::aggregate_max(values.begin(), sort_maxs.begin()));
+    BOOST_CHECK_EQUAL(
+        bc::detail::group_by_with_sort(
+            keys.begin(), keys.end(), sort_aggregates, sort_keys.begin(), queue
+        ),
+        size_t(10)
+    );
+
+    bc::vector<int> hash_keys(10, context);
+    bc::vector<float> hash_sums(10, context);
+    bc::vector<float> hash_maxs(10, context);
+    std::vector<bc::group_by_aggregate<float> > hash_aggregates;
+    hash_aggregates.push_back(bc::aggregate_sum(values.begin(), hash_sums.begin()));
+    hash_aggregates.push_back(bc::aggregate_max(values.begin(), hash_maxs.begin()));
+    bc::vector<int> distinct_keys(context);
+    const size_t groups = bc::detail::group_by_distinct_keys(
+        keys.begin(), keys.end(), 16, distinct_keys, queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(10));
+    BOOST_CHECK_EQUAL(
+        bc::detail::group_by_with_hash(
+            distinct_keys, groups, keys.begin(), keys.end(),
+            hash_aggregates, hash_keys.begin(), queue
+        ),
+        size_t(10)
+    );
+
+    // compute the expected results on the host
+    std::vector<float> expected_sums(10, 0.f);
+    std::vector<float> expected_maxs(10, 0.f);
+    for(size_t i = 0; i < n; i++){
+        expected_sums[host_keys[i]] += host_values[i];
+        expected_maxs[host_keys[i]] =
+            (std::max)(expected_maxs[host_keys[i]], host_values[i]);
+    }
+
+    CHECK_RANGE_EQUAL(int, 10, sort_keys, (0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+    CHECK_RANGE_EQUAL(int, 10, hash_keys, (0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+
+    std::vector<float> result(10);
+    bc::copy(sort_sums.begin(), sort_sums.end(), result.begin(), queue);
+    for(size_t i = 0; i < 10; i++){
+        BOOST_CHECK_CLOSE(result[i], expected_sums[i], 1e-4f);
+    }
+    bc::copy(hash_sums.begin(), hash_sums.end(), result.begin(), queue);
+    for(size_t i = 0; i < 10; i++){
+        BOOST_CHECK_CLOSE(result[i], expected_sums[i], 1e-4f);
+    }
+    bc::copy(sort_maxs.begin(), sort_maxs.end(), result.begin(), queue);
+    for(size_t i = 0; i < 10; i++){
+        BOOST_CHECK_EQUAL(result[i], expected_maxs[i]);
+    }
+    bc::copy(hash_maxs.begin(), hash_maxs.end(), result.begin(), queue);
+    for(size_t i = 0; i < 10; i++){
+        BOOST_CHECK_EQUAL(result[i], expected_maxs[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(group_by_too_many_groups_for_hash)
+{
+    const size_t n = 20000;
+    std::vector<int> host_keys(n);
+    for(size_t i = 0; i < n; i++){
+        host_keys[i] = static_cast<int>((n - 1 - i) % 10000);
+    }
+    bc::vector<int> keys(host_keys.begin(), host_keys.end(), queue);
+    bc::vector<int> values(n, context);
+    bc::fill(values.begin(), values.end(), 3, queue);
+
+    // counting the distinct keys stops once the table overflows
+    bc::vector<int> distinct_keys(context);
+    BOOST_CHECK_EQUAL(
+        bc::detail::group_by_distinct_keys(
+            keys.begin(), keys.end(), 4096, distinct_keys, queue
+        ),
+        size_t(4097)
+    );
+
+    bc::vector<int> unique_keys(10000, context);
+    bc::vector<int> sums(10000, context);
+    std::vector<bc::group_by_aggregate<int> > aggregates;
+    aggregates.push_back(bc::aggregate_sum(values.begin(), sums.begin()));
+
+    size_t groups = bc::group_by(
+        keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(10000));
+
+    std::vector<int> host_unique_keys(10000);
+    std::vector<int> host_sums(10000);
+    bc::copy(unique_keys.begin(), unique_keys.end(), host_unique_keys.begin(), queue);
+    bc::copy(sums.begin(), sums.end(), host_sums.begin(), queue);
+    for(size_t i = 0; i < 10000; i++){
+        BOOST_CHECK_EQUAL(host_unique_keys[i], static_cast<int>(i));
+        BOOST_CHECK_EQUAL(host_sums[i], 6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(group_by_few_groups_in_local_memory)
+{
+    const size_t n = 100000;
+    std::vector<bc::uint_> host_keys(n);
+    std::vector<float> host_values(n);
+    for(size_t i = 0; i < n; i++){
+        host_keys[i] = static_cast<bc::uint_>((i * 13) % 7);
+        host_values[i] = static_cast<float>(i % 11) - 5.f;
+    }
+    bc::vector<bc::uint_> keys(host_keys.begin(), host_keys.end(), queue);
+    bc::vector<float> values(host_values.begin(), host_values.end(), queue);
+
+    bc::vector<bc::uint_> unique_keys(7, context);
+    bc::vector<float> mins(7, context);
+    bc::vector<float> maxs(7, context);
+    bc::vector<float> counts(7, context);
+    std::vector<bc::group_by_aggregate<float> > aggregates;
+    aggregates.push_back(bc::aggregate_min(values.begin(), mins.begin()));
+    aggregates.push_back(bc::aggregate_max(values.begin(), maxs.begin()));
+    aggregates.push_back(bc::aggregate_count(counts.begin()));
+
+    size_t groups = bc::group_by(
+        keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(7));
+    CHECK_RANGE_EQUAL(bc::uint_, 7, unique_keys, (0, 1, 2, 3, 4, 5, 6));
+
+    // compute the expected results on the host
+    std::vector<float> expected_mins(7, 5.f);
+    std::vector<float> expected_maxs(7, -5.f);
+    std::vector<float> expected_counts(7, 0.f);
+    for(size_t i = 0; i < n; i++){
+        const bc::uint_ key = host_keys[i];
+        expected_mins[key] = (std::min)(expected_mins[key], host_values[i]);
+        expected_maxs[key] = (std::max)(expected_maxs[key], host_values[i]);
+        expected_counts[key] += 1.f;
+    }
+
+    std::vector<float> result(7);
+    bc::copy(mins.begin(), mins.end(), result.begin(), queue);
+    for(size_t i = 0; i < 7; i++){
+        BOOST_CHECK_EQUAL(result[i], expected_mins[i]);
+    }
+    bc::copy(maxs.begin(), maxs.end(), result.begin(), queue);
+    for(size_t i = 0; i < 7; i++){
+        BOOST_CHECK_EQUAL(result[i], expected_maxs[i]);
+    }
+    bc::copy(counts.begin(), counts.end(), result.begin(), queue);
+    for(size_t i = 0; i < 7; i++){
+        BOOST_CHECK_EQUAL(result[i], expected_counts[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(group_by_count_and_mean_with_sort)
+{
+    int keys_data[] = { 3, 1, 3, 2, 1, 3, 2, 1 };
+    int values_data[] = { 5, 1, 7, 4, 2, 6, -2, 9 };
+    bc::vector<int> keys(keys_data, keys_data + 8, queue);
+    bc::vector<int> values(values_data, values_data + 8, queue);
+
+    bc::vector<int> unique_keys(3, context);
+    bc::vector<int> counts(3, context);
+    bc::vector<int> means(3, context);
+
+    std::vector<bc::group_by_aggregate<int> > aggregates;
+    aggregates.push_back(bc::aggregate_count(counts.begin()));
+    aggregates.push_back(bc::aggregate_mean(values.begin(), means.begin()));
+
+    size_t groups = bc::detail::group_by_with_sort(
+        keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(3));
+    CHECK_RANGE_EQUAL(int, 3, unique_keys, (1, 2, 3));
+    CHECK_RANGE_EQUAL(int, 3, counts, (3, 2, 3));
+    CHECK_RANGE_EQUAL(int, 3, means, (4, 1, 6));
+}
+
+BOOST_AUTO_TEST_CASE(group_by_reserved_keys)
+{
+    // the two largest keys are reserved by the hash table
+    const int max_key = (std::numeric_limits<int>::max)();
+    int keys_data[] = { max_key, 1, max_key - 1, max_key, 1 };
+    int values_data[] = { 1, 2, 3, 4, 5 };
+    bc::vector<int> keys(keys_data, keys_data + 5, queue);
+    bc::vector<int> values(values_data, values_data + 5, queue);
+
+    bc::vector<int> unique_keys(3, context);
+    bc::vector<int> sums(3, context);
+    bc::vector<int> counts(3, context);
+
+    std::vector<bc::group_by_aggregate<int> > aggregates;
+    aggregates.push_back(bc::aggregate_sum(values.begin(), sums.begin()));
+    aggregates.push_back(bc::aggregate_count(counts.begin()));
+
+    size_t groups = bc::group_by(
+        keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(3));
+    CHECK_RANGE_EQUAL(int, 3, unique_keys, (1, max_key - 1, max_key));
+    CHECK_RANGE_EQUAL(int, 3, sums, (7, 3, 5));
+    CHECK_RANGE_EQUAL(int, 3, counts, (2, 1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(group_by_keys_only)
+{
+    bc::uint_ keys_data[] = { 9, 4, 9, 9, 0, 4 };
+    bc::vector<bc::uint_> keys(keys_data, keys_data + 6, queue);
+    bc::vector<bc::uint_> unique_keys(6, context);
+
+    std::vector<bc::group_by_aggregate<bc::uint_> > aggregates;
+    size_t groups = bc::group_by(
+        keys.begin(), keys.end(), aggregates, unique_keys.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(groups, size_t(3));
+    CHECK_RANGE_EQUAL(bc::uint_, 3, unique_keys, (0, 4, 9));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHistogram
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(histogram_float)
+{
+    float data[] = { 0.05f, 0.15f, 0.12f, 0.99f, -0.5f, 0.5f, 1.0f, 0.55f, 0.11f };
+    bc::vector<float> values(data, data + 9, queue);
+    bc::vector<bc::uint_> bins(5, context);
+
+    bc::histogram(values.begin(), values.end(), bins.begin(), 5, 0.0f, 1.0f, queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 5, bins, (4, 0, 2, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_int_many_values)
+{
+    const size_t n = 100000;
+    bc::vector<int> values(n, context);
+    bc::iota(values.begin(), values.end(), 0, queue);
+
+    bc::vector<bc::uint_> bins(10, context);
+    bc::histogram(values.begin(), values.end(), bins.begin(), 10, 0, 100000, queue);
+
+    std::vector<bc::uint_> host_bins(10);
+    bc::copy(bins.begin(), bins.end(), host_bins.begin(), queue);
+    for(size_t i = 0; i < 10; i++){
+        BOOST_CHECK_EQUAL(host_bins[i], bc::uint_(10000));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(histogram_bin_function)
+{
+    BOOST_COMPUTE_FUNCTION(bc::uint_, low_bits, (bc::uint_ x),
+    {
+        return x & 0x3;
+    });
+
+    bc::uint_ data[] = { 1, 2, 3, 4, 5, 6, 7, 9, 13, 17 };
+    bc::vector<bc::uint_> values(data, data + 10, queue);
+    bc::vector<bc::uint_> bins(4, context);
+
+    bc::histogram(values.begin(), values.end(), bins.begin(), 4, low_bits, queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 4, bins, (1, 5, 2, 2));
+
+    // bins outside of the range are not counted
+    bc::histogram(values.begin(), values.end(), bins.begin(), 2, low_bits, queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 2, bins, (1, 5));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_with_sort)
+{
+    BOOST_COMPUTE_FUNCTION(int, identity_bin, (int x),
+    {
+        return x;
+    });
+
+    int data[] = { 3, -1, 0, 3, 7, 3, 0, 5 };
+    bc::vector<int> values(data, data + 8, queue);
+    bc::vector<bc::uint_> bins(6, context);
+
+    bc::detail::histogram_with_sort(
+        bc::detail::histogram_function_bin_index<
+            bc::vector<int>::iterator, BOOST_TYPEOF(identity_bin)
+        >(values.begin(), identity_bin),
+        values.size(),
+        bins.begin(),
+        6,
+        queue
+    );
+    CHECK_RANGE_EQUAL(bc::uint_, 6, bins, (2, 0, 0, 3, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_by_key)
+{
+    BOOST_COMPUTE_FUNCTION(int, tens, (int x),
+    {
+        return x / 10;
+    });
+
+    int keys_data[] = { 0, 1, 0, 2, 1, 0, 3, 2 };
+    int values_data[] = { 5, 15, 25, 11, 12, 8, 1, 29 };
+    bc::vector<int> keys(keys_data, keys_data + 8, queue);
+    bc::vector<int> values(values_data, values_data + 8, queue);
+    bc::vector<bc::uint_> bins(9, context);
+
+    bc::histogram_by_key(
+        keys.begin(), keys.end(), values.begin(), bins.begin(), 3, 3, tens, queue
+    );
+    CHECK_RANGE_EQUAL(bc::uint_, 9, bins, (2, 0, 1, 0, 2, 0, 0, 1, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHostDispatch
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/command_graph.hpp>
+#include <boost/compute/algorithm/count.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/max_element.hpp>
+#include <boost/compute/algorithm/min_element.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/host_dispatch.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+typedef bc::host_dispatch dispatch;
+
+BOOST_AUTO_TEST_CASE(threshold)
+{
+    // host dispatch is opt-in
+    BOOST_CHECK_EQUAL(dispatch::threshold("reduce", device), size_t(0));
+    BOOST_CHECK_EQUAL(dispatch::threshold("scan", device), size_t(0));
+
+    dispatch::set_threshold("reduce", device, 100);
+    BOOST_CHECK_EQUAL(dispatch::threshold("reduce", device), size_t(100));
+    BOOST_CHECK_EQUAL(dispatch::threshold("scan", device), size_t(0));
+
+    dispatch::set_threshold("reduce", device, 0);
+}
+
+BOOST_AUTO_TEST_CASE(scoped_mode)
+{
+    BOOST_CHECK(dispatch::mode() == dispatch::automatic);
+    {
+        dispatch::scoped_mode mode(dispatch::force_host);
+        BOOST_CHECK(dispatch::mode() == dispatch::force_host);
+        {
+            dispatch::scoped_mode inner_mode(dispatch::force_device);
+            BOOST_CHECK(dispatch::mode() == dispatch::force_device);
+        }
+        BOOST_CHECK(dispatch::mode() == dispatch::force_host);
+    }
+    BOOST_CHECK(dispatch::mode() == dispatch::automatic);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_on_host_and_device)
+{
+    int data[] = { 4, -2, 9, 1, 7, -5, 3, 8 };
+    bc::vector<int> vector(data, data + 8, queue);
+
+    const dispatch::mode_type modes[] = {
+        dispatch::automatic, dispatch::force_host, dispatch::force_device
+    };
+
+    // the automatic mode runs the inputs below the threshold on the host
+    dispatch::set_threshold("reduce", device, 16);
+
+    for(size_t i = 0; i < 3; i++){
+        dispatch::scoped_mode mode(modes[i]);
+
+        int sum = 0;
+        bc::reduce(vector.begin(), vector.end(), &sum, queue);
+        BOOST_CHECK_EQUAL(sum, 25);
+
+        int product = 0;
+        bc::reduce(vector.begin(), vector.begin() + 4, &product,
+                   bc::multiplies<int>(), queue);
+        BOOST_CHECK_EQUAL(product, -72);
+
+        int minimum = 0;
+        bc::reduce(vector.begin(), vector.end(), &minimum,
+                   bc::min<int>(), queue);
+        BOOST_CHECK_EQUAL(minimum, -5);
+
+        // reduce to a device iterator
+        bc::vector<int> result(1, context);
+        bc::reduce(vector.begin() + 2, vector.end(), result.begin(),
+                   bc::max<int>(), queue);
+        CHECK_RANGE_EQUAL(int, 1, result, (9));
+    }
+
+    dispatch::set_threshold("reduce", device, 0);
+}
+
+BOOST_AUTO_TEST_CASE(force_host_with_device_function)
+{
+    using bc::lambda::_1;
+    using bc::lambda::_2;
+
+    int data[] = { 1, 2, 3, 4, 5 };
+    bc::vector<int> vector(data, data + 5, queue);
+
+    dispatch::scoped_mode mode(dispatch::force_host);
+
+    // the lambda cannot be evaluated on the host so the reduction is
+    // performed by a single work-item on the device
+    int result = 0;
+    bc::reduce(vector.begin(), vector.end(), &result, _1 + _2 * 2, queue);
+    BOOST_CHECK_EQUAL(result, 29);
+}
+
+BOOST_AUTO_TEST_CASE(scan_on_host)
+{
+    int data[] = { 1, 2, 3, 4, 5, 6 };
+    bc::vector<int> input(data, data + 6, queue);
+    bc::vector<int> output(6, context);
+
+    dispatch::scoped_mode mode(dispatch::force_host);
+
+    bc::inclusive_scan(input.begin(), input.end(), output.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 6, output, (1, 3, 6, 10, 15, 21));
+
+    bc::exclusive_scan(input.begin(), input.end(), output.begin(), 10, queue);
+    CHECK_RANGE_EQUAL(int, 6, output, (10, 11, 13, 16, 20, 25));
+
+    // in-place
+    bc::exclusive_scan(input.begin() + 1, input.end(), input.begin() + 1,
+                       1, bc::multiplies<int>(), queue);
+    CHECK_RANGE_EQUAL(int, 6, input, (1, 1, 2, 6, 24, 120));
+}
+
+BOOST_AUTO_TEST_CASE(count_on_host)
+{
+    int data[] = { 1, 2, 1, 3, 1, 4, 2 };
+    bc::vector<int> vector(data, data + 7, queue);
+
+    dispatch::scoped_mode mode(dispatch::force_host);
+
+    BOOST_CHECK_EQUAL(bc::count(vector.begin(), vector.end(), 1, queue), size_t(3));
+    BOOST_CHECK_EQUAL(bc::count(vector.begin(), vector.end(), 2, queue), size_t(2));
+    BOOST_CHECK_EQUAL(bc::count(vector.begin() + 3, vector.end(), 1, queue), size_t(1));
+    BOOST_CHECK_EQUAL(bc::count(vector.begin(), vector.end(), 5, queue), size_t(0));
+
+    // empty ranges are not mapped
+    BOOST_CHECK_EQUAL(bc::count(vector.begin(), vector.begin(), 1, queue), size_t(0));
+    BOOST_CHECK_EQUAL(bc::count(vector.end(), vector.end(), 2, queue), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(extrema_on_host)
+{
+    float data[] = { 3.f, -1.f, 7.f, -1.f, 7.f, 2.f };
+    bc::vector<float> vector(data, data + 6, queue);
+
+    dispatch::scoped_mode mode(dispatch::force_host);
+
+    // the first extremum is returned
+    BOOST_CHECK(bc::min_element(vector.begin(), vector.end(), queue) ==
+                vector.begin() + 1);
+    BOOST_CHECK(bc::max_element(vector.begin(), vector.end(), queue) ==
+                vector.begin() + 2);
+    BOOST_CHECK(bc::min_element(vector.begin() + 2, vector.end(), queue) ==
+                vector.begin() + 3);
+    BOOST_CHECK(bc::min_element(vector.begin(), vector.end(),
+                                bc::greater<float>(), queue) ==
+                vector.begin() + 2);
+}
+
+BOOST_AUTO_TEST_CASE(recording_runs_on_device)
+{
+    int data[] = { 1, 2, 3, 4 };
+    bc::vector<int> input(data, data + 4, queue);
+    bc::vector<int> output(4, context);
+
+    dispatch::scoped_mode mode(dispatch::force_host);
+
+    // commands enqueued while recording are not run on the host so that
+    // replaying the graph recomputes the result
+    queue.begin_recording();
+    bc::inclusive_scan(input.begin(), input.end(), output.begin(), queue);
+    bc::command_graph graph = queue.end_recording();
+    BOOST_CHECK(graph.kernel_count() > 0);
+    CHECK_RANGE_EQUAL(int, 4, output, (1, 3, 6, 10));
+
+    int new_data[] = { 4, 3, 2, 1 };
+    bc::copy(new_data, new_data + 4, input.begin(), queue);
+    queue.enqueue_command_graph(graph);
+    CHECK_RANGE_EQUAL(int, 4, output, (4, 7, 9, 10));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
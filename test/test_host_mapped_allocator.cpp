@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHostMappedAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/allocator/host_mapped_allocator.hpp>
+#include <boost/compute/container/mapped_span.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(vector_with_host_mapped_allocator)
+{
+    compute::vector<int, compute::host_mapped_allocator<int> > vector(context);
+    vector.push_back(12, queue);
+    vector.push_back(24, queue);
+    vector.push_back(36, queue);
+    CHECK_RANGE_EQUAL(int, 3, vector, (12, 24, 36));
+
+    compute::transform(
+        vector.begin(), vector.end(), vector.begin(), compute::lambda::_1 + 1, queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, vector, (13, 25, 37));
+}
+
+BOOST_AUTO_TEST_CASE(read_in_place)
+{
+    using compute::lambda::_1;
+
+//! [read_in_place]
+// create a vector whose buffer is stored in host memory
+boost::compute::vector<float, boost::compute::host_mapped_allocator<float> > vec(1024, context);
+
+// compute the values on the device
+boost::compute::iota(vec.begin(), vec.end(), 0.f, queue);
+boost::compute::transform(vec.begin(), vec.end(), vec.begin(), _1 * 2.f, queue);
+
+// read the values on the host without copying them (for CPU devices)
+boost::compute::mapped_span<float> values(vec.begin(), vec.end(), CL_MAP_READ, queue);
+float sum = 0;
+for(size_t i = 0; i < values.size(); i++){
+    sum += values[i];
+}
+//! [read_in_place]
+
+    BOOST_CHECK_EQUAL(values.size(), size_t(1024));
+    BOOST_CHECK_EQUAL(values[0], 0.f);
+    BOOST_CHECK_EQUAL(values[1023], 2046.f);
+    BOOST_CHECK_EQUAL(sum, 1047552.f);
+}
+
+BOOST_AUTO_TEST_CASE(copy_buffer_host_memory)
+{
+    compute::host_mapped_allocator<int> allocator(context);
+    if(!allocator.is_zero_copy()){
+        std::cout << "skipping: device does not share memory with the host" << std::endl;
+        return;
+    }
+
+    compute::vector<int, compute::host_mapped_allocator<int> > vector(8, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    // copying to the host memory of the buffer only synchronizes it
+    int *host_ptr = static_cast<int *>(vector.get_buffer().get_host_ptr());
+    BOOST_REQUIRE(host_ptr != 0);
+    int *end = compute::copy(vector.begin() + 2, vector.end(), host_ptr + 2, queue);
+    BOOST_CHECK(end == host_ptr + 8);
+    BOOST_CHECK_EQUAL(host_ptr[2], 2);
+    BOOST_CHECK_EQUAL(host_ptr[7], 7);
+
+    // and so does copying from it
+    compute::copy(host_ptr, host_ptr + 8, vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
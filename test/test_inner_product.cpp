@@ -50,4 +50,18 @@ BOOST_AUTO_TEST_CASE(inner_product_counting_iterator)
     );
 }
 
+BOOST_AUTO_TEST_CASE(inner_product_async)
+{
+    int data1[] = { 1, 2, 3, 4 };
+    int data2[] = { 2, 3, 4, 5 };
+    bc::vector<int> vector1(data1, data1 + 4, queue);
+    bc::vector<int> vector2(data2, data2 + 4, queue);
+
+    bc::future<int> product = bc::inner_product_async(
+        vector1.begin(), vector1.end(), vector2.begin(), 0, queue
+    );
+
+    BOOST_CHECK_EQUAL(product.get(), 40);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
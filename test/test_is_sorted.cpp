@@ -68,4 +68,21 @@ BOOST_AUTO_TEST_CASE(is_sorted_iota)
     BOOST_CHECK(compute::is_sorted(vec.begin(), vec.end(), compute::greater<int>(), queue) == false);
 }
 
+BOOST_AUTO_TEST_CASE(is_sorted_async)
+{
+    int data[] = { 1, 2, 2, 5, 4 };
+    compute::vector<int> vec(data, data + 5, queue);
+
+    compute::future<bool> sorted =
+        compute::is_sorted_async(vec.begin(), vec.begin() + 4, queue);
+    compute::future<bool> not_sorted =
+        compute::is_sorted_async(vec.begin(), vec.end(), queue);
+    compute::future<bool> one =
+        compute::is_sorted_async(vec.begin(), vec.begin() + 1, queue);
+
+    BOOST_CHECK(sorted.get() == true);
+    BOOST_CHECK(not_sorted.get() == false);
+    BOOST_CHECK(one.get() == true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
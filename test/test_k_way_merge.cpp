@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestKWayMerge
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/k_way_merge.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/types/pair.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(k_way_merge_int)
+{
+    int data[] = { 1, 4, 9, 2, 3, 8, 5, 6, 7 };
+    bc::uint_ offsets_data[] = { 0, 3, 6, 9 };
+    bc::vector<int> values(data, data + 9, queue);
+    bc::vector<bc::uint_> offsets(offsets_data, offsets_data + 4, queue);
+    bc::vector<int> result(9, context);
+
+    bc::vector<int>::iterator end = bc::k_way_merge(
+        offsets.begin(), offsets.end(), values.begin(), result.begin(), queue
+    );
+    BOOST_CHECK(end == result.end());
+    CHECK_RANGE_EQUAL(int, 9, result, (1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+BOOST_AUTO_TEST_CASE(k_way_merge_many_runs)
+{
+    // runs of varying lengths, including empty ones
+    const size_t runs = 100;
+    std::vector<bc::uint_> host_offsets(1, 0);
+    std::vector<float> host_values;
+    for(size_t i = 0; i < runs; i++){
+        const size_t length = (i % 7 == 3) ? 0 : static_cast<size_t>(std::rand() % 300);
+        std::vector<float> run(length);
+        for(size_t j = 0; j < length; j++){
+            run[j] = static_cast<float>(std::rand() % 1000);
+        }
+        std::sort(run.begin(), run.end(), std::greater<float>());
+        host_values.insert(host_values.end(), run.begin(), run.end());
+        host_offsets.push_back(static_cast<bc::uint_>(host_values.size()));
+    }
+
+    bc::vector<float> values(host_values.begin(), host_values.end(), queue);
+    bc::vector<bc::uint_> offsets(host_offsets.begin(), host_offsets.end(), queue);
+    bc::vector<float> result(values.size(), context);
+
+    bc::k_way_merge(
+        offsets.begin(), offsets.end(), values.begin(), result.begin(),
+        bc::greater<float>(), queue
+    );
+
+    std::sort(host_values.begin(), host_values.end(), std::greater<float>());
+    std::vector<float> host_result(result.size());
+    bc::copy(result.begin(), result.end(), host_result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_result.begin(), host_result.end(),
+        host_values.begin(), host_values.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(k_way_merge_stable)
+{
+    using bc::lambda::_1;
+    using bc::lambda::_2;
+    using bc::lambda::get;
+
+    // each value holds its key and the index of its run
+    const size_t runs = 16;
+    std::vector<std::pair<int, int> > host_values;
+    std::vector<bc::uint_> host_offsets(1, 0);
+    for(size_t i = 0; i < runs; i++){
+        for(int key = 0; key < 500; key += 1 + static_cast<int>(i % 3)){
+            host_values.push_back(std::make_pair(key / 4, static_cast<int>(i)));
+        }
+        host_offsets.push_back(static_cast<bc::uint_>(host_values.size()));
+    }
+
+    bc::vector<std::pair<int, int> > values(
+        host_values.begin(), host_values.end(), queue
+    );
+    bc::vector<bc::uint_> offsets(host_offsets.begin(), host_offsets.end(), queue);
+    bc::vector<std::pair<int, int> > result(values.size(), context);
+
+    bc::k_way_merge(
+        offsets.begin(), offsets.end(), values.begin(), result.begin(),
+        get<0>(_1) < get<0>(_2), queue
+    );
+
+    std::vector<std::pair<int, int> > host_result(result.size());
+    bc::copy(result.begin(), result.end(), host_result.begin(), queue);
+
+    std::stable_sort(host_values.begin(), host_values.end());
+    BOOST_CHECK(host_result == host_values);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMappedFile
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/utility/mapped_file.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+static void write_floats(const std::string &path, const std::vector<float> &values)
+{
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+    if(!values.empty()){
+        file.write(reinterpret_cast<const char *>(&values[0]),
+                   values.size() * sizeof(float));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mapped_file_range)
+{
+    float data[] = { 1.5f, 2.5f, 3.5f, 4.5f };
+    write_floats("test_mapped_file_range.bin", std::vector<float>(data, data + 4));
+
+    {
+        compute::mapped_file<float> file("test_mapped_file_range.bin");
+        BOOST_CHECK_EQUAL(file.size(), size_t(4));
+        BOOST_CHECK_EQUAL(file[2], 3.5f);
+
+        compute::vector<float> vector(4, context);
+        compute::copy(file.begin(), file.end(), vector.begin(), queue);
+        CHECK_RANGE_EQUAL(float, 4, vector, (1.5f, 2.5f, 3.5f, 4.5f));
+    }
+
+    std::remove("test_mapped_file_range.bin");
+}
+
+BOOST_AUTO_TEST_CASE(read_column)
+{
+    std::vector<float> values(100000);
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = static_cast<float>(i);
+    }
+    write_floats("column.bin", values);
+
+//! [read_column]
+// load the floats stored in "column.bin" to the device
+boost::compute::vector<float> column(context);
+boost::compute::read_file_to_buffer("column.bin", column, queue);
+//! [read_column]
+
+    BOOST_CHECK_EQUAL(column.size(), values.size());
+
+    std::vector<float> host(column.size());
+    compute::copy(column.begin(), column.end(), host.begin(), queue);
+    BOOST_CHECK(host == values);
+
+    std::remove("column.bin");
+}
+
+BOOST_AUTO_TEST_CASE(read_file_in_chunks)
+{
+    std::vector<float> values(10000);
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = static_cast<float>(i);
+    }
+    write_floats("test_read_file_in_chunks.bin", values);
+
+    // force several chunks of 4096 bytes
+    boost::shared_ptr<compute::detail::parameter_cache> parameters =
+        compute::detail::parameter_cache::get_global_cache(device);
+    parameters->set("__boost_mapped_file", "chunk_size", 4096);
+
+    compute::vector<float> vector(values.size() + 2, context);
+    compute::buffer_iterator<float> end = compute::read_file_to_buffer(
+        "test_read_file_in_chunks.bin", vector.begin() + 2, queue
+    );
+    BOOST_CHECK(end == vector.end());
+
+    std::vector<float> host(values.size());
+    compute::copy(vector.begin() + 2, vector.end(), host.begin(), queue);
+    BOOST_CHECK(host == values);
+
+    // and back to a file
+    compute::write_buffer_to_file(
+        vector.begin() + 2, vector.end(), "test_write_file_in_chunks.bin", queue
+    );
+    {
+        compute::mapped_file<float> file("test_write_file_in_chunks.bin");
+        BOOST_CHECK_EQUAL(file.size(), values.size());
+        BOOST_CHECK(std::equal(file.begin(), file.end(), values.begin()));
+    }
+
+    parameters->set("__boost_mapped_file", "chunk_size", 1 << 22);
+
+    std::remove("test_read_file_in_chunks.bin");
+    std::remove("test_write_file_in_chunks.bin");
+}
+
+BOOST_AUTO_TEST_CASE(empty_file)
+{
+    write_floats("test_empty_file.bin", std::vector<float>());
+
+    compute::vector<float> vector(4, context);
+    compute::read_file_to_buffer("test_empty_file.bin", vector, queue);
+    BOOST_CHECK(vector.empty());
+
+    compute::write_buffer_to_file(
+        vector.begin(), vector.end(), "test_empty_file.bin", queue
+    );
+    {
+        compute::mapped_file<float> file("test_empty_file.bin");
+        BOOST_CHECK(file.empty());
+    }
+
+    std::remove("test_empty_file.bin");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
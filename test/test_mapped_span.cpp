@@ -0,0 +1,65 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMappedSpan
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/mapped_span.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(read_range)
+{
+    compute::vector<int> vector(10, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    compute::mapped_span<int> span(vector.begin() + 2, vector.begin() + 6, CL_MAP_READ, queue);
+    BOOST_CHECK_EQUAL(span.size(), size_t(4));
+    BOOST_CHECK(!span.empty());
+    BOOST_CHECK_EQUAL(span[0], 2);
+    BOOST_CHECK_EQUAL(span[3], 5);
+    BOOST_CHECK_EQUAL(std::accumulate(span.begin(), span.end(), 0), 14);
+
+    span.unmap();
+    BOOST_CHECK(span.empty());
+}
+
+BOOST_AUTO_TEST_CASE(write_range)
+{
+    compute::vector<int> vector(4, context);
+    compute::iota(vector.begin(), vector.end(), 0, queue);
+
+    {
+        compute::mapped_span<int> span(vector.begin(), vector.end(), CL_MAP_WRITE, queue);
+        std::fill(span.begin(), span.end(), 7);
+        span[1] = 3;
+    }
+
+    CHECK_RANGE_EQUAL(int, 4, vector, (7, 3, 7, 7));
+}
+
+BOOST_AUTO_TEST_CASE(empty_range)
+{
+    compute::vector<int> vector(4, context);
+
+    compute::mapped_span<int> span(vector.begin(), vector.begin(), CL_MAP_READ, queue);
+    BOOST_CHECK(span.empty());
+    BOOST_CHECK(span.data() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
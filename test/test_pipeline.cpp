@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestPipeline
+#include <boost/test/unit_test.hpp>
+
+#include <numeric>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/utility/pipeline.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(transform_reduce)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::vector<int> vec(data, data + 8, queue);
+
+    int sum = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .transform(_1 * 2)
+        .transform(_1 + 1)
+        .reduce(compute::plus<int>());
+    BOOST_CHECK_EQUAL(sum, 80);
+
+    // with an initial value
+    sum = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .transform(_1 * _1)
+        .reduce(100, compute::plus<int>());
+    BOOST_CHECK_EQUAL(sum, 304);
+}
+
+BOOST_AUTO_TEST_CASE(filter_count)
+{
+    using compute::lambda::_1;
+
+    compute::vector<int> vec(size_t(10000), context);
+    compute::iota(vec.begin(), vec.end(), 0, queue);
+
+    size_t count = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .filter(_1 % 3 == 0)
+        .count();
+    BOOST_CHECK_EQUAL(count, size_t(3334));
+
+    // the maximum of the odd values
+    int max = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .filter(_1 % 2 == 1)
+        .reduce(compute::max<int>());
+    BOOST_CHECK_EQUAL(max, 9999);
+
+    // no value passes the filter
+    max = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .filter(_1 < 0)
+        .reduce(-1, compute::max<int>());
+    BOOST_CHECK_EQUAL(max, -1);
+}
+
+BOOST_AUTO_TEST_CASE(change_type)
+{
+    BOOST_COMPUTE_FUNCTION(float, to_float, (int x),
+    {
+        return (float) x;
+    });
+
+    int data[] = { 1, 4, 9, 16 };
+    compute::vector<int> vec(data, data + 4, queue);
+
+    float sum = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .transform(to_float)
+        .transform(compute::sqrt<float>())
+        .reduce(compute::plus<float>());
+    BOOST_CHECK_CLOSE(sum, 10.0f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(store_and_execute)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4, 5 };
+    compute::vector<int> vec(data, data + 5, queue);
+    compute::vector<int> squares(5, context);
+    compute::vector<int> cubes(5, context);
+    compute::fill(cubes.begin(), cubes.end(), 0, queue);
+
+    // write several outputs in a single pass
+    int sum = compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .transform(_1 * _1)
+        .store(squares.begin())
+        .filter(_1 > 4)
+        .transform(_1 * _1)
+        .store(cubes.begin())
+        .reduce(compute::plus<int>());
+    BOOST_CHECK_EQUAL(sum, 81 + 256 + 625);
+    CHECK_RANGE_EQUAL(int, 5, squares, (1, 4, 9, 16, 25));
+    CHECK_RANGE_EQUAL(int, 5, cubes, (0, 0, 81, 256, 625));
+
+    compute::make_pipeline(vec.begin(), vec.end(), queue)
+        .transform(_1 + 10)
+        .store(squares.begin())
+        .execute();
+    CHECK_RANGE_EQUAL(int, 5, squares, (11, 12, 13, 14, 15));
+}
+
+BOOST_AUTO_TEST_CASE(empty_range)
+{
+    using compute::lambda::_1;
+
+    compute::vector<int> vec(context);
+
+    BOOST_CHECK_EQUAL(
+        compute::make_pipeline(vec.begin(), vec.end(), queue).count(), size_t(0)
+    );
+    BOOST_CHECK_EQUAL(
+        compute::make_pipeline(vec.begin(), vec.end(), queue)
+            .transform(_1 + 1)
+            .reduce(7, compute::plus<int>()),
+        7
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
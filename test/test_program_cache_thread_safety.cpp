@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestProgramCacheThreadSafety
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+  #include <thread>
+  using std::thread;
+#else
+  #include <boost/thread.hpp>
+  using boost::thread;
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/context.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/program.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+
+namespace compute = boost::compute;
+
+const char source[] =
+    "__kernel void add(__global int *a, int x)\n"
+    "{\n"
+    "    a[get_global_id(0)] += x;\n"
+    "}\n";
+
+void get_or_build_worker_thread(
+    int id,
+    const compute::context& context,
+    compute::program* programs,
+    compute::program_cache** caches)
+{
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    caches[id] = cache.get();
+
+    programs[id] = cache->get_or_build(
+        "__boost_test_thread_safety", std::string(), source, context
+    );
+
+    // kernels are created by each thread from the shared program
+    compute::kernel kernel = programs[id].create_kernel("add");
+    BOOST_CHECK_EQUAL(kernel.name(), std::string("add"));
+}
+
+void parameter_cache_worker_thread(int id, const compute::device& device)
+{
+    boost::shared_ptr<compute::detail::parameter_cache> cache =
+        compute::detail::parameter_cache::get_global_cache(device);
+
+    cache->set("__boost_test_thread_safety", "thread", compute::uint_(id));
+    BOOST_CHECK(
+        cache->get("__boost_test_thread_safety", "thread", 1000) < 1000
+    );
+}
+
+BOOST_AUTO_TEST_CASE(shared_program_cache)
+{
+#if defined(BOOST_COMPUTE_THREAD_SAFE) && defined(NDEBUG)
+    const int num_threads = 16;
+
+    compute::program programs[num_threads];
+    compute::program_cache* caches[num_threads];
+    thread* threads[num_threads];
+
+    compute::context context = compute::system::default_context();
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads[i] = new thread(
+            get_or_build_worker_thread, i, context, programs, caches
+        );
+    }
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    // all threads share one cache and the program was only built once
+    for (int i = 1; i < num_threads; i++)
+    {
+        BOOST_CHECK_EQUAL(caches[0], caches[i]);
+        BOOST_CHECK_EQUAL(programs[0].get(), programs[i].get());
+    }
+    BOOST_CHECK_EQUAL(
+        compute::program_cache::get_global_cache(context).get(), caches[0]
+    );
+#endif // defined(BOOST_COMPUTE_THREAD_SAFE) && defined(NDEBUG)
+}
+
+BOOST_AUTO_TEST_CASE(shared_parameter_cache)
+{
+#if defined(BOOST_COMPUTE_THREAD_SAFE) && defined(NDEBUG)
+    const int num_threads = 16;
+
+    thread* threads[num_threads];
+
+    compute::device device = compute::system::default_device();
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads[i] = new thread(parameter_cache_worker_thread, i, device);
+    }
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    // values set by the worker threads are visible to this thread
+    BOOST_CHECK(
+        compute::detail::parameter_cache::get_global_cache(device)->get(
+            "__boost_test_thread_safety", "thread", 1000
+        ) < num_threads
+    );
+#endif // defined(BOOST_COMPUTE_THREAD_SAFE) && defined(NDEBUG)
+}
@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestQueuePool
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/async/queue_pool.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+#if defined(BOOST_COMPUTE_THREAD_SAFE) && defined(NDEBUG) && \
+    defined(BOOST_COMPUTE_CL_VERSION_1_1)
+
+// fills a block of the vector with the index of the block
+struct fill_block
+{
+    fill_block(compute::vector<int> &vector, size_t block, size_t block_size)
+        : vector(vector), block(block), block_size(block_size)
+    {
+    }
+
+    void operator()(compute::command_queue &queue) const
+    {
+        compute::fill(
+            vector.begin() + block * block_size,
+            vector.begin() + (block + 1) * block_size,
+            static_cast<int>(block),
+            queue
+        );
+    }
+
+    compute::vector<int> &vector;
+    size_t block;
+    size_t block_size;
+};
+
+struct throw_job
+{
+    void operator()(compute::command_queue &) const
+    {
+        throw std::runtime_error("job failed");
+    }
+};
+
+BOOST_AUTO_TEST_CASE(submit_jobs)
+{
+    compute::vector<int> vector(64, context);
+    queue.finish();
+
+//! [submit_jobs]
+// create a pool of four queues
+boost::compute::queue_pool pool(context, 4);
+
+// fill each block of the vector with one job
+boost::compute::wait_list events;
+for(size_t block = 0; block < 8; block++){
+    events.insert(pool.submit(fill_block(vector, block, 8)));
+}
+
+// wait for all jobs to complete
+events.wait();
+//! [submit_jobs]
+
+    BOOST_CHECK_EQUAL(pool.size(), size_t(4));
+    BOOST_CHECK_EQUAL(pool.outstanding(), size_t(0));
+    BOOST_CHECK(pool.stolen() <= 8);
+
+    std::vector<int> host(64);
+    compute::copy(vector.begin(), vector.end(), host.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<int>(i / 8));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(wait_for_jobs)
+{
+    compute::vector<int> vector(1024, context);
+
+    compute::queue_pool pool(context, 2);
+    for(size_t block = 0; block < 16; block++){
+        pool.submit(fill_block(vector, block, 64));
+    }
+    pool.wait();
+
+    BOOST_CHECK_EQUAL(pool.outstanding(), size_t(0));
+    BOOST_CHECK_EQUAL(int(vector[0]), 0);
+    BOOST_CHECK_EQUAL(int(vector[1023]), 15);
+}
+
+BOOST_AUTO_TEST_CASE(failed_job)
+{
+    compute::queue_pool pool(context, 2);
+
+    compute::event event = pool.submit(throw_job());
+    pool.wait();
+
+    BOOST_CHECK(event.status() < 0);
+}
+
+BOOST_AUTO_TEST_CASE(pool_from_queues)
+{
+    std::vector<compute::command_queue> queues;
+    queues.push_back(queue);
+
+    compute::vector<int> vector(32, context);
+
+    compute::queue_pool pool(queues);
+    BOOST_CHECK_EQUAL(pool.size(), size_t(1));
+    BOOST_CHECK(pool.get_queue(0) == queue);
+
+    pool.submit(fill_block(vector, 1, 16)).wait();
+    BOOST_CHECK_EQUAL(int(vector[16]), 1);
+    BOOST_CHECK_EQUAL(int(vector[31]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_queues)
+{
+    std::vector<compute::command_queue> queues;
+    BOOST_CHECK_THROW(compute::queue_pool pool(queues), std::invalid_argument);
+    BOOST_CHECK_THROW(compute::queue_pool pool(context, 0), std::invalid_argument);
+
+    // queues from different contexts
+    compute::context other_context(device);
+    queues.push_back(queue);
+    queues.push_back(compute::command_queue(other_context, device));
+    BOOST_CHECK_THROW(compute::queue_pool pool(queues), std::invalid_argument);
+}
+
+#endif // BOOST_COMPUTE_THREAD_SAFE && NDEBUG && BOOST_COMPUTE_CL_VERSION_1_1
+
+BOOST_AUTO_TEST_SUITE_END()
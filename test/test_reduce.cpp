@@ -295,4 +295,22 @@ BOOST_AUTO_TEST_CASE(buffer_reference_count_test)
     BOOST_CHECK_EQUAL(rc1, rc2);
 }
 
+BOOST_AUTO_TEST_CASE(reduce_async)
+{
+    int data[] = { 1, 5, 9, 13, 17 };
+    compute::vector<int> vector(data, data + 5, queue);
+
+    compute::future<int> sum =
+        compute::reduce_async(vector.begin(), vector.end(), queue);
+    compute::future<int> max = compute::reduce_async(
+        vector.begin(), vector.end(), compute::max<int>(), queue
+    );
+    compute::future<int> empty =
+        compute::reduce_async(vector.begin(), vector.begin(), queue);
+
+    BOOST_CHECK_EQUAL(sum.get(), 45);
+    BOOST_CHECK_EQUAL(max.get(), 17);
+    BOOST_CHECK_EQUAL(empty.get(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestScratchPool
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/allocator/scratch_allocator.hpp>
+#include <boost/compute/allocator/scratch_pool.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(allocate_deallocate)
+{
+    compute::scratch_pool pool(context);
+    BOOST_CHECK_EQUAL(pool.size(), size_t(0));
+
+    compute::buffer a = pool.allocate(1000);
+    BOOST_CHECK_EQUAL(a.size(), size_t(1024));
+    BOOST_CHECK_EQUAL(pool.size(), size_t(1));
+
+    // a is in use so a new buffer is created
+    compute::buffer b = pool.allocate(1000);
+    BOOST_CHECK(a.get() != b.get());
+    BOOST_CHECK_EQUAL(pool.size(), size_t(2));
+    BOOST_CHECK_EQUAL(pool.memory_size(), size_t(2048));
+
+    // a is not reused until it is released
+    BOOST_CHECK(pool.deallocate(a));
+    compute::buffer c = pool.allocate(900);
+    BOOST_CHECK(c.get() != a.get());
+    BOOST_CHECK_EQUAL(pool.size(), size_t(3));
+
+    // a is reused for a request of the same rounded size
+    pool.release();
+    compute::buffer d = pool.allocate(900);
+    BOOST_CHECK(d.get() == a.get());
+    BOOST_CHECK_EQUAL(pool.size(), size_t(3));
+
+    compute::buffer other(context, 16);
+    BOOST_CHECK(!pool.deallocate(other));
+
+    BOOST_CHECK(pool.deallocate(b));
+    pool.release();
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.size(), size_t(2));
+}
+
+BOOST_AUTO_TEST_CASE(release_with_event)
+{
+    compute::scratch_pool pool(context);
+
+    compute::buffer a = pool.allocate(256);
+    BOOST_CHECK(pool.deallocate(a));
+
+    // a is reused once the commands using it are complete
+    compute::event marker = queue.enqueue_marker();
+    pool.release(marker);
+    marker.wait();
+
+    compute::buffer b = pool.allocate(256);
+    BOOST_CHECK(b.get() == a.get());
+    BOOST_CHECK_EQUAL(pool.size(), size_t(1));
+}
+
+BOOST_AUTO_TEST_CASE(scratch_allocator_uses_active_pool)
+{
+    compute::scratch_pool pool(context);
+
+    {
+        compute::scratch_pool::scoped_activation activation(&pool);
+        BOOST_CHECK(compute::scratch_pool::active() == &pool);
+
+        for(int i = 0; i < 4; i++){
+            compute::vector<int, compute::scratch_allocator<int> >
+                vector(100, context);
+            compute::fill(vector.begin(), vector.end(), i, queue);
+            CHECK_RANGE_EQUAL(int, 3, vector, (i, i, i));
+            pool.release();
+        }
+    }
+    BOOST_CHECK(compute::scratch_pool::active() == 0);
+
+    // each vector reused the buffer of the previous one
+    BOOST_CHECK_EQUAL(pool.size(), size_t(1));
+}
+
+BOOST_AUTO_TEST_CASE(buffer_allocator_ignores_active_pool)
+{
+    compute::scratch_pool pool(context);
+
+    {
+        compute::scratch_pool::scoped_activation activation(&pool);
+
+        // containers created by the caller are not taken from the pool
+        compute::vector<int> vector(100, context);
+        BOOST_CHECK_EQUAL(vector.get_buffer().size(), 100 * sizeof(int));
+    }
+
+    BOOST_CHECK_EQUAL(pool.size(), size_t(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSoaVector
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <boost/compute/types/struct.hpp>
+
+struct Particle
+{
+    Particle(): x(0.f), y(0.f), mass(0) { }
+    Particle(float _x, float _y, int _mass): x(_x), y(_y), mass(_mass) { }
+
+    float x;
+    float y;
+    int mass;
+};
+
+// adapt struct for OpenCL
+BOOST_COMPUTE_ADAPT_STRUCT(Particle, Particle, (x, y, mass))
+
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/soa_vector.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/get.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/types/tuple.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(columns)
+{
+    BOOST_CHECK_EQUAL(compute::soa_vector<Particle>::column_count(), size_t(3));
+    BOOST_CHECK_EQUAL(std::string(compute::soa_vector<Particle>::column_name(2)), "mass");
+
+    compute::soa_vector<Particle> particles(4, context);
+    BOOST_CHECK_EQUAL(particles.size(), size_t(4));
+    BOOST_CHECK_EQUAL(particles.column<0>().size(), size_t(4));
+    BOOST_CHECK(&particles.column<1>() == &particles.column(&Particle::y));
+    BOOST_CHECK(&particles.column<2>() == &particles.column(&Particle::mass));
+}
+
+BOOST_AUTO_TEST_CASE(push_back_and_read)
+{
+    compute::soa_vector<Particle> particles(context);
+    particles.push_back(Particle(1.f, 2.f, 3), queue);
+    particles.push_back(Particle(4.f, 5.f, 6), queue);
+    BOOST_CHECK_EQUAL(particles.size(), size_t(2));
+
+    CHECK_RANGE_EQUAL(float, 2, particles.column(&Particle::x), (1.f, 4.f));
+    CHECK_RANGE_EQUAL(int, 2, particles.column(&Particle::mass), (3, 6));
+
+    Particle p = particles.get(1, queue);
+    BOOST_CHECK_EQUAL(p.x, 4.f);
+    BOOST_CHECK_EQUAL(p.y, 5.f);
+    BOOST_CHECK_EQUAL(p.mass, 6);
+
+    particles[0] = Particle(7.f, 8.f, 9);
+    p = particles[0];
+    BOOST_CHECK_EQUAL(p.y, 8.f);
+    BOOST_CHECK_EQUAL(p.mass, 9);
+}
+
+BOOST_AUTO_TEST_CASE(assign_and_copy_to_host)
+{
+    std::vector<Particle> host;
+    host.push_back(Particle(1.f, 0.f, 10));
+    host.push_back(Particle(2.f, 1.f, 20));
+    host.push_back(Particle(3.f, 2.f, 30));
+
+    compute::soa_vector<Particle> particles(host.begin(), host.end(), queue);
+    BOOST_CHECK_EQUAL(particles.size(), size_t(3));
+    CHECK_RANGE_EQUAL(float, 3, particles.column<1>(), (0.f, 1.f, 2.f));
+
+    std::vector<Particle> result(3);
+    particles.copy_to(result.begin(), queue);
+    BOOST_CHECK_EQUAL(result[2].x, 3.f);
+    BOOST_CHECK_EQUAL(result[2].mass, 30);
+
+    compute::soa_vector<Particle> filled(3, Particle(5.f, 6.f, 7), queue);
+    CHECK_RANGE_EQUAL(int, 3, filled.column<2>(), (7, 7, 7));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_column)
+{
+    std::vector<Particle> host;
+    for(int i = 0; i < 16; i++){
+        host.push_back(Particle(float(i), 0.f, i + 1));
+    }
+
+//! [reduce_column]
+// store the particles with one buffer per member
+boost::compute::soa_vector<Particle> particles(host.begin(), host.end(), queue);
+
+// sum their masses, reading only the mass column
+boost::compute::vector<int> &mass = particles.column(&Particle::mass);
+
+int total_mass = 0;
+boost::compute::reduce(mass.begin(), mass.end(), &total_mass, queue);
+//! [reduce_column]
+
+    BOOST_CHECK_EQUAL(total_mass, 136);
+}
+
+BOOST_AUTO_TEST_CASE(zip_view)
+{
+    compute::soa_vector<Particle> particles(context);
+    particles.push_back(Particle(1.f, 2.f, 1), queue);
+    particles.push_back(Particle(3.f, 4.f, 2), queue);
+    particles.push_back(Particle(5.f, 6.f, 3), queue);
+    BOOST_CHECK_EQUAL(std::distance(particles.begin(), particles.end()), 3);
+
+    // x + y for each particle
+    compute::vector<float> sums(3, context);
+    compute::transform(
+        compute::make_transform_iterator(particles.begin(), compute::get<0>()),
+        compute::make_transform_iterator(particles.end(), compute::get<0>()),
+        compute::make_transform_iterator(particles.begin(), compute::get<1>()),
+        sums.begin(),
+        compute::plus<float>(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(float, 3, sums, (3.f, 7.f, 11.f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
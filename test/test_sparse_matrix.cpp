@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSparseMatrix
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/container/coo_matrix.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty_matrix)
+{
+    compute::coo_matrix<float> coo(context);
+    BOOST_CHECK_EQUAL(coo.rows(), size_t(0));
+    BOOST_CHECK_EQUAL(coo.cols(), size_t(0));
+    BOOST_CHECK_EQUAL(coo.nonzeros(), size_t(0));
+
+    compute::csr_matrix<float> csr(coo, queue);
+    BOOST_CHECK_EQUAL(csr.rows(), size_t(0));
+    BOOST_CHECK_EQUAL(csr.nonzeros(), size_t(0));
+    CHECK_RANGE_EQUAL(compute::uint_, 1, csr.row_offsets(), (0));
+
+    compute::csr_matrix<float> empty(context);
+    BOOST_CHECK_EQUAL(empty.rows(), size_t(0));
+    BOOST_CHECK_EQUAL(empty.nonzeros(), size_t(0));
+    CHECK_RANGE_EQUAL(compute::uint_, 1, empty.row_offsets(), (0));
+}
+
+BOOST_AUTO_TEST_CASE(coo_to_csr)
+{
+//! [coo_to_csr]
+// the entries of a 4x4 matrix in any order
+boost::compute::uint_ rows[] = { 2, 0, 3, 0, 2 };
+boost::compute::uint_ cols[] = { 1, 3, 0, 0, 3 };
+float values[] = { 5, 2, 6, 1, 4 };
+
+boost::compute::coo_matrix<float> coo(4, 4, rows, rows + 5, cols, values, queue);
+
+// sorts the entries by row and column
+boost::compute::csr_matrix<float> csr(coo, queue);
+
+// row_offsets = { 0, 2, 2, 4, 5 }
+// column_indices = { 0, 3, 1, 3, 0 }
+// values = { 1, 2, 5, 4, 6 }
+//! [coo_to_csr]
+
+    BOOST_CHECK_EQUAL(csr.rows(), size_t(4));
+    BOOST_CHECK_EQUAL(csr.cols(), size_t(4));
+    BOOST_CHECK_EQUAL(csr.nonzeros(), size_t(5));
+    CHECK_RANGE_EQUAL(compute::uint_, 5, csr.row_offsets(), (0, 2, 2, 4, 5));
+    CHECK_RANGE_EQUAL(compute::uint_, 5, csr.column_indices(), (0, 3, 1, 3, 0));
+    CHECK_RANGE_EQUAL(float, 5, csr.values(), (1, 2, 5, 4, 6));
+}
+
+BOOST_AUTO_TEST_CASE(trailing_empty_rows)
+{
+    compute::uint_ rows[] = { 1, 1 };
+    compute::uint_ cols[] = { 2, 0 };
+    float values[] = { 3, 4 };
+
+    compute::coo_matrix<float> coo(5, 3, rows, rows + 2, cols, values, queue);
+    compute::csr_matrix<float> csr(coo, queue);
+    CHECK_RANGE_EQUAL(compute::uint_, 6, csr.row_offsets(), (0, 0, 2, 2, 2, 2));
+    CHECK_RANGE_EQUAL(compute::uint_, 2, csr.column_indices(), (0, 2));
+    CHECK_RANGE_EQUAL(float, 2, csr.values(), (4, 3));
+}
+
+BOOST_AUTO_TEST_CASE(csr_from_arrays)
+{
+    compute::uint_ offsets[] = { 0, 1, 3, 3 };
+    compute::uint_ cols[] = { 2, 0, 1 };
+    float values[] = { 1, 2, 3 };
+
+    compute::csr_matrix<float> csr(3, 3, 3, offsets, cols, values, queue);
+    BOOST_CHECK_EQUAL(csr.rows(), size_t(3));
+    BOOST_CHECK_EQUAL(csr.nonzeros(), size_t(3));
+    CHECK_RANGE_EQUAL(compute::uint_, 4, csr.row_offsets(), (0, 1, 3, 3));
+
+    // copies keep the entries
+    compute::csr_matrix<float> copy(csr);
+    CHECK_RANGE_EQUAL(compute::uint_, 3, copy.column_indices(), (2, 0, 1));
+    CHECK_RANGE_EQUAL(float, 3, copy.values(), (1, 2, 3));
+}
+
+BOOST_AUTO_TEST_CASE(csr_to_coo)
+{
+    compute::uint_ offsets[] = { 0, 2, 2, 3 };
+    compute::uint_ cols[] = { 0, 2, 1 };
+    float values[] = { 1, 2, 3 };
+
+    compute::csr_matrix<float> csr(3, 3, 3, offsets, cols, values, queue);
+
+    compute::coo_matrix<float> coo(context);
+    csr.copy_to(coo, queue);
+    BOOST_CHECK_EQUAL(coo.rows(), size_t(3));
+    BOOST_CHECK_EQUAL(coo.cols(), size_t(3));
+    CHECK_RANGE_EQUAL(compute::uint_, 3, coo.row_indices(), (0, 0, 2));
+    CHECK_RANGE_EQUAL(compute::uint_, 3, coo.column_indices(), (0, 2, 1));
+    CHECK_RANGE_EQUAL(float, 3, coo.values(), (1, 2, 3));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
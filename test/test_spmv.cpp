@@ -0,0 +1,204 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSpmv
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/spmm.hpp>
+#include <boost/compute/algorithm/spmv.hpp>
+#include <boost/compute/allocator/scratch_pool.hpp>
+#include <boost/compute/container/csr_matrix.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// a matrix with empty rows, short rows and rows which span many tiles of
+// the merge path kernel. the values are small integers so that the sums
+// are exact.
+struct irregular_matrix
+{
+    irregular_matrix(size_t rows, size_t cols)
+        : offsets(1, 0), x(cols)
+    {
+        for(size_t row = 0; row < rows; row++){
+            const size_t length =
+                row % 7 == 3 ? 0 : row % 13 == 5 ? 200 + row : row % 5;
+            for(size_t i = 0; i < length; i++){
+                columns.push_back(static_cast<compute::uint_>((row * 31 + i * 17) % cols));
+                values.push_back(static_cast<float>((row + i) % 5) - 2.f);
+            }
+            offsets.push_back(static_cast<compute::uint_>(values.size()));
+        }
+        for(size_t i = 0; i < cols; i++){
+            x[i] = static_cast<float>(i % 3);
+        }
+    }
+
+    // computes y = a * x for the n columns of x on the host
+    std::vector<float> multiply(const std::vector<float> &x, size_t n) const
+    {
+        std::vector<float> y((offsets.size() - 1) * n, 0.f);
+        for(size_t row = 0; row + 1 < offsets.size(); row++){
+            for(compute::uint_ j = offsets[row]; j < offsets[row + 1]; j++){
+                for(size_t col = 0; col < n; col++){
+                    y[row * n + col] += values[j] * x[columns[j] * n + col];
+                }
+            }
+        }
+        return y;
+    }
+
+    std::vector<compute::uint_> offsets;
+    std::vector<compute::uint_> columns;
+    std::vector<float> values;
+    std::vector<float> x;
+};
+
+typedef compute::vector<float>::iterator iterator;
+typedef void (*spmv_function)(const compute::csr_matrix<float> &,
+                              iterator,
+                              iterator,
+                              compute::command_queue &);
+
+void check_spmv(spmv_function function, compute::command_queue &queue)
+{
+    const size_t rows = 250;
+    const size_t cols = 97;
+    irregular_matrix host(rows, cols);
+
+    compute::csr_matrix<float> a(
+        rows, cols, host.values.size(),
+        host.offsets.begin(), host.columns.begin(), host.values.begin(), queue
+    );
+    compute::vector<float> x(host.x.begin(), host.x.end(), queue);
+    compute::vector<float> y(rows, queue.get_context());
+
+    function(a, x.begin(), y.begin(), queue);
+
+    std::vector<float> expected = host.multiply(host.x, 1);
+    std::vector<float> result(rows);
+    compute::copy(y.begin(), y.end(), result.begin(), queue);
+    for(size_t i = 0; i < rows; i++){
+        BOOST_CHECK_EQUAL(result[i], expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(spmv_float)
+{
+//! [spmv]
+// the 3x3 matrix { { 1, 0, 2 },
+//                  { 0, 0, 0 },
+//                  { 0, 3, 0 } }
+boost::compute::uint_ offsets[] = { 0, 2, 2, 3 };
+boost::compute::uint_ cols[] = { 0, 2, 1 };
+float values[] = { 1, 2, 3 };
+float x_data[] = { 1, 2, 3 };
+
+boost::compute::csr_matrix<float> a(3, 3, 3, offsets, cols, values, queue);
+boost::compute::vector<float> x(x_data, x_data + 3, queue);
+boost::compute::vector<float> y(3, context);
+
+// y = a * x
+boost::compute::spmv(a, x.begin(), y.begin(), queue);
+
+// y = { 7, 0, 6 }
+//! [spmv]
+
+    CHECK_RANGE_EQUAL(float, 3, y, (7, 0, 6));
+}
+
+BOOST_AUTO_TEST_CASE(spmv_irregular_rows)
+{
+    check_spmv(&compute::spmv<float, iterator, iterator>, queue);
+}
+
+BOOST_AUTO_TEST_CASE(spmv_scalar)
+{
+    check_spmv(&compute::detail::spmv_scalar<float, iterator, iterator>, queue);
+}
+
+BOOST_AUTO_TEST_CASE(spmv_vector)
+{
+    check_spmv(&compute::detail::spmv_vector<float, iterator, iterator>, queue);
+}
+
+BOOST_AUTO_TEST_CASE(spmv_merge_path)
+{
+    check_spmv(&compute::detail::spmv_merge_path<float, iterator, iterator>, queue);
+}
+
+BOOST_AUTO_TEST_CASE(spmv_merge_path_single_tile)
+{
+    // fewer rows and entries than the tile size
+    compute::uint_ offsets[] = { 0, 1, 1, 3 };
+    compute::uint_ cols[] = { 1, 0, 1 };
+    float values[] = { 2, 3, 4 };
+    float x_data[] = { 1, 2 };
+
+    compute::csr_matrix<float> a(3, 2, 3, offsets, cols, values, queue);
+    compute::vector<float> x(x_data, x_data + 2, queue);
+    compute::vector<float> y(3, context);
+
+    compute::detail::spmv_merge_path(a, x.begin(), y.begin(), queue);
+    CHECK_RANGE_EQUAL(float, 3, y, (4, 0, 11));
+}
+
+BOOST_AUTO_TEST_CASE(spmv_merge_path_reuses_scratch_pool)
+{
+    compute::scratch_pool pool(context);
+    compute::scratch_pool::scoped_activation activation(&pool);
+
+    check_spmv(&compute::detail::spmv_merge_path<float, iterator, iterator>, queue);
+    queue.finish();
+    pool.release();
+    const size_t buffers = pool.size();
+    BOOST_CHECK(buffers > 0);
+
+    // the second product takes its temporaries from the pool
+    check_spmv(&compute::detail::spmv_merge_path<float, iterator, iterator>, queue);
+    BOOST_CHECK_EQUAL(pool.size(), buffers);
+}
+
+BOOST_AUTO_TEST_CASE(spmm_float)
+{
+    const size_t rows = 60;
+    const size_t cols = 41;
+    const size_t n = 3;
+    irregular_matrix host(rows, cols);
+
+    std::vector<float> host_x(cols * n);
+    for(size_t i = 0; i < host_x.size(); i++){
+        host_x[i] = static_cast<float>(i % 4);
+    }
+
+    compute::csr_matrix<float> a(
+        rows, cols, host.values.size(),
+        host.offsets.begin(), host.columns.begin(), host.values.begin(), queue
+    );
+    compute::vector<float> x(host_x.begin(), host_x.end(), queue);
+    compute::vector<float> y(rows * n, context);
+
+    compute::spmm(a, x.begin(), n, y.begin(), queue);
+
+    std::vector<float> expected = host.multiply(host_x, n);
+    std::vector<float> result(rows * n);
+    compute::copy(y.begin(), y.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
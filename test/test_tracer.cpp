@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTracer
+#include <boost/test/unit_test.hpp>
+
+// the tracing hooks are only compiled in when this is defined
+#ifndef BOOST_COMPUTE_ENABLE_TRACING
+#define BOOST_COMPUTE_ENABLE_TRACING
+#endif
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/utility/tracer.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(trace_algorithm_kernels)
+{
+    bc::command_queue profiling_queue(
+        context, device, bc::command_queue::enable_profiling
+    );
+
+    std::vector<float> data(1024);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float>(data.size() - i);
+    }
+    bc::vector<float> vector(data.size(), context);
+
+    bc::tracer &tracer = bc::tracer::global();
+    tracer.clear();
+    tracer.start();
+    bc::copy(data.begin(), data.end(), vector.begin(), profiling_queue);
+    bc::sort(vector.begin(), vector.end(), profiling_queue);
+    bc::transform(
+        vector.begin(), vector.end(), vector.begin(), bc::sqrt<float>(), profiling_queue
+    );
+    tracer.stop();
+    profiling_queue.finish();
+
+    // commands enqueued after stop() are not recorded
+    const size_t count = tracer.size();
+    bc::transform(
+        vector.begin(), vector.end(), vector.begin(), bc::sqrt<float>(), profiling_queue
+    );
+    BOOST_CHECK_EQUAL(tracer.size(), count);
+
+    std::vector<bc::trace_record> records = tracer.records();
+    BOOST_REQUIRE(!records.empty());
+
+    size_t kernels = 0;
+    size_t writes = 0;
+    for(size_t i = 0; i < records.size(); i++){
+        const bc::trace_record &record = records[i];
+        if(record.type == "kernel"){
+            kernels++;
+            BOOST_CHECK(!record.name.empty());
+            BOOST_CHECK(record.work_dim > 0);
+            BOOST_CHECK(record.global_work_size[0] > 0);
+        }
+        else if(record.type == "write_buffer"){
+            writes++;
+            BOOST_CHECK(record.bytes > 0);
+        }
+        BOOST_CHECK(record.start <= record.end);
+    }
+
+    // sort() launches several kernels internally
+    BOOST_CHECK(kernels > 2);
+    BOOST_CHECK(writes > 0);
+
+    // kernels generated with meta_kernel have a cache key
+    BOOST_CHECK(records.back().type == "kernel");
+    BOOST_CHECK(!records.back().cache_key.empty());
+
+    std::stringstream json;
+    tracer.write_chrome_trace(json);
+    BOOST_CHECK(json.str().find("\"traceEvents\"") != std::string::npos);
+    BOOST_CHECK(json.str().find("\"ph\":\"X\"") != std::string::npos);
+
+    std::stringstream csv;
+    tracer.write_csv(csv);
+    std::string header;
+    std::getline(csv, header);
+    BOOST_CHECK_EQUAL(
+        header,
+        "type,name,cache_key,global_work_size,local_work_size,"
+        "bytes,queued,submit,start,end"
+    );
+
+    tracer.clear();
+    BOOST_CHECK_EQUAL(tracer.size(), size_t(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
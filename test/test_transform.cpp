@@ -15,10 +15,12 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/function.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
 #include <boost/compute/functional/field.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -98,6 +100,57 @@ BOOST_AUTO_TEST_CASE(transform_add_int)
     CHECK_RANGE_EQUAL(int, 4, output, (10, 40, 90, 160));
 }
 
+BOOST_AUTO_TEST_CASE(transform_registered_kernel_offsets)
+{
+    // built-in functions on plain buffers use a kernel registered by type,
+    // check that it is reused with different buffers and offsets
+    bc::detail::kernel_registry &registry =
+        bc::detail::kernel_registry::get_global_registry();
+
+    int data1[] = { 1, 2, 3, 4, 5, 6 };
+    bc::vector<int> input1(data1, data1 + 6, queue);
+
+    int data2[] = { 10, 20, 30, 40, 50, 60 };
+    bc::vector<int> input2(data2, data2 + 6, queue);
+
+    bc::vector<int> output(6, context);
+    bc::transform(input1.begin(),
+                  input1.end(),
+                  input2.begin(),
+                  output.begin(),
+                  bc::minus<int>(),
+                  queue);
+    CHECK_RANGE_EQUAL(int, 6, output, (-9, -18, -27, -36, -45, -54));
+    const size_t registered = registry.size();
+
+    bc::transform(input1.begin() + 1,
+                  input1.begin() + 4,
+                  input2.begin() + 2,
+                  output.begin() + 3,
+                  bc::minus<int>(),
+                  queue);
+    CHECK_RANGE_EQUAL(int, 6, output, (-9, -18, -27, -28, -37, -46));
+
+    // in-place
+    bc::transform(input2.begin() + 3,
+                  input2.end(),
+                  input1.begin(),
+                  input2.begin() + 3,
+                  bc::minus<int>(),
+                  queue);
+    CHECK_RANGE_EQUAL(int, 6, input2, (10, 20, 30, 39, 48, 57));
+    BOOST_CHECK_EQUAL(registry.size(), registered);
+
+    // conversion to another output type
+    bc::vector<float> floats(3, context);
+    bc::transform(input1.begin() + 3,
+                  input1.end(),
+                  floats.begin(),
+                  bc::abs<int>(),
+                  queue);
+    CHECK_RANGE_EQUAL(float, 3, floats, (4.0f, 5.0f, 6.0f));
+}
+
 BOOST_AUTO_TEST_CASE(transform_pow4)
 {
     float data[] = { 1.0f, 2.0f, 3.0f, 4.0f };
@@ -321,4 +374,50 @@ BOOST_AUTO_TEST_CASE(abs_if_odd)
     CHECK_RANGE_EQUAL(int, 8, vector, (-2, +3, -4, +5, -6, +7, -8, +9));
 }
 
+BOOST_AUTO_TEST_CASE(transform_vectorized_offsets)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    boost::shared_ptr<compute::detail::parameter_cache> parameters =
+        compute::detail::parameter_cache::get_global_cache(device);
+    parameters->set("__boost_vectorized_transform_float", "vw", 4);
+
+    float data[] = { 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f };
+    compute::vector<float> x(data, data + 11, queue);
+    compute::vector<float> y(data, data + 11, queue);
+    compute::vector<float> result(11, context);
+    compute::fill(result.begin(), result.end(), -1.f, queue);
+
+    // the output starts at an unaligned index so the first three values
+    // and the last value are not part of a vector
+    compute::transform(
+        x.begin(), x.begin() + 8, y.begin() + 2, result.begin() + 1,
+        2.f * _1 + _2, queue
+    );
+    CHECK_RANGE_EQUAL(
+        float, 11, result,
+        (-1.f, 2.f, 5.f, 8.f, 11.f, 14.f, 17.f, 20.f, 23.f, -1.f, -1.f)
+    );
+
+    compute::transform(
+        x.begin() + 3, x.end(), result.begin(), _1 * _1, queue
+    );
+    CHECK_RANGE_EQUAL(
+        float, 8, result,
+        (9.f, 16.f, 25.f, 36.f, 49.f, 64.f, 81.f, 100.f)
+    );
+
+    // fewer values than the vector width
+    compute::transform(
+        x.begin(), x.begin() + 2, result.begin() + 5, _1 * 2.f, queue
+    );
+    CHECK_RANGE_EQUAL(
+        float, 8, result,
+        (9.f, 16.f, 25.f, 36.f, 49.f, 0.f, 2.f, 100.f)
+    );
+
+    parameters->remove("__boost_vectorized_transform_float", "vw");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
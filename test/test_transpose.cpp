@@ -0,0 +1,225 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestTranspose
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/batched_transpose.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/permute_axes.hpp>
+#include <boost/compute/algorithm/transpose.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/dim.hpp>
+#include <boost/compute/utility/extents.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// permutes the axes of a row-major array on the host
+template<size_t N>
+std::vector<int> host_permute_axes(const std::vector<int> &input,
+                                   const compute::extents<N> &shape,
+                                   const compute::extents<N> &axes)
+{
+    compute::extents<N> strides(1);
+    for(size_t i = N - 1; i > 0; i--){
+        strides[i - 1] = strides[i] * shape[i];
+    }
+
+    std::vector<int> output(input.size());
+    for(size_t i = 0; i < output.size(); i++){
+        size_t rest = i;
+        size_t src = 0;
+        for(size_t d = N; d > 0; d--){
+            src += (rest % shape[axes[d - 1]]) * strides[axes[d - 1]];
+            rest /= shape[axes[d - 1]];
+        }
+        output[i] = input[src];
+    }
+
+    return output;
+}
+
+// checks permute_axes() against the host implementation
+template<size_t N>
+void check_permute_axes(const compute::extents<N> &shape,
+                        const compute::extents<N> &axes,
+                        compute::command_queue &queue)
+{
+    const compute::context context = queue.get_context();
+
+    compute::vector<int> input(shape.linear(), context);
+    compute::iota(input.begin(), input.end(), 0, queue);
+    compute::vector<int> output(shape.linear(), context);
+
+    compute::permute_axes(input.begin(), output.begin(), shape, axes, queue);
+
+    std::vector<int> host_input(input.size());
+    compute::copy(input.begin(), input.end(), host_input.begin(), queue);
+    std::vector<int> expected = host_permute_axes(host_input, shape, axes);
+
+    std::vector<int> host_output(output.size());
+    compute::copy(output.begin(), output.end(), host_output.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        host_output.begin(), host_output.end(), expected.begin(), expected.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(transpose_int)
+{
+//! [transpose_matrix]
+// 3x4 matrix in row-major order
+int data[] = { 0, 1, 2, 3,
+               4, 5, 6, 7,
+               8, 9, 10, 11 };
+boost::compute::vector<int> matrix(data, data + 12, queue);
+
+// transpose to a 4x3 matrix (i.e. the 3x4 matrix in column-major order)
+boost::compute::vector<int> transposed(12, context);
+boost::compute::transpose(matrix.begin(), transposed.begin(), 3, 4, queue);
+
+// transposed = { 0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11 }
+//! [transpose_matrix]
+
+    CHECK_RANGE_EQUAL(
+        int, 12, transposed, (0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(transpose_partial_tiles)
+{
+    // sizes which are not a multiple of the tile size
+    const size_t rows = 67;
+    const size_t cols = 131;
+
+    std::vector<float> host(rows * cols);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<float>(i);
+    }
+
+    compute::vector<float> matrix(host.begin(), host.end(), queue);
+    compute::vector<float> transposed(rows * cols, context);
+    compute::transpose(matrix.begin(), transposed.begin(), rows, cols, queue);
+
+    std::vector<float> result(rows * cols);
+    compute::copy(transposed.begin(), transposed.end(), result.begin(), queue);
+    for(size_t i = 0; i < rows; i++){
+        for(size_t j = 0; j < cols; j++){
+            BOOST_CHECK_EQUAL(result[j * rows + i], host[i * cols + j]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transpose_vector)
+{
+    // a single row is transposed to a single column
+    int data[] = { 1, 2, 3, 4, 5 };
+    compute::vector<int> row(data, data + 5, queue);
+    compute::vector<int> column(5, context);
+
+    compute::transpose(row.begin(), column.begin(), 1, 5, queue);
+    CHECK_RANGE_EQUAL(int, 5, column, (1, 2, 3, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(batched_transpose_int)
+{
+    // two 2x3 matrices
+    int data[] = { 0, 1, 2,
+                   3, 4, 5,
+
+                   6, 7, 8,
+                   9, 10, 11 };
+    compute::vector<int> matrices(data, data + 12, queue);
+    compute::vector<int> transposed(12, context);
+
+    compute::batched_transpose(
+        matrices.begin(), transposed.begin(), 2, 2, 3, queue
+    );
+    CHECK_RANGE_EQUAL(
+        int, 12, transposed, (0, 3, 1, 4, 2, 5, 6, 9, 7, 10, 8, 11)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(permute_axes_nhwc)
+{
+    const size_t n = 2, h = 5, w = 7, c = 3;
+
+    std::vector<float> host(n * h * w * c);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<float>(i);
+    }
+    compute::vector<float> nhwc(host.begin(), host.end(), queue);
+
+//! [permute_axes_nhwc]
+// convert a batch of images from NHWC (channels last) to NCHW layout
+boost::compute::vector<float> nchw(n * h * w * c, context);
+boost::compute::permute_axes(
+    nhwc.begin(),
+    nchw.begin(),
+    boost::compute::dim(n, h, w, c),
+    boost::compute::dim(0, 3, 1, 2),
+    queue
+);
+//! [permute_axes_nhwc]
+
+    std::vector<float> result(nchw.size());
+    compute::copy(nchw.begin(), nchw.end(), result.begin(), queue);
+    for(size_t i = 0; i < n; i++){
+        for(size_t y = 0; y < h; y++){
+            for(size_t x = 0; x < w; x++){
+                for(size_t k = 0; k < c; k++){
+                    BOOST_CHECK_EQUAL(
+                        result[((i * c + k) * h + y) * w + x],
+                        host[((i * h + y) * w + x) * c + k]
+                    );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(permute_axes_identity)
+{
+    check_permute_axes(compute::dim(3, 4, 5), compute::dim(0, 1, 2), queue);
+}
+
+BOOST_AUTO_TEST_CASE(permute_axes_transpose)
+{
+    // merged to a 12x5 transpose
+    check_permute_axes(compute::dim(3, 4, 5), compute::dim(2, 0, 1), queue);
+
+    // merged to a 3x20 transpose
+    check_permute_axes(compute::dim(3, 4, 5), compute::dim(1, 2, 0), queue);
+}
+
+BOOST_AUTO_TEST_CASE(permute_axes_gather)
+{
+    check_permute_axes(compute::dim(3, 4, 5), compute::dim(1, 0, 2), queue);
+    check_permute_axes(compute::dim(3, 4, 5), compute::dim(2, 1, 0), queue);
+    check_permute_axes(
+        compute::dim(2, 3, 4, 5), compute::dim(3, 1, 0, 2), queue
+    );
+}
+
+BOOST_AUTO_TEST_CASE(permute_axes_unit_extents)
+{
+    // the axes of extent one do not prevent merging the others
+    check_permute_axes(
+        compute::dim(4, 1, 6, 1), compute::dim(2, 3, 0, 1), queue
+    );
+    check_permute_axes(compute::dim(1, 1), compute::dim(1, 0), queue);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
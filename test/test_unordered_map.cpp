@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestUnorderedMap
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/unordered_map.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(insert_find)
+{
+    int keys_data[] = { 4, 12, -3, 7, 9 };
+    float values_data[] = { 4.5f, 12.5f, -3.5f, 7.5f, 9.5f };
+    bc::vector<int> keys(keys_data, keys_data + 5, queue);
+    bc::vector<float> values(values_data, values_data + 5, queue);
+
+    bc::unordered_map<int, float> map(context);
+    BOOST_CHECK(map.empty());
+
+    size_t inserted = map.insert(keys.begin(), keys.end(), values.begin(), queue);
+    BOOST_CHECK_EQUAL(inserted, size_t(5));
+    BOOST_CHECK_EQUAL(map.size(), size_t(5));
+    BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+
+    int lookup_data[] = { 7, 1, 4, -3 };
+    bc::vector<int> lookup(lookup_data, lookup_data + 4, queue);
+    bc::vector<float> result(4, context);
+    map.find(lookup.begin(), lookup.end(), result.begin(), -1.f, queue);
+    CHECK_RANGE_EQUAL(float, 4, result, (7.5f, -1.f, 4.5f, -3.5f));
+
+    bc::vector<int> found(4, context);
+    map.contains(lookup.begin(), lookup.end(), found.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 4, found, (1, 0, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(insert_existing_keys)
+{
+    int keys_data[] = { 1, 2, 2, 3, 1 };
+    int values_data[] = { 10, 20, 20, 30, 10 };
+    bc::vector<int> keys(keys_data, keys_data + 5, queue);
+    bc::vector<int> values(values_data, values_data + 5, queue);
+
+    bc::unordered_map<int, int> map(context);
+    BOOST_CHECK_EQUAL(
+        map.insert(keys.begin(), keys.end(), values.begin(), queue), size_t(3)
+    );
+    BOOST_CHECK_EQUAL(map.size(), size_t(3));
+
+    // inserting keys again does not change their values
+    bc::vector<int> other_values(size_t(5), 0, queue);
+    BOOST_CHECK_EQUAL(
+        map.insert(keys.begin(), keys.end(), other_values.begin(), queue),
+        size_t(0)
+    );
+
+    bc::vector<int> result(3, context);
+    map.find(keys.begin(), keys.begin() + 3, result.begin(), -1, queue);
+    CHECK_RANGE_EQUAL(int, 3, result, (10, 20, 20));
+}
+
+BOOST_AUTO_TEST_CASE(erase)
+{
+    bc::vector<bc::uint_> keys(64, context);
+    bc::iota(keys.begin(), keys.end(), 0, queue);
+
+    bc::unordered_map<bc::uint_, bc::uint_> map(context);
+    map.insert(keys.begin(), keys.end(), keys.begin(), queue);
+    BOOST_CHECK_EQUAL(map.size(), size_t(64));
+
+    // erase the first half of the keys (and one missing key)
+    BOOST_CHECK_EQUAL(map.erase(keys.begin(), keys.begin() + 32, queue), size_t(32));
+    BOOST_CHECK_EQUAL(map.erase(keys.begin(), keys.begin() + 1, queue), size_t(0));
+    BOOST_CHECK_EQUAL(map.size(), size_t(32));
+
+    bc::vector<bc::uint_> found(64, context);
+    map.contains(keys.begin(), keys.end(), found.begin(), queue);
+    std::vector<bc::uint_> host_found(64);
+    bc::copy(found.begin(), found.end(), host_found.begin(), queue);
+    for(size_t i = 0; i < 64; i++){
+        BOOST_CHECK_EQUAL(host_found[i], i < 32 ? 0u : 1u);
+    }
+
+    // erased keys can be inserted again
+    map.insert(keys.begin(), keys.begin() + 4, keys.begin(), queue);
+    BOOST_CHECK_EQUAL(map.size(), size_t(36));
+}
+
+BOOST_AUTO_TEST_CASE(rehash_and_retrieve_all)
+{
+    const size_t n = 10000;
+
+    bc::vector<int> keys(n, context);
+    bc::iota(keys.begin(), keys.end(), -5000, queue);
+    bc::vector<int> values(n, context);
+    bc::iota(values.begin(), values.end(), 0, queue);
+
+    // insert in several batches to force rehashing
+    bc::unordered_map<int, int> map(16, queue);
+    for(size_t i = 0; i < n; i += 1000){
+        map.insert(keys.begin() + i, keys.begin() + i + 1000, values.begin() + i, queue);
+    }
+    BOOST_CHECK_EQUAL(map.size(), n);
+    BOOST_CHECK(map.bucket_count() >= n);
+    BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+
+    bc::vector<int> result_keys(n, context);
+    bc::vector<int> result_values(n, context);
+    BOOST_CHECK_EQUAL(
+        map.retrieve_all(result_keys.begin(), result_values.begin(), queue), n
+    );
+
+    bc::sort_by_key(
+        result_keys.begin(), result_keys.end(), result_values.begin(), queue
+    );
+
+    std::vector<int> host_keys(n);
+    std::vector<int> host_values(n);
+    bc::copy(result_keys.begin(), result_keys.end(), host_keys.begin(), queue);
+    bc::copy(result_values.begin(), result_values.end(), host_values.begin(), queue);
+    for(size_t i = 0; i < n; i++){
+        BOOST_CHECK_EQUAL(host_keys[i], int(i) - 5000);
+        BOOST_CHECK_EQUAL(host_values[i], int(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+    int keys_data[] = { 1, 2, 3 };
+    bc::vector<int> keys(keys_data, keys_data + 3, queue);
+
+    bc::unordered_map<int, int> map(context);
+    map.insert(keys.begin(), keys.end(), keys.begin(), queue);
+    map.clear(queue);
+    BOOST_CHECK(map.empty());
+
+    bc::vector<int> found(3, context);
+    map.contains(keys.begin(), keys.end(), found.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 3, found, (0, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(max_load_factor)
+{
+    bc::unordered_map<int, int> map(context);
+    map.max_load_factor(0.75f);
+    BOOST_CHECK_EQUAL(map.max_load_factor(), 0.75f);
+
+    // a full table would never end probing
+    BOOST_CHECK_THROW(map.max_load_factor(0.f), std::invalid_argument);
+    BOOST_CHECK_THROW(map.max_load_factor(-0.5f), std::invalid_argument);
+    BOOST_CHECK_THROW(map.max_load_factor(1.f), std::invalid_argument);
+    BOOST_CHECK_THROW(map.max_load_factor(2.f), std::invalid_argument);
+    BOOST_CHECK_EQUAL(map.max_load_factor(), 0.75f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
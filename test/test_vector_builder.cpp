@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestVectorBuilder
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/vector_builder.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(push_back)
+{
+    bc::vector<int> vector(context);
+
+    {
+        bc::vector_builder<int> builder(vector, queue, 4);
+        BOOST_CHECK_EQUAL(builder.batch_size(), size_t(4));
+
+        for(int i = 0; i < 6; i++){
+            builder.push_back(i);
+        }
+
+        // the first four values were flushed when the batch was full
+        BOOST_CHECK_EQUAL(builder.staged(), size_t(2));
+        BOOST_CHECK_EQUAL(builder.size(), size_t(6));
+        BOOST_CHECK_EQUAL(vector.size(), size_t(4));
+
+        builder.push_back(6);
+    }
+
+    // the remaining values are flushed when the builder is destroyed
+    BOOST_CHECK_EQUAL(vector.size(), size_t(7));
+    CHECK_RANGE_EQUAL(int, 7, vector, (0, 1, 2, 3, 4, 5, 6));
+}
+
+BOOST_AUTO_TEST_CASE(append_values)
+{
+    std::vector<float> received(1000);
+    for(size_t i = 0; i < received.size(); i++){
+        received[i] = static_cast<float>(i);
+    }
+
+//! [append_values]
+boost::compute::vector<float> values(context);
+boost::compute::vector_builder<float> builder(values, queue, 256);
+
+// stage the values in pinned host memory and write them in batches
+builder.append(received.begin(), received.end());
+builder.push_back(1000.f);
+
+// flush the values which are still staged
+builder.flush();
+//! [append_values]
+
+    BOOST_CHECK_EQUAL(values.size(), size_t(1001));
+
+    std::vector<float> host(values.size());
+    bc::copy(values.begin(), values.end(), host.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<float>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(append_to_existing_values)
+{
+    int data[] = { 1, 2, 3 };
+    bc::vector<int> vector(data, data + 3, queue);
+
+    bc::vector_builder<int> builder(vector, queue, 2);
+    builder.push_back(4);
+    builder.push_back(5);
+    builder.push_back(6);
+
+    bc::vector<int> &result = builder.get_vector();
+    BOOST_CHECK_EQUAL(builder.staged(), size_t(0));
+    BOOST_CHECK_EQUAL(result.size(), size_t(6));
+    CHECK_RANGE_EQUAL(int, 6, result, (1, 2, 3, 4, 5, 6));
+}
+
+BOOST_AUTO_TEST_SUITE_END()